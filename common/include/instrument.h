@@ -0,0 +1,232 @@
+/*
+ * File Name: instrument.h
+ * Authors: Arpit Patel, Dharm KaPatel
+ * Date: 2025-03-19
+ * Description: This file defines the instrumentation shared by the sparse matrix and the priority
+ *              queue libraries: memory accounting (bytes and nodes in use, allocation and free
+ *              counts, high-water marks) and per-operation timers. Counters are updated with
+ *              relaxed atomics, so they are safe to bump from several threads and cost a few
+ *              cycles each. Timers are compiled in only with -DINSTRUMENT_TIMERS (make TIMERS=1).
+ */
+
+
+#ifndef INSTRUMENT_H
+#define INSTRUMENT_H
+
+
+// Include necessary headers
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <time.h>
+
+
+/*
+ * Struct: mem_stats
+ * ----------------------------
+ * Memory accounting of a library or of one object.
+ *
+ * bytes: Bytes in use.
+ * peak_bytes: Largest value bytes has reached.
+ * nodes: Nodes (matrix elements, queue entries) in use.
+ * peak_nodes: Largest value nodes has reached.
+ * allocations: Number of allocations made.
+ * frees: Number of allocations released.
+ */
+typedef struct mem_stats {
+        uint64_t bytes;
+        uint64_t peak_bytes;
+        uint64_t nodes;
+        uint64_t peak_nodes;
+        uint64_t allocations;
+        uint64_t frees;
+} mem_stats;
+
+
+/*
+ * Struct: op_timer
+ * ----------------------------
+ * Time spent in one operation.
+ *
+ * name: Name of the operation.
+ * count: Number of calls.
+ * cycles: Total time of the calls, in TSC cycles (nanoseconds where there is no TSC).
+ */
+typedef struct op_timer {
+        const char* name;
+        uint64_t count;
+        uint64_t cycles;
+} op_timer;
+
+
+/*
+ * Function: raise_peak
+ * ----------------------------
+ * Raises a high-water mark to a value if it is below it.
+ *
+ * @param peak - The high-water mark.
+ * @param value - The current value.
+ */
+static inline void raise_peak(uint64_t* peak, uint64_t value) {
+        uint64_t seen = __atomic_load_n(peak, __ATOMIC_RELAXED);
+        while (seen < value && !__atomic_compare_exchange_n(peak, &seen, value, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+}
+
+
+/*
+ * Function: mem_stats_alloc
+ * ----------------------------
+ * Records memory coming into use.
+ *
+ * @param s - The statistics, or NULL.
+ * @param bytes - Bytes allocated.
+ * @param nodes - Nodes among them.
+ * @param count - Number of allocations; 0 when memory is only handed over from elsewhere.
+ */
+static inline void mem_stats_alloc(mem_stats* s, uint64_t bytes, uint64_t nodes, uint64_t count) {
+        if (!s) return;
+
+        raise_peak(&s->peak_bytes, __atomic_add_fetch(&s->bytes, bytes, __ATOMIC_RELAXED));
+        if (nodes) raise_peak(&s->peak_nodes, __atomic_add_fetch(&s->nodes, nodes, __ATOMIC_RELAXED));
+        if (count) __atomic_add_fetch(&s->allocations, count, __ATOMIC_RELAXED);
+}
+
+
+/*
+ * Function: mem_stats_free
+ * ----------------------------
+ * Records memory going out of use.
+ *
+ * @param s - The statistics, or NULL.
+ * @param bytes - Bytes released.
+ * @param nodes - Nodes among them.
+ * @param count - Number of frees; 0 when memory is only handed over elsewhere.
+ */
+static inline void mem_stats_free(mem_stats* s, uint64_t bytes, uint64_t nodes, uint64_t count) {
+        if (!s) return;
+
+        __atomic_sub_fetch(&s->bytes, bytes, __ATOMIC_RELAXED);
+        if (nodes) __atomic_sub_fetch(&s->nodes, nodes, __ATOMIC_RELAXED);
+        if (count) __atomic_add_fetch(&s->frees, count, __ATOMIC_RELAXED);
+}
+
+
+/*
+ * Function: mem_stats_alloc_owned
+ * ----------------------------
+ * Records memory coming into use in statistics that only the calling thread updates.
+ *
+ * @param s - The statistics.
+ * @param bytes - Bytes allocated.
+ * @param nodes - Nodes among them.
+ * @param count - Number of allocations.
+ *
+ * Description:
+ *   Each field is loaded and stored separately instead of with a locked read-modify-write,
+ *   so mem_stats_read from another thread still sees whole values but no update is atomic.
+ */
+static inline void mem_stats_alloc_owned(mem_stats* s, uint64_t bytes, uint64_t nodes, uint64_t count) {
+        uint64_t used = __atomic_load_n(&s->bytes, __ATOMIC_RELAXED) + bytes;
+        __atomic_store_n(&s->bytes, used, __ATOMIC_RELAXED);
+        if (used > s->peak_bytes) __atomic_store_n(&s->peak_bytes, used, __ATOMIC_RELAXED);
+
+        uint64_t held = __atomic_load_n(&s->nodes, __ATOMIC_RELAXED) + nodes;
+        __atomic_store_n(&s->nodes, held, __ATOMIC_RELAXED);
+        if (held > s->peak_nodes) __atomic_store_n(&s->peak_nodes, held, __ATOMIC_RELAXED);
+
+        __atomic_store_n(&s->allocations, __atomic_load_n(&s->allocations, __ATOMIC_RELAXED) + count, __ATOMIC_RELAXED);
+}
+
+
+/*
+ * Function: mem_stats_read
+ * ----------------------------
+ * Copies statistics that other threads may be updating.
+ *
+ * @param s - The statistics.
+ * @param out - Output copy.
+ */
+void mem_stats_read(const mem_stats* s, mem_stats* out);
+
+
+/*
+ * Function: instrument_cycles
+ * ----------------------------
+ * Reads the cycle counter used by the timers.
+ *
+ * @return The time stamp counter, or monotonic nanoseconds where there is none.
+ */
+static inline uint64_t instrument_cycles(void) {
+#if defined(__x86_64__) || defined(__i386__)
+        return __builtin_ia32_rdtsc();
+#else
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+
+/*
+ * Function: op_timer_record
+ * ----------------------------
+ * Adds one call to a timer.
+ *
+ * @param t - The timer.
+ * @param cycles - Duration of the call.
+ */
+static inline void op_timer_record(op_timer* t, uint64_t cycles) {
+        __atomic_add_fetch(&t->count, 1, __ATOMIC_RELAXED);
+        __atomic_add_fetch(&t->cycles, cycles, __ATOMIC_RELAXED);
+}
+
+
+#ifdef INSTRUMENT_TIMERS
+
+typedef struct op_timer_scope {
+        op_timer* timer;
+        uint64_t start;
+} op_timer_scope;
+
+
+static inline void op_timer_leave(op_timer_scope* scope) {
+        op_timer_record(scope->timer, instrument_cycles() - scope->start);
+}
+
+
+// Times the rest of the enclosing block, whichever way it is left
+#define OP_TIMED(timer) \
+        op_timer_scope op_timer_scope_ __attribute__((cleanup(op_timer_leave))) = { &(timer), instrument_cycles() }
+
+#else
+
+#define OP_TIMED(timer) ((void)0)
+
+#endif
+
+
+/*
+ * Function: instrument_json
+ * ----------------------------
+ * Writes the instrumentation of a library as a JSON object.
+ *
+ * @param out - Destination stream.
+ * @param library - Name of the library.
+ * @param totals - Library-wide memory statistics.
+ * @param objects - Per-object memory statistics, or NULL.
+ * @param object_count - Number of entries in objects.
+ * @param timers - The library's timers.
+ * @param timer_count - Number of entries in timers.
+ *
+ * @return true if the object was written, false on a stream error.
+ *
+ * Description:
+ *   The object has the members "library", "totals", "objects" (an array) and "timers", which
+ *   holds "enabled" (whether the build has INSTRUMENT_TIMERS), "unit" and "operations" with
+ *   the name, count, total and mean time of each operation.
+ */
+bool instrument_json(FILE* out, const char* library, const mem_stats* totals, const mem_stats* objects,
+                     uint32_t object_count, const op_timer* timers, uint32_t timer_count);
+
+
+#endif // INSTRUMENT_H
@@ -0,0 +1,108 @@
+/*
+ * File Name: instrument.c
+ * Authors: Arpit Patel, Dharm KaPatel
+ * Date: 2025-03-19
+ * Description: This file implements the instrumentation shared by the sparse matrix and the
+ *              priority queue libraries. The counters themselves are updated inline; this file
+ *              reads them back and writes them out as JSON.
+ */
+
+
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <inttypes.h>
+
+
+#include "../include/instrument.h"
+
+
+/*
+ * Function: mem_stats_read
+ * ----------------------------
+ * Copies statistics that other threads may be updating.
+ *
+ * @param s - The statistics.
+ * @param out - Output copy.
+ */
+void mem_stats_read(const mem_stats* s, mem_stats* out) {
+        out->bytes = __atomic_load_n(&s->bytes, __ATOMIC_RELAXED);
+        out->peak_bytes = __atomic_load_n(&s->peak_bytes, __ATOMIC_RELAXED);
+        out->nodes = __atomic_load_n(&s->nodes, __ATOMIC_RELAXED);
+        out->peak_nodes = __atomic_load_n(&s->peak_nodes, __ATOMIC_RELAXED);
+        out->allocations = __atomic_load_n(&s->allocations, __ATOMIC_RELAXED);
+        out->frees = __atomic_load_n(&s->frees, __ATOMIC_RELAXED);
+}
+
+
+/*
+ * Function: stats_json
+ * ----------------------------
+ * Writes one set of memory statistics as a single-line JSON object.
+ *
+ * @param out - Destination stream.
+ * @param s - The statistics; read through mem_stats_read, so they may be in use.
+ */
+static void stats_json(FILE* out, const mem_stats* s) {
+        mem_stats v;
+        mem_stats_read(s, &v);
+
+        fprintf(out, "{\"bytes\": %" PRIu64 ", \"peak_bytes\": %" PRIu64 ", \"nodes\": %" PRIu64
+                     ", \"peak_nodes\": %" PRIu64 ", \"allocations\": %" PRIu64 ", \"frees\": %" PRIu64 "}",
+                v.bytes, v.peak_bytes, v.nodes, v.peak_nodes, v.allocations, v.frees);
+}
+
+
+/*
+ * Function: instrument_json
+ * ----------------------------
+ * Writes the instrumentation of a library as a JSON object.
+ *
+ * @param out - Destination stream.
+ * @param library - Name of the library.
+ * @param totals - Library-wide memory statistics.
+ * @param objects - Per-object memory statistics, or NULL.
+ * @param object_count - Number of entries in objects.
+ * @param timers - The library's timers.
+ * @param timer_count - Number of entries in timers.
+ *
+ * @return true if the object was written, false on a stream error.
+ */
+bool instrument_json(FILE* out, const char* library, const mem_stats* totals, const mem_stats* objects,
+                     uint32_t object_count, const op_timer* timers, uint32_t timer_count) {
+        if (!out) return false;
+
+        // Names are library constants, so they need no escaping
+        fprintf(out, "{\n  \"library\": \"%s\",\n  \"totals\": ", library);
+        stats_json(out, totals);
+
+        fprintf(out, ",\n  \"objects\": [");
+        for (uint32_t i = 0; objects && i < object_count; i++) {
+                fprintf(out, "%s\n    ", i ? "," : "");
+                stats_json(out, &objects[i]);
+        }
+        fprintf(out, "%s],\n", (objects && object_count) ? "\n  " : "");
+
+#ifdef INSTRUMENT_TIMERS
+        const char* enabled = "true";
+#else
+        const char* enabled = "false";
+#endif
+#if defined(__x86_64__) || defined(__i386__)
+        const char* unit = "cycles";
+#else
+        const char* unit = "ns";
+#endif
+        fprintf(out, "  \"timers\": {\"enabled\": %s, \"unit\": \"%s\", \"operations\": [", enabled, unit);
+        for (uint32_t i = 0; i < timer_count; i++) {
+                uint64_t count = __atomic_load_n(&timers[i].count, __ATOMIC_RELAXED);
+                uint64_t cycles = __atomic_load_n(&timers[i].cycles, __ATOMIC_RELAXED);
+
+                fprintf(out, "%s\n    {\"name\": \"%s\", \"count\": %" PRIu64 ", \"total\": %" PRIu64 ", \"mean\": %.1f}",
+                        i ? "," : "", timers[i].name, count, cycles, count ? (double)cycles / count : 0.0);
+        }
+        fprintf(out, "%s]}\n}\n", timer_count ? "\n  " : "");
+
+        return !ferror(out);
+}
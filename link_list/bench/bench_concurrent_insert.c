@@ -0,0 +1,207 @@
+/*
+ * File Name: bench_concurrent_insert.c
+ * Authors: Arpit Patel, Dharm KaPatel
+ * Date: 2025-03-19
+ * Description: Scaling benchmark for insert_data_concurrent. Inserts the same number of
+ *              random elements with 1 to N threads and reports the throughput of each run.
+ *              After each run the matrix is checked against a serial build of the same
+ *              inserts; every value is derived from its position, so the result does not
+ *              depend on which thread wrote a position last.
+ *
+ * Usage: bench_concurrent_insert [max_threads] [inserts] [dimension]
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "../source/include/S_Matrix.h"
+#include "../source/include/S_Matrix_concurrent.h"
+#include "../source/include/S_Matrix_fingerprint.h"
+
+/*
+ * Struct: bench_worker
+ * ----------------------------
+ * Work assigned to one inserting thread.
+ *
+ * CM: Matrix being filled.
+ * seed: Seed of the thread's random sequence.
+ * count: Number of inserts to perform.
+ * dimension: Rows and columns of the matrix.
+ */
+typedef struct bench_worker {
+        c_matrix* CM;
+        uint64_t seed;
+        uint64_t count;
+        uint32_t dimension;
+} bench_worker;
+
+/*
+ * Function: next_random
+ * ----------------------------
+ * xorshift64 step.
+ *
+ * @param state - Pointer to the generator state.
+ *
+ * @return Next pseudo random number.
+ */
+static uint64_t next_random(uint64_t* state) {
+        uint64_t x = *state;
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        *state = x;
+        return x;
+}
+
+/*
+ * Function: next_insert
+ * ----------------------------
+ * Draws the position of the next insert of a worker.
+ *
+ * @param state - Pointer to the worker's generator state.
+ * @param dimension - Rows and columns of the matrix.
+ * @param row - Output, row index.
+ * @param col - Output, column index.
+ *
+ * @return Value to store, a function of the position.
+ */
+static double next_insert(uint64_t* state, uint32_t dimension, uint32_t* row, uint32_t* col) {
+        uint64_t r = next_random(state);
+        *row = (uint32_t)(r % dimension) + 1;
+        *col = (uint32_t)((r >> 32) % dimension) + 1;
+
+        return (double)(((uint64_t)*row * 31 + *col) % 1000 + 1);
+}
+
+/*
+ * Function: insert_worker
+ * ----------------------------
+ * Thread body; performs the worker's inserts through the concurrent wrapper.
+ *
+ * @param arg - Pointer to the bench_worker.
+ *
+ * @return NULL.
+ */
+static void* insert_worker(void* arg) {
+        bench_worker* w = (bench_worker*)arg;
+        uint64_t state = w->seed;
+
+        for (uint64_t i = 0; i < w->count; i++) {
+                uint32_t row, col;
+                double value = next_insert(&state, w->dimension, &row, &col);
+                insert_data_concurrent(w->CM, row, col, value);
+        }
+
+        return NULL;
+}
+
+/*
+ * Function: matches_serial
+ * ----------------------------
+ * Replays the inserts of every worker on one thread and compares the result.
+ *
+ * @param M - The matrix filled by the timed run.
+ * @param workers - The workers of the run.
+ * @param threads - Number of workers.
+ *
+ * @return true if both matrices hold the same number of nodes and the same values.
+ */
+static bool matches_serial(matrix* M, bench_worker* workers, uint32_t threads) {
+        matrix* S = create_S_Matrix(M->row, M->col);
+        if (!S) return false;
+
+        for (uint32_t t = 0; t < threads; t++) {
+                uint64_t state = workers[t].seed;
+                for (uint64_t i = 0; i < workers[t].count; i++) {
+                        uint32_t row, col;
+                        double value = next_insert(&state, workers[t].dimension, &row, &col);
+                        insert_data(S, row, col, value);
+                }
+        }
+
+        mem_stats a, b;
+        sm_memory(M, &a);
+        sm_memory(S, &b);
+        bool same = a.nodes == b.nodes && matrix_equal(M, S, 0);
+
+        free_S_Matrix(S);
+        return same;
+}
+
+/*
+ * Function: now_seconds
+ * ----------------------------
+ * Reads the monotonic clock.
+ *
+ * @return Current time in seconds.
+ */
+static double now_seconds() {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/*
+ * Function: main
+ * ----------------------------
+ * Runs the benchmark with 1 to max_threads threads and prints one line per run.
+ *
+ * @param argc - Number of arguments.
+ * @param argv - Optional max_threads, inserts and dimension.
+ *
+ * @return 0 on success, 1 if allocation fails or a run differs from the serial build.
+ */
+int main(int argc, char** argv) {
+        uint32_t max_threads = (argc > 1) ? (uint32_t)atoi(argv[1]) : 8;
+        uint64_t inserts = (argc > 2) ? (uint64_t)atoll(argv[2]) : 1000000;
+        uint32_t dimension = (argc > 3) ? (uint32_t)atoi(argv[3]) : 16384;
+
+        if (max_threads < 1) max_threads = 1;
+
+        printf("%8s %12s %14s %8s %8s\n", "threads", "seconds", "inserts/s", "speedup", "check");
+
+        double base = 0;
+        for (uint32_t threads = 1; threads <= max_threads; threads++) {
+                matrix* M = create_S_Matrix(dimension, dimension);
+                c_matrix* CM = create_concurrent_S_Matrix(M);
+                if (!CM) {
+                        printf("Memory allocation failed!\n");
+                        free_S_Matrix(M);
+                        return 1;
+                }
+
+                pthread_t* tids = (pthread_t*)malloc(threads * sizeof(pthread_t));
+                bench_worker* workers = (bench_worker*)malloc(threads * sizeof(bench_worker));
+
+                double start = now_seconds();
+                for (uint32_t t = 0; t < threads; t++) {
+                        workers[t].CM = CM;
+                        workers[t].seed = 0x9E3779B97F4A7C15ULL * (t + 1);
+                        workers[t].count = inserts / threads + (t < inserts % threads);
+                        workers[t].dimension = dimension;
+                        pthread_create(&tids[t], NULL, insert_worker, &workers[t]);
+                }
+                for (uint32_t t = 0; t < threads; t++) {
+                        pthread_join(tids[t], NULL);
+                }
+                double elapsed = now_seconds() - start;
+
+                M = release_concurrent_S_Matrix(CM);
+                bool ok = matches_serial(M, workers, threads);
+
+                if (threads == 1) base = elapsed;
+                printf("%8u %12.3f %14.0f %8.2f %8s\n", threads, elapsed, inserts / elapsed, base / elapsed, ok ? "ok" : "FAILED");
+
+                free(tids);
+                free(workers);
+                free_S_Matrix(M);
+
+                if (!ok) return 1;
+        }
+
+        return 0;
+}
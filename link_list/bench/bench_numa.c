@@ -0,0 +1,211 @@
+/*
+ * File Name: bench_numa.c
+ * Authors: Arpit Patel, Dharm KaPatel
+ * Date: 2025-03-19
+ * Description: Local versus remote memory benchmark for the NUMA-partitioned matrix. First
+ *              measures the read bandwidth of a buffer placed on each node from threads pinned
+ *              to each node, then times nm_spmv with every block run on its own node and with
+ *              the blocks shifted one node over, which keeps the data but makes every access
+ *              remote. On a single-node host both numbers describe local memory.
+ *
+ * Usage: bench_numa [buffer_mib] [rows] [nnz_per_row]
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/mman.h>
+
+#include "../source/include/S_Matrix.h"
+#include "../source/include/S_Matrix_csr.h"
+#include "../source/include/S_Matrix_numa.h"
+
+#define BENCH_PASSES 5
+#define BENCH_SPMV_RUNS 10
+
+// Read results are stored here so the loops are not optimized away
+static volatile uint64_t sink;
+
+/*
+ * Struct: bandwidth_job
+ * ----------------------------
+ * One step of the bandwidth test, run on a thread pinned to a node.
+ *
+ * node: Node the thread runs on.
+ * buffer: Buffer being written (first touch) or read.
+ * words: Number of 64-bit words in the buffer.
+ * touch: Whether to write the buffer instead of reading it.
+ * seconds: Time of the fastest read pass.
+ * sum: Sum of the words.
+ */
+typedef struct bandwidth_job {
+        uint32_t node;
+        uint64_t* buffer;
+        uint64_t words;
+        int touch;
+        double seconds;
+        uint64_t sum;
+} bandwidth_job;
+
+static double now_seconds() {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void* bandwidth_worker(void* arg) {
+        bandwidth_job* job = (bandwidth_job*)arg;
+        numa_pin_thread(job->node);
+
+        if (job->touch) {
+                for (uint64_t i = 0; i < job->words; i++) job->buffer[i] = i;
+                return NULL;
+        }
+
+        job->seconds = 1e30;
+        for (int pass = 0; pass < BENCH_PASSES; pass++) {
+                double start = now_seconds();
+                uint64_t sum = 0;
+                for (uint64_t i = 0; i < job->words; i++) sum += job->buffer[i];
+                double elapsed = now_seconds() - start;
+
+                job->sum += sum;
+                if (elapsed < job->seconds) job->seconds = elapsed;
+        }
+
+        return NULL;
+}
+
+static void run_on_node(bandwidth_job* job) {
+        pthread_t tid;
+        if (pthread_create(&tid, NULL, bandwidth_worker, job) == 0) {
+                pthread_join(tid, NULL);
+        } else {
+                bandwidth_worker(job);
+        }
+}
+
+/*
+ * Function: next_random
+ * ----------------------------
+ * xorshift64 step.
+ *
+ * @param state - Pointer to the generator state.
+ *
+ * @return Next pseudo random number.
+ */
+static uint64_t next_random(uint64_t* state) {
+        uint64_t x = *state;
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        *state = x;
+        return x;
+}
+
+static double time_spmv(n_matrix* N, const double* x, double* y) {
+        double best = 1e30;
+        for (int run = 0; run < BENCH_SPMV_RUNS; run++) {
+                double start = now_seconds();
+                nm_spmv(N, x, y);
+                double elapsed = now_seconds() - start;
+                if (elapsed < best) best = elapsed;
+        }
+        return best;
+}
+
+int main(int argc, char** argv) {
+        uint64_t mib = (argc > 1) ? (uint64_t)atoll(argv[1]) : 256;
+        uint32_t rows = (argc > 2) ? (uint32_t)atoi(argv[2]) : 1000000;
+        uint32_t per_row = (argc > 3) ? (uint32_t)atoi(argv[3]) : 16;
+
+        uint32_t nodes = numa_node_count();
+        printf("%u NUMA node(s)\n", nodes);
+        for (uint32_t n = 0; n < nodes; n++) printf("  node %u: %u CPUs\n", n, numa_node_cpus(n));
+
+        // Read bandwidth of a buffer placed on each node, from each node
+        uint64_t words = mib * 1024 * 1024 / sizeof(uint64_t);
+        printf("\nread bandwidth (GB/s), %llu MiB buffer, one thread\n%10s", (unsigned long long)mib, "data\\cpu");
+        for (uint32_t n = 0; n < nodes; n++) printf(" %9u", n);
+        printf("\n");
+
+        for (uint32_t home = 0; home < nodes; home++) {
+                uint64_t* buffer = (uint64_t*)mmap(NULL, words * sizeof(uint64_t), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (buffer == MAP_FAILED) {
+                        printf("Memory allocation failed!\n");
+                        return 1;
+                }
+
+                bandwidth_job touch = { home, buffer, words, 1, 0, 0 };
+                run_on_node(&touch);
+
+                printf("%10u", home);
+                for (uint32_t runner = 0; runner < nodes; runner++) {
+                        bandwidth_job read = { runner, buffer, words, 0, 0, 0 };
+                        run_on_node(&read);
+                        sink += read.sum;
+                        printf(" %9.2f", words * sizeof(uint64_t) / read.seconds * 1e-9);
+                }
+                printf("\n");
+
+                munmap(buffer, words * sizeof(uint64_t));
+        }
+
+        // SpMV with every block on its own node, then shifted one node over
+        uint64_t count = (uint64_t)rows * per_row;
+        sm_triplet* entries = (sm_triplet*)malloc(count * sizeof(sm_triplet));
+        double* x = (double*)malloc(rows * sizeof(double));
+        double* y = (double*)malloc(rows * sizeof(double));
+        if (!entries || !x || !y) {
+                printf("Memory allocation failed!\n");
+                return 1;
+        }
+
+        uint64_t state = 0x9E3779B97F4A7C15ULL;
+        for (uint64_t i = 0; i < count; i++) {
+                uint64_t r = next_random(&state);
+                entries[i].row = (uint32_t)(i / per_row) + 1;
+                entries[i].column = (uint32_t)(r % rows) + 1;
+                entries[i].value = (double)((r >> 40) % 100 + 1);
+        }
+        for (uint32_t i = 0; i < rows; i++) x[i] = 1.0 / (i + 1);
+
+        csr_matrix* A = csr_from_triplets(rows, rows, entries, count);
+        free(entries);
+        n_matrix* N = A ? numa_from_csr(A, 0, 0, SM_NUMA_BIND) : NULL;
+        if (!N) {
+                printf("Memory allocation failed!\n");
+                return 1;
+        }
+
+        // Bytes streamed per product: values, column indices, row offsets and y
+        double bytes = (double)N->nnz * (sizeof(double) + sizeof(uint32_t)) + (double)rows * (sizeof(uint64_t) + sizeof(double));
+
+        printf("\nnm_spmv, %u rows, %llu non-zeros, %u block(s), bound %s\n", rows, (unsigned long long)N->nnz,
+               N->partition_count, N->partitions[0].bound ? "yes" : "no (first touch)");
+        printf("%10s %12s %12s %10s\n", "placement", "seconds", "GB/s", "GFLOP/s");
+
+        double local = time_spmv(N, x, y);
+        sink += (uint64_t)y[0];
+        printf("%10s %12.6f %12.2f %10.2f\n", "local", local, bytes / local * 1e-9, 2.0 * N->nnz / local * 1e-9);
+
+        for (uint32_t p = 0; p < N->partition_count; p++) {
+                N->partitions[p].node = (N->partitions[p].home + 1) % nodes;
+        }
+        double remote = time_spmv(N, x, y);
+        sink += (uint64_t)y[0];
+        printf("%10s %12.6f %12.2f %10.2f\n", "remote", remote, bytes / remote * 1e-9, 2.0 * N->nnz / remote * 1e-9);
+        printf("remote / local time: %.2f\n", remote / local);
+
+        free_numa_matrix(N);
+        free_csr_matrix(A);
+        free(x);
+        free(y);
+
+        return 0;
+}
@@ -0,0 +1,436 @@
+/*
+ * File Name: batch_mode.c
+ * Authors: Arpit Patel, Dharm KaPatel
+ * Date: 2025-03-19
+ * Description: This file provides the non-interactive interface of the S_Matrix structure.
+ *              Commands are read one per line from a file or stdin through a fixed buffer and
+ *              tokenized in place, so replaying a command stream allocates nothing beyond the
+ *              matrix itself. Nothing is drawn; output is produced only by the query commands.
+ *
+ * Commands (blank lines and lines starting with '#' are ignored):
+ *   create <rows> <columns>     Create a matrix, replacing the current one
+ *   symmetric <n>               Create a symmetric n x n matrix, replacing the current one
+ *   insert <row> <column> <v>   Insert or update a value
+ *   dup <v>                     Print whether a value is present
+ *   get <row> <column>          Print the value at a position
+ *   resize [<rows> <columns>]   Double the dimensions, or set them
+ *   transpose                   Transpose the matrix
+ *   load <path>                 Replace the matrix with a Matrix Market coordinate file
+ *   save <path>                 Write the matrix as a Matrix Market coordinate file
+ *   display                     Print the matrix
+ *   stats                       Print the memory statistics and timers as JSON
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <strings.h>
+#include <errno.h>
+
+#include "../include/S_Matrix.h"
+
+
+// Size of the read buffer; also the longest accepted line
+#define BATCH_BUFFER (1 << 16)
+
+// Most tokens a line can have; the Matrix Market banner has five
+#define BATCH_MAX_TOKENS 5
+
+
+/*
+ * Struct: line_reader
+ * ----------------------------
+ * Buffered line reader over a stream.
+ *
+ * in: The stream.
+ * buffer: Read buffer, one byte longer than BATCH_BUFFER for the terminating NUL.
+ * begin: Offset of the first unread byte.
+ * end: Offset one past the last buffered byte.
+ * line: Number of the line most recently returned (1-based).
+ * eof: Whether the stream has been read to the end.
+ */
+typedef struct line_reader {
+        FILE* in;
+        char buffer[BATCH_BUFFER + 1];
+        size_t begin;
+        size_t end;
+        uint64_t line;
+        bool eof;
+} line_reader;
+
+
+static void init_reader(line_reader* R, FILE* in) {
+        R->in = in;
+        R->begin = 0;
+        R->end = 0;
+        R->line = 0;
+        R->eof = false;
+}
+
+
+/*
+ * Function: next_line
+ * ----------------------------
+ * Returns the next line, NUL-terminated in place inside the buffer.
+ *
+ * @param R - Pointer to the reader.
+ * @param line - Output pointer to the line; valid until the next call.
+ *
+ * @return 1 if a line was read, 0 at the end of the stream, -1 if a line exceeds BATCH_BUFFER.
+ */
+static int next_line(line_reader* R, char** line) {
+        for (;;) {
+                char* start = R->buffer + R->begin;
+                char* newline = memchr(start, '\n', R->end - R->begin);
+
+                if (newline || (R->eof && R->end > R->begin)) {
+                        char* stop = newline ? newline : R->buffer + R->end;
+                        *stop = '\0';
+                        R->begin = (size_t)(stop - R->buffer) + (newline ? 1 : 0);
+                        R->line++;
+                        *line = start;
+                        return 1;
+                }
+                if (R->eof) return 0;
+
+                // Move the partial line to the front and refill behind it
+                size_t partial = R->end - R->begin;
+                if (partial == BATCH_BUFFER) return -1;
+
+                memmove(R->buffer, start, partial);
+                R->begin = 0;
+                R->end = partial;
+
+                size_t got = fread(R->buffer + R->end, 1, BATCH_BUFFER - R->end, R->in);
+                R->end += got;
+                if (got == 0) R->eof = true;
+        }
+}
+
+
+/*
+ * Function: split
+ * ----------------------------
+ * Splits a line into whitespace-separated tokens in place.
+ *
+ * @param line - The line; separators are overwritten with NUL.
+ * @param tokens - Output array of BATCH_MAX_TOKENS token pointers.
+ *
+ * @return Number of tokens, or BATCH_MAX_TOKENS + 1 if there are more.
+ */
+static int split(char* line, char** tokens) {
+        int count = 0;
+
+        for (char* p = line; *p;) {
+                while (*p == ' ' || *p == '\t' || *p == '\r') p++;
+                if (!*p) break;
+
+                if (count == BATCH_MAX_TOKENS) return BATCH_MAX_TOKENS + 1;
+                tokens[count++] = p;
+
+                while (*p && *p != ' ' && *p != '\t' && *p != '\r') p++;
+                if (*p) *p++ = '\0';
+        }
+
+        return count;
+}
+
+
+static bool parse_index(const char* token, uint32_t* value) {
+        char* end;
+        errno = 0;
+        unsigned long long v = strtoull(token, &end, 10);
+        if (errno || *end || end == token || token[0] == '-' || v > UINT32_MAX) return false;
+
+        *value = (uint32_t)v;
+        return true;
+}
+
+
+static bool parse_value(const char* token, double* value) {
+        char* end;
+        errno = 0;
+        *value = strtod(token, &end);
+        return !errno && !*end && end != token;
+}
+
+
+static void report(uint64_t line, const char* message) {
+        fprintf(stderr, "line %llu: %s\n", (unsigned long long)line, message);
+}
+
+
+/*
+ * Function: load_matrix
+ * ----------------------------
+ * Reads a Matrix Market coordinate file (real or integer, general or symmetric).
+ *
+ * @param path - Path of the file.
+ * @param reader - Reader whose buffer is reused for the file.
+ * @param error - Output description of the failure.
+ *
+ * @return Pointer to the matrix, or NULL on failure.
+ *
+ * Description:
+ *   The banner is split into its fields and each is matched exactly, ignoring case as the
+ *   format allows. Skew-symmetric, hermitian, complex and pattern files are rejected.
+ */
+static matrix* load_matrix(const char* path, line_reader* reader, const char** error) {
+        FILE* in = fopen(path, "r");
+        if (!in) {
+                *error = "can not open file";
+                return NULL;
+        }
+
+        init_reader(reader, in);
+
+        char* line;
+        char* tokens[BATCH_MAX_TOKENS];
+        matrix* M = NULL;
+        bool symmetric = false;
+        bool sized = false;
+        int status;
+
+        *error = NULL;
+        while ((status = next_line(reader, &line)) == 1) {
+                if (reader->line == 1) {
+                        // %%MatrixMarket <object> <format> <field> <symmetry>
+                        if (split(line, tokens) != 5 || strcmp(tokens[0], "%%MatrixMarket") != 0 ||
+                            strcasecmp(tokens[1], "matrix") != 0 || strcasecmp(tokens[2], "coordinate") != 0) {
+                                *error = "not a Matrix Market coordinate file";
+                                break;
+                        }
+                        if (strcasecmp(tokens[3], "real") != 0 && strcasecmp(tokens[3], "integer") != 0) {
+                                *error = "only real and integer values are supported";
+                                break;
+                        }
+                        if (strcasecmp(tokens[4], "symmetric") == 0) {
+                                symmetric = true;
+                        } else if (strcasecmp(tokens[4], "general") != 0) {
+                                *error = "only general and symmetric matrices are supported";
+                                break;
+                        }
+                        continue;
+                }
+                if (line[0] == '%') continue;
+
+                int count = split(line, tokens);
+                if (count == 0) continue;
+
+                if (!sized) {
+                        uint32_t rows, cols, nnz;
+                        if (count != 3 || !parse_index(tokens[0], &rows) || !parse_index(tokens[1], &cols) || !parse_index(tokens[2], &nnz)) {
+                                *error = "bad size line";
+                                break;
+                        }
+                        M = symmetric ? create_symmetric_S_Matrix(rows) : create_S_Matrix(rows, cols);
+                        if (!M || (symmetric && rows != cols)) {
+                                *error = M ? "symmetric matrix must be square" : sm_status_message(SM_ERR_NO_MEMORY);
+                                break;
+                        }
+                        sized = true;
+                        continue;
+                }
+
+                uint32_t row, col;
+                double value;
+                if (count != 3 || !parse_index(tokens[0], &row) || !parse_index(tokens[1], &col) || !parse_value(tokens[2], &value)) {
+                        *error = "bad entry line";
+                        break;
+                }
+
+                sm_status result = insert_data(M, row, col, value);
+                if (result != SM_OK && result != SM_ERR_ZERO_VALUE) {
+                        *error = sm_status_message(result);
+                        break;
+                }
+        }
+
+        if (!*error && status < 0) *error = "line too long";
+        if (!*error && !sized) *error = "missing size line";
+
+        fclose(in);
+
+        if (*error) {
+                free_S_Matrix(M);
+                return NULL;
+        }
+        return M;
+}
+
+
+/*
+ * Function: save_matrix
+ * ----------------------------
+ * Writes a matrix as a Matrix Market coordinate file.
+ *
+ * @param M - Pointer to the matrix.
+ * @param path - Path of the file.
+ *
+ * @return true on success, false if the file can not be written.
+ *
+ * Description:
+ *   A symmetric matrix is written with the "symmetric" qualifier and its stored upper triangle
+ *   mirrored into the lower one, as the format expects.
+ */
+static bool save_matrix(matrix* M, const char* path) {
+        FILE* out = fopen(path, "w");
+        if (!out) return false;
+
+        static char out_buffer[BATCH_BUFFER];
+        setvbuf(out, out_buffer, _IOFBF, sizeof(out_buffer));
+
+        uint64_t nnz = 0;
+        uint32_t index = 0;
+        for (l_node* temp; (temp = next_header(M->rowList, &index));) {
+                for (m_node* node = temp->matrix_node; node; node = node->row_ptr) nnz++;
+        }
+
+        fprintf(out, "%%%%MatrixMarket matrix coordinate real %s\n", M->symmetric ? "symmetric" : "general");
+        fprintf(out, "%u %u %llu\n", M->row, M->col, (unsigned long long)nnz);
+
+        index = 0;
+        for (l_node* temp; (temp = next_header(M->rowList, &index));) {
+                for (m_node* node = temp->matrix_node; node; node = node->row_ptr) {
+                        if (M->symmetric) {
+                                fprintf(out, "%u %u %.17g\n", node->column, node->row, node->value);
+                        } else {
+                                fprintf(out, "%u %u %.17g\n", node->row, node->column, node->value);
+                        }
+                }
+        }
+
+        bool ok = !ferror(out);
+        return (fclose(out) == 0) && ok;
+}
+
+
+/*
+ * Function: _sparse_matrix_batch
+ * ----------------------------
+ * Runs a stream of commands against one matrix without any prompts or redraws.
+ *
+ * @param in - The command stream.
+ *
+ * @return Number of commands that failed.
+ *
+ * Description:
+ *   Failures are reported on stderr with their line number and do not stop the stream.
+ *   Query results go to stdout, which main makes fully buffered before anything is written.
+ */
+int _sparse_matrix_batch(FILE* in) {
+        static line_reader commands;
+        static line_reader file_reader;
+
+        init_reader(&commands, in);
+
+        matrix* M = NULL;
+        int failures = 0;
+        char* line;
+        char* tokens[BATCH_MAX_TOKENS + 1];
+        int status;
+
+        while ((status = next_line(&commands, &line)) != 0) {
+                if (status < 0) {
+                        report(commands.line + 1, "line too long");
+                        failures++;
+                        break;
+                }
+
+                int count = split(line, tokens);
+                if (count == 0 || tokens[0][0] == '#') continue;
+
+                const char* command = tokens[0];
+                const char* error = NULL;
+                uint32_t row, col;
+                double value;
+
+                if (strcmp(command, "create") == 0 || strcmp(command, "symmetric") == 0) {
+                        bool symmetric = command[0] == 's';
+                        if (count != (symmetric ? 2 : 3) || !parse_index(tokens[1], &row) || (!symmetric && !parse_index(tokens[2], &col))) {
+                                error = symmetric ? "usage: symmetric <n>" : "usage: create <rows> <columns>";
+                        } else {
+                                free_S_Matrix(M);
+                                M = symmetric ? create_symmetric_S_Matrix(row) : create_S_Matrix(row, col);
+                                if (!M) error = sm_status_message(SM_ERR_NO_MEMORY);
+                        }
+                } else if (strcmp(command, "insert") == 0) {
+                        if (count != 4 || !parse_index(tokens[1], &row) || !parse_index(tokens[2], &col) || !parse_value(tokens[3], &value)) {
+                                error = "usage: insert <row> <column> <value>";
+                        } else {
+                                sm_status result = insert_data(M, row, col, value);
+                                if (result != SM_OK) error = sm_status_message(result);
+                        }
+                } else if (strcmp(command, "dup") == 0) {
+                        bool found = false;
+                        if (count != 2 || !parse_value(tokens[1], &value)) {
+                                error = "usage: dup <value>";
+                        } else {
+                                sm_status result = duplicatevalue(M, value, &found);
+                                if (result != SM_OK) error = sm_status_message(result);
+                                else printf("%s\n", found ? "present" : "absent");
+                        }
+                } else if (strcmp(command, "get") == 0) {
+                        if (count != 3 || !parse_index(tokens[1], &row) || !parse_index(tokens[2], &col)) {
+                                error = "usage: get <row> <column>";
+                        } else if (!M) {
+                                error = sm_status_message(SM_ERR_NOT_CREATED);
+                        } else if (row < 1 || row > M->row || col < 1 || col > M->col) {
+                                error = sm_status_message(SM_ERR_OUT_OF_BOUNDS);
+                        } else {
+                                printf("%.17g\n", get_data(M, row, col));
+                        }
+                } else if (strcmp(command, "resize") == 0 && count == 3) {
+                        uint32_t rows, columns;
+                        if (!parse_index(tokens[1], &rows) || !parse_index(tokens[2], &columns)) {
+                                error = "usage: resize [<rows> <columns>]";
+                        } else {
+                                sm_status result = resize_to(M, rows, columns);
+                                if (result != SM_OK) error = sm_status_message(result);
+                        }
+                } else if (strcmp(command, "resize") == 0 || strcmp(command, "transpose") == 0) {
+                        if (count != 1) {
+                                error = "command takes no arguments";
+                        } else {
+                                sm_status result = (command[0] == 'r') ? resize(M) : transpose(M);
+                                if (result != SM_OK) error = sm_status_message(result);
+                        }
+                } else if (strcmp(command, "load") == 0) {
+                        if (count != 2) {
+                                error = "usage: load <path>";
+                        } else {
+                                matrix* loaded = load_matrix(tokens[1], &file_reader, &error);
+                                if (loaded) {
+                                        free_S_Matrix(M);
+                                        M = loaded;
+                                }
+                        }
+                } else if (strcmp(command, "save") == 0) {
+                        if (count != 2) {
+                                error = "usage: save <path>";
+                        } else if (!M) {
+                                error = sm_status_message(SM_ERR_NOT_CREATED);
+                        } else if (!save_matrix(M, tokens[1])) {
+                                error = "can not write file";
+                        }
+                } else if (strcmp(command, "display") == 0) {
+                        displayMatrix(M);
+                } else if (strcmp(command, "stats") == 0) {
+                        if (!sm_memory_json(stdout, M)) error = "could not write the statistics";
+                } else {
+                        error = "unknown command";
+                }
+
+                if (error) {
+                        report(commands.line, error);
+                        failures++;
+                }
+        }
+
+        free_S_Matrix(M);
+        fflush(stdout);
+
+        return failures;
+}
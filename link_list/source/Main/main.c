@@ -3,17 +3,47 @@
  * Authors: Arpit Patel, Dharm KaPatel
  * Date: 2025-03-19
  * Description: Entry point for the sparse matrix program that provides a continuous
- *              execution loop until the user chooses to exit.
+ *              execution loop until the user chooses to exit. With -b it instead runs
+ *              a command stream from a file (or stdin when the file is omitted or "-").
  */
 
+#include <stdio.h>
 #include <stdbool.h>
+#include <string.h>
 
 #include "../include/S_Matrix.h"
 
 extern _Bool _continue();
 extern void _sparse_matrix();
-
-int main(){
+extern int _sparse_matrix_batch(FILE* in);
+
+int main(int argc, char* argv[]){
+
+	if (argc > 1) {
+		if (strcmp(argv[1], "-b") != 0 || argc > 3) {
+			fprintf(stderr, "usage: %s [-b [file]]\n", argv[0]);
+			return 2;
+		}
+
+		// Query results are flushed in large blocks, even to a terminal; this must
+		// happen before anything is written to stdout
+		static char out_buffer[1 << 16];
+		setvbuf(stdout, out_buffer, _IOFBF, sizeof(out_buffer));
+
+		FILE* in = stdin;
+		if (argc == 3 && strcmp(argv[2], "-") != 0) {
+			in = fopen(argv[2], "r");
+			if (!in) {
+				perror(argv[2]);
+				return 2;
+			}
+		}
+
+		int failures = _sparse_matrix_batch(in);
+		if (in != stdin) fclose(in);
+
+		return failures ? 1 : 0;
+	}
 
 	while(1){
 
@@ -131,7 +131,10 @@ void _sparse_matrix() {
                                                         } while (getchar() != '\n');
                                                 }
                                         }
-                                        insert_data(M, row, col, value);
+                                        sm_status status = insert_data(M, row, col, value);
+                                        if (status != SM_OK) {
+                                                printf("%s\n", sm_status_message(status));
+                                        }
                                         printf("\n\n");
                                 }
                                 break;
@@ -151,17 +154,22 @@ void _sparse_matrix() {
                                                         } while (getchar() != '\n');
                                                 }
                                         }
-                                        (duplicatevalue(M, value)) ? printf("Value %.1lf present in Sparse Matrix\n\n", value) : printf("Value %.1lf not present in Sparse Matrix\n\n", value);
+                                        bool found = false;
+                                        sm_status status = duplicatevalue(M, value, &found);
+                                        if (status != SM_OK) {
+                                                printf("%s\n", sm_status_message(status));
+                                        }
+                                        (found) ? printf("Value %.1lf present in Sparse Matrix\n\n", value) : printf("Value %.1lf not present in Sparse Matrix\n\n", value);
                                 }
                                 break;
                         case 'r':
                                 {
-                                        (resize(M)) ? printf("Matrix is resized\n\n") : printf("Matrix is not resized\n\n");
+                                        (resize(M) == SM_OK) ? printf("Matrix is resized\n\n") : printf("Matrix is not resized\n\n");
                                 }
                                 break;
                         case 't':
                                 {
-                                        (transpose(M)) ? printf("Matrix converted to transposed version\n\n"): printf("Matrix not converted to trasposed version\n\n");
+                                        (transpose(M) == SM_OK) ? printf("Matrix converted to transposed version\n\n"): printf("Matrix not converted to trasposed version\n\n");
                                 }
                                 break;
                         case 'q':
@@ -17,6 +17,52 @@
 #include <stdbool.h>
 #include <stdio.h>
 
+#include "../../../common/include/instrument.h"
+
+
+// Headers per allocation block of a header list
+#define SM_HEADER_BLOCK 64
+
+// Nodes insert_data makes before it adds them to the library totals
+#define SM_COUNT_BATCH 64
+
+
+/*
+ * Enum: sm_status
+ * ----------------------------
+ * Result of a matrix operation. The library never prints; callers turn a status into text
+ * with sm_status_message() when they want to.
+ *
+ * SM_OK: The operation succeeded.
+ * SM_ERR_NOT_CREATED: The matrix or list is NULL.
+ * SM_ERR_ZERO_VALUE: 0 can not be stored or searched for.
+ * SM_ERR_OUT_OF_BOUNDS: A row or column index is outside the matrix, or the dimensions are invalid.
+ * SM_ERR_NO_MEMORY: An allocation failed.
+ * SM_ERR_OVERFLOW: The new dimensions do not fit in 32 bits.
+ * SM_ERR_INVALID_ARG: A required output pointer or parameter is missing or invalid.
+ */
+typedef enum sm_status {
+        SM_OK = 0,
+        SM_ERR_NOT_CREATED,
+        SM_ERR_ZERO_VALUE,
+        SM_ERR_OUT_OF_BOUNDS,
+        SM_ERR_NO_MEMORY,
+        SM_ERR_OVERFLOW,
+        SM_ERR_INVALID_ARG
+} sm_status;
+
+
+/*
+ * Type: sm_trace_fn
+ * ----------------------------
+ * Debug hook called whenever a matrix operation fails.
+ *
+ * function: Name of the failing library function.
+ * status: The error being returned.
+ * ctx: Context registered with sm_set_trace().
+ */
+typedef void (*sm_trace_fn)(const char* function, sm_status status, void* ctx);
+
 
 /*
  * Struct: m_node
@@ -41,32 +87,35 @@ typedef struct m_node {
 /*
  * Struct: l_node
  * ----------------------------
- * Represents a node in a linked list.
+ * Represents the header of one row or column.
  *
- * matrix_node: Pointer to a matrix node.
- * next: Pointer to the next node in the list.
- * prev: Pointer to the previous node in the list.
+ * matrix_node: Pointer to the first matrix node of the row or column.
  */
 typedef struct l_node {
         m_node* matrix_node;
-        struct l_node* next;
-        struct l_node* prev;
 } l_node;
 
 
 /*
  * Struct: link_list
  * ----------------------------
- * Represents a linked list to store nodes.
+ * Represents the list of row or column headers.
  *
- * head: Pointer to the first node in the list.
- * tail: Pointer to the last node in the list.
  * size: Number of nodes in the list.
+ * blocks: Storage of the nodes, SM_HEADER_BLOCK per block; node i (1-based) is
+ *         blocks[(i - 1) / SM_HEADER_BLOCK][(i - 1) % SM_HEADER_BLOCK]. A block is allocated
+ *         when one of its nodes first gets a matrix node; until then its slot is NULL and all
+ *         its rows or columns are empty.
+ * block_count: Number of allocated blocks.
+ * block_capacity: Number of slots in blocks.
+ * mem: Statistics of the matrix that owns the list, charged for its blocks; NULL for a standalone list.
  */
 typedef struct link_list {
-        l_node* head;
-        l_node* tail;
         uint32_t size;
+        l_node** blocks;
+        uint32_t block_count;
+        uint32_t block_capacity;
+        mem_stats* mem;
 } link_list;
 
 
@@ -79,25 +128,166 @@ typedef struct link_list {
  * columnList: Array of pointers to the first node in each column.
  * row: The number of rows in the matrix.
  * col: The number of columns in the matrix.
+ * symmetric: Whether only the upper triangle (row <= column) is stored; the lower one mirrors it.
+ * generation: Modification counter, advanced by every change to the contents or dimensions, so
+ *             results derived from the matrix can tell when they are stale.
+ * mem: Memory of this matrix (the struct, header lists and blocks, nodes) and its high-water marks.
+ * uncounted: Nodes insert_data has made that are not in the library totals yet.
  */
 typedef struct matrix {
         link_list* rowList;
         link_list* columnList;
         uint32_t row;
         uint32_t col;
+        bool symmetric;
+        uint64_t generation;
+        mem_stats mem;
+        uint32_t uncounted;
 } matrix;
 
 
 /*
- * Function: create_l_node
+ * Function: sm_status_message
+ * ----------------------------
+ * Gets the description of a status.
+ *
+ * @param status - The status.
+ *
+ * @return A static string; never NULL.
+ */
+const char* sm_status_message(sm_status status);
+
+
+/*
+ * Function: sm_set_trace
+ * ----------------------------
+ * Installs (or, with NULL, removes) the debug hook called on every error.
+ *
+ * @param fn - The hook.
+ * @param ctx - Context passed to the hook.
+ *
+ * Description:
+ *   The hook is a process-wide setting; install it before other threads use the library.
+ *   Without a hook an error costs one predictable branch.
+ */
+void sm_set_trace(sm_trace_fn fn, void* ctx);
+
+
+/*
+ * Function: sm_fail
+ * ----------------------------
+ * Reports an error to the trace hook, if any, and returns it.
+ *
+ * @param function - Name of the failing function.
+ * @param status - The error.
+ *
+ * @return status.
+ *
+ * Description:
+ *   For the library's other matrix types, so their errors reach the same hook.
+ */
+sm_status sm_fail(const char* function, sm_status status);
+
+
+/*
+ * Function: grow_list
+ * ----------------------------
+ * Grows a linked list to the given number of empty nodes.
+ *
+ * @param ll - Pointer to the linked list.
+ * @param size - Number of nodes needed; a list already that long is left as it is.
+ *
+ * @return SM_OK, SM_ERR_NOT_CREATED if ll is NULL, or SM_ERR_NO_MEMORY.
+ *
+ * Description:
+ *   Only the array of block slots grows, zero-filled; no block is allocated, so growing to
+ *   any size is cheap and touch_header() later allocates the blocks that get used.
+ */
+sm_status grow_list(link_list* ll, uint32_t size);
+
+
+/*
+ * Function: touch_header
  * ----------------------------
- * Creates and initializes a linked list node with the given matrix node data.
+ * Gets the node at a position, allocating its block if it has none yet.
+ *
+ * @param ll - Pointer to the linked list.
+ * @param index - Position of the node (1-based, at most ll->size).
  *
- * @param data - Pointer to the matrix node to be stored in the linked list node.
+ * @return Pointer to the node, or NULL if the block can not be allocated.
  *
- * @return Pointer to the linked list node, or NULL if allocation fails.
+ * Description:
+ *   Callers must not race each other, but a new block is published with a release store,
+ *   so other threads may look the slot up with an acquire load while a block is added.
  */
-l_node* create_l_node(m_node* data);
+l_node* touch_header(link_list* ll, uint32_t index);
+
+
+/*
+ * Function: seek_header
+ * ----------------------------
+ * Finds the node at a position through the list's blocks.
+ *
+ * @param ll - Pointer to the linked list.
+ * @param index - Position of the node (1-based, at most ll->size).
+ *
+ * @return Pointer to the node, or NULL if its block was never allocated (the row or column
+ *         is empty).
+ */
+static inline l_node* seek_header(link_list* ll, uint32_t index) {
+        l_node* block = ll->blocks[(index - 1) / SM_HEADER_BLOCK];
+        return block ? &block[(index - 1) % SM_HEADER_BLOCK] : NULL;
+}
+
+
+/*
+ * Function: header_chain
+ * ----------------------------
+ * Gets the first matrix node of a row or column.
+ *
+ * @param ll - Pointer to the linked list.
+ * @param index - Position of the node (1-based); positions past ll->size are empty.
+ *
+ * @return The first matrix node, or NULL if the row or column is empty.
+ */
+static inline m_node* header_chain(link_list* ll, uint32_t index) {
+        if (index < 1 || index > ll->size) return NULL;
+
+        l_node* header = seek_header(ll, index);
+        return header ? header->matrix_node : NULL;
+}
+
+
+/*
+ * Function: next_header
+ * ----------------------------
+ * Steps to the next node of the list that has a block, skipping whole unallocated blocks.
+ *
+ * @param ll - Pointer to the linked list.
+ * @param index - Position of the last node visited (0 to start); set to the position of the
+ *                returned node.
+ *
+ * @return Pointer to the node, or NULL past the end of the list.
+ *
+ * Description:
+ *   Walks are written for (l_node* h; (h = next_header(ll, &i));) with i starting at 0.
+ */
+static inline l_node* next_header(link_list* ll, uint32_t* index) {
+        uint32_t i = *index;
+
+        // i is the 0-based position of the next candidate
+        while (i < ll->size) {
+                l_node* block = ll->blocks[i / SM_HEADER_BLOCK];
+                if (block) {
+                        *index = i + 1;
+                        return &block[i % SM_HEADER_BLOCK];
+                }
+                i = (i / SM_HEADER_BLOCK + 1) * SM_HEADER_BLOCK;
+        }
+
+        *index = ll->size;
+        return NULL;
+}
 
 
 /*
@@ -107,8 +297,14 @@ l_node* create_l_node(m_node* data);
  *
  * @param ll - Pointer to the linked list.
  * @param data - Pointer to the matrix node to be stored in the new list node.
+ *
+ * @return SM_OK, SM_ERR_NOT_CREATED if ll is NULL, or SM_ERR_NO_MEMORY.
+ *
+ * Description:
+ *   The node comes from its block; a block of SM_HEADER_BLOCK nodes is allocated only when
+ *   the first of its nodes is used, so list nodes must not be freed individually.
  */
-void add_list_node(link_list* ll, m_node* data);
+sm_status add_list_node(link_list* ll, m_node* data);
 
 
 /*
@@ -121,6 +317,50 @@ void add_list_node(link_list* ll, m_node* data);
 link_list* create_link_list();
 
 
+/*
+ * Function: alloc_mat_node
+ * ----------------------------
+ * Creates and initializes a matrix node without counting it in the library totals.
+ *
+ * @param row - Row index of the node.
+ * @param col - Column index of the node.
+ * @param value - Value to be stored in the node.
+ *
+ * @return Pointer to the matrix node, or NULL if allocation fails.
+ *
+ * Description:
+ *   For code that makes many nodes, possibly on several threads: it counts what it made with
+ *   one count_mat_nodes() call per batch instead of an atomic update per node. A node that was
+ *   never counted is released with free().
+ */
+m_node* alloc_mat_node(uint32_t row, uint32_t col, double value);
+
+
+/*
+ * Function: count_mat_nodes
+ * ----------------------------
+ * Records a batch of matrix nodes coming into and going out of use in the library totals.
+ *
+ * @param created - Nodes made with alloc_mat_node.
+ * @param released - Nodes released with free().
+ */
+void count_mat_nodes(uint64_t created, uint64_t released);
+
+
+/*
+ * Function: flush_mat_nodes
+ * ----------------------------
+ * Adds the nodes insert_data has made since the last flush to the library totals.
+ *
+ * @param M - Pointer to the matrix.
+ *
+ * Description:
+ *   Must be called before nodes of the matrix are released and counted with count_mat_nodes,
+ *   so the totals never go below the nodes in use.
+ */
+void flush_mat_nodes(matrix* M);
+
+
 /*
  * Function: create_mat_node
  * ----------------------------
@@ -139,6 +379,20 @@ link_list* create_link_list();
 m_node* create_mat_node(uint32_t row, uint32_t col, double value);
 
 
+/*
+ * Function: free_mat_node
+ * ----------------------------
+ * Frees a matrix node made by create_mat_node.
+ *
+ * @param node - Pointer to the matrix node.
+ *
+ * Description:
+ *   Nodes are counted in the library totals when they are created and released here. Code that
+ *   links nodes into a matrix, or unlinks them, also charges the matrix's own statistics.
+ */
+void free_mat_node(m_node* node);
+
+
 /*
  * Function: create_S_Matrix
  * ----------------------------
@@ -156,6 +410,26 @@ m_node* create_mat_node(uint32_t row, uint32_t col, double value);
 matrix* create_S_Matrix(uint32_t rows, uint32_t columns);
 
 
+/*
+ * Function: create_symmetric_S_Matrix
+ * ----------------------------
+ * Creates and initializes a symmetric n x n S_Matrix.
+ *
+ * @param n - Number of rows and columns.
+ *
+ * @return Pointer to the matrix, or NULL if allocation fails.
+ *
+ * Description:
+ *   Only the upper triangle is stored, so each off-diagonal pair costs one m_node.
+ *   insert_data, get_data, duplicatevalue, spmv_S_Matrix and displayMatrix mirror it
+ *   transparently, and transpose leaves the matrix untouched. The other modules (views,
+ *   cursors, SpMM, reductions, semiring kernels, reordering, file storage) see the full
+ *   matrix as well. Code that walks the chains directly sees the stored triangle;
+ *   csr_from_S_Matrix expands it to the full matrix.
+ */
+matrix* create_symmetric_S_Matrix(uint32_t n);
+
+
 /*
  * Function: insert_data
  * ----------------------------
@@ -166,11 +440,28 @@ matrix* create_S_Matrix(uint32_t rows, uint32_t columns);
  * @param column - Column index.
  * @param value - Value to be inserted.
  *
+ * @return SM_OK, SM_ERR_NOT_CREATED, SM_ERR_ZERO_VALUE, SM_ERR_OUT_OF_BOUNDS or SM_ERR_NO_MEMORY.
+ *
  * Description:
  *   Inserts the value at the specified position in the sparse matrix.
  *   If the position already contains a value, it updates the existing value.
+ *   In a symmetric matrix a lower-triangle position is stored as its mirror.
+ */
+sm_status insert_data(matrix* M, uint32_t row, uint32_t column, double value);
+
+
+/*
+ * Function: get_data
+ * ----------------------------
+ * Reads the value at the specified row and column in the matrix.
+ *
+ * @param M - Pointer to the matrix.
+ * @param row - Row index.
+ * @param column - Column index.
+ *
+ * @return The value, or 0 if the position holds no value or is out of bounds.
  */
-void insert_data(matrix* M, uint32_t row, uint32_t column, double value);
+double get_data(matrix* M, uint32_t row, uint32_t column);
 
 
 /*
@@ -180,10 +471,11 @@ void insert_data(matrix* M, uint32_t row, uint32_t column, double value);
  *
  * @param M - Pointer to the matrix.
  * @param value - Value to search for.
+ * @param found - Output, true if the value exists.
  *
- * @return true if the value exists, false otherwise.
+ * @return SM_OK, SM_ERR_NOT_CREATED, SM_ERR_INVALID_ARG (found is NULL) or SM_ERR_ZERO_VALUE.
  */
-bool duplicatevalue(matrix* M, double value);
+sm_status duplicatevalue(matrix* M, double value, bool* found);
 
 
 /*
@@ -193,9 +485,30 @@ bool duplicatevalue(matrix* M, double value);
  *
  * @param M - Pointer to the matrix.
  *
- * @return true if resizing is successful, false otherwise.
+ * @return SM_OK, SM_ERR_NOT_CREATED or SM_ERR_OVERFLOW.
  */
-bool resize(matrix* M);
+sm_status resize(matrix* M);
+
+
+/*
+ * Function: resize_to
+ * ----------------------------
+ * Changes the dimensions of the matrix, dropping the values that fall outside.
+ *
+ * @param M - Pointer to the matrix.
+ * @param rows - New number of rows.
+ * @param columns - New number of columns.
+ *
+ * @return SM_OK, SM_ERR_NOT_CREATED, SM_ERR_OUT_OF_BOUNDS (a symmetric matrix must stay square)
+ *         or SM_ERR_NO_MEMORY.
+ *
+ * Description:
+ *   Growing only records the new dimensions; an insert later allocates just the header
+ *   blocks holding its row and its column. Shrinking cuts the surviving chains that lead into the removed rows and
+ *   columns, frees the removed nodes and releases the header blocks past the new size, so
+ *   it costs O(removed + length of the chains that are cut) rather than a full scan.
+ */
+sm_status resize_to(matrix* M, uint32_t rows, uint32_t columns);
 
 
 /*
@@ -205,9 +518,30 @@ bool resize(matrix* M);
  *
  * @param M - Pointer to the matrix.
  *
- * @return true if transposition is successful, false otherwise.
+ * @return SM_OK or SM_ERR_NOT_CREATED.
+ *
+ * Description:
+ *   A symmetric matrix is its own transpose and is left untouched.
+ */
+sm_status transpose(matrix* M);
+
+
+/*
+ * Function: spmv_S_Matrix
+ * ----------------------------
+ * Computes y = M * x.
+ *
+ * @param M - Pointer to the matrix.
+ * @param x - Input vector of M->col entries; entry i belongs to column i + 1.
+ * @param y - Output vector of M->row entries; entry i belongs to row i + 1.
+ *
+ * @return SM_OK or SM_ERR_NOT_CREATED.
+ *
+ * Description:
+ *   In a symmetric matrix each stored off-diagonal node contributes to both y[row] and
+ *   y[column], so the mirrored triangle is never materialized.
  */
-bool transpose(matrix* M);
+sm_status spmv_S_Matrix(matrix* M, const double* x, double* y);
 
 
 /*
@@ -216,6 +550,9 @@ bool transpose(matrix* M);
  * Displays the matrix contents in a formatted manner.
  *
  * @param M - Pointer to the matrix.
+ *
+ * Description:
+ *   This is the only function of the core library that writes to stdout.
  */
 void displayMatrix(matrix* M);
 
@@ -230,4 +567,55 @@ void displayMatrix(matrix* M);
 void free_S_Matrix(matrix* M);
 
 
+/*
+ * Function: sm_memory
+ * ----------------------------
+ * Reads the memory statistics of one matrix.
+ *
+ * @param M - Pointer to the matrix.
+ * @param out - Output statistics; zeroed if M is NULL.
+ */
+void sm_memory(matrix* M, mem_stats* out);
+
+
+/*
+ * Function: sm_memory_totals
+ * ----------------------------
+ * Reads the memory statistics of all matrices of the process together.
+ *
+ * @param out - Output statistics.
+ *
+ * Description:
+ *   The totals cover the matrix structs, header lists and nodes that S_Matrix.c allocates;
+ *   derived forms (CSR copies, caches, plans) keep their own memory.
+ */
+void sm_memory_totals(mem_stats* out);
+
+
+/*
+ * Function: sm_timers
+ * ----------------------------
+ * Gets the timers of the main matrix operations.
+ *
+ * @param count - Output, number of timers.
+ *
+ * @return The timers: insert_data, get_data, resize, resize_to, transpose, spmv_S_Matrix and
+ *         free_S_Matrix. They stay at zero unless the library is built with INSTRUMENT_TIMERS.
+ */
+const op_timer* sm_timers(uint32_t* count);
+
+
+/*
+ * Function: sm_memory_json
+ * ----------------------------
+ * Writes the library totals, the statistics of one matrix and the timers as JSON.
+ *
+ * @param out - Destination stream.
+ * @param M - Pointer to the matrix, or NULL for the totals and timers only.
+ *
+ * @return true if the JSON was written, false on a stream error.
+ */
+bool sm_memory_json(FILE* out, matrix* M);
+
+
 #endif // S_MATRIX_H
@@ -0,0 +1,97 @@
+/*
+ * File Name: S_Matrix_analyze.h
+ * Authors: Arpit Patel, Dharm KaPatel
+ * Date: 2025-03-19
+ * Description: This file defines the structure analyzer of the S_Matrix data structure. It reports
+ *              the statistics that decide which storage format and kernel suit a matrix, and can
+ *              sample evenly spaced row bands instead of walking every chain of a huge matrix.
+ */
+
+
+#ifndef S_MATRIX_ANALYZE_H
+#define S_MATRIX_ANALYZE_H
+
+
+// Include necessary headers
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "S_Matrix.h"
+
+
+// Bins of the row-length histogram: bin 0 counts empty rows, bin b lengths in [2^(b-1), 2^b)
+#define SM_ROW_HISTOGRAM_BINS 33
+
+// Side of the square blocks measured by block_density, and the height of a sampled row band
+#define SM_ANALYZE_BLOCK 4
+
+// distinct_values saturates here, meaning "more than a 16-bit dictionary can hold"
+#define SM_DISTINCT_CAP 65537
+
+
+/*
+ * Struct: sm_structure
+ * ----------------------------
+ * Structure statistics of a matrix.
+ *
+ * row: The number of rows in the matrix.
+ * col: The number of columns in the matrix.
+ * nnz: Number of non-zeros (extrapolated when sampled).
+ * max_row_nnz: Length of the longest examined row.
+ * row_histogram: Row-length histogram (extrapolated when sampled).
+ * bandwidth: Largest |row - column| over the examined non-zeros.
+ * symmetric: Whether the examined rows equal their columns (always true for symmetric storage).
+ * block_density: Fraction of the cells of occupied SM_ANALYZE_BLOCK x SM_ANALYZE_BLOCK blocks that
+ *                hold a stored non-zero.
+ * distinct_values: Number of distinct examined values, at most SM_DISTINCT_CAP.
+ * rows_examined: Number of rows whose chains were walked.
+ * sampled: Whether only part of the rows was examined.
+ */
+typedef struct sm_structure {
+        uint32_t row;
+        uint32_t col;
+        uint64_t nnz;
+        uint32_t max_row_nnz;
+        uint64_t row_histogram[SM_ROW_HISTOGRAM_BINS];
+        uint32_t bandwidth;
+        bool symmetric;
+        double block_density;
+        uint32_t distinct_values;
+        uint32_t rows_examined;
+        bool sampled;
+} sm_structure;
+
+
+/*
+ * Function: analyze_S_Matrix
+ * ----------------------------
+ * Computes the structure statistics of a matrix.
+ *
+ * @param M - Pointer to the matrix.
+ * @param sample_rows - Upper bound on the rows to examine, or 0 to examine all of them.
+ * @param stats - Output statistics.
+ *
+ * @return true on success, false if M is NULL or the value set can not be allocated.
+ *
+ * Description:
+ *   When sampling, every k-th band of SM_ANALYZE_BLOCK rows is examined, so the cost is
+ *   proportional to sample_rows plus one step per row header. Counts are scaled up to the
+ *   whole matrix; maxima and the symmetry test only cover the examined rows.
+ *   A symmetric matrix reports the lengths of its full rows, mirror included.
+ */
+bool analyze_S_Matrix(matrix* M, uint32_t sample_rows, sm_structure* stats);
+
+
+/*
+ * Function: row_histogram_bin
+ * ----------------------------
+ * Gets the histogram bin of a row length.
+ *
+ * @param length - Number of non-zeros of the row.
+ *
+ * @return The bin, in [0, SM_ROW_HISTOGRAM_BINS).
+ */
+uint32_t row_histogram_bin(uint32_t length);
+
+
+#endif // S_MATRIX_ANALYZE_H
@@ -0,0 +1,201 @@
+/*
+ * File Name: S_Matrix_buffered.h
+ * Authors: Arpit Patel, Dharm KaPatel
+ * Date: 2025-03-19
+ * Description: This file defines a write-buffered sparse matrix for mixed update and scan workloads.
+ *              Inserts are appended to a buffer in O(1) amortized time, reads merge the buffer
+ *              with a compacted CSR base on the fly, and compaction folds the buffer into the base.
+ *
+ * A hash index over the buffer keeps one entry per position and answers bm_get in O(1). Scans
+ * put the buffer in row-major order and keep it that way, so each one sorts only the entries
+ * added since the previous scan. Because reads reorder the buffer, a b_matrix must not be used
+ * from several threads at once, even for reading.
+ */
+
+
+#ifndef S_MATRIX_BUFFERED_H
+#define S_MATRIX_BUFFERED_H
+
+
+// Include necessary headers
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "S_Matrix.h"
+#include "S_Matrix_csr.h"
+
+
+/*
+ * Type: sm_visit_fn
+ * ----------------------------
+ * Callback receiving one non-zero of a scan.
+ *
+ * row: The row index of the element.
+ * column: The column index of the element.
+ * value: The value of the element.
+ * ctx: Caller context passed through the scan.
+ */
+typedef void (*sm_visit_fn)(uint32_t row, uint32_t column, double value, void* ctx);
+
+
+/*
+ * Struct: b_matrix
+ * ----------------------------
+ * Represents a write-buffered sparse matrix.
+ *
+ * base: Compacted non-zeros in CSR form.
+ * buffer: Inserts not yet compacted, one entry per position.
+ * buf_size: Number of entries in the buffer.
+ * buf_cap: Number of entries the buffer can hold before it grows.
+ * sorted: Length of the buffer prefix that is in row-major order; later entries are in arrival order.
+ * index: Open-addressing hash table of buffer slot + 1 by position (0 is an empty cell).
+ * index_mask: Number of cells of index minus one; the table has 2 * buf_cap cells.
+ * compact_threshold: Buffer size that triggers an automatic compaction (0 disables it).
+ */
+typedef struct b_matrix {
+        csr_matrix* base;
+        sm_triplet* buffer;
+        uint64_t buf_size;
+        uint64_t buf_cap;
+        uint64_t sorted;
+        uint64_t* index;
+        uint64_t index_mask;
+        uint64_t compact_threshold;
+} b_matrix;
+
+
+/*
+ * Function: create_buffered_matrix
+ * ----------------------------
+ * Creates an empty write-buffered matrix.
+ *
+ * @param rows - Number of rows.
+ * @param columns - Number of columns.
+ * @param compact_threshold - Buffer size that triggers compaction, or 0 for explicit bm_compact only.
+ *
+ * @return Pointer to the matrix, or NULL if allocation fails.
+ */
+b_matrix* create_buffered_matrix(uint32_t rows, uint32_t columns, uint64_t compact_threshold);
+
+
+/*
+ * Function: buffered_from_S_Matrix
+ * ----------------------------
+ * Creates a write-buffered matrix whose base holds the contents of a linked matrix.
+ *
+ * @param M - Pointer to the matrix.
+ * @param compact_threshold - Buffer size that triggers compaction, or 0 for explicit bm_compact only.
+ *
+ * @return Pointer to the matrix, or NULL if allocation fails.
+ */
+b_matrix* buffered_from_S_Matrix(matrix* M, uint64_t compact_threshold);
+
+
+/*
+ * Function: bm_insert_data
+ * ----------------------------
+ * Appends a value for the specified row and column to the write buffer.
+ *
+ * @param B - Pointer to the buffered matrix.
+ * @param row - Row index.
+ * @param column - Column index.
+ * @param value - Value to be inserted.
+ *
+ * @return SM_OK, SM_ERR_NOT_CREATED, SM_ERR_ZERO_VALUE, SM_ERR_OUT_OF_BOUNDS or SM_ERR_NO_MEMORY.
+ *
+ * Description:
+ *   A later insert at the same position overwrites the buffered entry in place. When the
+ *   buffer reaches the compaction threshold it is folded into the base; if that fails the
+ *   entry stays buffered and the insert still returns SM_OK.
+ */
+sm_status bm_insert_data(b_matrix* B, uint32_t row, uint32_t column, double value);
+
+
+/*
+ * Function: bm_get
+ * ----------------------------
+ * Reads a single element, looking at the buffer first and the base second.
+ *
+ * @param B - Pointer to the buffered matrix.
+ * @param row - Row index.
+ * @param column - Column index.
+ *
+ * @return The current value, or 0 if the position is empty.
+ *
+ * Description:
+ *   The buffer is searched through its hash index, so the cost does not grow with the buffer.
+ */
+double bm_get(b_matrix* B, uint32_t row, uint32_t column);
+
+
+/*
+ * Function: bm_scan
+ * ----------------------------
+ * Visits every non-zero in row-major order, merging the buffer with the base.
+ *
+ * @param B - Pointer to the buffered matrix.
+ * @param visit - Callback receiving each non-zero.
+ * @param ctx - Caller context passed to the callback.
+ *
+ * @return true on success, false if the scratch space can not be allocated.
+ *
+ * Description:
+ *   The entries buffered since the previous scan are sorted and merged into the sorted part
+ *   of the buffer, so a scan costs O(nnz + b + t log t) for a buffer of b entries, t of them new.
+ */
+bool bm_scan(b_matrix* B, sm_visit_fn visit, void* ctx);
+
+
+/*
+ * Function: bm_scan_row
+ * ----------------------------
+ * Visits the non-zeros of one row in column order, merging the buffer with the base.
+ *
+ * @param B - Pointer to the buffered matrix.
+ * @param row - Row index.
+ * @param visit - Callback receiving each non-zero.
+ * @param ctx - Caller context passed to the callback.
+ *
+ * @return true on success, false if the scratch space can not be allocated.
+ *
+ * Description:
+ *   Like bm_scan it first sorts the new entries; the row is then found by binary search.
+ */
+bool bm_scan_row(b_matrix* B, uint32_t row, sm_visit_fn visit, void* ctx);
+
+
+/*
+ * Function: bm_compact
+ * ----------------------------
+ * Folds the write buffer into the base.
+ *
+ * @param B - Pointer to the buffered matrix.
+ *
+ * @return SM_OK, SM_ERR_NOT_CREATED or SM_ERR_NO_MEMORY (the matrix is left unchanged).
+ */
+sm_status bm_compact(b_matrix* B);
+
+
+/*
+ * Function: S_Matrix_from_buffered
+ * ----------------------------
+ * Compacts the buffered matrix and builds a linked matrix from it.
+ *
+ * @param B - Pointer to the buffered matrix.
+ *
+ * @return Pointer to the matrix, or NULL if allocation fails.
+ */
+matrix* S_Matrix_from_buffered(b_matrix* B);
+
+
+/*
+ * Function: free_buffered_matrix
+ * ----------------------------
+ * Frees all memory associated with the buffered matrix.
+ *
+ * @param B - Pointer to the buffered matrix.
+ */
+void free_buffered_matrix(b_matrix* B);
+
+
+#endif // S_MATRIX_BUFFERED_H
@@ -0,0 +1,194 @@
+/*
+ * File Name: S_Matrix_cache.h
+ * Authors: Arpit Patel, Dharm KaPatel
+ * Date: 2025-03-19
+ * Description: This file defines the derived-result cache of the S_Matrix data structure. A cache
+ *              belongs to one matrix and memoizes results computed from it (CSR and transposed CSR
+ *              copies, row and column reductions, the compressed form, tuned product plans). Each
+ *              result is kept until the matrix's generation moves on, or until it is evicted,
+ *              least recently used first, to stay within a memory budget.
+ */
+
+
+#ifndef S_MATRIX_CACHE_H
+#define S_MATRIX_CACHE_H
+
+
+// Include necessary headers
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "S_Matrix.h"
+#include "S_Matrix_csr.h"
+#include "S_Matrix_elementwise.h"
+#include "S_Matrix_compressed.h"
+#include "S_Matrix_optimize.h"
+
+
+/*
+ * Enum: sm_cache_op
+ * ----------------------------
+ * Kinds of cached results.
+ *
+ * SM_CACHE_CSR: CSR copy (csr_from_S_Matrix).
+ * SM_CACHE_TRANSPOSE: CSR copy of the transpose.
+ * SM_CACHE_ROW_REDUCE: Reduction of every row, one per sm_reduce kind.
+ * SM_CACHE_COLUMN_REDUCE: Reduction of every column, one per sm_reduce kind.
+ * SM_CACHE_COMPRESSED: Compressed read-only form.
+ * SM_CACHE_PLAN: Product plan from matrix_optimize, one per sm_workload.
+ */
+typedef enum sm_cache_op {
+        SM_CACHE_CSR,
+        SM_CACHE_TRANSPOSE,
+        SM_CACHE_ROW_REDUCE,
+        SM_CACHE_COLUMN_REDUCE,
+        SM_CACHE_COMPRESSED,
+        SM_CACHE_PLAN
+} sm_cache_op;
+
+
+/*
+ * Struct: sm_cache
+ * ----------------------------
+ * Memoized results of one matrix.
+ *
+ * M: The matrix the results are computed from.
+ * budget: Bytes the cached results may take.
+ * bytes: Bytes the cached results take now.
+ * generation: Generation of M the cached results belong to.
+ * hits: Requests answered from the cache.
+ * misses: Requests that computed their result.
+ * evictions: Results dropped to stay within the budget.
+ * head: Most recently used entry.
+ * tail: Least recently used entry.
+ */
+typedef struct sm_cache {
+        matrix* M;
+        size_t budget;
+        size_t bytes;
+        uint64_t generation;
+        uint64_t hits;
+        uint64_t misses;
+        uint64_t evictions;
+        struct sm_cache_entry* head;
+        struct sm_cache_entry* tail;
+} sm_cache;
+
+
+/*
+ * Function: create_cache
+ * ----------------------------
+ * Creates an empty cache for a matrix.
+ *
+ * @param M - Pointer to the matrix; it must outlive the cache.
+ * @param budget - Bytes the cached results may take.
+ *
+ * @return Pointer to the cache, or NULL if M is NULL or allocation fails.
+ *
+ * Description:
+ *   Every request first compares M->generation with the cache's; when the matrix has changed
+ *   all entries are dropped. Results returned by the cache are owned by it and stay valid
+ *   until the next request on the same cache, cache_clear() or free_cache(); they must not
+ *   be modified or freed. The newest result is always kept, even when it alone exceeds the
+ *   budget. A cache is not thread safe.
+ */
+sm_cache* create_cache(matrix* M, size_t budget);
+
+
+/*
+ * Function: cache_csr
+ * ----------------------------
+ * Gets the CSR copy of the matrix.
+ *
+ * @param C - Pointer to the cache.
+ *
+ * @return The CSR copy, or NULL if it can not be built.
+ */
+csr_matrix* cache_csr(sm_cache* C);
+
+
+/*
+ * Function: cache_transpose
+ * ----------------------------
+ * Gets the CSR copy of the transpose of the matrix.
+ *
+ * @param C - Pointer to the cache.
+ *
+ * @return The transposed CSR copy (M->col rows), or NULL if it can not be built.
+ */
+csr_matrix* cache_transpose(sm_cache* C);
+
+
+/*
+ * Function: cache_row_reduce
+ * ----------------------------
+ * Gets the reduction of every row, as computed by row_reduce_S_Matrix.
+ *
+ * @param C - Pointer to the cache.
+ * @param kind - The reduction.
+ *
+ * @return Vector of M->row entries, or NULL if allocation fails.
+ */
+const double* cache_row_reduce(sm_cache* C, sm_reduce kind);
+
+
+/*
+ * Function: cache_column_reduce
+ * ----------------------------
+ * Gets the reduction of every column, as computed by column_reduce_S_Matrix.
+ *
+ * @param C - Pointer to the cache.
+ * @param kind - The reduction.
+ *
+ * @return Vector of M->col entries, or NULL if allocation fails.
+ */
+const double* cache_column_reduce(sm_cache* C, sm_reduce kind);
+
+
+/*
+ * Function: cache_compressed
+ * ----------------------------
+ * Gets the compressed form of the matrix, built from the cached CSR copy when there is one.
+ *
+ * @param C - Pointer to the cache.
+ *
+ * @return The compressed form, or NULL if it can not be built.
+ */
+z_matrix* cache_compressed(sm_cache* C);
+
+
+/*
+ * Function: cache_plan
+ * ----------------------------
+ * Gets the product plan for a workload, so repeated products skip the tuning runs.
+ *
+ * @param C - Pointer to the cache.
+ * @param hint - The expected workload.
+ *
+ * @return The plan, or NULL if it can not be built.
+ */
+sm_plan* cache_plan(sm_cache* C, sm_workload hint);
+
+
+/*
+ * Function: cache_clear
+ * ----------------------------
+ * Drops every cached result; the counters are kept.
+ *
+ * @param C - Pointer to the cache.
+ */
+void cache_clear(sm_cache* C);
+
+
+/*
+ * Function: free_cache
+ * ----------------------------
+ * Frees a cache and its results (not the matrix).
+ *
+ * @param C - Pointer to the cache.
+ */
+void free_cache(sm_cache* C);
+
+
+#endif // S_MATRIX_CACHE_H
@@ -0,0 +1,213 @@
+/*
+ * File Name: S_Matrix_compressed.h
+ * Authors: Arpit Patel, Dharm KaPatel
+ * Date: 2025-03-19
+ * Description: This file defines a compressed, read-only sparse matrix for cold data kept in memory.
+ *              Column indices are delta encoded and bit-packed per row, values are dictionary encoded
+ *              when few distinct values occur, and rows are grouped into blocks so any row is found
+ *              by skipping at most SM_COMPRESS_BLOCK - 1 row headers.
+ *
+ * Row layout (in the index stream):
+ *   [nnz varint] and, when nnz > 0:
+ *   [first column varint][width u8][nnz - 1 gaps of width bits, LSB first, padded to a byte]
+ *   A gap is the column delta minus one, so runs of adjacent columns pack to width 0.
+ */
+
+
+#ifndef S_MATRIX_COMPRESSED_H
+#define S_MATRIX_COMPRESSED_H
+
+
+// Include necessary headers
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "S_Matrix.h"
+#include "S_Matrix_csr.h"
+#include "S_Matrix_buffered.h"
+
+
+// Number of rows per addressable block
+#define SM_COMPRESS_BLOCK 64
+
+
+/*
+ * Enum: sm_value_encoding
+ * ----------------------------
+ * How the values of a compressed matrix are stored.
+ *
+ * SM_VALUES_RAW: One double per non-zero.
+ * SM_VALUES_DICT8: One byte per non-zero indexing a dictionary of up to 256 values.
+ * SM_VALUES_DICT16: Two bytes per non-zero indexing a dictionary of up to 65536 values.
+ */
+typedef enum sm_value_encoding {
+        SM_VALUES_RAW,
+        SM_VALUES_DICT8,
+        SM_VALUES_DICT16
+} sm_value_encoding;
+
+
+/*
+ * Struct: z_matrix
+ * ----------------------------
+ * Represents a compressed matrix.
+ *
+ * row: The number of rows in the matrix.
+ * col: The number of columns in the matrix.
+ * nnz: Number of non-zeros.
+ * max_row_nnz: Length of the longest row.
+ * index: Encoded rows, followed by 8 bytes of padding for the unaligned decoder loads.
+ * index_size: Length of the encoded rows in bytes (without the padding).
+ * block_offset: Byte offset of the first row of each block in index.
+ * block_entry: Number of non-zeros before the first row of each block.
+ * encoding: How the values are stored.
+ * dictionary: The distinct values (dictionary encodings only).
+ * dictionary_size: Number of distinct values.
+ * codes: Dictionary codes (uint8_t or uint16_t) or raw doubles, one per non-zero.
+ */
+typedef struct z_matrix {
+        uint32_t row;
+        uint32_t col;
+        uint64_t nnz;
+        uint32_t max_row_nnz;
+        uint8_t* index;
+        uint64_t index_size;
+        uint64_t* block_offset;
+        uint64_t* block_entry;
+        sm_value_encoding encoding;
+        double* dictionary;
+        uint32_t dictionary_size;
+        void* codes;
+} z_matrix;
+
+
+/*
+ * Function: compressed_from_csr
+ * ----------------------------
+ * Compresses a CSR matrix.
+ *
+ * @param A - Pointer to the CSR matrix; columns must be strictly increasing within each row.
+ *
+ * @return Pointer to the compressed matrix, or NULL if A is NULL or allocation fails.
+ */
+z_matrix* compressed_from_csr(csr_matrix* A);
+
+
+/*
+ * Function: compressed_from_S_Matrix
+ * ----------------------------
+ * Compresses a linked matrix.
+ *
+ * @param M - Pointer to the matrix; a symmetric matrix is stored with both triangles.
+ *
+ * @return Pointer to the compressed matrix, or NULL if M is NULL or allocation fails.
+ */
+z_matrix* compressed_from_S_Matrix(matrix* M);
+
+
+/*
+ * Function: zm_bytes
+ * ----------------------------
+ * Gets the memory held by a compressed matrix.
+ *
+ * @param Z - Pointer to the compressed matrix.
+ *
+ * @return Number of bytes, including the struct and the block tables.
+ */
+uint64_t zm_bytes(z_matrix* Z);
+
+
+/*
+ * Function: zm_row_length
+ * ----------------------------
+ * Gets the number of non-zeros of one row.
+ *
+ * @param Z - Pointer to the compressed matrix.
+ * @param row - Row index.
+ *
+ * @return Number of non-zeros, or 0 if the row is out of bounds.
+ */
+uint32_t zm_row_length(z_matrix* Z, uint32_t row);
+
+
+/*
+ * Function: zm_row
+ * ----------------------------
+ * Decodes one row into caller-provided arrays.
+ *
+ * @param Z - Pointer to the compressed matrix.
+ * @param row - Row index.
+ * @param columns - Output array of at least zm_row_length() (or max_row_nnz) column indices.
+ * @param values - Output array of as many values, or NULL.
+ *
+ * @return Number of non-zeros decoded, or 0 if the row is out of bounds.
+ */
+uint32_t zm_row(z_matrix* Z, uint32_t row, uint32_t* columns, double* values);
+
+
+/*
+ * Function: zm_get
+ * ----------------------------
+ * Reads one element without decoding the rest of its row.
+ *
+ * @param Z - Pointer to the compressed matrix.
+ * @param row - Row index.
+ * @param column - Column index.
+ *
+ * @return The value, or 0 if the position holds no value or is out of bounds.
+ */
+double zm_get(z_matrix* Z, uint32_t row, uint32_t column);
+
+
+/*
+ * Function: zm_scan
+ * ----------------------------
+ * Visits every non-zero in row-major order.
+ *
+ * @param Z - Pointer to the compressed matrix.
+ * @param visit - Callback receiving each non-zero.
+ * @param ctx - Caller context passed to visit.
+ *
+ * @return true on success, false if the row buffers can not be allocated.
+ */
+bool zm_scan(z_matrix* Z, sm_visit_fn visit, void* ctx);
+
+
+/*
+ * Function: zm_spmv
+ * ----------------------------
+ * Computes y = Z * x, decoding the rows block by block.
+ *
+ * @param Z - Pointer to the compressed matrix.
+ * @param x - Input vector of Z->col entries; entry i belongs to column i + 1.
+ * @param y - Output vector of Z->row entries; entry i belongs to row i + 1.
+ * @param threads - Number of threads, or 0 for one per online CPU.
+ *
+ * @return true on success, false if the row buffers can not be allocated.
+ */
+bool zm_spmv(z_matrix* Z, const double* x, double* y, uint32_t threads);
+
+
+/*
+ * Function: csr_from_compressed
+ * ----------------------------
+ * Decompresses a compressed matrix to CSR form.
+ *
+ * @param Z - Pointer to the compressed matrix.
+ *
+ * @return Pointer to the CSR matrix, or NULL if Z is NULL or allocation fails.
+ */
+csr_matrix* csr_from_compressed(z_matrix* Z);
+
+
+/*
+ * Function: free_compressed_matrix
+ * ----------------------------
+ * Frees all memory associated with a compressed matrix.
+ *
+ * @param Z - Pointer to the compressed matrix.
+ */
+void free_compressed_matrix(z_matrix* Z);
+
+
+#endif // S_MATRIX_COMPRESSED_H
@@ -0,0 +1,106 @@
+/*
+ * File Name: S_Matrix_concurrent.h
+ * Authors: Arpit Patel, Dharm KaPatel
+ * Date: 2025-03-19
+ * Description: This file defines a concurrent insertion mode for the S_Matrix data structure.
+ *              Many threads can insert into the same matrix at once; inserts into different
+ *              rows and columns run in parallel.
+ */
+
+
+#ifndef S_MATRIX_CONCURRENT_H
+#define S_MATRIX_CONCURRENT_H
+
+
+// Include necessary headers
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+#include "S_Matrix.h"
+
+
+// Number of lock stripes for the row headers and for the column headers
+#define SM_LOCK_STRIPES 64
+
+
+/*
+ * Struct: c_matrix
+ * ----------------------------
+ * Wraps a matrix for concurrent insertion.
+ *
+ * M: Pointer to the wrapped matrix.
+ * block_lock: Serializes allocating header blocks; a header whose block exists is found
+ *             without it.
+ * row_locks: Striped locks guarding the row chains; row r uses row_locks[r % SM_LOCK_STRIPES].
+ * col_locks: Striped locks guarding the column chains; column c uses col_locks[c % SM_LOCK_STRIPES].
+ * inserted: New nodes linked under each row stripe, guarded by that stripe's lock.
+ *
+ * Locking order: a row stripe is always taken before a column stripe and never the
+ * other way around, so two inserts can not wait on each other.
+ */
+typedef struct c_matrix {
+        matrix* M;
+        pthread_mutex_t block_lock;
+        pthread_mutex_t row_locks[SM_LOCK_STRIPES];
+        pthread_mutex_t col_locks[SM_LOCK_STRIPES];
+        uint64_t inserted[SM_LOCK_STRIPES];
+} c_matrix;
+
+
+/*
+ * Function: create_concurrent_S_Matrix
+ * ----------------------------
+ * Prepares a matrix for concurrent insertion.
+ *
+ * @param M - Pointer to the matrix.
+ *
+ * @return Pointer to the concurrent wrapper, or NULL if allocation fails.
+ *
+ * Description:
+ *   Grows the row and column header lists of M up to M->row and M->col so no insert has
+ *   to grow them; the header blocks are still allocated by the first insert that needs
+ *   them. The matrix must not be used through the plain API until
+ *   release_concurrent_S_Matrix is called.
+ */
+c_matrix* create_concurrent_S_Matrix(matrix* M);
+
+
+/*
+ * Function: insert_data_concurrent
+ * ----------------------------
+ * Inserts a value at the specified row and column; safe to call from many threads.
+ *
+ * @param CM - Pointer to the concurrent wrapper.
+ * @param row - Row index.
+ * @param column - Column index.
+ * @param value - Value to be inserted.
+ *
+ * @return SM_OK, SM_ERR_NOT_CREATED, SM_ERR_ZERO_VALUE, SM_ERR_OUT_OF_BOUNDS or SM_ERR_NO_MEMORY.
+ *
+ * Description:
+ *   Same semantics as insert_data: zero values and out of bound positions are rejected,
+ *   and an existing element is updated in place. Errors reach the trace hook, which is
+ *   then called from the inserting thread. New nodes show in the memory statistics once
+ *   the wrapper is released.
+ */
+sm_status insert_data_concurrent(c_matrix* CM, uint32_t row, uint32_t column, double value);
+
+
+/*
+ * Function: release_concurrent_S_Matrix
+ * ----------------------------
+ * Frees the concurrent wrapper and hands the matrix back to the plain API.
+ *
+ * @param CM - Pointer to the concurrent wrapper.
+ *
+ * @return Pointer to the wrapped matrix.
+ *
+ * Description:
+ *   Advances M->generation once for all the concurrent inserts, and adds their nodes to
+ *   M->mem and the library totals in one step.
+ */
+matrix* release_concurrent_S_Matrix(c_matrix* CM);
+
+
+#endif // S_MATRIX_CONCURRENT_H
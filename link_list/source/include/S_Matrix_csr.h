@@ -0,0 +1,180 @@
+/*
+ * File Name: S_Matrix_csr.h
+ * Authors: Arpit Patel, Dharm KaPatel
+ * Date: 2025-03-19
+ * Description: This file defines the compressed sparse row (CSR) form of the S_Matrix data structure.
+ *              The CSR form keeps the non-zeros of each row in contiguous arrays; it is the
+ *              read-optimized counterpart of the linked matrix and is built from it in bulk.
+ */
+
+
+#ifndef S_MATRIX_CSR_H
+#define S_MATRIX_CSR_H
+
+
+// Include necessary headers
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "S_Matrix.h"
+
+
+/*
+ * Struct: sm_triplet
+ * ----------------------------
+ * A single (row, column, value) entry.
+ *
+ * row: The row index of the element.
+ * column: The column index of the element.
+ * value: The value of the element.
+ */
+typedef struct sm_triplet {
+        uint32_t row;
+        uint32_t column;
+        double value;
+} sm_triplet;
+
+
+/*
+ * Struct: csr_matrix
+ * ----------------------------
+ * Represents a sparse matrix in compressed sparse row form.
+ *
+ * row_ptr: Offsets into col_idx/values; row r (1-based) occupies [row_ptr[r - 1], row_ptr[r]).
+ * col_idx: Column index (1-based) of each non-zero, increasing within a row.
+ * values: Value of each non-zero.
+ * nnz: Number of non-zeros.
+ * row: The number of rows in the matrix.
+ * col: The number of columns in the matrix.
+ */
+typedef struct csr_matrix {
+        uint64_t* row_ptr;
+        uint32_t* col_idx;
+        double* values;
+        uint64_t nnz;
+        uint32_t row;
+        uint32_t col;
+} csr_matrix;
+
+
+/*
+ * Function: create_csr_matrix
+ * ----------------------------
+ * Allocates a CSR matrix with room for the given number of non-zeros.
+ *
+ * @param rows - Number of rows.
+ * @param columns - Number of columns.
+ * @param nnz - Number of non-zeros to reserve.
+ *
+ * @return Pointer to the CSR matrix with row_ptr zeroed, or NULL if allocation fails.
+ */
+csr_matrix* create_csr_matrix(uint32_t rows, uint32_t columns, uint64_t nnz);
+
+
+/*
+ * Function: csr_from_S_Matrix
+ * ----------------------------
+ * Exports a linked matrix to CSR form.
+ *
+ * @param M - Pointer to the matrix.
+ *
+ * @return Pointer to the CSR matrix, or NULL if M is NULL or allocation fails.
+ *
+ * Description:
+ *   A symmetric matrix is expanded to both triangles.
+ */
+csr_matrix* csr_from_S_Matrix(matrix* M);
+
+
+/*
+ * Function: csr_from_triplets
+ * ----------------------------
+ * Builds a CSR matrix from unsorted triplets.
+ *
+ * @param rows - Number of rows.
+ * @param columns - Number of columns.
+ * @param entries - Array of triplets; it is sorted in place.
+ * @param count - Number of triplets.
+ *
+ * @return Pointer to the CSR matrix, or NULL if allocation fails.
+ *
+ * Description:
+ *   When a position appears more than once the entry that came last in the input wins.
+ *   Out of bound positions and zero values are dropped.
+ */
+csr_matrix* csr_from_triplets(uint32_t rows, uint32_t columns, sm_triplet* entries, uint64_t count);
+
+
+/*
+ * Function: csr_get
+ * ----------------------------
+ * Looks up a single element by binary search within its row.
+ *
+ * @param A - Pointer to the CSR matrix.
+ * @param row - Row index.
+ * @param column - Column index.
+ *
+ * @return The stored value, or 0 if the position is empty.
+ */
+double csr_get(csr_matrix* A, uint32_t row, uint32_t column);
+
+
+/*
+ * Function: S_Matrix_from_csr
+ * ----------------------------
+ * Builds a linked matrix from CSR form on the calling thread.
+ *
+ * @param A - Pointer to the CSR matrix.
+ *
+ * @return Pointer to the matrix, or NULL if allocation fails.
+ *
+ * Description:
+ *   Same as S_Matrix_from_csr_parallel() with one thread.
+ */
+matrix* S_Matrix_from_csr(csr_matrix* A);
+
+
+/*
+ * Function: S_Matrix_from_csr_parallel
+ * ----------------------------
+ * Builds a linked matrix from CSR form, creating rows and linking columns in parallel.
+ *
+ * @param A - Pointer to the CSR matrix; each row's columns must be strictly increasing.
+ * @param threads - Number of threads, or 0 for one per online CPU.
+ *
+ * @return Pointer to the matrix, or NULL if allocation fails.
+ *
+ * Description:
+ *   Threads first create the nodes of disjoint row ranges and link each row chain in order.
+ *   The column chains are then appended through a tail pointer per column, each thread owning
+ *   a range of columns, so no locks are taken and the cost is O(nnz + rows + columns) instead
+ *   of one insert_data per element. Headers exist up to the last non-empty row and column.
+ */
+matrix* S_Matrix_from_csr_parallel(csr_matrix* A, uint32_t threads);
+
+
+/*
+ * Function: sort_triplets
+ * ----------------------------
+ * Stable sort of triplets by row, then column.
+ *
+ * @param entries - Array of triplets.
+ * @param count - Number of triplets.
+ *
+ * @return true on success, false if the scratch buffer can not be allocated.
+ */
+bool sort_triplets(sm_triplet* entries, uint64_t count);
+
+
+/*
+ * Function: free_csr_matrix
+ * ----------------------------
+ * Frees all memory associated with the CSR matrix.
+ *
+ * @param A - Pointer to the CSR matrix.
+ */
+void free_csr_matrix(csr_matrix* A);
+
+
+#endif // S_MATRIX_CSR_H
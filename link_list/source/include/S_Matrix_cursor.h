@@ -0,0 +1,117 @@
+/*
+ * File Name: S_Matrix_cursor.h
+ * Authors: Arpit Patel, Dharm KaPatel
+ * Date: 2025-03-19
+ * Description: This file defines a cursor for iterating over the non-zeros of the S_Matrix data structure.
+ *              Consumers read (row, column, value) entries without touching l_node or m_node, and
+ *              the cursor prefetches the nodes a few steps ahead of the current position.
+ */
+
+
+#ifndef S_MATRIX_CURSOR_H
+#define S_MATRIX_CURSOR_H
+
+
+// Include necessary headers
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "S_Matrix.h"
+
+
+/*
+ * Enum: sm_cursor_order
+ * ----------------------------
+ * Traversal orders of a cursor.
+ *
+ * SM_CURSOR_ROW_MAJOR: All non-zeros, row by row, columns increasing.
+ * SM_CURSOR_COLUMN_MAJOR: All non-zeros, column by column, rows increasing.
+ * SM_CURSOR_ROW: The non-zeros of one row, columns increasing.
+ * SM_CURSOR_COLUMN: The non-zeros of one column, rows increasing.
+ */
+typedef enum sm_cursor_order {
+        SM_CURSOR_ROW_MAJOR,
+        SM_CURSOR_COLUMN_MAJOR,
+        SM_CURSOR_ROW,
+        SM_CURSOR_COLUMN
+} sm_cursor_order;
+
+
+// Number of nodes the cursor prefetches ahead of its position
+#define SM_CURSOR_PREFETCH 4
+
+
+// The cursor's layout is private so the matrix storage can change without breaking callers
+typedef struct sm_cursor sm_cursor;
+
+
+/*
+ * Function: create_cursor
+ * ----------------------------
+ * Creates a cursor positioned before the first non-zero of a traversal.
+ *
+ * @param M - Pointer to the matrix.
+ * @param order - Traversal order.
+ * @param index - Row (SM_CURSOR_ROW) or column (SM_CURSOR_COLUMN) to iterate; ignored otherwise.
+ *
+ * @return Pointer to the cursor, or NULL if M is NULL, the index is out of bounds or allocation fails.
+ *
+ * Description:
+ *   The matrix must not be modified while the cursor is in use. A symmetric matrix is
+ *   traversed as if both triangles were stored.
+ */
+sm_cursor* create_cursor(matrix* M, sm_cursor_order order, uint32_t index);
+
+
+/*
+ * Function: cursor_next
+ * ----------------------------
+ * Reads the next non-zero and advances the cursor.
+ *
+ * @param C - Pointer to the cursor.
+ * @param row - Output row index, or NULL.
+ * @param column - Output column index, or NULL.
+ * @param value - Output value, or NULL.
+ *
+ * @return true if an entry was read, false at the end of the traversal.
+ */
+bool cursor_next(sm_cursor* C, uint32_t* row, uint32_t* column, double* value);
+
+
+/*
+ * Function: cursor_next_n
+ * ----------------------------
+ * Reads up to n non-zeros into caller-provided arrays and advances the cursor past them.
+ *
+ * @param C - Pointer to the cursor.
+ * @param rows - Output array of n row indices, or NULL.
+ * @param columns - Output array of n column indices, or NULL.
+ * @param values - Output array of n values, or NULL.
+ * @param n - Capacity of the arrays.
+ *
+ * @return Number of entries read; less than n only at the end of the traversal.
+ */
+uint32_t cursor_next_n(sm_cursor* C, uint32_t* rows, uint32_t* columns, double* values, uint32_t n);
+
+
+/*
+ * Function: cursor_reset
+ * ----------------------------
+ * Moves a cursor back before the first non-zero of its traversal.
+ *
+ * @param C - Pointer to the cursor.
+ */
+void cursor_reset(sm_cursor* C);
+
+
+/*
+ * Function: free_cursor
+ * ----------------------------
+ * Frees a cursor; the matrix is not touched.
+ *
+ * @param C - Pointer to the cursor.
+ */
+void free_cursor(sm_cursor* C);
+
+
+#endif // S_MATRIX_CURSOR_H
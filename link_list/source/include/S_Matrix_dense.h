@@ -0,0 +1,65 @@
+/*
+ * File Name: S_Matrix_dense.h
+ * Authors: Arpit Patel, Dharm KaPatel
+ * Date: 2025-03-19
+ * Description: This file defines the bulk conversions between the S_Matrix data structure and
+ *              dense row-major buffers of doubles. Both directions run in parallel over rows;
+ *              the import finds non-zeros eight cells at a time with SIMD compares.
+ *
+ * A dense buffer has a leading dimension ld >= cols: cell (r, c) (1-based) is at
+ * buffer[(r - 1) * ld + (c - 1)].
+ */
+
+
+#ifndef S_MATRIX_DENSE_H
+#define S_MATRIX_DENSE_H
+
+
+// Include necessary headers
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "S_Matrix.h"
+
+
+/*
+ * Function: S_Matrix_from_dense
+ * ----------------------------
+ * Builds a linked matrix from a dense row-major buffer.
+ *
+ * @param A - The dense buffer.
+ * @param rows - Number of rows.
+ * @param cols - Number of columns.
+ * @param ld - Leading dimension (doubles between the starts of consecutive rows).
+ * @param threads - Number of threads, or 0 for one per online CPU.
+ *
+ * @return Pointer to the matrix, or NULL on invalid input or allocation failure.
+ *
+ * Description:
+ *   Rows are counted and then copied into a CSR form by independent threads; zeros (including
+ *   -0.0) are skipped, NaN is kept. The CSR form is linked by S_Matrix_from_csr_parallel()
+ *   with the same threads.
+ */
+matrix* S_Matrix_from_dense(const double* A, uint32_t rows, uint32_t cols, uint64_t ld, uint32_t threads);
+
+
+/*
+ * Function: dense_from_S_Matrix
+ * ----------------------------
+ * Writes a linked matrix into a dense row-major buffer.
+ *
+ * @param M - Pointer to the matrix.
+ * @param out - Output buffer of at least (M->row - 1) * ld + M->col doubles; every cell of the
+ *              matrix is written and the padding past M->col in each row is left untouched.
+ * @param ld - Leading dimension, at least M->col.
+ * @param threads - Number of threads, or 0 for one per online CPU.
+ *
+ * @return true on success, false on invalid input or allocation failure.
+ *
+ * Description:
+ *   Symmetric storage is written in full, mirror included.
+ */
+bool dense_from_S_Matrix(matrix* M, double* out, uint64_t ld, uint32_t threads);
+
+
+#endif // S_MATRIX_DENSE_H
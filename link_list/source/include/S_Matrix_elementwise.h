@@ -0,0 +1,246 @@
+/*
+ * File Name: S_Matrix_elementwise.h
+ * Authors: Arpit Patel, Dharm KaPatel
+ * Date: 2025-03-19
+ * Description: This file defines element-wise operations and reductions over the stored non-zeros.
+ *              The CSR versions run over the contiguous value array with SIMD and split the work
+ *              across threads; the linked versions walk the chains and keep the matrix free of
+ *              zeros.
+ *
+ * Output vectors are plain arrays indexed from 0: entry i belongs to row (or column) i + 1.
+ */
+
+
+#ifndef S_MATRIX_ELEMENTWISE_H
+#define S_MATRIX_ELEMENTWISE_H
+
+
+// Include necessary headers
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "S_Matrix.h"
+#include "S_Matrix_csr.h"
+
+
+/*
+ * Enum: sm_unary_op
+ * ----------------------------
+ * Predefined element-wise operators.
+ *
+ * SM_OP_ABS: |v|.
+ * SM_OP_NEGATE: -v.
+ * SM_OP_SQUARE: v * v.
+ * SM_OP_SQRT: sqrt(v).
+ * SM_OP_RECIPROCAL: 1 / v.
+ */
+typedef enum sm_unary_op {
+        SM_OP_ABS,
+        SM_OP_NEGATE,
+        SM_OP_SQUARE,
+        SM_OP_SQRT,
+        SM_OP_RECIPROCAL
+} sm_unary_op;
+
+
+/*
+ * Enum: sm_reduce
+ * ----------------------------
+ * Reductions over the stored non-zeros; an empty row or column reduces to 0.
+ *
+ * SM_REDUCE_SUM: Sum of the values.
+ * SM_REDUCE_NORM1: Sum of |v|.
+ * SM_REDUCE_NORM2: Square root of the sum of v * v.
+ * SM_REDUCE_NORM_INF: Largest |v|.
+ * SM_REDUCE_MIN: Smallest value.
+ * SM_REDUCE_MAX: Largest value.
+ * SM_REDUCE_NNZ: Number of stored values.
+ */
+typedef enum sm_reduce {
+        SM_REDUCE_SUM,
+        SM_REDUCE_NORM1,
+        SM_REDUCE_NORM2,
+        SM_REDUCE_NORM_INF,
+        SM_REDUCE_MIN,
+        SM_REDUCE_MAX,
+        SM_REDUCE_NNZ
+} sm_reduce;
+
+
+/*
+ * Type: sm_map_fn
+ * ----------------------------
+ * User function applied to each stored value.
+ *
+ * value: The stored value.
+ * ctx: Caller context passed through the map call.
+ *
+ * Returns the new value.
+ */
+typedef double (*sm_map_fn)(double value, void* ctx);
+
+
+/*
+ * Function: csr_scale
+ * ----------------------------
+ * Multiplies every stored value by a constant.
+ *
+ * @param A - Pointer to the CSR matrix.
+ * @param alpha - Scale factor.
+ * @param threads - Number of threads, or 0 for one per online CPU.
+ */
+void csr_scale(csr_matrix* A, double alpha, uint32_t threads);
+
+
+/*
+ * Function: csr_apply
+ * ----------------------------
+ * Applies a predefined operator to every stored value.
+ *
+ * @param A - Pointer to the CSR matrix.
+ * @param op - The operator.
+ * @param threads - Number of threads, or 0 for one per online CPU.
+ */
+void csr_apply(csr_matrix* A, sm_unary_op op, uint32_t threads);
+
+
+/*
+ * Function: csr_map
+ * ----------------------------
+ * Applies a user function to every stored value.
+ *
+ * @param A - Pointer to the CSR matrix.
+ * @param fn - The function; it is called concurrently from several threads.
+ * @param ctx - Caller context passed to fn.
+ * @param threads - Number of threads, or 0 for one per online CPU.
+ */
+void csr_map(csr_matrix* A, sm_map_fn fn, void* ctx, uint32_t threads);
+
+
+/*
+ * Function: csr_prune
+ * ----------------------------
+ * Drops the stored values with |v| < eps, and any stored zeros, compacting the arrays in place.
+ *
+ * @param A - Pointer to the CSR matrix.
+ * @param eps - Threshold.
+ *
+ * @return Number of entries dropped.
+ */
+uint64_t csr_prune(csr_matrix* A, double eps);
+
+
+/*
+ * Function: csr_reduce
+ * ----------------------------
+ * Reduces all stored values to one number.
+ *
+ * @param A - Pointer to the CSR matrix.
+ * @param kind - The reduction.
+ * @param threads - Number of threads, or 0 for one per online CPU.
+ *
+ * @return The reduced value (0 for an empty matrix).
+ */
+double csr_reduce(csr_matrix* A, sm_reduce kind, uint32_t threads);
+
+
+/*
+ * Function: csr_row_reduce
+ * ----------------------------
+ * Reduces each row to one number.
+ *
+ * @param A - Pointer to the CSR matrix.
+ * @param kind - The reduction.
+ * @param out - Output vector of A->row entries.
+ * @param threads - Number of threads, or 0 for one per online CPU.
+ */
+void csr_row_reduce(csr_matrix* A, sm_reduce kind, double* out, uint32_t threads);
+
+
+/*
+ * Function: csr_column_reduce
+ * ----------------------------
+ * Reduces each column to one number.
+ *
+ * @param A - Pointer to the CSR matrix.
+ * @param kind - The reduction.
+ * @param out - Output vector of A->col entries.
+ * @param threads - Number of threads, or 0 for one per online CPU.
+ *
+ * @return true on success, false if the per-thread partial columns can not be allocated.
+ */
+bool csr_column_reduce(csr_matrix* A, sm_reduce kind, double* out, uint32_t threads);
+
+
+/*
+ * Function: scale_S_Matrix
+ * ----------------------------
+ * Multiplies every stored value of a linked matrix by a constant.
+ *
+ * @param M - Pointer to the matrix.
+ * @param alpha - Scale factor; 0 empties the matrix.
+ */
+void scale_S_Matrix(matrix* M, double alpha);
+
+
+/*
+ * Function: apply_S_Matrix
+ * ----------------------------
+ * Applies a predefined operator to every stored value of a linked matrix.
+ *
+ * @param M - Pointer to the matrix.
+ * @param op - The operator; entries that become 0 are removed.
+ */
+void apply_S_Matrix(matrix* M, sm_unary_op op);
+
+
+/*
+ * Function: map_S_Matrix
+ * ----------------------------
+ * Applies a user function to every stored value of a linked matrix.
+ *
+ * @param M - Pointer to the matrix.
+ * @param fn - The function; entries it maps to 0 are removed.
+ * @param ctx - Caller context passed to fn.
+ */
+void map_S_Matrix(matrix* M, sm_map_fn fn, void* ctx);
+
+
+/*
+ * Function: prune_S_Matrix
+ * ----------------------------
+ * Removes the entries with |v| < eps from a linked matrix.
+ *
+ * @param M - Pointer to the matrix.
+ * @param eps - Threshold.
+ *
+ * @return Number of entries removed.
+ */
+uint64_t prune_S_Matrix(matrix* M, double eps);
+
+
+/*
+ * Function: row_reduce_S_Matrix
+ * ----------------------------
+ * Reduces each row of a linked matrix to one number.
+ *
+ * @param M - Pointer to the matrix.
+ * @param kind - The reduction.
+ * @param out - Output vector of M->row entries.
+ */
+void row_reduce_S_Matrix(matrix* M, sm_reduce kind, double* out);
+
+
+/*
+ * Function: column_reduce_S_Matrix
+ * ----------------------------
+ * Reduces each column of a linked matrix to one number, walking the column chains.
+ *
+ * @param M - Pointer to the matrix.
+ * @param kind - The reduction.
+ * @param out - Output vector of M->col entries.
+ */
+void column_reduce_S_Matrix(matrix* M, sm_reduce kind, double* out);
+
+
+#endif // S_MATRIX_ELEMENTWISE_H
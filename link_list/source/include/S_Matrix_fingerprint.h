@@ -0,0 +1,78 @@
+/*
+ * File Name: S_Matrix_fingerprint.h
+ * Authors: Arpit Patel, Dharm KaPatel
+ * Date: 2025-03-19
+ * Description: This file defines content equality and content fingerprints of the S_Matrix data
+ *              structure, so identical matrices can be found without comparing them element by
+ *              element. Both run in parallel over blocks of rows.
+ *
+ * Both look at the logical contents: a symmetric matrix equals, and fingerprints like, the
+ * general matrix holding both of its triangles. Values are compared by their bit pattern.
+ */
+
+
+#ifndef S_MATRIX_FINGERPRINT_H
+#define S_MATRIX_FINGERPRINT_H
+
+
+// Include necessary headers
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "S_Matrix.h"
+
+
+/*
+ * Struct: sm_fingerprint
+ * ----------------------------
+ * 128-bit content hash of a matrix.
+ *
+ * lo: Low 64 bits.
+ * hi: High 64 bits.
+ */
+typedef struct sm_fingerprint {
+        uint64_t lo;
+        uint64_t hi;
+} sm_fingerprint;
+
+
+/*
+ * Function: matrix_equal
+ * ----------------------------
+ * Checks whether two matrices have the same dimensions and the same values at the same positions.
+ *
+ * @param A - Pointer to the first matrix.
+ * @param B - Pointer to the second matrix.
+ * @param threads - Number of threads, or 0 for one per online CPU.
+ *
+ * @return true if the matrices are equal (two NULL matrices are), false otherwise.
+ *
+ * Description:
+ *   Each thread walks the row chains of a block of rows of both matrices in lockstep and all
+ *   threads stop at the first difference. A symmetric matrix compared with a general one is
+ *   expanded to CSR form first.
+ */
+bool matrix_equal(matrix* A, matrix* B, uint32_t threads);
+
+
+/*
+ * Function: fingerprint_S_Matrix
+ * ----------------------------
+ * Computes the content hash of a matrix.
+ *
+ * @param M - Pointer to the matrix.
+ * @param threads - Number of threads, or 0 for one per online CPU.
+ *
+ * @return The fingerprint; {0, 0} for NULL.
+ *
+ * Description:
+ *   Every (row, column, value) entry is hashed on its own, eight entries at a time in SIMD
+ *   lanes, and the entry hashes are added up, so the result does not depend on insertion
+ *   order, storage history or the thread split. The dimensions and the number of entries are
+ *   mixed in at the end. Equal matrices always have equal fingerprints; different matrices
+ *   collide with probability about 2^-128, so a match can be confirmed with matrix_equal().
+ */
+sm_fingerprint fingerprint_S_Matrix(matrix* M, uint32_t threads);
+
+
+#endif // S_MATRIX_FINGERPRINT_H
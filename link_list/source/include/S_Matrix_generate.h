@@ -0,0 +1,114 @@
+/*
+ * File Name: S_Matrix_generate.h
+ * Authors: Arpit Patel, Dharm KaPatel
+ * Date: 2025-03-19
+ * Description: This file defines the bulk generators of the S_Matrix data structure: the Kronecker
+ *              product and R-MAT, Erdős–Rényi and k-diagonal matrices. Each one fills a CSR form
+ *              in parallel, sized exactly before anything is written, and links it into a matrix
+ *              in parallel, so no element goes through insert_data.
+ *
+ * The random generators draw every row (Erdős–Rényi) or every edge (R-MAT) from its own
+ * counter-based stream derived from the seed, so a seed gives the same matrix for any
+ * thread count.
+ */
+
+
+#ifndef S_MATRIX_GENERATE_H
+#define S_MATRIX_GENERATE_H
+
+
+// Include necessary headers
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "S_Matrix.h"
+
+
+/*
+ * Function: kron_S_Matrix
+ * ----------------------------
+ * Computes the Kronecker product A ⊗ B.
+ *
+ * @param A - Pointer to the left matrix.
+ * @param B - Pointer to the right matrix.
+ * @param threads - Number of threads, or 0 for one per online CPU.
+ *
+ * @return Pointer to the (A->row * B->row) x (A->col * B->col) matrix, or NULL if an input is
+ *         missing, the dimensions do not fit in 32 bits or allocation fails.
+ *
+ * Description:
+ *   Output row (i - 1) * B->row + k holds row i of A times row k of B, so its length is known
+ *   before it is written and the columns come out sorted. Symmetric inputs are expanded; the
+ *   result is a general matrix with nnz(A) * nnz(B) entries.
+ */
+matrix* kron_S_Matrix(matrix* A, matrix* B, uint32_t threads);
+
+
+/*
+ * Function: generate_rmat
+ * ----------------------------
+ * Generates an R-MAT graph adjacency matrix.
+ *
+ * @param scale - log2 of the number of vertices, at most 31.
+ * @param edges - Number of edges to draw.
+ * @param a - Probability of the top left quadrant.
+ * @param b - Probability of the top right quadrant.
+ * @param c - Probability of the bottom left quadrant; the bottom right one gets 1 - a - b - c.
+ * @param seed - Seed of the random streams.
+ * @param threads - Number of threads, or 0 for one per online CPU.
+ *
+ * @return Pointer to the 2^scale x 2^scale matrix, or NULL on invalid parameters or
+ *         allocation failure.
+ *
+ * Description:
+ *   Each edge descends scale levels of the recursive quadrant split. Edges drawn more than once
+ *   are stored once, so the matrix holds at most edges entries, all 1.0. The Graph500 kernel
+ *   uses a = 0.57, b = c = 0.19.
+ */
+matrix* generate_rmat(uint32_t scale, uint64_t edges, double a, double b, double c, uint64_t seed, uint32_t threads);
+
+
+/*
+ * Function: generate_erdos_renyi
+ * ----------------------------
+ * Generates a G(n, p) style random matrix where every position is present independently.
+ *
+ * @param rows - Number of rows.
+ * @param columns - Number of columns.
+ * @param p - Probability of each position.
+ * @param seed - Seed of the random streams.
+ * @param threads - Number of threads, or 0 for one per online CPU.
+ *
+ * @return Pointer to the matrix with entries of 1.0, or NULL on invalid parameters or
+ *         allocation failure.
+ *
+ * Description:
+ *   Rows skip from one entry to the next with geometrically distributed gaps, so the cost is
+ *   O(rows + nnz) rather than O(rows * columns). Each row is drawn twice, once to count and once
+ *   to fill, from the same stream.
+ */
+matrix* generate_erdos_renyi(uint32_t rows, uint32_t columns, double p, uint64_t seed, uint32_t threads);
+
+
+/*
+ * Function: generate_diagonals
+ * ----------------------------
+ * Generates a banded matrix with constant values along chosen diagonals.
+ *
+ * @param rows - Number of rows.
+ * @param columns - Number of columns.
+ * @param offsets - Diagonal of each value as column - row (0 is the main diagonal).
+ * @param values - Value of each diagonal; a zero leaves its diagonal empty.
+ * @param count - Number of diagonals.
+ * @param threads - Number of threads, or 0 for one per online CPU.
+ *
+ * @return Pointer to the matrix, or NULL if an offset repeats or allocation fails.
+ *
+ * Description:
+ *   The offsets may come in any order. A tridiagonal matrix is offsets {-1, 0, 1}.
+ */
+matrix* generate_diagonals(uint32_t rows, uint32_t columns, const int64_t* offsets, const double* values,
+                           uint32_t count, uint32_t threads);
+
+
+#endif // S_MATRIX_GENERATE_H
@@ -0,0 +1,242 @@
+/*
+ * File Name: S_Matrix_mmap.h
+ * Authors: Arpit Patel, Dharm KaPatel
+ * Date: 2025-03-19
+ * Description: This file defines a file-backed, memory-mapped sparse matrix for data larger than RAM.
+ *              Rows are stored as records appended to a data file and located through a row-offset
+ *              index kept in a second file (<path>.idx). The kernel pages records in on demand.
+ *
+ * Data file layout:
+ *   mm_header, then one record per appended row:
+ *   [row u32][nnz u32][values double x nnz][columns u32 x nnz][padding to 8 bytes]
+ *
+ * Index file layout:
+ *   uint64_t offset of the newest record of each row, indexed by row (0 means empty).
+ */
+
+
+#ifndef S_MATRIX_MMAP_H
+#define S_MATRIX_MMAP_H
+
+
+// Include necessary headers
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "S_Matrix.h"
+#include "S_Matrix_buffered.h"
+
+
+/*
+ * Struct: mm_header
+ * ----------------------------
+ * Header at the start of the data file.
+ *
+ * magic: File signature "SMMAP01".
+ * row: The number of rows in the matrix.
+ * col: The number of columns in the matrix.
+ * end: Offset one past the last record.
+ */
+typedef struct mm_header {
+        char magic[8];
+        uint32_t row;
+        uint32_t col;
+        uint64_t end;
+} mm_header;
+
+
+/*
+ * Struct: mm_matrix
+ * ----------------------------
+ * Represents an open file-backed matrix.
+ *
+ * data_fd: Descriptor of the data file.
+ * index_fd: Descriptor of the index file.
+ * data: Mapping of the data file.
+ * data_size: Length of the data mapping in bytes.
+ * index: Mapping of the index file.
+ * index_rows: Number of rows the index mapping covers.
+ * writable: Whether rows can be appended.
+ */
+typedef struct mm_matrix {
+        int data_fd;
+        int index_fd;
+        uint8_t* data;
+        uint64_t data_size;
+        uint64_t* index;
+        uint64_t index_rows;
+        bool writable;
+} mm_matrix;
+
+
+/*
+ * Function: mm_create
+ * ----------------------------
+ * Creates (or truncates) a file-backed matrix.
+ *
+ * @param path - Path of the data file; the index is written to <path>.idx.
+ * @param rows - Number of rows.
+ * @param columns - Number of columns.
+ *
+ * @return Pointer to the writable matrix, or NULL if the files can not be created.
+ */
+mm_matrix* mm_create(const char* path, uint32_t rows, uint32_t columns);
+
+
+/*
+ * Function: mm_open
+ * ----------------------------
+ * Opens an existing file-backed matrix.
+ *
+ * @param path - Path of the data file.
+ * @param writable - Whether rows will be appended.
+ *
+ * @return Pointer to the matrix, or NULL if the files can not be opened or are not valid.
+ *
+ * Description:
+ *   The header and every index entry are checked: each record, with the size its nnz
+ *   implies, must lie inside the written part of the data file. A truncated or corrupt
+ *   file is rejected here instead of making later reads leave the mapping.
+ */
+mm_matrix* mm_open(const char* path, bool writable);
+
+
+/*
+ * Function: mm_rows
+ * ----------------------------
+ * Gets the number of rows of a file-backed matrix.
+ *
+ * @param F - Pointer to the file-backed matrix.
+ *
+ * @return Number of rows.
+ */
+uint32_t mm_rows(mm_matrix* F);
+
+
+/*
+ * Function: mm_columns
+ * ----------------------------
+ * Gets the number of columns of a file-backed matrix.
+ *
+ * @param F - Pointer to the file-backed matrix.
+ *
+ * @return Number of columns.
+ */
+uint32_t mm_columns(mm_matrix* F);
+
+
+/*
+ * Function: mm_append_row
+ * ----------------------------
+ * Appends the contents of one row to the end of the data file.
+ *
+ * @param F - Pointer to the writable file-backed matrix.
+ * @param row - Row index; rows past the current last row extend the matrix.
+ * @param cols - Column indices (1-based), strictly increasing.
+ * @param values - Non-zero values.
+ * @param nnz - Number of entries.
+ *
+ * @return SM_OK, SM_ERR_NOT_CREATED, SM_ERR_INVALID_ARG (read-only or unsorted columns),
+ *         SM_ERR_OUT_OF_BOUNDS, SM_ERR_ZERO_VALUE or SM_ERR_NO_MEMORY (the files can not grow).
+ *
+ * Description:
+ *   Nothing already written is rewritten: the record goes to the end of the data file and
+ *   the row's index slot is pointed at it. Appending a row again replaces its contents.
+ *   Pointers returned by mm_row are invalid after an append.
+ */
+sm_status mm_append_row(mm_matrix* F, uint32_t row, const uint32_t* cols, const double* values, uint32_t nnz);
+
+
+/*
+ * Function: mm_row
+ * ----------------------------
+ * Gets a row without copying; the pages are read in when first touched.
+ *
+ * @param F - Pointer to the file-backed matrix.
+ * @param row - Row index.
+ * @param cols - Output pointer to the row's column indices.
+ * @param values - Output pointer to the row's values.
+ *
+ * @return Number of non-zeros in the row.
+ */
+uint32_t mm_row(mm_matrix* F, uint32_t row, const uint32_t** cols, const double** values);
+
+
+/*
+ * Function: mm_get
+ * ----------------------------
+ * Reads a single element by binary search within its row.
+ *
+ * @param F - Pointer to the file-backed matrix.
+ * @param row - Row index.
+ * @param column - Column index.
+ *
+ * @return The stored value, or 0 if the position is empty.
+ */
+double mm_get(mm_matrix* F, uint32_t row, uint32_t column);
+
+
+/*
+ * Function: mm_prefetch_rows
+ * ----------------------------
+ * Hints the kernel to start reading the records of a range of rows.
+ *
+ * @param F - Pointer to the file-backed matrix.
+ * @param first - First row of the range.
+ * @param last - Last row of the range.
+ */
+void mm_prefetch_rows(mm_matrix* F, uint32_t first, uint32_t last);
+
+
+/*
+ * Function: mm_scan
+ * ----------------------------
+ * Visits every non-zero in row-major order with sequential readahead enabled.
+ *
+ * @param F - Pointer to the file-backed matrix.
+ * @param visit - Callback receiving each non-zero.
+ * @param ctx - Caller context passed to the callback.
+ */
+void mm_scan(mm_matrix* F, sm_visit_fn visit, void* ctx);
+
+
+/*
+ * Function: mm_save_S_Matrix
+ * ----------------------------
+ * Writes a linked matrix to a new file-backed matrix, one row at a time.
+ *
+ * @param path - Path of the data file.
+ * @param M - Pointer to the matrix.
+ *
+ * @return true on success, false on I/O or allocation failure.
+ *
+ * Description:
+ *   A symmetric matrix is written with both triangles, so the file readers and
+ *   S_Matrix_from_mm see the full matrix.
+ */
+bool mm_save_S_Matrix(const char* path, matrix* M);
+
+
+/*
+ * Function: S_Matrix_from_mm
+ * ----------------------------
+ * Loads a file-backed matrix into a linked matrix.
+ *
+ * @param F - Pointer to the file-backed matrix.
+ *
+ * @return Pointer to the matrix, or NULL if a record holds invalid columns or allocation fails.
+ */
+matrix* S_Matrix_from_mm(mm_matrix* F);
+
+
+/*
+ * Function: mm_close
+ * ----------------------------
+ * Flushes and closes a file-backed matrix.
+ *
+ * @param F - Pointer to the file-backed matrix.
+ */
+void mm_close(mm_matrix* F);
+
+
+#endif // S_MATRIX_MMAP_H
@@ -0,0 +1,223 @@
+/*
+ * File Name: S_Matrix_numa.h
+ * Authors: Arpit Patel, Dharm KaPatel
+ * Date: 2025-03-19
+ * Description: This file defines the NUMA-partitioned form of the S_Matrix data structure.
+ *              Rows are split into contiguous blocks, one per partition, and each block is
+ *              stored as CSR in memory placed on its partition's NUMA node. The parallel kernels
+ *              run each block only on threads pinned to that node, so every node streams its
+ *              own memory.
+ *
+ * Vectors are plain arrays indexed from 0: entry i belongs to row (or column) i + 1.
+ */
+
+
+#ifndef S_MATRIX_NUMA_H
+#define S_MATRIX_NUMA_H
+
+
+// Include necessary headers
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "S_Matrix.h"
+#include "S_Matrix_csr.h"
+
+
+// Most NUMA nodes taken from the system topology
+#define SM_NUMA_MAX_NODES 64
+
+
+/*
+ * Enum: sm_numa_placement
+ * ----------------------------
+ * How partition memory is put on its node.
+ *
+ * SM_NUMA_FIRST_TOUCH: A thread pinned to the node writes the memory first, so the kernel's
+ *                      default policy places the pages there.
+ * SM_NUMA_BIND: The memory is also bound to the node with mbind() before it is written; if
+ *               the kernel refuses, first touch is used alone.
+ */
+typedef enum sm_numa_placement {
+        SM_NUMA_FIRST_TOUCH,
+        SM_NUMA_BIND
+} sm_numa_placement;
+
+
+/*
+ * Struct: n_partition
+ * ----------------------------
+ * One row block of a partitioned matrix.
+ *
+ * home: Node the block's memory was placed on.
+ * node: Node whose CPUs run the block; equal to home unless changed by the caller, which
+ *       moves the work but not the data (the benchmark uses this to measure remote access).
+ * first_row: First row of the block (1-based).
+ * rows: Number of rows in the block.
+ * nnz: Number of non-zeros in the block.
+ * threads: Number of threads that work on the block.
+ * row_ptr: Offsets into col_idx/values, local to the block; row first_row + i occupies
+ *          [row_ptr[i], row_ptr[i + 1]).
+ * col_idx: Column index (1-based) of each non-zero, increasing within a row.
+ * values: Value of each non-zero.
+ * region: Start of the mapping holding the three arrays.
+ * region_bytes: Length of the mapping.
+ * bound: Whether the memory was bound with mbind().
+ */
+typedef struct n_partition {
+        uint32_t home;
+        uint32_t node;
+        uint32_t first_row;
+        uint32_t rows;
+        uint64_t nnz;
+        uint32_t threads;
+        uint64_t* row_ptr;
+        uint32_t* col_idx;
+        double* values;
+        void* region;
+        size_t region_bytes;
+        bool bound;
+} n_partition;
+
+
+/*
+ * Struct: n_matrix
+ * ----------------------------
+ * Represents a read-only sparse matrix partitioned across NUMA nodes.
+ *
+ * row: The number of rows in the matrix.
+ * col: The number of columns in the matrix.
+ * nnz: Number of non-zeros.
+ * partition_count: Number of row blocks.
+ * partitions: The row blocks, in row order.
+ */
+typedef struct n_matrix {
+        uint32_t row;
+        uint32_t col;
+        uint64_t nnz;
+        uint32_t partition_count;
+        n_partition* partitions;
+} n_matrix;
+
+
+/*
+ * Function: numa_node_count
+ * ----------------------------
+ * Gets the number of NUMA nodes this process can use.
+ *
+ * @return Number of nodes, 1 when the system exposes no topology.
+ */
+uint32_t numa_node_count(void);
+
+
+/*
+ * Function: numa_node_cpus
+ * ----------------------------
+ * Gets the number of CPUs of a node that this process may run on.
+ *
+ * @param node - The node.
+ *
+ * @return Number of CPUs, 0 if the node does not exist.
+ */
+uint32_t numa_node_cpus(uint32_t node);
+
+
+/*
+ * Function: numa_pin_thread
+ * ----------------------------
+ * Restricts the calling thread to the CPUs of a node.
+ *
+ * @param node - The node.
+ *
+ * @return true on success, false if the node does not exist or the affinity can not be set.
+ */
+bool numa_pin_thread(uint32_t node);
+
+
+/*
+ * Function: numa_from_csr
+ * ----------------------------
+ * Builds a partitioned matrix from a CSR matrix.
+ *
+ * @param A - Pointer to the CSR matrix.
+ * @param partitions - Number of row blocks, or 0 for one per node.
+ * @param threads - Total threads for the kernels, or 0 for every CPU of each node.
+ * @param placement - How block memory is placed.
+ *
+ * @return Pointer to the partitioned matrix, or NULL on invalid input or allocation failure.
+ *
+ * Description:
+ *   Row blocks hold about the same number of non-zeros; block p goes to node p modulo the
+ *   node count. Each block is copied by a thread pinned to its node. With an explicit thread
+ *   count the threads are shared evenly between the blocks, each getting at least one.
+ */
+n_matrix* numa_from_csr(csr_matrix* A, uint32_t partitions, uint32_t threads, sm_numa_placement placement);
+
+
+/*
+ * Function: numa_from_S_Matrix
+ * ----------------------------
+ * Builds a partitioned matrix from a linked matrix (symmetric storage is expanded).
+ *
+ * @param M - Pointer to the matrix.
+ * @param partitions - Number of row blocks, or 0 for one per node.
+ * @param threads - Total threads for the kernels, or 0 for every CPU of each node.
+ * @param placement - How block memory is placed.
+ *
+ * @return Pointer to the partitioned matrix, or NULL on invalid input or allocation failure.
+ */
+n_matrix* numa_from_S_Matrix(matrix* M, uint32_t partitions, uint32_t threads, sm_numa_placement placement);
+
+
+/*
+ * Function: nm_spmv
+ * ----------------------------
+ * Computes y = N x, running each block on threads pinned to its node.
+ *
+ * @param N - Pointer to the partitioned matrix.
+ * @param x - Input vector of N->col entries.
+ * @param y - Output vector of N->row entries.
+ *
+ * @return true on success, false on invalid input.
+ */
+bool nm_spmv(n_matrix* N, const double* x, double* y);
+
+
+/*
+ * Function: nm_get
+ * ----------------------------
+ * Looks up a single element.
+ *
+ * @param N - Pointer to the partitioned matrix.
+ * @param row - Row index.
+ * @param column - Column index.
+ *
+ * @return The stored value, or 0 if the position is empty or out of bounds.
+ */
+double nm_get(n_matrix* N, uint32_t row, uint32_t column);
+
+
+/*
+ * Function: csr_from_numa
+ * ----------------------------
+ * Gathers a partitioned matrix back into one CSR matrix.
+ *
+ * @param N - Pointer to the partitioned matrix.
+ *
+ * @return Pointer to the CSR matrix, or NULL on invalid input or allocation failure.
+ */
+csr_matrix* csr_from_numa(n_matrix* N);
+
+
+/*
+ * Function: free_numa_matrix
+ * ----------------------------
+ * Frees a partitioned matrix.
+ *
+ * @param N - Pointer to the partitioned matrix.
+ */
+void free_numa_matrix(n_matrix* N);
+
+
+#endif // S_MATRIX_NUMA_H
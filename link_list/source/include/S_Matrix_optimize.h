@@ -0,0 +1,174 @@
+/*
+ * File Name: S_Matrix_optimize.h
+ * Authors: Arpit Patel, Dharm KaPatel
+ * Date: 2025-03-19
+ * Description: This file defines the format auto-tuner of the S_Matrix data structure.
+ *              matrix_optimize() analyzes a matrix, builds the layouts that suit the declared
+ *              workload and, for product workloads, times each candidate layout and thread count
+ *              for a few runs before keeping the fastest. The result is a read-only plan that
+ *              runs the chosen kernel.
+ *
+ * Vectors are plain arrays indexed from 0: entry i belongs to row (or column) i + 1.
+ */
+
+
+#ifndef S_MATRIX_OPTIMIZE_H
+#define S_MATRIX_OPTIMIZE_H
+
+
+// Include necessary headers
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "S_Matrix.h"
+#include "S_Matrix_csr.h"
+#include "S_Matrix_compressed.h"
+#include "S_Matrix_analyze.h"
+
+
+// Rows the analyzer examines before it switches to sampling
+#define SM_OPTIMIZE_SAMPLE 65536
+
+// Below this many non-zeros the defaults are used without timing anything
+#define SM_CALIBRATE_MIN_NNZ 65536
+
+// Timed runs per candidate; the fastest run counts
+#define SM_CALIBRATE_RUNS 3
+
+
+/*
+ * Enum: sm_workload
+ * ----------------------------
+ * What the caller will do with the matrix.
+ *
+ * SM_WORKLOAD_SPMV: Repeated products with one vector.
+ * SM_WORKLOAD_SPMM: Repeated products with blocks of vectors.
+ * SM_WORKLOAD_RANDOM_ACCESS: Point reads.
+ * SM_WORKLOAD_ARCHIVE: Rare reads; memory matters most.
+ */
+typedef enum sm_workload {
+        SM_WORKLOAD_SPMV,
+        SM_WORKLOAD_SPMM,
+        SM_WORKLOAD_RANDOM_ACCESS,
+        SM_WORKLOAD_ARCHIVE
+} sm_workload;
+
+
+/*
+ * Enum: sm_format
+ * ----------------------------
+ * Layouts a plan can choose.
+ *
+ * SM_FORMAT_CSR: CSR, with the register-blocked kernel for blocks of vectors.
+ * SM_FORMAT_CSR_REORDERED: CSR of the Reverse Cuthill-McKee permutation, for wide-band matrices.
+ * SM_FORMAT_COMPRESSED: Compressed read-only form (z_matrix).
+ */
+typedef enum sm_format {
+        SM_FORMAT_CSR,
+        SM_FORMAT_CSR_REORDERED,
+        SM_FORMAT_COMPRESSED
+} sm_format;
+
+
+/*
+ * Struct: sm_plan
+ * ----------------------------
+ * A layout and kernel chosen for one matrix and workload.
+ *
+ * format: The chosen layout.
+ * threads: Number of threads the kernels run with.
+ * stats: Structure statistics the choice was based on.
+ * csr: CSR form (SM_FORMAT_CSR and SM_FORMAT_CSR_REORDERED).
+ * compressed: Compressed form (SM_FORMAT_COMPRESSED).
+ * row_perm, col_perm: Permutations of the reordered form, new to old (1-based).
+ * row_inverse, col_inverse: The same permutations, old to new (1-based).
+ */
+typedef struct sm_plan {
+        sm_format format;
+        uint32_t threads;
+        sm_structure stats;
+        csr_matrix* csr;
+        z_matrix* compressed;
+        uint32_t* row_perm;
+        uint32_t* col_perm;
+        uint32_t* row_inverse;
+        uint32_t* col_inverse;
+} sm_plan;
+
+
+/*
+ * Function: matrix_optimize
+ * ----------------------------
+ * Chooses and builds the layout and kernel for a matrix and workload.
+ *
+ * @param M - Pointer to the matrix; it is copied, so it can change or be freed afterwards.
+ * @param hint - The expected workload.
+ *
+ * @return Pointer to the plan, or NULL if M is NULL or allocation fails.
+ *
+ * Description:
+ *   SM_WORKLOAD_ARCHIVE always compresses and SM_WORKLOAD_RANDOM_ACCESS uses CSR. For the
+ *   product workloads CSR is always a candidate. The RCM reordering is one for a square matrix
+ *   whose bandwidth exceeds a quarter of the dimension (half when the matrix is not symmetric)
+ *   and whose row histogram has no heavy tail of long rows. The compressed form is one for SpMV
+ *   when the values fit a one-byte dictionary or at least half of the occupied blocks' cells
+ *   are filled. With at least SM_CALIBRATE_MIN_NNZ non-zeros every candidate is timed with one
+ *   thread and with all CPUs; otherwise plain CSR on one thread is kept.
+ */
+sm_plan* matrix_optimize(matrix* M, sm_workload hint);
+
+
+/*
+ * Function: plan_spmv
+ * ----------------------------
+ * Computes y = M x with the plan's kernel.
+ *
+ * @param P - Pointer to the plan.
+ * @param x - Input vector of M->col entries.
+ * @param y - Output vector of M->row entries.
+ *
+ * @return true on success, false on invalid input or allocation failure.
+ */
+bool plan_spmv(sm_plan* P, const double* x, double* y);
+
+
+/*
+ * Function: plan_spmm
+ * ----------------------------
+ * Computes Y = M X for a row-major block of k vectors with the plan's kernel.
+ *
+ * @param P - Pointer to the plan.
+ * @param X - Input block, M->col rows of k entries.
+ * @param k - Number of vectors.
+ * @param Y - Output block, M->row rows of k entries; overwritten.
+ *
+ * @return true on success, false on invalid input or allocation failure.
+ */
+bool plan_spmm(sm_plan* P, const double* X, uint32_t k, double* Y);
+
+
+/*
+ * Function: plan_get
+ * ----------------------------
+ * Reads one element through the plan's layout.
+ *
+ * @param P - Pointer to the plan.
+ * @param row - Row index.
+ * @param column - Column index.
+ *
+ * @return The value, or 0 if the position holds no value or is out of bounds.
+ */
+double plan_get(sm_plan* P, uint32_t row, uint32_t column);
+
+
+/*
+ * Function: free_plan
+ * ----------------------------
+ * Frees a plan and the layouts it built.
+ *
+ * @param P - Pointer to the plan.
+ */
+void free_plan(sm_plan* P);
+
+
+#endif // S_MATRIX_OPTIMIZE_H
@@ -0,0 +1,69 @@
+/*
+ * File Name: S_Matrix_parallel.h
+ * Authors: Arpit Patel, Dharm KaPatel
+ * Date: 2025-03-19
+ * Description: This file defines the small fork-join helper used by the parallel S_Matrix kernels.
+ *              A range of work items is split into one contiguous chunk per thread.
+ */
+
+
+#ifndef S_MATRIX_PARALLEL_H
+#define S_MATRIX_PARALLEL_H
+
+
+// Include necessary headers
+#include <stdint.h>
+
+
+// Ranges shorter than this run on the calling thread only
+#define SM_PARALLEL_GRAIN 4096
+
+
+/*
+ * Type: sm_range_fn
+ * ----------------------------
+ * Work function receiving one chunk of a parallel range.
+ *
+ * begin: First item of the chunk.
+ * end: One past the last item of the chunk.
+ * thread: Index of the chunk (0 .. threads - 1), usable to address per-thread partial results.
+ * ctx: Caller context passed through sm_parallel_for.
+ */
+typedef void (*sm_range_fn)(uint64_t begin, uint64_t end, uint32_t thread, void* ctx);
+
+
+/*
+ * Function: sm_thread_count
+ * ----------------------------
+ * Resolves a requested thread count.
+ *
+ * @param requested - Requested number of threads, or 0 for one per online CPU.
+ *
+ * @return Number of threads to use, at least 1.
+ */
+uint32_t sm_thread_count(uint32_t requested);
+
+
+/*
+ * Function: sm_parallel_for
+ * ----------------------------
+ * Runs a work function over [0, n) split into contiguous chunks, one per thread.
+ *
+ * @param n - Number of work items.
+ * @param threads - Number of threads (already resolved with sm_thread_count).
+ * @param fn - Work function.
+ * @param ctx - Caller context passed to fn.
+ *
+ * @return Number of chunks actually used; chunk indices passed to fn are below this value.
+ *
+ * Description:
+ *   The calling thread runs chunk 0 itself. If a worker thread can not be started its chunk
+ *   also runs on the calling thread, so the whole range is always processed. Worker threads
+ *   are started on first use and kept for later calls, so iterative solvers pay the thread
+ *   start-up once; a call made while another one is running (from a work function or from a
+ *   second thread) starts threads of its own.
+ */
+uint32_t sm_parallel_for(uint64_t n, uint32_t threads, sm_range_fn fn, void* ctx);
+
+
+#endif // S_MATRIX_PARALLEL_H
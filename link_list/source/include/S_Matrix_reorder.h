@@ -0,0 +1,109 @@
+/*
+ * File Name: S_Matrix_reorder.h
+ * Authors: Arpit Patel, Dharm KaPatel
+ * Date: 2025-03-19
+ * Description: This file defines bandwidth-reducing reorderings for the S_Matrix data structure.
+ *              An ordering renumbers rows and columns so that non-zeros which are used together
+ *              sit close together in memory; it is returned as permutation vectors and can be
+ *              applied to produce a permuted copy of the matrix.
+ *
+ * Permutation convention: perm[k] is the old (1-based) index of new index k + 1.
+ */
+
+
+#ifndef S_MATRIX_REORDER_H
+#define S_MATRIX_REORDER_H
+
+
+// Include necessary headers
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "S_Matrix.h"
+
+
+/*
+ * Enum: sm_ordering
+ * ----------------------------
+ * Available reorderings.
+ *
+ * SM_ORDER_RCM: Reverse Cuthill-McKee on the symmetrized structure; one numbering shared by rows and columns.
+ * SM_ORDER_DEGREE: Rows and columns independently sorted by their number of non-zeros.
+ * SM_ORDER_PARTITION: Recursive BFS bisection into clusters of at most SM_PARTITION_LEAF indices.
+ */
+typedef enum sm_ordering {
+        SM_ORDER_RCM,
+        SM_ORDER_DEGREE,
+        SM_ORDER_PARTITION
+} sm_ordering;
+
+
+// Largest cluster produced by SM_ORDER_PARTITION
+#define SM_PARTITION_LEAF 64
+
+
+/*
+ * Function: compute_ordering
+ * ----------------------------
+ * Computes row and column permutations for a matrix.
+ *
+ * @param M - Pointer to the matrix.
+ * @param kind - Reordering to compute.
+ * @param row_perm - Output array of M->row entries (caller frees).
+ * @param col_perm - Output array of M->col entries (caller frees).
+ *
+ * @return true on success, false if M is NULL or allocation fails.
+ *
+ * Description:
+ *   For SM_ORDER_RCM and SM_ORDER_PARTITION the graph has one vertex per index up to
+ *   max(rows, columns) and an edge for every off-diagonal non-zero, taken in both
+ *   directions. Rows and columns then follow the same vertex order.
+ */
+bool compute_ordering(matrix* M, sm_ordering kind, uint32_t** row_perm, uint32_t** col_perm);
+
+
+/*
+ * Function: permute_S_Matrix
+ * ----------------------------
+ * Builds a permuted copy of a matrix.
+ *
+ * @param M - Pointer to the matrix.
+ * @param row_perm - Row permutation (new to old), M->row entries.
+ * @param col_perm - Column permutation (new to old), M->col entries.
+ *
+ * @return Pointer to the permuted matrix, or NULL if a permutation is invalid or allocation fails.
+ *
+ * Description:
+ *   The copy of a symmetric matrix is a general matrix holding both triangles.
+ */
+matrix* permute_S_Matrix(matrix* M, const uint32_t* row_perm, const uint32_t* col_perm);
+
+
+/*
+ * Function: reorder_S_Matrix
+ * ----------------------------
+ * Computes an ordering and applies it in one call.
+ *
+ * @param M - Pointer to the matrix.
+ * @param kind - Reordering to compute.
+ * @param row_perm - Output row permutation (caller frees), or NULL if not needed.
+ * @param col_perm - Output column permutation (caller frees), or NULL if not needed.
+ *
+ * @return Pointer to the permuted matrix, or NULL on failure.
+ */
+matrix* reorder_S_Matrix(matrix* M, sm_ordering kind, uint32_t** row_perm, uint32_t** col_perm);
+
+
+/*
+ * Function: bandwidth_S_Matrix
+ * ----------------------------
+ * Computes the bandwidth of a matrix, the largest |row - column| over all non-zeros.
+ *
+ * @param M - Pointer to the matrix.
+ *
+ * @return The bandwidth, or 0 for an empty matrix.
+ */
+uint32_t bandwidth_S_Matrix(matrix* M);
+
+
+#endif // S_MATRIX_REORDER_H
@@ -0,0 +1,182 @@
+/*
+ * File Name: S_Matrix_semiring.h
+ * Authors: Arpit Patel, Dharm KaPatel
+ * Date: 2025-03-19
+ * Description: This file defines semiring sparse matrix kernels and the graph algorithms built on them.
+ *              A matrix is read as a directed graph with an edge i -> j of weight M(i, j) for every
+ *              non-zero. Products replace (+, x) with the (add, multiply) pair of a semiring, and
+ *              positions that are not stored hold the semiring's zero. A symmetric matrix is an
+ *              undirected graph: each stored entry is an edge in both directions.
+ *
+ * Vectors are plain arrays indexed from 0: entry i belongs to row (or column, or vertex) i + 1.
+ * Graph algorithms use max(rows, columns) vertices.
+ */
+
+
+#ifndef S_MATRIX_SEMIRING_H
+#define S_MATRIX_SEMIRING_H
+
+
+// Include necessary headers
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "S_Matrix.h"
+
+
+/*
+ * Enum: sm_semiring
+ * ----------------------------
+ * Available semirings, written as (add, multiply) with the zero in brackets.
+ *
+ * SM_SEMIRING_MIN_PLUS: (min, +) [+inf]; shortest paths.
+ * SM_SEMIRING_OR_AND: (or, and) [0]; reachability, any non-zero counts as true and results are 0 or 1.
+ * SM_SEMIRING_MAX_TIMES: (max, x) [0]; most reliable paths over non-negative weights.
+ */
+typedef enum sm_semiring {
+        SM_SEMIRING_MIN_PLUS,
+        SM_SEMIRING_OR_AND,
+        SM_SEMIRING_MAX_TIMES
+} sm_semiring;
+
+
+/*
+ * Enum: sm_direction
+ * ----------------------------
+ * Traversal direction of a vector-matrix product.
+ *
+ * SM_PUSH: Scatter from the non-zeros of the input along the row chains (rowList).
+ * SM_PULL: Gather into each unmasked output along the column chains (columnList).
+ * SM_AUTO: Push when the input touches few edges, pull otherwise.
+ */
+typedef enum sm_direction {
+        SM_PUSH,
+        SM_PULL,
+        SM_AUTO
+} sm_direction;
+
+
+// Push switches to pull when the frontier's edges exceed 1/SM_PULL_ALPHA of the unexplored edges
+#define SM_PULL_ALPHA 14
+
+// Pull switches back to push when the frontier is smaller than 1/SM_PUSH_BETA of the vertices
+#define SM_PUSH_BETA 24
+
+
+/*
+ * Function: semiring_zero
+ * ----------------------------
+ * Gets the additive identity of a semiring.
+ *
+ * @param s - The semiring.
+ *
+ * @return The semiring's zero.
+ */
+double semiring_zero(sm_semiring s);
+
+
+/*
+ * Function: semiring_mxv
+ * ----------------------------
+ * Matrix-vector product y = y (+) M (x) x over a semiring, walking the row chains.
+ *
+ * @param M - Pointer to the matrix.
+ * @param s - The semiring.
+ * @param x - Input vector of M->col entries.
+ * @param y - Accumulator of M->row entries; fill with semiring_zero() for a plain product.
+ * @param mask - Rows to compute (true), or NULL for all; other entries of y are left as they are.
+ *
+ * @return true on success, false on invalid input or allocation failure.
+ */
+bool semiring_mxv(matrix* M, sm_semiring s, const double* x, double* y, const bool* mask);
+
+
+/*
+ * Function: semiring_vxm
+ * ----------------------------
+ * Vector-matrix product y = y (+) x (x) M over a semiring.
+ *
+ * @param M - Pointer to the matrix.
+ * @param s - The semiring.
+ * @param x - Input vector of M->row entries.
+ * @param y - Accumulator of M->col entries; fill with semiring_zero() for a plain product.
+ * @param mask - Columns to compute (true), or NULL for all; other entries of y are left as they are.
+ * @param dir - Traversal direction; both give the same result.
+ *
+ * @return true on success, false on invalid input or allocation failure.
+ *
+ * Description:
+ *   Push visits only the rows whose x entry differs from the zero and costs their edges.
+ *   Pull visits the columns selected by the mask and, for (or, and), stops reading a
+ *   column at its first hit.
+ */
+bool semiring_vxm(matrix* M, sm_semiring s, const double* x, double* y, const bool* mask, sm_direction dir);
+
+
+/*
+ * Function: semiring_spgemm
+ * ----------------------------
+ * Matrix-matrix product A (+).(x) B over a semiring.
+ *
+ * @param A - Pointer to the left matrix.
+ * @param B - Pointer to the right matrix; B->row must equal A->col.
+ * @param s - The semiring.
+ *
+ * @return Pointer to the product, or NULL on a dimension mismatch or allocation failure.
+ *
+ * Description:
+ *   Only positions reached by at least one A(i, k) (x) B(k, j) are produced. Results equal
+ *   to 0 are dropped, since the linked matrix does not store zeros.
+ */
+matrix* semiring_spgemm(matrix* A, matrix* B, sm_semiring s);
+
+
+/*
+ * Function: bfs_S_Matrix
+ * ----------------------------
+ * Breadth-first search from a vertex with direction-optimizing (or, and) steps.
+ *
+ * @param M - Pointer to the matrix.
+ * @param source - Start vertex (1-based).
+ * @param level - Output array of max(rows, columns) entries: hop count from the source,
+ *                or UINT32_MAX for unreachable vertices.
+ *
+ * @return true on success, false on invalid input or allocation failure.
+ */
+bool bfs_S_Matrix(matrix* M, uint32_t source, uint32_t* level);
+
+
+/*
+ * Function: sssp_S_Matrix
+ * ----------------------------
+ * Single-source shortest paths by (min, +) relaxation (Bellman-Ford).
+ *
+ * @param M - Pointer to the matrix; negative weights are allowed.
+ * @param source - Start vertex (1-based).
+ * @param dist - Output array of max(rows, columns) entries: path length, or INFINITY if unreachable.
+ *
+ * @return true on success, false on invalid input, allocation failure or a negative cycle
+ *         reachable from the source.
+ *
+ * Description:
+ *   Each round relaxes only the edges leaving the vertices improved in the previous round,
+ *   switching to a pull over every column when that set is large.
+ */
+bool sssp_S_Matrix(matrix* M, uint32_t source, double* dist);
+
+
+/*
+ * Function: components_S_Matrix
+ * ----------------------------
+ * Labels the weakly connected components, following edges in both directions.
+ *
+ * @param M - Pointer to the matrix.
+ * @param component - Output array of max(rows, columns) entries: smallest vertex (1-based)
+ *                    of the component each vertex belongs to.
+ *
+ * @return Number of components, or 0 on invalid input or allocation failure.
+ */
+uint32_t components_S_Matrix(matrix* M, uint32_t* component);
+
+
+#endif // S_MATRIX_SEMIRING_H
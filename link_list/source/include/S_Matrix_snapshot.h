@@ -0,0 +1,272 @@
+/*
+ * File Name: S_Matrix_snapshot.h
+ * Authors: Arpit Patel, Dharm KaPatel
+ * Date: 2025-03-19
+ * Description: This file defines a versioned sparse matrix with copy-on-write snapshots.
+ *              A writer keeps inserting, resizing and transposing while readers hold consistent
+ *              snapshots taken in O(1). Rows are stored in reference counted blocks under a
+ *              tree of directory nodes; a write copies only the blocks it touches and the nodes
+ *              on their paths and publishes a new version, and a version is reclaimed when its
+ *              last reader releases it.
+ */
+
+
+#ifndef S_MATRIX_SNAPSHOT_H
+#define S_MATRIX_SNAPSHOT_H
+
+
+// Include necessary headers
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#include "S_Matrix.h"
+#include "S_Matrix_csr.h"
+#include "S_Matrix_buffered.h"
+
+
+// Rows per copy-on-write block, and children per directory node (a power of two)
+#define SM_BLOCK_ROWS 64
+#define SM_DIR_BITS 6
+#define SM_DIR_FANOUT (1 << SM_DIR_BITS)
+
+
+/*
+ * Struct: sm_row_block
+ * ----------------------------
+ * Immutable CSR slice holding SM_BLOCK_ROWS consecutive rows.
+ *
+ * refs: Number of directory nodes sharing this block.
+ * nnz: Number of non-zeros in the block.
+ * row_ptr: Offsets into col_idx/values for each row of the block.
+ * col_idx: Column index (1-based) of each non-zero.
+ * values: Value of each non-zero.
+ */
+typedef struct sm_row_block {
+        atomic_uint refs;
+        uint32_t nnz;
+        uint32_t row_ptr[SM_BLOCK_ROWS + 1];
+        uint32_t* col_idx;
+        double* values;
+} sm_row_block;
+
+
+/*
+ * Struct: sm_block_dir
+ * ----------------------------
+ * Immutable directory node of a version's tree. A node at level 1 holds row blocks, a node
+ * at a higher level holds nodes of the level below; a NULL child has no non-zeros.
+ *
+ * refs: Number of versions and parent nodes sharing this node.
+ * dirs: The child nodes, above level 1.
+ * blocks: The row blocks, at level 1.
+ */
+typedef struct sm_block_dir {
+        atomic_uint refs;
+        union {
+                struct sm_block_dir* dirs[SM_DIR_FANOUT];
+                sm_row_block* blocks[SM_DIR_FANOUT];
+        };
+} sm_block_dir;
+
+
+/*
+ * Struct: sm_snapshot
+ * ----------------------------
+ * One immutable version of the matrix.
+ *
+ * refs: Number of holders (the matrix itself and every reader).
+ * row: The number of rows in this version.
+ * col: The number of columns in this version.
+ * nnz: Number of non-zeros in this version.
+ * depth: Levels of directory nodes, the fewest whose blocks cover every row.
+ * root: The top directory node, or NULL if the version has no non-zeros.
+ */
+typedef struct sm_snapshot {
+        atomic_uint refs;
+        uint32_t row;
+        uint32_t col;
+        uint64_t nnz;
+        uint32_t depth;
+        sm_block_dir* root;
+} sm_snapshot;
+
+
+/*
+ * Struct: v_matrix
+ * ----------------------------
+ * Represents a versioned sparse matrix.
+ *
+ * current: The latest published version.
+ * publish_lock: Guards loading and replacing current; held only for a pointer swap or a reference count increment.
+ * writer_lock: Serializes writers.
+ */
+typedef struct v_matrix {
+        sm_snapshot* current;
+        pthread_mutex_t publish_lock;
+        pthread_mutex_t writer_lock;
+} v_matrix;
+
+
+/*
+ * Function: create_versioned_matrix
+ * ----------------------------
+ * Creates an empty versioned matrix.
+ *
+ * @param rows - Number of rows.
+ * @param columns - Number of columns.
+ *
+ * @return Pointer to the matrix, or NULL if allocation fails.
+ */
+v_matrix* create_versioned_matrix(uint32_t rows, uint32_t columns);
+
+
+/*
+ * Function: versioned_from_S_Matrix
+ * ----------------------------
+ * Creates a versioned matrix holding the contents of a linked matrix.
+ *
+ * @param M - Pointer to the matrix.
+ *
+ * @return Pointer to the versioned matrix, or NULL if allocation fails.
+ */
+v_matrix* versioned_from_S_Matrix(matrix* M);
+
+
+/*
+ * Function: vm_insert_data
+ * ----------------------------
+ * Inserts or updates a value and publishes a new version.
+ *
+ * @param V - Pointer to the versioned matrix.
+ * @param row - Row index.
+ * @param column - Column index.
+ * @param value - Value to be inserted.
+ *
+ * @return SM_OK, SM_ERR_NOT_CREATED, SM_ERR_ZERO_VALUE, SM_ERR_OUT_OF_BOUNDS or SM_ERR_NO_MEMORY.
+ *
+ * Description:
+ *   Copies the row block holding the position and the directory nodes on its path, so the
+ *   cost grows with log(rows); every other node and block is shared with the previous
+ *   version. Use vm_insert_batch to publish many inserts at once.
+ */
+sm_status vm_insert_data(v_matrix* V, uint32_t row, uint32_t column, double value);
+
+
+/*
+ * Function: vm_insert_batch
+ * ----------------------------
+ * Inserts or updates many values and publishes them as one new version.
+ *
+ * @param V - Pointer to the versioned matrix.
+ * @param entries - Array of triplets; it is filtered and sorted in place.
+ * @param count - Number of triplets.
+ *
+ * @return SM_OK, SM_ERR_NOT_CREATED or SM_ERR_NO_MEMORY (nothing is published).
+ *
+ * Description:
+ *   The last entry for a position wins. Zero values and out of bound positions are dropped.
+ */
+sm_status vm_insert_batch(v_matrix* V, sm_triplet* entries, uint64_t count);
+
+
+/*
+ * Function: vm_resize
+ * ----------------------------
+ * Doubles the dimensions and publishes a new version sharing every row block.
+ *
+ * @param V - Pointer to the versioned matrix.
+ *
+ * @return SM_OK, SM_ERR_NOT_CREATED, SM_ERR_OVERFLOW or SM_ERR_NO_MEMORY.
+ */
+sm_status vm_resize(v_matrix* V);
+
+
+/*
+ * Function: vm_transpose
+ * ----------------------------
+ * Transposes the matrix and publishes the result as a new version.
+ *
+ * @param V - Pointer to the versioned matrix.
+ *
+ * @return SM_OK, SM_ERR_NOT_CREATED or SM_ERR_NO_MEMORY.
+ *
+ * Description:
+ *   Every row block changes, so this builds the new version in O(nnz + rows); snapshots of
+ *   the old orientation stay valid.
+ */
+sm_status vm_transpose(v_matrix* V);
+
+
+/*
+ * Function: snapshot
+ * ----------------------------
+ * Takes a consistent read-only view of the current version in O(1).
+ *
+ * @param V - Pointer to the versioned matrix.
+ *
+ * @return Pointer to the snapshot; release it with release_snapshot.
+ */
+sm_snapshot* snapshot(v_matrix* V);
+
+
+/*
+ * Function: snapshot_get
+ * ----------------------------
+ * Reads a single element of a snapshot.
+ *
+ * @param S - Pointer to the snapshot.
+ * @param row - Row index.
+ * @param column - Column index.
+ *
+ * @return The stored value, or 0 if the position is empty.
+ */
+double snapshot_get(sm_snapshot* S, uint32_t row, uint32_t column);
+
+
+/*
+ * Function: snapshot_scan
+ * ----------------------------
+ * Visits every non-zero of a snapshot in row-major order.
+ *
+ * @param S - Pointer to the snapshot.
+ * @param visit - Callback receiving each non-zero.
+ * @param ctx - Caller context passed to the callback.
+ */
+void snapshot_scan(sm_snapshot* S, sm_visit_fn visit, void* ctx);
+
+
+/*
+ * Function: csr_from_snapshot
+ * ----------------------------
+ * Exports a snapshot to CSR form.
+ *
+ * @param S - Pointer to the snapshot.
+ *
+ * @return Pointer to the CSR matrix, or NULL if allocation fails.
+ */
+csr_matrix* csr_from_snapshot(sm_snapshot* S);
+
+
+/*
+ * Function: release_snapshot
+ * ----------------------------
+ * Drops a reference to a snapshot; the last release frees the blocks no other version shares.
+ *
+ * @param S - Pointer to the snapshot.
+ */
+void release_snapshot(sm_snapshot* S);
+
+
+/*
+ * Function: free_versioned_matrix
+ * ----------------------------
+ * Frees the versioned matrix; snapshots still held by readers stay valid until released.
+ *
+ * @param V - Pointer to the versioned matrix.
+ */
+void free_versioned_matrix(v_matrix* V);
+
+
+#endif // S_MATRIX_SNAPSHOT_H
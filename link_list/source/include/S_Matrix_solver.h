@@ -0,0 +1,172 @@
+/*
+ * File Name: S_Matrix_solver.h
+ * Authors: Arpit Patel, Dharm KaPatel
+ * Date: 2025-03-19
+ * Description: This file defines iterative linear solvers for the S_Matrix data structure.
+ *              Conjugate Gradient (symmetric positive definite systems) and BiCGSTAB (general
+ *              square systems) run on the CSR form with optional Jacobi or ILU(0) preconditioning.
+ *
+ * Vectors are plain arrays indexed from 0: entry i belongs to row (or column) i + 1.
+ */
+
+
+#ifndef S_MATRIX_SOLVER_H
+#define S_MATRIX_SOLVER_H
+
+
+// Include necessary headers
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "S_Matrix.h"
+#include "S_Matrix_csr.h"
+
+
+/*
+ * Enum: sm_preconditioner
+ * ----------------------------
+ * Available preconditioners.
+ *
+ * SM_PRECOND_NONE: No preconditioning.
+ * SM_PRECOND_JACOBI: Scaling by the inverse diagonal; applied inside the fused vector kernels.
+ * SM_PRECOND_ILU0: Incomplete LU factorization with the sparsity pattern of the matrix.
+ */
+typedef enum sm_preconditioner {
+        SM_PRECOND_NONE,
+        SM_PRECOND_JACOBI,
+        SM_PRECOND_ILU0
+} sm_preconditioner;
+
+
+/*
+ * Struct: sm_solver_options
+ * ----------------------------
+ * Parameters of a solve.
+ *
+ * tolerance: Stop once ||b - Ax|| <= tolerance * ||b||.
+ * max_iterations: Upper bound on the number of iterations.
+ * precond: Preconditioner to apply.
+ * threads: Number of threads for the vector kernels, or 0 for one per online CPU.
+ */
+typedef struct sm_solver_options {
+        double tolerance;
+        uint32_t max_iterations;
+        sm_preconditioner precond;
+        uint32_t threads;
+} sm_solver_options;
+
+
+/*
+ * Struct: sm_solver_result
+ * ----------------------------
+ * Outcome of a solve.
+ *
+ * iterations: Number of iterations performed.
+ * residual: Final relative residual ||b - Ax|| / ||b||.
+ * converged: Whether the tolerance was reached.
+ */
+typedef struct sm_solver_result {
+        uint32_t iterations;
+        double residual;
+        bool converged;
+} sm_solver_result;
+
+
+/*
+ * Function: default_solver_options
+ * ----------------------------
+ * Fills in the default solver parameters: tolerance 1e-8, 1000 iterations, no
+ * preconditioner and one thread per online CPU.
+ *
+ * @param opts - Pointer to the options to fill in.
+ */
+void default_solver_options(sm_solver_options* opts);
+
+
+/*
+ * Function: csr_spmv
+ * ----------------------------
+ * Multiplies a CSR matrix by a dense vector, y = Ax.
+ *
+ * @param A - Pointer to the CSR matrix.
+ * @param x - Input vector of A->col entries.
+ * @param y - Output vector of A->row entries.
+ * @param threads - Number of threads, or 0 for one per online CPU.
+ */
+void csr_spmv(csr_matrix* A, const double* x, double* y, uint32_t threads);
+
+
+/*
+ * Function: csr_solve_cg
+ * ----------------------------
+ * Solves Ax = b with the preconditioned Conjugate Gradient method.
+ *
+ * @param A - Pointer to the square, symmetric positive definite CSR matrix.
+ * @param b - Right-hand side.
+ * @param x - Initial guess on entry, solution on return.
+ * @param opts - Solver parameters, or NULL for the defaults.
+ * @param result - Output outcome of the solve, or NULL if not needed.
+ *
+ * @return true if the solve ran, false if the matrix is not square, a preconditioner can not
+ *         be built (zero diagonal or pivot) or allocation fails.
+ *
+ * Description:
+ *   Each iteration makes one pass over the matrix (SpMV fused with the p.q product) and one
+ *   pass that updates x and r, applies the Jacobi scaling and accumulates both r.z and r.r.
+ */
+bool csr_solve_cg(csr_matrix* A, const double* b, double* x, const sm_solver_options* opts, sm_solver_result* result);
+
+
+/*
+ * Function: csr_solve_bicgstab
+ * ----------------------------
+ * Solves Ax = b with the right-preconditioned BiCGSTAB method.
+ *
+ * @param A - Pointer to the square CSR matrix.
+ * @param b - Right-hand side.
+ * @param x - Initial guess on entry, solution on return.
+ * @param opts - Solver parameters, or NULL for the defaults.
+ * @param result - Output outcome of the solve, or NULL if not needed.
+ *
+ * @return true if the solve ran, false if the matrix is not square, a preconditioner can not
+ *         be built or allocation fails.
+ *
+ * Description:
+ *   A breakdown (a vanishing inner product) ends the solve early with converged set to false.
+ */
+bool csr_solve_bicgstab(csr_matrix* A, const double* b, double* x, const sm_solver_options* opts, sm_solver_result* result);
+
+
+/*
+ * Function: solve_cg
+ * ----------------------------
+ * Solves Mx = b with Conjugate Gradient, converting the linked matrix to CSR first.
+ *
+ * @param M - Pointer to the matrix.
+ * @param b - Right-hand side.
+ * @param x - Initial guess on entry, solution on return.
+ * @param opts - Solver parameters, or NULL for the defaults.
+ * @param result - Output outcome of the solve, or NULL if not needed.
+ *
+ * @return true if the solve ran, false otherwise (see csr_solve_cg).
+ */
+bool solve_cg(matrix* M, const double* b, double* x, const sm_solver_options* opts, sm_solver_result* result);
+
+
+/*
+ * Function: solve_bicgstab
+ * ----------------------------
+ * Solves Mx = b with BiCGSTAB, converting the linked matrix to CSR first.
+ *
+ * @param M - Pointer to the matrix.
+ * @param b - Right-hand side.
+ * @param x - Initial guess on entry, solution on return.
+ * @param opts - Solver parameters, or NULL for the defaults.
+ * @param result - Output outcome of the solve, or NULL if not needed.
+ *
+ * @return true if the solve ran, false otherwise (see csr_solve_bicgstab).
+ */
+bool solve_bicgstab(matrix* M, const double* b, double* x, const sm_solver_options* opts, sm_solver_result* result);
+
+
+#endif // S_MATRIX_SOLVER_H
@@ -0,0 +1,86 @@
+/*
+ * File Name: S_Matrix_spmm.h
+ * Authors: Arpit Patel, Dharm KaPatel
+ * Date: 2025-03-19
+ * Description: This file defines sparse times dense multi-vector products (SpMM), Y = A X, where
+ *              X and Y are row-major dense blocks of k vectors. Each non-zero of A is loaded once
+ *              per register block and applied to a slice of SIMD lanes of the vectors.
+ *
+ * Block layout: X has one row of k entries per column of A, Y has one row of k entries per
+ * row of A; entry (i, j) of a block is at [i * k + j] with i counted from 0.
+ */
+
+
+#ifndef S_MATRIX_SPMM_H
+#define S_MATRIX_SPMM_H
+
+
+// Include necessary headers
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "S_Matrix.h"
+#include "S_Matrix_csr.h"
+#include "S_Matrix_mmap.h"
+
+
+// Doubles per SIMD slice (one 512-bit register, or two/four narrower ones)
+#define SM_SPMM_LANES 8
+
+// Slices held in registers at once; up to SM_SPMM_LANES * SM_SPMM_BLOCK vectors share one pass over a row
+#define SM_SPMM_BLOCK 4
+
+
+/*
+ * Function: csr_spmm
+ * ----------------------------
+ * Multiplies a CSR matrix by a dense block of vectors, Y = A X.
+ *
+ * @param A - Pointer to the CSR matrix.
+ * @param X - Input block, A->col rows of k entries.
+ * @param k - Number of vectors.
+ * @param Y - Output block, A->row rows of k entries; overwritten.
+ * @param threads - Number of threads, or 0 for one per online CPU.
+ *
+ * @return true on success, false on invalid input.
+ */
+bool csr_spmm(csr_matrix* A, const double* X, uint32_t k, double* Y, uint32_t threads);
+
+
+/*
+ * Function: spmm_S_Matrix
+ * ----------------------------
+ * Multiplies a linked matrix by a dense block of vectors, Y = M X.
+ *
+ * @param M - Pointer to the matrix.
+ * @param X - Input block, M->col rows of k entries.
+ * @param k - Number of vectors.
+ * @param Y - Output block, M->row rows of k entries; overwritten.
+ * @param threads - Number of threads, or 0 for one per online CPU.
+ *
+ * @return true on success, false on invalid input or allocation failure.
+ *
+ * Description:
+ *   Each row chain is gathered into a small contiguous buffer and then run through the
+ *   same kernel as the CSR form, so the chain is walked once for all k vectors.
+ */
+bool spmm_S_Matrix(matrix* M, const double* X, uint32_t k, double* Y, uint32_t threads);
+
+
+/*
+ * Function: mm_spmm
+ * ----------------------------
+ * Multiplies a file-backed matrix by a dense block of vectors, Y = F X.
+ *
+ * @param F - Pointer to the file-backed matrix.
+ * @param X - Input block, mm_columns(F) rows of k entries.
+ * @param k - Number of vectors.
+ * @param Y - Output block, mm_rows(F) rows of k entries; overwritten.
+ * @param threads - Number of threads, or 0 for one per online CPU.
+ *
+ * @return true on success, false on invalid input.
+ */
+bool mm_spmm(mm_matrix* F, const double* X, uint32_t k, double* Y, uint32_t threads);
+
+
+#endif // S_MATRIX_SPMM_H
@@ -0,0 +1,69 @@
+/*
+ * File Name: S_Matrix_typed.h
+ * Authors: Arpit Patel, Dharm KaPatel
+ * Date: 2025-03-19
+ * Description: This file declares the type-specialized family of S_Matrix variants.
+ *              Every variant has the same API as the double/uint32_t matrix, with the
+ *              value and index types fixed at compile time, e.g. S_Matrix_f32_u32 and
+ *              insert_data_f32_u32(), and the same sm_status results. Elements live in one pool per matrix and link to
+ *              each other by pool slot instead of pointer, so a float/uint32_t element
+ *              takes 20 bytes instead of the 32 bytes of an m_node.
+ */
+
+
+#ifndef S_MATRIX_TYPED_H
+#define S_MATRIX_TYPED_H
+
+
+// Include necessary headers
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "S_Matrix.h"
+
+
+#define SM_CONCAT_(a, b) a##_##b
+#define SM_CONCAT(a, b) SM_CONCAT_(a, b)
+#define SM_NAME(name) SM_CONCAT(name, SM_SUFFIX)
+
+
+// float values, 32-bit indices
+#define SM_SUFFIX f32_u32
+#define SM_VALUE_T float
+#define SM_INDEX_T uint32_t
+#include "S_Matrix_typed_decl.h"
+#undef SM_SUFFIX
+#undef SM_VALUE_T
+#undef SM_INDEX_T
+
+// double values, 32-bit indices
+#define SM_SUFFIX f64_u32
+#define SM_VALUE_T double
+#define SM_INDEX_T uint32_t
+#include "S_Matrix_typed_decl.h"
+#undef SM_SUFFIX
+#undef SM_VALUE_T
+#undef SM_INDEX_T
+
+// float values, 64-bit indices
+#define SM_SUFFIX f32_u64
+#define SM_VALUE_T float
+#define SM_INDEX_T uint64_t
+#include "S_Matrix_typed_decl.h"
+#undef SM_SUFFIX
+#undef SM_VALUE_T
+#undef SM_INDEX_T
+
+// double values, 64-bit indices
+#define SM_SUFFIX f64_u64
+#define SM_VALUE_T double
+#define SM_INDEX_T uint64_t
+#include "S_Matrix_typed_decl.h"
+#undef SM_SUFFIX
+#undef SM_VALUE_T
+#undef SM_INDEX_T
+
+
+#endif // S_MATRIX_TYPED_H
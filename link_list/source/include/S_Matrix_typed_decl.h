@@ -0,0 +1,156 @@
+/*
+ * File Name: S_Matrix_typed_decl.h
+ * Authors: Arpit Patel, Dharm KaPatel
+ * Date: 2025-03-19
+ * Description: Declaration template for one type-specialized S_Matrix variant.
+ *              Do not include directly; S_Matrix_typed.h includes it once per variant
+ *              with SM_SUFFIX, SM_VALUE_T and SM_INDEX_T defined.
+ */
+
+
+#if !defined(SM_SUFFIX) || !defined(SM_VALUE_T) || !defined(SM_INDEX_T)
+#error "S_Matrix_typed_decl.h needs SM_SUFFIX, SM_VALUE_T and SM_INDEX_T"
+#endif
+
+
+#define SM_NODE SM_NAME(m_node)
+#define SM_MATRIX SM_NAME(S_Matrix)
+
+
+/*
+ * Struct: m_node_<suffix>
+ * ----------------------------
+ * Represents a single element of a type-specialized sparse matrix.
+ *
+ * row: The row index of the element.
+ * column: The column index of the element.
+ * value: The value of the element.
+ * row_ptr: Pool slot of the next element in the same row (0 means none).
+ * col_ptr: Pool slot of the next element in the same column (0 means none).
+ */
+typedef struct SM_NODE {
+        SM_INDEX_T row;
+        SM_INDEX_T column;
+        SM_VALUE_T value;
+        SM_INDEX_T row_ptr;
+        SM_INDEX_T col_ptr;
+} SM_NODE;
+
+
+/*
+ * Struct: S_Matrix_<suffix>
+ * ----------------------------
+ * Represents a type-specialized sparse matrix.
+ *
+ * pool: Array holding every element; slot 0 is reserved as the null link.
+ * pool_size: Number of used slots in the pool (including slot 0).
+ * pool_cap: Number of allocated slots in the pool.
+ * row_heads: Pool slot of the first element in each row (1-based).
+ * col_heads: Pool slot of the first element in each column (1-based).
+ * row_cap: Number of rows covered by row_heads.
+ * col_cap: Number of columns covered by col_heads.
+ * row: The number of rows in the matrix.
+ * col: The number of columns in the matrix.
+ */
+typedef struct SM_MATRIX {
+        SM_NODE* pool;
+        SM_INDEX_T pool_size;
+        SM_INDEX_T pool_cap;
+        SM_INDEX_T* row_heads;
+        SM_INDEX_T* col_heads;
+        SM_INDEX_T row_cap;
+        SM_INDEX_T col_cap;
+        SM_INDEX_T row;
+        SM_INDEX_T col;
+} SM_MATRIX;
+
+
+/*
+ * Function: create_S_Matrix_<suffix>
+ * ----------------------------
+ * Creates and initializes a type-specialized matrix with the given rows and columns.
+ *
+ * @param rows - Number of rows.
+ * @param columns - Number of columns.
+ *
+ * @return Pointer to the matrix, or NULL if allocation fails.
+ */
+SM_MATRIX* SM_NAME(create_S_Matrix)(SM_INDEX_T rows, SM_INDEX_T columns);
+
+
+/*
+ * Function: insert_data_<suffix>
+ * ----------------------------
+ * Inserts a value at the specified row and column in the matrix.
+ * If the position already contains a value, it updates the existing value.
+ *
+ * @param M - Pointer to the matrix.
+ * @param row - Row index.
+ * @param column - Column index.
+ * @param value - Value to be inserted.
+ *
+ * @return SM_OK, SM_ERR_NOT_CREATED, SM_ERR_ZERO_VALUE, SM_ERR_OUT_OF_BOUNDS or SM_ERR_NO_MEMORY.
+ */
+sm_status SM_NAME(insert_data)(SM_MATRIX* M, SM_INDEX_T row, SM_INDEX_T column, SM_VALUE_T value);
+
+
+/*
+ * Function: duplicatevalue_<suffix>
+ * ----------------------------
+ * Checks if a specific value exists in the matrix.
+ *
+ * @param M - Pointer to the matrix.
+ * @param value - Value to search for.
+ * @param found - Output, true if the value exists.
+ *
+ * @return SM_OK, SM_ERR_NOT_CREATED, SM_ERR_INVALID_ARG (found is NULL) or SM_ERR_ZERO_VALUE.
+ */
+sm_status SM_NAME(duplicatevalue)(SM_MATRIX* M, SM_VALUE_T value, bool* found);
+
+
+/*
+ * Function: resize_<suffix>
+ * ----------------------------
+ * Resizes the matrix by doubling its dimensions.
+ *
+ * @param M - Pointer to the matrix.
+ *
+ * @return SM_OK, SM_ERR_NOT_CREATED or SM_ERR_OVERFLOW.
+ */
+sm_status SM_NAME(resize)(SM_MATRIX* M);
+
+
+/*
+ * Function: transpose_<suffix>
+ * ----------------------------
+ * Transposes the matrix, swapping rows and columns.
+ *
+ * @param M - Pointer to the matrix.
+ *
+ * @return SM_OK or SM_ERR_NOT_CREATED.
+ */
+sm_status SM_NAME(transpose)(SM_MATRIX* M);
+
+
+/*
+ * Function: displayMatrix_<suffix>
+ * ----------------------------
+ * Displays the matrix contents in a formatted manner.
+ *
+ * @param M - Pointer to the matrix.
+ */
+void SM_NAME(displayMatrix)(SM_MATRIX* M);
+
+
+/*
+ * Function: free_S_Matrix_<suffix>
+ * ----------------------------
+ * Frees all memory associated with the matrix.
+ *
+ * @param M - Pointer to the matrix.
+ */
+void SM_NAME(free_S_Matrix)(SM_MATRIX* M);
+
+
+#undef SM_NODE
+#undef SM_MATRIX
@@ -0,0 +1,209 @@
+/*
+ * File Name: S_Matrix_view.h
+ * Authors: Arpit Patel, Dharm KaPatel
+ * Date: 2025-03-19
+ * Description: This file defines zero-copy submatrix views over the S_Matrix data structure.
+ *              A view selects a range or a set of rows and of columns of an existing matrix and
+ *              reads through to its nodes; nothing is copied until the view is materialized.
+ *
+ * A view has its own 1-based coordinates: view row i is the i-th selected row of the matrix,
+ * and likewise for columns. A view of a symmetric matrix sees both triangles. A view must not
+ * be used after the matrix is modified or freed.
+ */
+
+
+#ifndef S_MATRIX_VIEW_H
+#define S_MATRIX_VIEW_H
+
+
+// Include necessary headers
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "S_Matrix.h"
+#include "S_Matrix_csr.h"
+#include "S_Matrix_buffered.h"
+
+
+/*
+ * Struct: sm_index_map
+ * ----------------------------
+ * Selection of rows or columns.
+ *
+ * first: First selected index when set is NULL.
+ * count: Number of selected indices.
+ * set: Selected indices in increasing order, or NULL for the range first .. first + count - 1.
+ */
+typedef struct sm_index_map {
+        uint32_t first;
+        uint32_t count;
+        uint32_t* set;
+} sm_index_map;
+
+
+/*
+ * Struct: sm_view
+ * ----------------------------
+ * Represents a submatrix view.
+ *
+ * M: The viewed matrix.
+ * rows: Selected rows.
+ * cols: Selected columns.
+ */
+typedef struct sm_view {
+        matrix* M;
+        sm_index_map rows;
+        sm_index_map cols;
+} sm_view;
+
+
+/*
+ * Function: view_block
+ * ----------------------------
+ * Creates a view of a contiguous block of a matrix in O(1).
+ *
+ * @param M - Pointer to the matrix.
+ * @param first_row - First row of the block.
+ * @param last_row - Last row of the block.
+ * @param first_col - First column of the block.
+ * @param last_col - Last column of the block.
+ *
+ * @return Pointer to the view, or NULL if the block is empty, out of bounds or allocation fails.
+ */
+sm_view* view_block(matrix* M, uint32_t first_row, uint32_t last_row, uint32_t first_col, uint32_t last_col);
+
+
+/*
+ * Function: view_rows
+ * ----------------------------
+ * Creates a view of a band of rows (all columns) in O(1).
+ *
+ * @param M - Pointer to the matrix.
+ * @param first - First row of the band.
+ * @param last - Last row of the band.
+ *
+ * @return Pointer to the view, or NULL on invalid input or allocation failure.
+ */
+sm_view* view_rows(matrix* M, uint32_t first, uint32_t last);
+
+
+/*
+ * Function: view_columns
+ * ----------------------------
+ * Creates a view of a band of columns (all rows) in O(1).
+ *
+ * @param M - Pointer to the matrix.
+ * @param first - First column of the band.
+ * @param last - Last column of the band.
+ *
+ * @return Pointer to the view, or NULL on invalid input or allocation failure.
+ */
+sm_view* view_columns(matrix* M, uint32_t first, uint32_t last);
+
+
+/*
+ * Function: view_index_sets
+ * ----------------------------
+ * Creates a view of arbitrary sets of rows and columns.
+ *
+ * @param M - Pointer to the matrix.
+ * @param rows - Selected rows in strictly increasing order, or NULL for all rows.
+ * @param row_count - Number of selected rows (ignored when rows is NULL).
+ * @param cols - Selected columns in strictly increasing order, or NULL for all columns.
+ * @param col_count - Number of selected columns (ignored when cols is NULL).
+ *
+ * @return Pointer to the view, or NULL if a set is empty, unsorted or out of bounds,
+ *         or allocation fails.
+ *
+ * Description:
+ *   The index sets are copied; the matrix is not.
+ */
+sm_view* view_index_sets(matrix* M, const uint32_t* rows, uint32_t row_count, const uint32_t* cols, uint32_t col_count);
+
+
+/*
+ * Function: view_get
+ * ----------------------------
+ * Reads a single element of a view.
+ *
+ * @param V - Pointer to the view.
+ * @param row - Row index in view coordinates.
+ * @param column - Column index in view coordinates.
+ *
+ * @return The stored value, or 0 if the position is empty or outside the view.
+ */
+double view_get(sm_view* V, uint32_t row, uint32_t column);
+
+
+/*
+ * Function: view_scan
+ * ----------------------------
+ * Visits every non-zero of a view in row-major order, in view coordinates.
+ *
+ * @param V - Pointer to the view.
+ * @param visit - Callback receiving each non-zero.
+ * @param ctx - Caller context passed to the callback.
+ */
+void view_scan(sm_view* V, sm_visit_fn visit, void* ctx);
+
+
+/*
+ * Function: view_scan_row
+ * ----------------------------
+ * Visits the non-zeros of one view row in column order, in view coordinates.
+ *
+ * @param V - Pointer to the view.
+ * @param row - Row index in view coordinates.
+ * @param visit - Callback receiving each non-zero.
+ * @param ctx - Caller context passed to the callback.
+ */
+void view_scan_row(sm_view* V, uint32_t row, sm_visit_fn visit, void* ctx);
+
+
+/*
+ * Function: view_spmv
+ * ----------------------------
+ * Multiplies a view by a dense vector, y = Vx.
+ *
+ * @param V - Pointer to the view.
+ * @param x - Input vector of V->cols.count entries, indexed from 0.
+ * @param y - Output vector of V->rows.count entries, indexed from 0; overwritten.
+ */
+void view_spmv(sm_view* V, const double* x, double* y);
+
+
+/*
+ * Function: csr_from_view
+ * ----------------------------
+ * Exports a view to CSR form in view coordinates.
+ *
+ * @param V - Pointer to the view.
+ *
+ * @return Pointer to the CSR matrix, or NULL if allocation fails.
+ */
+csr_matrix* csr_from_view(sm_view* V);
+
+
+/*
+ * Function: materialize_view
+ * ----------------------------
+ * Copies a view into a new, independent linked matrix.
+ *
+ * @param V - Pointer to the view.
+ *
+ * @return Pointer to the matrix, or NULL if allocation fails.
+ */
+matrix* materialize_view(sm_view* V);
+
+
+/*
+ * Function: free_view
+ * ----------------------------
+ * Frees a view; the viewed matrix is not touched.
+ *
+ * @param V - Pointer to the view.
+ */
+void free_view(sm_view* V);
+
+
+#endif // S_MATRIX_VIEW_H
@@ -12,29 +12,182 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include <stdio.h>
+#include <string.h>
 
 
 #include "../include/S_Matrix.h"
 
 
+// Debug hook installed with sm_set_trace
+static sm_trace_fn trace_fn = NULL;
+static void* trace_ctx = NULL;
+
+// Memory of every matrix of the process
+static mem_stats totals;
+
+// Timers of the main operations, in the order sm_timers documents
+enum {
+        TIMER_INSERT,
+        TIMER_GET,
+        TIMER_RESIZE,
+        TIMER_RESIZE_TO,
+        TIMER_TRANSPOSE,
+        TIMER_SPMV,
+        TIMER_FREE,
+        TIMER_COUNT
+};
+
+static op_timer timers[TIMER_COUNT] = {
+        { "insert_data", 0, 0 },
+        { "get_data", 0, 0 },
+        { "resize", 0, 0 },
+        { "resize_to", 0, 0 },
+        { "transpose", 0, 0 },
+        { "spmv_S_Matrix", 0, 0 },
+        { "free_S_Matrix", 0, 0 }
+};
+
+
+/*
+ * Function: fail
+ * ----------------------------
+ * Reports an error to the trace hook, if any, and returns it.
+ *
+ * @param function - Name of the failing function.
+ * @param status - The error.
+ *
+ * @return status.
+ */
+static sm_status fail(const char* function, sm_status status) {
+        if (trace_fn) trace_fn(function, status, trace_ctx);
+        return status;
+}
+
+
+/*
+ * Function: sm_status_message
+ * ----------------------------
+ * Gets the description of a status.
+ *
+ * @param status - The status.
+ *
+ * @return A static string; never NULL.
+ */
+const char* sm_status_message(sm_status status) {
+        switch (status) {
+        case SM_OK: return "Success";
+        case SM_ERR_NOT_CREATED: return "Currently Matrix is not created!!";
+        case SM_ERR_ZERO_VALUE: return "Zero can not be stored in the matrix";
+        case SM_ERR_OUT_OF_BOUNDS: return "Row or Col out of bound";
+        case SM_ERR_NO_MEMORY: return "Memory allocation failed!";
+        case SM_ERR_OVERFLOW: return "Matrix dimensions would overflow";
+        case SM_ERR_INVALID_ARG: return "Invalid argument";
+        }
+        return "Unknown status";
+}
+
+
+/*
+ * Function: sm_set_trace
+ * ----------------------------
+ * Installs (or, with NULL, removes) the debug hook called on every error.
+ *
+ * @param fn - The hook.
+ * @param ctx - Context passed to the hook.
+ */
+void sm_set_trace(sm_trace_fn fn, void* ctx) {
+        trace_fn = fn;
+        trace_ctx = ctx;
+}
+
+
 /*
- * Function: create_l_node
+ * Function: sm_fail
  * ----------------------------
- * Creates and initializes a linked list node with the given matrix node data.
+ * Reports an error to the trace hook, if any, and returns it.
  *
- * @param data - Pointer to the matrix node to be stored in the linked list node.
+ * @param function - Name of the failing function.
+ * @param status - The error.
  *
- * @return Pointer to the linked list node, or NULL if allocation fails.
+ * @return status.
  */
-l_node* create_l_node(m_node* data) {
-        l_node* new_l_node = (l_node*)malloc(sizeof(l_node));
-        if (!new_l_node) return NULL;
+sm_status sm_fail(const char* function, sm_status status) {
+        return fail(function, status);
+}
 
-        new_l_node->matrix_node = data;
-        new_l_node->next = NULL;
-        new_l_node->prev = NULL;  
+/*
+ * Function: grow_list
+ * ----------------------------
+ * Grows a linked list to the given number of empty nodes.
+ *
+ * @param ll - Pointer to the linked list.
+ * @param size - Number of nodes needed; a list already that long is left as it is.
+ *
+ * @return SM_OK, SM_ERR_NOT_CREATED if ll is NULL, or SM_ERR_NO_MEMORY.
+ */
+sm_status grow_list(link_list* ll, uint32_t size) {
+        if (!ll) {
+                return fail(__func__, SM_ERR_NOT_CREATED);
+        }
+        if (size <= ll->size) return SM_OK;
+
+        uint32_t needed = (uint32_t)(((uint64_t)size + SM_HEADER_BLOCK - 1) / SM_HEADER_BLOCK);
+        if (needed > ll->block_capacity) {
+                uint32_t capacity = ll->block_capacity ? ll->block_capacity : 4;
+                while (capacity < needed) capacity *= 2;
+
+                // calloc rather than realloc: the new slots must be NULL, and a large zeroed
+                // array costs nothing until its pages are touched
+                l_node** blocks = (l_node**)calloc(capacity, sizeof(l_node*));
+                if (!blocks) {
+                        return fail(__func__, SM_ERR_NO_MEMORY);
+                }
+                if (ll->blocks) memcpy(blocks, ll->blocks, (size_t)ll->block_capacity * sizeof(l_node*));
+                free(ll->blocks);
+
+                uint64_t grown = (uint64_t)(capacity - ll->block_capacity) * sizeof(l_node*);
+                uint64_t moved = ll->block_capacity ? 1 : 0;
+                mem_stats_alloc(&totals, grown, 0, 1);
+                mem_stats_free(&totals, 0, 0, moved);
+                mem_stats_alloc(ll->mem, grown, 0, 1);
+                mem_stats_free(ll->mem, 0, 0, moved);
+
+                ll->blocks = blocks;
+                ll->block_capacity = capacity;
+        }
 
-        return new_l_node;
+        ll->size = size;
+        return SM_OK;
+}
+
+
+/*
+ * Function: touch_header
+ * ----------------------------
+ * Gets the node at a position, allocating its block if it has none yet.
+ *
+ * @param ll - Pointer to the linked list.
+ * @param index - Position of the node (1-based, at most ll->size).
+ *
+ * @return Pointer to the node, or NULL if the block can not be allocated.
+ */
+l_node* touch_header(link_list* ll, uint32_t index) {
+        l_node** slot = &ll->blocks[(index - 1) / SM_HEADER_BLOCK];
+        l_node* block = *slot;
+
+        if (!block) {
+                block = (l_node*)calloc(SM_HEADER_BLOCK, sizeof(l_node));
+                if (!block) return NULL;
+
+                ll->block_count++;
+                mem_stats_alloc(&totals, SM_HEADER_BLOCK * sizeof(l_node), 0, 1);
+                mem_stats_alloc(ll->mem, SM_HEADER_BLOCK * sizeof(l_node), 0, 1);
+
+                // Stored last, so a thread that finds the slot set also sees the zeroed block
+                __atomic_store_n(slot, block, __ATOMIC_RELEASE);
+        }
+
+        return &block[(index - 1) % SM_HEADER_BLOCK];
 }
 
 
@@ -45,29 +198,25 @@ l_node* create_l_node(m_node* data) {
  *
  * @param ll - Pointer to the linked list.
  * @param data - Pointer to the matrix node to be stored in the new list node.
+ *
+ * @return SM_OK, SM_ERR_NOT_CREATED if ll is NULL, or SM_ERR_NO_MEMORY.
  */
-void add_list_node(link_list* ll, m_node* data) {
+sm_status add_list_node(link_list* ll, m_node* data) {
         if (!ll) {
-                printf("Linked list is not created!\n");
-                return;
+                return fail(__func__, SM_ERR_NOT_CREATED);
         }
 
-        l_node* new_node = create_l_node(data);
-        if (!new_node) {
-                printf("Memory allocation failed!\n");
-                return;
-        }
+        sm_status status = grow_list(ll, ll->size + 1);
+        if (status != SM_OK) return status;
 
-        if (!ll->head) {
-                ll->head = new_node;
-                ll->tail = new_node;
-                ll->size = 1;
-        } else {
-                new_node->prev = ll->tail;  
-                ll->tail->next = new_node;
-                ll->tail = new_node;
-                ll->size++;
+        l_node* node = touch_header(ll, ll->size);
+        if (!node) {
+                ll->size--;
+                return fail(__func__, SM_ERR_NO_MEMORY);
         }
+        node->matrix_node = data;
+
+        return SM_OK;
 }
 
 
@@ -83,18 +232,45 @@ link_list* create_link_list() {
 
         if (!ll) return NULL;
 
-        ll->head = NULL;
-        ll->tail = NULL;
         ll->size = 0;
+        ll->blocks = NULL;
+        ll->block_count = 0;
+        ll->block_capacity = 0;
+        ll->mem = NULL;
 
+        mem_stats_alloc(&totals, sizeof(link_list), 0, 1);
         return ll;
 }
 
 
 /*
- * Function: create_mat_node
+ * Function: free_link_list
  * ----------------------------
- * Creates and initializes a matrix node with the given row, column, and value.
+ * Frees a header list and its node blocks (not the matrix nodes).
+ *
+ * @param ll - Pointer to the linked list.
+ */
+static void free_link_list(link_list* ll) {
+        if (!ll) return;
+
+        uint64_t bytes = sizeof(link_list) + (uint64_t)ll->block_count * SM_HEADER_BLOCK * sizeof(l_node)
+                         + (uint64_t)ll->block_capacity * sizeof(l_node*);
+        uint64_t count = 1 + ll->block_count + (ll->block_capacity ? 1 : 0);
+
+        for (uint32_t b = 0; b < ll->block_capacity; b++) {
+                free(ll->blocks[b]);
+        }
+        free(ll->blocks);
+        free(ll);
+
+        mem_stats_free(&totals, bytes, 0, count);
+}
+
+
+/*
+ * Function: alloc_mat_node
+ * ----------------------------
+ * Creates and initializes a matrix node without counting it in the library totals.
  *
  * @param row - Row index of the node.
  * @param col - Column index of the node.
@@ -102,7 +278,7 @@ link_list* create_link_list() {
  *
  * @return Pointer to the matrix node, or NULL if allocation fails.
  */
-m_node* create_mat_node(uint32_t row, uint32_t col, double value) {
+m_node* alloc_mat_node(uint32_t row, uint32_t col, double value) {
         m_node* new_m_node = (m_node*)malloc(sizeof(m_node)); 
 
         if (!new_m_node) return NULL; 
@@ -117,6 +293,69 @@ m_node* create_mat_node(uint32_t row, uint32_t col, double value) {
 }
 
 
+/*
+ * Function: count_mat_nodes
+ * ----------------------------
+ * Records a batch of matrix nodes coming into and going out of use in the library totals.
+ *
+ * @param created - Nodes made with alloc_mat_node.
+ * @param released - Nodes released with free().
+ */
+void count_mat_nodes(uint64_t created, uint64_t released) {
+        if (created) mem_stats_alloc(&totals, created * sizeof(m_node), created, created);
+        if (released) mem_stats_free(&totals, released * sizeof(m_node), released, released);
+}
+
+
+/*
+ * Function: flush_mat_nodes
+ * ----------------------------
+ * Adds the nodes insert_data has made since the last flush to the library totals.
+ *
+ * @param M - Pointer to the matrix.
+ */
+void flush_mat_nodes(matrix* M) {
+        if (!M || !M->uncounted) return;
+
+        count_mat_nodes(M->uncounted, 0);
+        M->uncounted = 0;
+}
+
+
+/*
+ * Function: create_mat_node
+ * ----------------------------
+ * Creates and initializes a matrix node with the given row, column, and value.
+ *
+ * @param row - Row index of the node.
+ * @param col - Column index of the node.
+ * @param value - Value to be stored in the node.
+ *
+ * @return Pointer to the matrix node, or NULL if allocation fails.
+ */
+m_node* create_mat_node(uint32_t row, uint32_t col, double value) {
+        m_node* new_m_node = alloc_mat_node(row, col, value);
+
+        if (new_m_node) count_mat_nodes(1, 0);
+        return new_m_node;
+}
+
+
+/*
+ * Function: free_mat_node
+ * ----------------------------
+ * Frees a matrix node made by create_mat_node.
+ *
+ * @param node - Pointer to the matrix node.
+ */
+void free_mat_node(m_node* node) {
+        if (!node) return;
+
+        free(node);
+        mem_stats_free(&totals, sizeof(m_node), 1, 1);
+}
+
+
 /*
  * Function: create_S_Matrix
  * ----------------------------
@@ -133,17 +372,46 @@ matrix* create_S_Matrix(uint32_t rows, uint32_t columns) {
 
         M->row = rows;
         M->col = columns;
+        M->symmetric = false;
+        M->generation = 0;
+        M->mem = (mem_stats){ 0 };
+        M->uncounted = 0;
+        mem_stats_alloc(&totals, sizeof(matrix), 0, 1);
 
         M->rowList = create_link_list();
         M->columnList = create_link_list();
 
         if (!M->rowList || !M->columnList) {
-                if (M->rowList) free(M->rowList);
-                if (M->columnList) free(M->columnList);
+                free_link_list(M->rowList);
+                free_link_list(M->columnList);
                 free(M);
+                mem_stats_free(&totals, sizeof(matrix), 0, 1);
                 return NULL;
         }
 
+        M->rowList->mem = &M->mem;
+        M->columnList->mem = &M->mem;
+        mem_stats_alloc(&M->mem, sizeof(matrix) + 2 * sizeof(link_list), 0, 3);
+
+        return M;
+}
+
+
+/*
+ * Function: create_symmetric_S_Matrix
+ * ----------------------------
+ * Creates and initializes a symmetric n x n S_Matrix that stores only its upper triangle.
+ *
+ * @param n - Number of rows and columns.
+ *
+ * @return Pointer to the matrix, or NULL if allocation fails.
+ */
+matrix* create_symmetric_S_Matrix(uint32_t n) {
+        matrix* M = create_S_Matrix(n, n);
+        if (M == NULL) return NULL;
+
+        M->symmetric = true;
+
         return M;
 }
 
@@ -157,181 +425,133 @@ matrix* create_S_Matrix(uint32_t rows, uint32_t columns) {
  * @param row - Row index.
  * @param column - Column index.
  * @param value - Value to be inserted.
+ *
+ * @return SM_OK, SM_ERR_NOT_CREATED, SM_ERR_ZERO_VALUE, SM_ERR_OUT_OF_BOUNDS or SM_ERR_NO_MEMORY.
  */
-void insert_data(matrix* M, uint32_t row, uint32_t column, double value) {
-        if (!M) {
-                printf("Currently Matrix is not created!!\n");
-                return;
+sm_status insert_data(matrix* M, uint32_t row, uint32_t column, double value) {
+        OP_TIMED(timers[TIMER_INSERT]);
+
+        if (!M || !M->rowList || !M->columnList) {
+                return fail(__func__, SM_ERR_NOT_CREATED);
         }
 
         if (value == 0) {
-                printf("you can not add 0 in the matrix\n");
-                return;
+                return fail(__func__, SM_ERR_ZERO_VALUE);
         }
 
         if (row > M->row || row < 1 || column > M->col || column < 1) {
-                printf("Row or Col out of bound\n");
-                return;
+                return fail(__func__, SM_ERR_OUT_OF_BOUNDS);
         }
 
-        m_node* matrix_node = create_mat_node(row, column, value);
-        if (!matrix_node) {
-                printf("Memory allocation failed!\n");
-                return;
+        // A symmetric matrix keeps only the upper triangle
+        if (M->symmetric && row > column) {
+                uint32_t temp = row;
+                row = column;
+                column = temp;
         }
 
         link_list* col_ll = M->columnList;
         link_list* row_ll = M->rowList;
 
-        uint32_t cur_col_size = col_ll->size;
-        uint32_t cur_row_size = row_ll->size;
+        // Grow the header lists until the row and the column have a header; only the blocks
+        // holding those two are allocated
+        // grow_list has already reported its error
+        sm_status status = grow_list(col_ll, column);
+        if (status == SM_OK) status = grow_list(row_ll, row);
+        if (status != SM_OK) return status;
+
+        l_node* col_pos = touch_header(col_ll, column);
+        l_node* row_pos = touch_header(row_ll, row);
+        if (!col_pos || !row_pos) {
+                return fail(__func__, SM_ERR_NO_MEMORY);
+        }
 
-        l_node* col_pos = NULL;
-        l_node* row_pos = NULL;
+        // Find the position in the row, which is sorted by column
+        m_node* row_prev = NULL;
+        m_node* row_next = row_pos->matrix_node;
+        while (row_next && row_next->column < column) {
+                row_prev = row_next;
+                row_next = row_next->row_ptr;
+        }
 
-        uint32_t col_index = 0;
-        uint32_t row_index = 0;
+        // Update value if node exists
+        if (row_next && row_next->column == column) {
+                row_next->value = value;
+                M->generation++;
+                return SM_OK;
+        }
 
-        m_node* cur_col_ptr = NULL;
-        m_node* cur_row_ptr = NULL;
+        // Find the position in the column, which is sorted by row
+        m_node* col_prev = NULL;
+        m_node* col_next = col_pos->matrix_node;
+        while (col_next && col_next->row < row) {
+                col_prev = col_next;
+                col_next = col_next->col_ptr;
+        }
 
-        // Find the Col position where matrix node will add
-        if (cur_col_size < column) {
-                while (cur_col_size < column) {
-                        add_list_node(col_ll, NULL);
-                        cur_col_size = col_ll->size;
-                }
-                col_pos = col_ll->tail;
-        } else {
-                col_pos = col_ll->head; 
-                col_index = 1;
-                while (col_index < column) {
-                        col_pos = col_pos->next;
-                        col_index++;
-                }
+        // The matrix is used by one thread, so only the library totals need atomic updates
+        m_node* matrix_node = alloc_mat_node(row, column, value);
+        if (!matrix_node) {
+                return fail(__func__, SM_ERR_NO_MEMORY);
         }
+        mem_stats_alloc_owned(&M->mem, sizeof(m_node), 1, 1);
+        if (++M->uncounted == SM_COUNT_BATCH) flush_mat_nodes(M);
 
-        // Find the Row position where matrix node will add
-        if (cur_row_size < row) {
-                while (cur_row_size < row) {
-                        add_list_node(row_ll, NULL);
-                        cur_row_size = row_ll->size;
-                }
-                row_pos = row_ll->tail;
+        // Link the node into both chains; an empty header or a smaller first index means it goes first
+        matrix_node->row_ptr = row_next;
+        if (row_prev) {
+                row_prev->row_ptr = matrix_node;
         } else {
-                row_pos = row_ll->head; 
-                row_index = 1;
-                while (row_index < row) {
-                        row_pos = row_pos->next;
-                        row_index++;
-                }
+                row_pos->matrix_node = matrix_node;
         }
 
-        // Case1: row_pos and col_pos not pointing to any matrix node
-        if (!row_pos->matrix_node && !col_pos->matrix_node) {
+        matrix_node->col_ptr = col_next;
+        if (col_prev) {
+                col_prev->col_ptr = matrix_node;
+        } else {
                 col_pos->matrix_node = matrix_node;
-                row_pos->matrix_node = matrix_node;
-                return; 
-        }
-
-        bool exist_col_m_node = false;  
-	bool exist_row_m_node = false;  
-
-        // Case2: col_pos pointing to any node
-        if (col_pos->matrix_node) {
-                // Row value less than the first m_node in that col
-                if (col_pos->matrix_node->row > row) {
-                        matrix_node->col_ptr = col_pos->matrix_node;
-                        col_pos->matrix_node = matrix_node;
-                } else if (col_pos->matrix_node->row == row) {
-                        exist_col_m_node = true;
-                        // Update value if node exists
-                        if (col_pos->matrix_node->column == column) {
-                                col_pos->matrix_node->value = value;
-                                free(matrix_node);  
-                                return;
-                        }
-                } else {
-                        // Row value between or highest in that column
-                        cur_col_ptr = col_pos->matrix_node;
-                }
         }
 
-        // Case3: row_pos pointing to any node
-        if (row_pos->matrix_node) {
-                // Col value less than the first m_node in that row
-                if (row_pos->matrix_node->column > column) {
-                        matrix_node->row_ptr = row_pos->matrix_node;
-                        row_pos->matrix_node = matrix_node;
-                } else if (row_pos->matrix_node->column == column) {
-                        exist_row_m_node = true;
-                        // Update value if node exists
-                        if (row_pos->matrix_node->row == row) {
-                                row_pos->matrix_node->value = value;
-                                if (!exist_col_m_node) { 
-                                        free(matrix_node);
-                                }
-                                return;
-                        }
-                } else {
-                        // Row value between or highest in that row
-                        cur_row_ptr = row_pos->matrix_node;
-                }
+        M->generation++;
+        return SM_OK;
+}
+
+
+/*
+ * Function: get_data
+ * ----------------------------
+ * Reads the value at the specified row and column in the matrix.
+ *
+ * @param M - Pointer to the matrix.
+ * @param row - Row index.
+ * @param column - Column index.
+ *
+ * @return The value, or 0 if the position holds no value or is out of bounds.
+ */
+double get_data(matrix* M, uint32_t row, uint32_t column) {
+        OP_TIMED(timers[TIMER_GET]);
+
+        if (!M) {
+                fail(__func__, SM_ERR_NOT_CREATED);
+                return 0;
         }
 
-        // Case4: m_node in col will add after some nodes or at the end of col
-        if (cur_col_ptr) {
-                while (cur_col_ptr->col_ptr) {
-                        if (cur_col_ptr->col_ptr->row > row) {
-                                break;
-                        } else if (cur_col_ptr->col_ptr->row < row) {
-                                cur_col_ptr = cur_col_ptr->col_ptr;
-                        } else {
-                                exist_col_m_node = true;
-                                // Update value if node exists
-                                if (cur_col_ptr->col_ptr->column == column) {
-                                        cur_col_ptr->col_ptr->value = value;
-                                        free(matrix_node);
-                                        return;
-                                }
-                                break;
-                        }
-                }
+        if (row > M->row || row < 1 || column > M->col || column < 1 || !M->rowList) {
+                return 0;
         }
 
-        // Case5: m_node in row will add after some nodes or at the end of row
-        if (cur_row_ptr) {
-                while (cur_row_ptr->row_ptr) {
-                        if (cur_row_ptr->row_ptr->column > column) {
-                                break;
-                        } else if (cur_row_ptr->row_ptr->column < column) {
-                                cur_row_ptr = cur_row_ptr->row_ptr;
-                        } else {
-                                exist_row_m_node = true;
-                                // Update value if node exists
-                                if (cur_row_ptr->row_ptr->row == row && !exist_col_m_node) {
-                                        cur_row_ptr->row_ptr->value = value;
-                                        free(matrix_node);
-                                        return;
-                                }
-                                break;
-                        }
-                }
+        // The lower triangle of a symmetric matrix is read from its mirror
+        if (M->symmetric && row > column) {
+                uint32_t temp = row;
+                row = column;
+                column = temp;
         }
 
-        if (exist_col_m_node && exist_row_m_node) {
-                printf("Node is already exists\n");
-                free(matrix_node);  
-        } else {
-                if (cur_col_ptr) {
-                        matrix_node->col_ptr = cur_col_ptr->col_ptr;
-                        cur_col_ptr->col_ptr = matrix_node;
-                }
-                if (cur_row_ptr) {
-                        matrix_node->row_ptr = cur_row_ptr->row_ptr;
-                        cur_row_ptr->row_ptr = matrix_node;
-                }
+        for (m_node* temp = header_chain(M->rowList, row); temp && temp->column <= column; temp = temp->row_ptr) {
+                if (temp->column == column) return temp->value;
         }
+
+        return 0;
 }
 
 
@@ -342,40 +562,46 @@ void insert_data(matrix* M, uint32_t row, uint32_t column, double value) {
  *
  * @param M - Pointer to the matrix.
  * @param value - Value to search for.
+ * @param found - Output, true if the value exists.
  *
- * @return true if the value exists, false otherwise.
+ * @return SM_OK, SM_ERR_NOT_CREATED, SM_ERR_INVALID_ARG or SM_ERR_ZERO_VALUE.
  */
-bool duplicatevalue(matrix* M, double value) { 
+sm_status duplicatevalue(matrix* M, double value, bool* found) { 
+        if (!found) {
+                return fail(__func__, SM_ERR_INVALID_ARG);
+        }
+        *found = false;
+
         if (!M) {
-                printf("Currently Matrix is not created!!\n");
-                return false;
+                return fail(__func__, SM_ERR_NOT_CREATED);
         }
 
         if (value == 0) {
-                printf("Zero can not be there\n");
-                return false;
+                return fail(__func__, SM_ERR_ZERO_VALUE);
         }
 
         link_list* row_ll = M->rowList;
         if (!row_ll) {
-                return false;
+                return fail(__func__, SM_ERR_NOT_CREATED);
         }
 
-        l_node* temp = row_ll->head;
+        // The mirrored triangle of a symmetric matrix holds the same values, so the stored nodes suffice
+        uint32_t index = 0;
+        l_node* temp;
 
-        while (temp) {
+        while ((temp = next_header(row_ll, &index))) {
                 m_node* temp_row_ptr = temp->matrix_node;
 
                 while (temp_row_ptr) {
                         if (temp_row_ptr->value == value) {
-                                return true;
+                                *found = true;
+                                return SM_OK;
                         }
                         temp_row_ptr = temp_row_ptr->row_ptr;
                 }
-                temp = temp->next;
         }
 
-        return false;
+        return SM_OK;
 }
 
 
@@ -386,18 +612,192 @@ bool duplicatevalue(matrix* M, double value) {
  *
  * @param M - Pointer to the matrix.
  *
- * @return true if resizing is successful, false otherwise.
+ * @return SM_OK, SM_ERR_NOT_CREATED or SM_ERR_OVERFLOW.
  */
-bool resize(matrix* M) { 
+sm_status resize(matrix* M) { 
+        OP_TIMED(timers[TIMER_RESIZE]);
+
         if (!M) {
-                printf("Currently Matrix is not created!!\n");
-                return false;
+                return fail(__func__, SM_ERR_NOT_CREATED);
+        }
+
+        if (M->row > UINT32_MAX / 2 || M->col > UINT32_MAX / 2) {
+                return fail(__func__, SM_ERR_OVERFLOW);
         }
 
         M->row *= 2;
         M->col *= 2;
+        M->generation++;
+
+        return SM_OK;
+}
+
+
+/*
+ * Function: cut_chain
+ * ----------------------------
+ * Ends a row chain before its first column above a limit, or a column chain before its
+ * first row above a limit. Chains are sorted, so everything cut off is being removed.
+ *
+ * @param header - Header of the chain.
+ * @param limit - Largest index that stays.
+ * @param by_column - Whether the chain is a column chain.
+ */
+static void cut_chain(l_node* header, uint32_t limit, bool by_column) {
+        m_node* prev = NULL;
+        m_node* node = header->matrix_node;
+
+        while (node && (by_column ? node->row : node->column) <= limit) {
+                prev = node;
+                node = by_column ? node->col_ptr : node->row_ptr;
+        }
+
+        if (!prev) {
+                header->matrix_node = NULL;
+        } else if (by_column) {
+                prev->col_ptr = NULL;
+        } else {
+                prev->row_ptr = NULL;
+        }
+}
+
+
+/*
+ * Function: truncate_list
+ * ----------------------------
+ * Drops the headers past a size and frees the blocks no remaining header uses.
+ *
+ * @param ll - Pointer to the linked list.
+ * @param size - Number of headers to keep.
+ */
+static void truncate_list(link_list* ll, uint32_t size) {
+        if (ll->size <= size) return;
+
+        uint32_t keep = (size + SM_HEADER_BLOCK - 1) / SM_HEADER_BLOCK;
+        uint32_t used = (ll->size + SM_HEADER_BLOCK - 1) / SM_HEADER_BLOCK;
+
+        // The dropped headers that share the last kept block must not point at freed nodes
+        uint64_t shared = (uint64_t)keep * SM_HEADER_BLOCK;
+        if (shared > ll->size) shared = ll->size;
+        for (uint64_t i = (uint64_t)size + 1; i <= shared; i++) {
+                l_node* header = seek_header(ll, (uint32_t)i);
+                if (header) header->matrix_node = NULL;
+        }
+
+        uint64_t released = 0;
+        for (uint32_t b = keep; b < used; b++) {
+                if (!ll->blocks[b]) continue;
 
-        return true;
+                free(ll->blocks[b]);
+                ll->blocks[b] = NULL;
+                released++;
+        }
+        ll->size = size;
+
+        mem_stats_free(&totals, released * SM_HEADER_BLOCK * sizeof(l_node), 0, released);
+        mem_stats_free(ll->mem, released * SM_HEADER_BLOCK * sizeof(l_node), 0, released);
+        ll->block_count -= (uint32_t)released;
+}
+
+
+/*
+ * Function: resize_to
+ * ----------------------------
+ * Changes the dimensions of the matrix, dropping the values that fall outside.
+ *
+ * @param M - Pointer to the matrix.
+ * @param rows - New number of rows.
+ * @param columns - New number of columns.
+ *
+ * @return SM_OK, SM_ERR_NOT_CREATED, SM_ERR_OUT_OF_BOUNDS or SM_ERR_NO_MEMORY.
+ */
+sm_status resize_to(matrix* M, uint32_t rows, uint32_t columns) {
+        OP_TIMED(timers[TIMER_RESIZE_TO]);
+
+        if (!M || !M->rowList || !M->columnList) {
+                return fail(__func__, SM_ERR_NOT_CREATED);
+        }
+
+        if (M->symmetric && rows != columns) {
+                return fail(__func__, SM_ERR_OUT_OF_BOUNDS);
+        }
+
+        link_list* row_ll = M->rowList;
+        link_list* col_ll = M->columnList;
+
+        if (row_ll->size > rows || col_ll->size > columns) {
+                uint32_t kept_rows = (row_ll->size < rows) ? row_ll->size : rows;
+                uint32_t kept_cols = (col_ll->size < columns) ? col_ll->size : columns;
+
+                // One bit per surviving row and column, so each chain is cut at most once
+                uint64_t* row_cut = (uint64_t*)calloc(kept_rows / 64 + 1, sizeof(uint64_t));
+                uint64_t* col_cut = (uint64_t*)calloc(kept_cols / 64 + 1, sizeof(uint64_t));
+                if (!row_cut || !col_cut) {
+                        free(row_cut);
+                        free(col_cut);
+                        return fail(__func__, SM_ERR_NO_MEMORY);
+                }
+
+                // Surviving columns that reach into the removed rows
+                for (uint32_t i = rows + 1; i <= row_ll->size; i++) {
+                        for (m_node* node = header_chain(row_ll, i); node; node = node->row_ptr) {
+                                uint32_t c = node->column;
+                                if (c > kept_cols || (col_cut[c / 64] >> (c % 64) & 1)) continue;
+
+                                col_cut[c / 64] |= 1ULL << (c % 64);
+                                cut_chain(seek_header(col_ll, c), rows, true);
+                        }
+                }
+
+                // Surviving rows that reach into the removed columns
+                for (uint32_t j = columns + 1; j <= col_ll->size; j++) {
+                        for (m_node* node = header_chain(col_ll, j); node; node = node->col_ptr) {
+                                uint32_t r = node->row;
+                                if (r > kept_rows || (row_cut[r / 64] >> (r % 64) & 1)) continue;
+
+                                row_cut[r / 64] |= 1ULL << (r % 64);
+                                cut_chain(seek_header(row_ll, r), columns, false);
+                        }
+                }
+
+                free(row_cut);
+                free(col_cut);
+
+                // Nodes of removed columns in surviving rows, then every node of the removed rows
+                uint64_t removed = 0;
+                for (uint32_t j = columns + 1; j <= col_ll->size; j++) {
+                        m_node* node = header_chain(col_ll, j);
+                        while (node) {
+                                m_node* next = node->col_ptr;
+                                if (node->row <= rows) {
+                                        free(node);
+                                        removed++;
+                                }
+                                node = next;
+                        }
+                }
+                for (uint32_t i = rows + 1; i <= row_ll->size; i++) {
+                        m_node* node = header_chain(row_ll, i);
+                        while (node) {
+                                m_node* next = node->row_ptr;
+                                free(node);
+                                removed++;
+                                node = next;
+                        }
+                }
+                flush_mat_nodes(M);
+                count_mat_nodes(0, removed);
+                mem_stats_free(&M->mem, removed * sizeof(m_node), removed, removed);
+
+                truncate_list(row_ll, rows);
+                truncate_list(col_ll, columns);
+        }
+
+        M->row = rows;
+        M->col = columns;
+        M->generation++;
+
+        return SM_OK;
 }
 
 
@@ -408,12 +808,18 @@ bool resize(matrix* M) {
  *
  * @param M - Pointer to the matrix.
  *
- * @return true if transposition is successful, false otherwise.
+ * @return SM_OK or SM_ERR_NOT_CREATED.
  */
-bool transpose(matrix* M) {  
+sm_status transpose(matrix* M) {  
+        OP_TIMED(timers[TIMER_TRANSPOSE]);
+
         if (!M) {
-                printf("Currently Matrix is not created!!\n");
-                return false;
+                return fail(__func__, SM_ERR_NOT_CREATED);
+        }
+
+        // A symmetric matrix is its own transpose
+        if (M->symmetric) {
+                return SM_OK;
         }
 
         // Swapping the size values
@@ -428,12 +834,13 @@ bool transpose(matrix* M) {
 
         link_list* row_ll = M->rowList;
         if (!row_ll) {
-                return false;
+                return fail(__func__, SM_ERR_NOT_CREATED);
         }
 
-        l_node* temp_node = row_ll->head;
+        uint32_t index = 0;
+        l_node* temp_node;
 
-        while (temp_node) {
+        while ((temp_node = next_header(row_ll, &index))) {
                 m_node* temp_row_ptr = temp_node->matrix_node;
                 while (temp_row_ptr) {
                         // Swap row and column of each node
@@ -448,10 +855,56 @@ bool transpose(matrix* M) {
                         
                         temp_row_ptr = temp_row_ptr->row_ptr;
                 }
-                temp_node = temp_node->next;
         }
 
-        return true;
+        M->generation++;
+        return SM_OK;
+}
+
+
+/*
+ * Function: spmv_S_Matrix
+ * ----------------------------
+ * Computes y = M * x.
+ *
+ * @param M - Pointer to the matrix.
+ * @param x - Input vector of M->col entries.
+ * @param y - Output vector of M->row entries.
+ *
+ * @return SM_OK or SM_ERR_NOT_CREATED.
+ */
+sm_status spmv_S_Matrix(matrix* M, const double* x, double* y) {
+        OP_TIMED(timers[TIMER_SPMV]);
+
+        if (!M) {
+                return fail(__func__, SM_ERR_NOT_CREATED);
+        }
+
+        for (uint32_t i = 0; i < M->row; i++) {
+                y[i] = 0;
+        }
+
+        if (!M->rowList) {
+                return SM_OK;
+        }
+
+        uint32_t row_index = 0;
+        l_node* temp;
+
+        while ((temp = next_header(M->rowList, &row_index)) && row_index <= M->row) {
+                double sum = 0;
+                for (m_node* temp_row_ptr = temp->matrix_node; temp_row_ptr; temp_row_ptr = temp_row_ptr->row_ptr) {
+                        sum += temp_row_ptr->value * x[temp_row_ptr->column - 1];
+
+                        // The mirrored entry (column, row) of a symmetric matrix
+                        if (M->symmetric && temp_row_ptr->column != row_index) {
+                                y[temp_row_ptr->column - 1] += temp_row_ptr->value * x[row_index - 1];
+                        }
+                }
+                y[row_index - 1] += sum;
+        }
+
+        return SM_OK;
 }
 
 
@@ -475,17 +928,24 @@ void displayMatrix(matrix* M) {
                 return;
         }
 
-        l_node* temp = row_ll->head;
+        // A symmetric matrix reads the lower triangle of row i from the stored column i
+        link_list* col_ll = (M->symmetric && M->columnList) ? M->columnList : NULL;
+        uint32_t headers = row_ll->size;
+        if (col_ll && col_ll->size > headers) headers = col_ll->size;
 
         uint32_t row_index = 1;
 
-        if (temp) {
-                while (temp && row_index <= M->row) {
+        if (headers) {
+                while (row_index <= headers && row_index <= M->row) {
                         uint32_t col_index = 1;
-                        m_node* temp_row_ptr = temp->matrix_node;
-                        
+                        m_node* temp_row_ptr = header_chain(row_ll, row_index);
+                        m_node* temp_col_ptr = col_ll ? header_chain(col_ll, row_index) : NULL;
+
                         while (col_index <= M->col) {
-                                if (temp_row_ptr && temp_row_ptr->column == col_index) {
+                                if (temp_col_ptr && temp_col_ptr->row == col_index && col_index < row_index) {
+                                        printf("%6.1f", temp_col_ptr->value);
+                                        temp_col_ptr = temp_col_ptr->col_ptr;
+                                } else if (temp_row_ptr && temp_row_ptr->column == col_index) {
                                         printf("%6.1f", temp_row_ptr->value); 
                                         temp_row_ptr = temp_row_ptr->row_ptr;
                                 } else {
@@ -495,7 +955,6 @@ void displayMatrix(matrix* M) {
                         }
                         
                         printf("\n");
-                        temp = temp->next;
                         row_index++;
                 }
                 
@@ -527,48 +986,98 @@ void displayMatrix(matrix* M) {
  * @param M - Pointer to the matrix.
  */
 void free_S_Matrix(matrix* M) {
-        if (!M) {
-                return;
-        }
+        OP_TIMED(timers[TIMER_FREE]);
 
-        link_list* row_ll = M->rowList;
-        if (!row_ll) {
-                free(M->columnList);
-                free(M);
+        if (!M) {
                 return;
         }
 
-        link_list* col_ll = M->columnList;
-        l_node* temp = row_ll->head;
-        l_node* back_node = NULL;
-
         // Free all matrix nodes through row list only
-        while (temp) {
-                back_node = temp;
-                m_node* temp_row_ptr = temp->matrix_node;
-                m_node* back_row_ptr = NULL;
-                while (temp_row_ptr) {
-                        back_row_ptr = temp_row_ptr;
-                        temp_row_ptr = temp_row_ptr->row_ptr;
-                        free(back_row_ptr);
-                }
-                temp = temp->next;
-                free(back_node);
-        }
-
-        // Free row list
-        free(row_ll);
-        
-        // Free column list nodes
-        if (col_ll) {
-                l_node* temp_col = col_ll->head;
-                while (temp_col) {
-                        l_node* back_col_node = temp_col;
-                        temp_col = temp_col->next;
-                        free(back_col_node);
+        uint64_t removed = 0;
+        if (M->rowList) {
+                uint32_t index = 0;
+                for (l_node* temp; (temp = next_header(M->rowList, &index));) {
+                        m_node* temp_row_ptr = temp->matrix_node;
+                        while (temp_row_ptr) {
+                                m_node* back_row_ptr = temp_row_ptr;
+                                temp_row_ptr = temp_row_ptr->row_ptr;
+                                free(back_row_ptr);
+                                removed++;
+                        }
                 }
-                free(col_ll);
         }
-        
+        flush_mat_nodes(M);
+        count_mat_nodes(0, removed);
+
+        free_link_list(M->rowList);
+        free_link_list(M->columnList);
         free(M);
+        mem_stats_free(&totals, sizeof(matrix), 0, 1);
+}
+
+
+/*
+ * Function: sm_memory
+ * ----------------------------
+ * Reads the memory statistics of one matrix.
+ *
+ * @param M - Pointer to the matrix.
+ * @param out - Output statistics; zeroed if M is NULL.
+ */
+void sm_memory(matrix* M, mem_stats* out) {
+        if (!out) return;
+
+        if (!M) {
+                *out = (mem_stats){ 0 };
+                return;
+        }
+
+        mem_stats_read(&M->mem, out);
+}
+
+
+/*
+ * Function: sm_memory_totals
+ * ----------------------------
+ * Reads the memory statistics of all matrices of the process together.
+ *
+ * @param out - Output statistics.
+ *
+ * Description:
+ *   Each matrix adds the nodes of its single inserts SM_COUNT_BATCH at a time, so up to
+ *   SM_COUNT_BATCH - 1 of its newest nodes may not be in the totals yet.
+ */
+void sm_memory_totals(mem_stats* out) {
+        if (out) mem_stats_read(&totals, out);
+}
+
+
+/*
+ * Function: sm_timers
+ * ----------------------------
+ * Gets the timers of the main matrix operations.
+ *
+ * @param count - Output, number of timers.
+ *
+ * @return The timers.
+ */
+const op_timer* sm_timers(uint32_t* count) {
+        if (count) *count = TIMER_COUNT;
+        return timers;
+}
+
+
+/*
+ * Function: sm_memory_json
+ * ----------------------------
+ * Writes the library totals, the statistics of one matrix and the timers as JSON.
+ *
+ * @param out - Destination stream.
+ * @param M - Pointer to the matrix, or NULL for the totals and timers only.
+ *
+ * @return true if the JSON was written, false on a stream error.
+ */
+bool sm_memory_json(FILE* out, matrix* M) {
+        flush_mat_nodes(M);
+        return instrument_json(out, "S_Matrix", &totals, M ? &M->mem : NULL, M ? 1 : 0, timers, TIMER_COUNT);
 }
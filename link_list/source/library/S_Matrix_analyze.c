@@ -0,0 +1,267 @@
+/*
+ * File Name: S_Matrix_analyze.c
+ * Authors: Arpit Patel, Dharm KaPatel
+ * Date: 2025-03-19
+ * Description: This file implements the structure analyzer of the S_Matrix data structure.
+ *              Rows are examined in bands of SM_ANALYZE_BLOCK so the block density can be measured
+ *              by merging the band's row chains, and the column list is walked in step with the row
+ *              list so symmetry is checked without any lookups.
+ */
+
+
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+
+#include "../include/S_Matrix_analyze.h"
+
+
+// Initial slots of the distinct value set; it doubles while at least half full
+#define SM_VALUE_SET_INITIAL 1024
+
+
+/*
+ * Struct: value_set
+ * ----------------------------
+ * Open-addressing set of value bit patterns.
+ *
+ * keys: Stored bit patterns.
+ * used: Whether each slot holds a key.
+ * capacity: Number of slots (a power of two).
+ * count: Number of keys, saturating at SM_DISTINCT_CAP.
+ */
+typedef struct value_set {
+        uint64_t* keys;
+        uint8_t* used;
+        uint32_t capacity;
+        uint32_t count;
+} value_set;
+
+
+static inline uint32_t slot_of(uint64_t key, uint32_t capacity) {
+        return (uint32_t)((key * 0x9E3779B97F4A7C15ULL) >> 32) & (capacity - 1);
+}
+
+
+static bool value_set_init(value_set* S, uint32_t capacity) {
+        S->keys = (uint64_t*)malloc(capacity * sizeof(uint64_t));
+        S->used = (uint8_t*)calloc(capacity, sizeof(uint8_t));
+        S->capacity = capacity;
+        S->count = 0;
+
+        if (!S->keys || !S->used) {
+                free(S->keys);
+                free(S->used);
+                return false;
+        }
+        return true;
+}
+
+
+static void value_set_insert(value_set* S, uint64_t key) {
+        uint32_t slot = slot_of(key, S->capacity);
+        while (S->used[slot]) {
+                if (S->keys[slot] == key) return;
+                slot = (slot + 1) & (S->capacity - 1);
+        }
+
+        S->used[slot] = 1;
+        S->keys[slot] = key;
+        S->count++;
+}
+
+
+/*
+ * Function: value_set_add
+ * ----------------------------
+ * Adds a value to the set, growing it when half full.
+ *
+ * @param S - Pointer to the set.
+ * @param value - The value; compared by bit pattern.
+ *
+ * @return true on success, false if the set can not grow.
+ */
+static bool value_set_add(value_set* S, double value) {
+        if (S->count >= SM_DISTINCT_CAP) return true;
+
+        if (2 * (S->count + 1) > S->capacity) {
+                value_set grown;
+                if (!value_set_init(&grown, 2 * S->capacity)) return false;
+
+                for (uint32_t i = 0; i < S->capacity; i++) {
+                        if (S->used[i]) value_set_insert(&grown, S->keys[i]);
+                }
+                free(S->keys);
+                free(S->used);
+                *S = grown;
+        }
+
+        uint64_t key;
+        memcpy(&key, &value, sizeof(key));
+        value_set_insert(S, key);
+
+        return true;
+}
+
+
+/*
+ * Function: row_histogram_bin
+ * ----------------------------
+ * Gets the histogram bin of a row length.
+ *
+ * @param length - Number of non-zeros of the row.
+ *
+ * @return The bin, in [0, SM_ROW_HISTOGRAM_BINS).
+ */
+uint32_t row_histogram_bin(uint32_t length) {
+        return length ? 32 - (uint32_t)__builtin_clz(length) : 0;
+}
+
+
+/*
+ * Function: count_blocks
+ * ----------------------------
+ * Merges the row chains of one band and counts its occupied column blocks.
+ *
+ * @param chains - First node of each row chain of the band (consumed).
+ * @param count - Number of rows in the band.
+ * @param stored - Incremented by the number of nodes in the band.
+ *
+ * @return Number of occupied SM_ANALYZE_BLOCK-wide column blocks.
+ */
+static uint64_t count_blocks(m_node** chains, uint32_t count, uint64_t* stored) {
+        uint64_t occupied = 0;
+
+        for (;;) {
+                uint32_t block = UINT32_MAX;
+                for (uint32_t r = 0; r < count; r++) {
+                        if (chains[r] && (chains[r]->column - 1) / SM_ANALYZE_BLOCK < block) {
+                                block = (chains[r]->column - 1) / SM_ANALYZE_BLOCK;
+                        }
+                }
+                if (block == UINT32_MAX) return occupied;
+
+                occupied++;
+                for (uint32_t r = 0; r < count; r++) {
+                        while (chains[r] && (chains[r]->column - 1) / SM_ANALYZE_BLOCK == block) {
+                                (*stored)++;
+                                chains[r] = chains[r]->row_ptr;
+                        }
+                }
+        }
+}
+
+
+static inline uint32_t distance(uint32_t a, uint32_t b) {
+        return (a > b) ? a - b : b - a;
+}
+
+
+/*
+ * Function: analyze_S_Matrix
+ * ----------------------------
+ * Computes the structure statistics of a matrix.
+ *
+ * @param M - Pointer to the matrix.
+ * @param sample_rows - Upper bound on the rows to examine, or 0 to examine all of them.
+ * @param stats - Output statistics.
+ *
+ * @return true on success, false if M is NULL or the value set can not be allocated.
+ */
+bool analyze_S_Matrix(matrix* M, uint32_t sample_rows, sm_structure* stats) {
+        if (!M || !M->rowList || !stats) return false;
+
+        memset(stats, 0, sizeof(sm_structure));
+        stats->row = M->row;
+        stats->col = M->col;
+
+        value_set values;
+        if (!value_set_init(&values, SM_VALUE_SET_INITIAL)) return false;
+
+        uint32_t bands = (M->row + SM_ANALYZE_BLOCK - 1) / SM_ANALYZE_BLOCK;
+        uint32_t stride = 1;
+        if (sample_rows && sample_rows < M->row) {
+                uint32_t wanted = sample_rows / SM_ANALYZE_BLOCK ? sample_rows / SM_ANALYZE_BLOCK : 1;
+                stride = (bands + wanted - 1) / wanted;
+        }
+        stats->sampled = stride > 1;
+
+        bool symmetric = (M->row == M->col);
+        uint64_t examined_nnz = 0;
+        uint64_t occupied = 0;
+        uint64_t stored = 0;
+
+        for (uint32_t band = 0; band < bands; band++) {
+                uint32_t first = band * SM_ANALYZE_BLOCK + 1;
+                uint32_t count = (M->row - first + 1 < SM_ANALYZE_BLOCK) ? M->row - first + 1 : SM_ANALYZE_BLOCK;
+
+                m_node* chains[SM_ANALYZE_BLOCK];
+                m_node* columns[SM_ANALYZE_BLOCK];
+                if (band % stride) continue;
+
+                for (uint32_t r = 0; r < count; r++) {
+                        chains[r] = header_chain(M->rowList, first + r);
+                        columns[r] = M->columnList ? header_chain(M->columnList, first + r) : NULL;
+                }
+                stats->rows_examined += count;
+
+                for (uint32_t r = 0; r < count; r++) {
+                        uint32_t row = first + r;
+                        uint32_t length = 0;
+
+                        for (m_node* node = chains[r]; node; node = node->row_ptr) {
+                                length++;
+                                if (distance(row, node->column) > stats->bandwidth) stats->bandwidth = distance(row, node->column);
+                                if (!value_set_add(&values, node->value)) {
+                                        free(values.keys);
+                                        free(values.used);
+                                        return false;
+                                }
+                        }
+
+                        if (M->symmetric) {
+                                // The mirrored part of row r is the stored column r above the diagonal
+                                for (m_node* node = columns[r]; node && node->row < row; node = node->col_ptr) {
+                                        length++;
+                                }
+                        } else if (symmetric) {
+                                // Row r of a symmetric matrix reads the same as column r
+                                m_node* a = chains[r];
+                                m_node* b = columns[r];
+                                while (a && b && a->column == b->row && a->value == b->value) {
+                                        a = a->row_ptr;
+                                        b = b->col_ptr;
+                                }
+                                if (a || b) symmetric = false;
+                        }
+
+                        stats->row_histogram[row_histogram_bin(length)]++;
+                        if (length > stats->max_row_nnz) stats->max_row_nnz = length;
+                        examined_nnz += length;
+                }
+
+                occupied += count_blocks(chains, count, &stored);
+        }
+
+        stats->symmetric = M->symmetric || symmetric;
+        stats->block_density = occupied ? (double)stored / ((double)occupied * SM_ANALYZE_BLOCK * SM_ANALYZE_BLOCK) : 0;
+        stats->distinct_values = values.count;
+
+        // Counts of the examined rows are scaled up to the whole matrix
+        if (stats->rows_examined && stats->rows_examined < M->row) {
+                double scale = (double)M->row / stats->rows_examined;
+                stats->nnz = (uint64_t)(examined_nnz * scale + 0.5);
+                for (uint32_t b = 0; b < SM_ROW_HISTOGRAM_BINS; b++) {
+                        stats->row_histogram[b] = (uint64_t)(stats->row_histogram[b] * scale + 0.5);
+                }
+        } else {
+                stats->nnz = examined_nnz;
+        }
+
+        free(values.keys);
+        free(values.used);
+        return true;
+}
@@ -0,0 +1,473 @@
+/*
+ * File Name: S_Matrix_buffered.c
+ * Authors: Arpit Patel, Dharm KaPatel
+ * Date: 2025-03-19
+ * Description: This file implements the write-buffered sparse matrix. The buffer holds one
+ *              entry per position, found through a hash index. Its prefix is kept in row-major
+ *              order: a read sorts only the entries appended since the last one and merges them
+ *              into the prefix, then merges the buffer row by row with the CSR base.
+ */
+
+
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+
+#include "../include/S_Matrix_buffered.h"
+
+
+/*
+ * Struct: csr_fill_ctx
+ * ----------------------------
+ * State of the visitor that writes merged non-zeros into a new CSR matrix.
+ *
+ * A: CSR matrix being filled; row_ptr collects per-row counts.
+ * k: Number of non-zeros written so far.
+ */
+typedef struct csr_fill_ctx {
+        csr_matrix* A;
+        uint64_t k;
+} csr_fill_ctx;
+
+
+static void csr_fill_visit(uint32_t row, uint32_t column, double value, void* ctx) {
+        csr_fill_ctx* fill = (csr_fill_ctx*)ctx;
+        fill->A->col_idx[fill->k] = column;
+        fill->A->values[fill->k] = value;
+        fill->A->row_ptr[row]++;
+        fill->k++;
+}
+
+
+/*
+ * Function: position_hash
+ * ----------------------------
+ * Hashes a position for the buffer index.
+ *
+ * @param row - Row index.
+ * @param column - Column index.
+ *
+ * @return The hash; callers mask it to the table size.
+ */
+static inline uint64_t position_hash(uint32_t row, uint32_t column) {
+        uint64_t key = (((uint64_t)row << 32) | column) * 0x9E3779B97F4A7C15ULL;
+        return key ^ (key >> 29);
+}
+
+
+/*
+ * Function: find_cell
+ * ----------------------------
+ * Finds the index cell of a position by linear probing.
+ *
+ * @param B - Pointer to the buffered matrix (with an index).
+ * @param row - Row index.
+ * @param column - Column index.
+ *
+ * @return The cell holding the position's buffer slot + 1, or the empty cell where it belongs.
+ */
+static uint64_t* find_cell(b_matrix* B, uint32_t row, uint32_t column) {
+        uint64_t i = position_hash(row, column) & B->index_mask;
+
+        while (B->index[i]) {
+                sm_triplet* t = &B->buffer[B->index[i] - 1];
+                if (t->row == row && t->column == column) break;
+                i = (i + 1) & B->index_mask;
+        }
+
+        return &B->index[i];
+}
+
+
+/*
+ * Function: rebuild_index
+ * ----------------------------
+ * Clears the index and enters every buffered entry again, after the buffer has moved.
+ *
+ * @param B - Pointer to the buffered matrix (with an index).
+ */
+static void rebuild_index(b_matrix* B) {
+        memset(B->index, 0, (B->index_mask + 1) * sizeof(uint64_t));
+
+        for (uint64_t slot = 0; slot < B->buf_size; slot++) {
+                *find_cell(B, B->buffer[slot].row, B->buffer[slot].column) = slot + 1;
+        }
+}
+
+
+/*
+ * Function: sort_buffer
+ * ----------------------------
+ * Brings the whole buffer into row-major order.
+ *
+ * @param B - Pointer to the buffered matrix.
+ *
+ * @return true on success, false if the scratch space can not be allocated (the buffer is unchanged).
+ *
+ * Description:
+ *   The unsorted tail is sorted on its own and merged into the sorted prefix from the back,
+ *   so only the entries appended since the last call are sorted.
+ */
+static bool sort_buffer(b_matrix* B) {
+        uint64_t tail = B->buf_size - B->sorted;
+        if (!tail) return true;
+
+        sm_triplet* scratch = (sm_triplet*)malloc(tail * sizeof(sm_triplet));
+        if (!scratch) return false;
+
+        memcpy(scratch, B->buffer + B->sorted, tail * sizeof(sm_triplet));
+        if (!sort_triplets(scratch, tail)) {
+                free(scratch);
+                return false;
+        }
+
+        // Positions are unique, so the merge never sees a tie
+        uint64_t i = B->sorted;
+        uint64_t j = tail;
+        uint64_t k = B->buf_size;
+        while (j > 0) {
+                sm_triplet* a = (i > 0) ? &B->buffer[i - 1] : NULL;
+                sm_triplet* b = &scratch[j - 1];
+                bool take_prefix = a && (a->row > b->row || (a->row == b->row && a->column > b->column));
+                B->buffer[--k] = take_prefix ? B->buffer[--i] : scratch[--j];
+        }
+
+        free(scratch);
+        B->sorted = B->buf_size;
+        rebuild_index(B);
+
+        return true;
+}
+
+
+/*
+ * Function: merge_row
+ * ----------------------------
+ * Merges one base row with the buffered entries of the same row.
+ *
+ * @param base - Pointer to the CSR base.
+ * @param row - Row index.
+ * @param delta - Buffered entries of this row, sorted by column, one per column.
+ * @param count - Number of buffered entries.
+ * @param visit - Callback receiving each non-zero.
+ * @param ctx - Caller context passed to the callback.
+ *
+ * Description:
+ *   A buffered entry overrides the base value at the same column.
+ */
+static void merge_row(csr_matrix* base, uint32_t row, sm_triplet* delta, uint64_t count, sm_visit_fn visit, void* ctx) {
+        uint64_t i = base->row_ptr[row - 1];
+        uint64_t end = base->row_ptr[row];
+        uint64_t j = 0;
+
+        while (i < end || j < count) {
+                if (j >= count || (i < end && base->col_idx[i] < delta[j].column)) {
+                        visit(row, base->col_idx[i], base->values[i], ctx);
+                        i++;
+                } else {
+                        if (i < end && base->col_idx[i] == delta[j].column) i++;
+                        visit(row, delta[j].column, delta[j].value, ctx);
+                        j++;
+                }
+        }
+}
+
+
+/*
+ * Function: create_buffered_matrix
+ * ----------------------------
+ * Creates an empty write-buffered matrix.
+ *
+ * @param rows - Number of rows.
+ * @param columns - Number of columns.
+ * @param compact_threshold - Buffer size that triggers compaction, or 0 for explicit bm_compact only.
+ *
+ * @return Pointer to the matrix, or NULL if allocation fails.
+ */
+b_matrix* create_buffered_matrix(uint32_t rows, uint32_t columns, uint64_t compact_threshold) {
+        csr_matrix* base = create_csr_matrix(rows, columns, 0);
+        if (!base) return NULL;
+
+        b_matrix* B = (b_matrix*)malloc(sizeof(b_matrix));
+        if (!B) {
+                free_csr_matrix(base);
+                return NULL;
+        }
+
+        B->base = base;
+        B->buffer = NULL;
+        B->buf_size = 0;
+        B->buf_cap = 0;
+        B->sorted = 0;
+        B->index = NULL;
+        B->index_mask = 0;
+        B->compact_threshold = compact_threshold;
+
+        return B;
+}
+
+
+/*
+ * Function: buffered_from_S_Matrix
+ * ----------------------------
+ * Creates a write-buffered matrix whose base holds the contents of a linked matrix.
+ *
+ * @param M - Pointer to the matrix.
+ * @param compact_threshold - Buffer size that triggers compaction, or 0 for explicit bm_compact only.
+ *
+ * @return Pointer to the matrix, or NULL if allocation fails.
+ */
+b_matrix* buffered_from_S_Matrix(matrix* M, uint64_t compact_threshold) {
+        csr_matrix* base = csr_from_S_Matrix(M);
+        if (!base) return NULL;
+
+        b_matrix* B = (b_matrix*)malloc(sizeof(b_matrix));
+        if (!B) {
+                free_csr_matrix(base);
+                return NULL;
+        }
+
+        B->base = base;
+        B->buffer = NULL;
+        B->buf_size = 0;
+        B->buf_cap = 0;
+        B->sorted = 0;
+        B->index = NULL;
+        B->index_mask = 0;
+        B->compact_threshold = compact_threshold;
+
+        return B;
+}
+
+
+/*
+ * Function: bm_insert_data
+ * ----------------------------
+ * Appends a value for the specified row and column to the write buffer.
+ *
+ * @param B - Pointer to the buffered matrix.
+ * @param row - Row index.
+ * @param column - Column index.
+ * @param value - Value to be inserted.
+ *
+ * @return SM_OK, SM_ERR_NOT_CREATED, SM_ERR_ZERO_VALUE, SM_ERR_OUT_OF_BOUNDS or SM_ERR_NO_MEMORY.
+ */
+sm_status bm_insert_data(b_matrix* B, uint32_t row, uint32_t column, double value) {
+        if (!B) return sm_fail(__func__, SM_ERR_NOT_CREATED);
+        if (value == 0) return sm_fail(__func__, SM_ERR_ZERO_VALUE);
+
+        if (row > B->base->row || row < 1 || column > B->base->col || column < 1) {
+                return sm_fail(__func__, SM_ERR_OUT_OF_BOUNDS);
+        }
+
+        // A buffered position is overwritten in place; its place in the order does not change
+        if (B->index) {
+                uint64_t* cell = find_cell(B, row, column);
+                if (*cell) {
+                        B->buffer[*cell - 1].value = value;
+                        return SM_OK;
+                }
+        }
+
+        if (B->buf_size == B->buf_cap) {
+                uint64_t new_cap = B->buf_cap ? B->buf_cap * 2 : 64;
+                sm_triplet* buffer = (sm_triplet*)realloc(B->buffer, new_cap * sizeof(sm_triplet));
+                if (!buffer) return sm_fail(__func__, SM_ERR_NO_MEMORY);
+                B->buffer = buffer;
+
+                // The index keeps at most half of its cells in use
+                uint64_t* index = (uint64_t*)malloc(2 * new_cap * sizeof(uint64_t));
+                if (!index) return sm_fail(__func__, SM_ERR_NO_MEMORY);
+                free(B->index);
+                B->index = index;
+                B->index_mask = 2 * new_cap - 1;
+                B->buf_cap = new_cap;
+                rebuild_index(B);
+        }
+
+        sm_triplet* t = &B->buffer[B->buf_size];
+        t->row = row;
+        t->column = column;
+        t->value = value;
+        *find_cell(B, row, column) = ++B->buf_size;
+
+        if (B->compact_threshold && B->buf_size >= B->compact_threshold) {
+                // A failed compaction keeps the entry buffered, so the insert still succeeded
+                bm_compact(B);
+        }
+
+        return SM_OK;
+}
+
+
+/*
+ * Function: bm_get
+ * ----------------------------
+ * Reads a single element, looking at the buffer first and the base second.
+ *
+ * @param B - Pointer to the buffered matrix.
+ * @param row - Row index.
+ * @param column - Column index.
+ *
+ * @return The current value, or 0 if the position is empty.
+ */
+double bm_get(b_matrix* B, uint32_t row, uint32_t column) {
+        if (!B) return 0;
+
+        if (B->buf_size) {
+                uint64_t* cell = find_cell(B, row, column);
+                if (*cell) return B->buffer[*cell - 1].value;
+        }
+
+        return csr_get(B->base, row, column);
+}
+
+
+/*
+ * Function: bm_scan
+ * ----------------------------
+ * Visits every non-zero in row-major order, merging the buffer with the base.
+ *
+ * @param B - Pointer to the buffered matrix.
+ * @param visit - Callback receiving each non-zero.
+ * @param ctx - Caller context passed to the callback.
+ *
+ * @return true on success, false if the scratch space can not be allocated.
+ */
+bool bm_scan(b_matrix* B, sm_visit_fn visit, void* ctx) {
+        if (!B || !visit) return false;
+
+        if (!sort_buffer(B)) return false;
+
+        sm_triplet* delta = B->buffer;
+        uint64_t j = 0;
+        for (uint32_t r = 1; r <= B->base->row; r++) {
+                uint64_t start = j;
+                while (j < B->buf_size && delta[j].row == r) j++;
+
+                merge_row(B->base, r, delta + start, j - start, visit, ctx);
+        }
+
+        return true;
+}
+
+
+/*
+ * Function: bm_scan_row
+ * ----------------------------
+ * Visits the non-zeros of one row in column order, merging the buffer with the base.
+ *
+ * @param B - Pointer to the buffered matrix.
+ * @param row - Row index.
+ * @param visit - Callback receiving each non-zero.
+ * @param ctx - Caller context passed to the callback.
+ *
+ * @return true on success, false if the scratch space can not be allocated.
+ */
+bool bm_scan_row(b_matrix* B, uint32_t row, sm_visit_fn visit, void* ctx) {
+        if (!B || !visit || row < 1 || row > B->base->row) return false;
+
+        if (!sort_buffer(B)) return false;
+
+        // First buffered entry of the row, then the end of its run
+        uint64_t lo = 0;
+        uint64_t hi = B->buf_size;
+        while (lo < hi) {
+                uint64_t mid = lo + (hi - lo) / 2;
+                if (B->buffer[mid].row < row) lo = mid + 1;
+                else hi = mid;
+        }
+
+        uint64_t end = lo;
+        while (end < B->buf_size && B->buffer[end].row == row) end++;
+
+        merge_row(B->base, row, B->buffer + lo, end - lo, visit, ctx);
+
+        return true;
+}
+
+
+/*
+ * Function: bm_compact
+ * ----------------------------
+ * Folds the write buffer into the base.
+ *
+ * @param B - Pointer to the buffered matrix.
+ *
+ * @return SM_OK, SM_ERR_NOT_CREATED or SM_ERR_NO_MEMORY (the matrix is left unchanged).
+ */
+sm_status bm_compact(b_matrix* B) {
+        if (!B) return sm_fail(__func__, SM_ERR_NOT_CREATED);
+        if (!B->buf_size) return SM_OK;
+
+        csr_matrix* base = B->base;
+        csr_matrix* merged = create_csr_matrix(base->row, base->col, base->nnz + B->buf_size);
+        if (!merged) return sm_fail(__func__, SM_ERR_NO_MEMORY);
+
+        // bm_scan can only fail to allocate its scratch space here
+        csr_fill_ctx fill = { merged, 0 };
+        if (!bm_scan(B, csr_fill_visit, &fill)) {
+                free_csr_matrix(merged);
+                return sm_fail(__func__, SM_ERR_NO_MEMORY);
+        }
+
+        // Turn per-row counts into offsets
+        for (uint32_t r = 1; r <= merged->row; r++) {
+                merged->row_ptr[r] += merged->row_ptr[r - 1];
+        }
+
+        // Overwrites leave the arrays larger than needed; shrinking is best effort
+        merged->nnz = fill.k;
+        if (fill.k) {
+                uint32_t* col_idx = (uint32_t*)realloc(merged->col_idx, fill.k * sizeof(uint32_t));
+                if (col_idx) merged->col_idx = col_idx;
+                double* values = (double*)realloc(merged->values, fill.k * sizeof(double));
+                if (values) merged->values = values;
+        }
+
+        free_csr_matrix(base);
+        B->base = merged;
+        B->buf_size = 0;
+        B->sorted = 0;
+        rebuild_index(B);
+
+        return SM_OK;
+}
+
+
+/*
+ * Function: S_Matrix_from_buffered
+ * ----------------------------
+ * Compacts the buffered matrix and builds a linked matrix from it.
+ *
+ * @param B - Pointer to the buffered matrix.
+ *
+ * @return Pointer to the matrix, or NULL if allocation fails.
+ */
+matrix* S_Matrix_from_buffered(b_matrix* B) {
+        if (!B || bm_compact(B) != SM_OK) return NULL;
+
+        return S_Matrix_from_csr(B->base);
+}
+
+
+/*
+ * Function: free_buffered_matrix
+ * ----------------------------
+ * Frees all memory associated with the buffered matrix.
+ *
+ * @param B - Pointer to the buffered matrix.
+ */
+void free_buffered_matrix(b_matrix* B) {
+        if (!B) {
+                return;
+        }
+
+        free_csr_matrix(B->base);
+        free(B->buffer);
+        free(B->index);
+        free(B);
+}
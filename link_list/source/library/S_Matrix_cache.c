@@ -0,0 +1,470 @@
+/*
+ * File Name: S_Matrix_cache.c
+ * Authors: Arpit Patel, Dharm KaPatel
+ * Date: 2025-03-19
+ * Description: This file implements the derived-result cache of the S_Matrix data structure.
+ *              Entries sit in a doubly linked list in order of use, so a hit moves its entry to
+ *              the front and eviction takes entries from the back. A cache holds a handful of
+ *              entries, so lookups scan the list.
+ */
+
+
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+
+#include "../include/S_Matrix_cache.h"
+
+
+/*
+ * Struct: sm_cache_entry
+ * ----------------------------
+ * One cached result.
+ *
+ * op: Kind of result.
+ * arg: Parameter of the result (reduction kind or workload), 0 when there is none.
+ * bytes: Memory the result takes.
+ * data: The result.
+ * prev: More recently used entry.
+ * next: Less recently used entry.
+ */
+typedef struct sm_cache_entry {
+        sm_cache_op op;
+        uint32_t arg;
+        size_t bytes;
+        void* data;
+        struct sm_cache_entry* prev;
+        struct sm_cache_entry* next;
+} sm_cache_entry;
+
+
+/*
+ * Function: csr_bytes
+ * ----------------------------
+ * Gets the memory held by a CSR matrix: the struct, row_ptr, col_idx and values.
+ *
+ * @param A - Pointer to the CSR matrix.
+ *
+ * @return Number of bytes.
+ */
+static size_t csr_bytes(csr_matrix* A) {
+        return sizeof(csr_matrix) + ((size_t)A->row + 1) * sizeof(uint64_t) + A->nnz * (sizeof(uint32_t) + sizeof(double));
+}
+
+
+/*
+ * Function: plan_bytes
+ * ----------------------------
+ * Gets the memory held by a product plan, counting whichever of its CSR form, compressed
+ * form and permutations it carries.
+ *
+ * @param P - Pointer to the plan.
+ *
+ * @return Number of bytes.
+ *
+ * Description:
+ *   A reordered plan holds four permutation arrays, row_perm and row_inverse of stats.row
+ *   entries and col_perm and col_inverse of stats.col entries.
+ */
+static size_t plan_bytes(sm_plan* P) {
+        size_t bytes = sizeof(sm_plan);
+        if (P->csr) bytes += csr_bytes(P->csr);
+        if (P->compressed) bytes += zm_bytes(P->compressed);
+        if (P->row_perm) bytes += 2 * ((size_t)P->stats.row + P->stats.col) * sizeof(uint32_t);
+        return bytes;
+}
+
+
+/*
+ * Function: free_result
+ * ----------------------------
+ * Frees a cached result with the function matching its kind.
+ *
+ * @param op - Kind of the result.
+ * @param data - The result.
+ */
+static void free_result(sm_cache_op op, void* data) {
+        switch (op) {
+        case SM_CACHE_CSR:
+        case SM_CACHE_TRANSPOSE:
+                free_csr_matrix((csr_matrix*)data);
+                break;
+        case SM_CACHE_COMPRESSED:
+                free_compressed_matrix((z_matrix*)data);
+                break;
+        case SM_CACHE_PLAN:
+                free_plan((sm_plan*)data);
+                break;
+        case SM_CACHE_ROW_REDUCE:
+        case SM_CACHE_COLUMN_REDUCE:
+                free(data);
+                break;
+        }
+}
+
+
+/*
+ * Function: unlink_entry
+ * ----------------------------
+ * Takes an entry out of the recency list, fixing head and tail as needed. The entry and its
+ * result are not freed and the byte count is not changed.
+ *
+ * @param C - Pointer to the cache.
+ * @param e - Entry currently in the list.
+ */
+static void unlink_entry(sm_cache* C, sm_cache_entry* e) {
+        if (e->prev) e->prev->next = e->next;
+        else C->head = e->next;
+
+        if (e->next) e->next->prev = e->prev;
+        else C->tail = e->prev;
+
+        e->prev = NULL;
+        e->next = NULL;
+}
+
+
+/*
+ * Function: push_front
+ * ----------------------------
+ * Links an entry at the front of the recency list, as the most recently used.
+ *
+ * @param C - Pointer to the cache.
+ * @param e - Entry not currently in the list.
+ */
+static void push_front(sm_cache* C, sm_cache_entry* e) {
+        e->prev = NULL;
+        e->next = C->head;
+
+        if (C->head) C->head->prev = e;
+        else C->tail = e;
+        C->head = e;
+}
+
+
+/*
+ * Function: drop_entry
+ * ----------------------------
+ * Removes an entry from the cache and frees both the entry and its result.
+ *
+ * @param C - Pointer to the cache.
+ * @param e - Entry currently in the list.
+ */
+static void drop_entry(sm_cache* C, sm_cache_entry* e) {
+        unlink_entry(C, e);
+        C->bytes -= e->bytes;
+        free_result(e->op, e->data);
+        free(e);
+}
+
+
+/*
+ * Function: lookup
+ * ----------------------------
+ * Finds a current result and marks it as most recently used.
+ *
+ * @param C - Pointer to the cache.
+ * @param op - Kind of result.
+ * @param arg - Parameter of the result.
+ *
+ * @return The result, still owned by the cache, or NULL on a miss.
+ *
+ * Description:
+ *   If the matrix's generation has moved on, every entry is dropped first, which frees the
+ *   results returned by earlier requests.
+ */
+static void* lookup(sm_cache* C, sm_cache_op op, uint32_t arg) {
+        // Everything cached so far describes an older matrix
+        if (C->generation != C->M->generation) {
+                cache_clear(C);
+                C->generation = C->M->generation;
+        }
+
+        for (sm_cache_entry* e = C->head; e; e = e->next) {
+                if (e->op == op && e->arg == arg) {
+                        unlink_entry(C, e);
+                        push_front(C, e);
+                        C->hits++;
+                        return e->data;
+                }
+        }
+
+        C->misses++;
+        return NULL;
+}
+
+
+/*
+ * Function: store
+ * ----------------------------
+ * Adds a freshly computed result, evicting least recently used ones to fit the budget.
+ *
+ * @param C - Pointer to the cache.
+ * @param op - Kind of result.
+ * @param arg - Parameter of the result.
+ * @param data - The result, or NULL if computing it failed.
+ * @param bytes - Memory the result takes.
+ *
+ * @return data, or NULL if data is NULL or the entry can not be allocated.
+ *
+ * Description:
+ *   The cache takes ownership of data in every case. If the entry can not be allocated, data
+ *   is freed here with free_result before returning NULL, so the caller must not touch it
+ *   again. Eviction runs before the new entry is linked, so it only frees older results
+ *   (which may include ones handed out by earlier requests) and never data itself; once
+ *   stored, data is freed only by a later eviction, invalidation, cache_clear or free_cache.
+ */
+static void* store(sm_cache* C, sm_cache_op op, uint32_t arg, void* data, size_t bytes) {
+        if (!data) return NULL;
+
+        sm_cache_entry* e = (sm_cache_entry*)malloc(sizeof(sm_cache_entry));
+        if (!e) {
+                free_result(op, data);
+                return NULL;
+        }
+
+        while (C->tail && C->bytes + bytes > C->budget) {
+                drop_entry(C, C->tail);
+                C->evictions++;
+        }
+
+        e->op = op;
+        e->arg = arg;
+        e->bytes = bytes;
+        e->data = data;
+        push_front(C, e);
+        C->bytes += bytes;
+
+        return data;
+}
+
+
+/*
+ * Function: transpose_csr
+ * ----------------------------
+ * Builds the CSR form of the transpose by reading the column chains, which are already
+ * the rows of the transpose in order.
+ *
+ * @param M - Pointer to the matrix.
+ *
+ * @return Pointer to the CSR matrix (M->col rows), owned by the caller until it is passed to
+ *         store, or NULL if allocation fails.
+ *
+ * Description:
+ *   A symmetric matrix is its own transpose, so its ordinary CSR form (both triangles) is
+ *   returned. Otherwise one pass counts the non-zeros and a second fills the arrays.
+ */
+static csr_matrix* transpose_csr(matrix* M) {
+        if (M->symmetric) return csr_from_S_Matrix(M);
+
+        uint64_t nnz = 0;
+        uint32_t index = 0;
+        for (l_node* temp; (temp = next_header(M->columnList, &index));) {
+                for (m_node* node = temp->matrix_node; node; node = node->col_ptr) nnz++;
+        }
+
+        csr_matrix* T = create_csr_matrix(M->col, M->row, nnz);
+        if (!T) return NULL;
+
+        uint64_t k = 0;
+        for (uint32_t c = 1; c <= M->col; c++) {
+                for (m_node* node = header_chain(M->columnList, c); node; node = node->col_ptr, k++) {
+                        T->col_idx[k] = node->row;
+                        T->values[k] = node->value;
+                }
+                T->row_ptr[c] = k;
+        }
+
+        return T;
+}
+
+
+/*
+ * Function: create_cache
+ * ----------------------------
+ * Creates an empty cache for a matrix.
+ *
+ * @param M - Pointer to the matrix; it must outlive the cache.
+ * @param budget - Bytes the cached results may take.
+ *
+ * @return Pointer to the cache, or NULL if M is NULL or allocation fails.
+ */
+sm_cache* create_cache(matrix* M, size_t budget) {
+        if (!M) return NULL;
+
+        sm_cache* C = (sm_cache*)calloc(1, sizeof(sm_cache));
+        if (!C) return NULL;
+
+        C->M = M;
+        C->budget = budget;
+        C->generation = M->generation;
+
+        return C;
+}
+
+
+/*
+ * Function: cache_csr
+ * ----------------------------
+ * Gets the CSR copy of the matrix.
+ *
+ * @param C - Pointer to the cache.
+ *
+ * @return The CSR copy, or NULL if it can not be built.
+ */
+csr_matrix* cache_csr(sm_cache* C) {
+        if (!C) return NULL;
+
+        csr_matrix* A = (csr_matrix*)lookup(C, SM_CACHE_CSR, 0);
+        if (A) return A;
+
+        A = csr_from_S_Matrix(C->M);
+        return (csr_matrix*)store(C, SM_CACHE_CSR, 0, A, A ? csr_bytes(A) : 0);
+}
+
+
+/*
+ * Function: cache_transpose
+ * ----------------------------
+ * Gets the CSR copy of the transpose of the matrix.
+ *
+ * @param C - Pointer to the cache.
+ *
+ * @return The transposed CSR copy (M->col rows), or NULL if it can not be built.
+ */
+csr_matrix* cache_transpose(sm_cache* C) {
+        if (!C) return NULL;
+
+        csr_matrix* T = (csr_matrix*)lookup(C, SM_CACHE_TRANSPOSE, 0);
+        if (T) return T;
+
+        T = transpose_csr(C->M);
+        return (csr_matrix*)store(C, SM_CACHE_TRANSPOSE, 0, T, T ? csr_bytes(T) : 0);
+}
+
+
+/*
+ * Function: cache_row_reduce
+ * ----------------------------
+ * Gets the reduction of every row, as computed by row_reduce_S_Matrix.
+ *
+ * @param C - Pointer to the cache.
+ * @param kind - The reduction.
+ *
+ * @return Vector of M->row entries, or NULL if allocation fails.
+ */
+const double* cache_row_reduce(sm_cache* C, sm_reduce kind) {
+        if (!C) return NULL;
+
+        double* out = (double*)lookup(C, SM_CACHE_ROW_REDUCE, (uint32_t)kind);
+        if (out) return out;
+
+        size_t bytes = ((size_t)C->M->row ? C->M->row : 1) * sizeof(double);
+        out = (double*)malloc(bytes);
+        if (out) row_reduce_S_Matrix(C->M, kind, out);
+
+        return (const double*)store(C, SM_CACHE_ROW_REDUCE, (uint32_t)kind, out, bytes);
+}
+
+
+/*
+ * Function: cache_column_reduce
+ * ----------------------------
+ * Gets the reduction of every column, as computed by column_reduce_S_Matrix.
+ *
+ * @param C - Pointer to the cache.
+ * @param kind - The reduction.
+ *
+ * @return Vector of M->col entries, or NULL if allocation fails.
+ */
+const double* cache_column_reduce(sm_cache* C, sm_reduce kind) {
+        if (!C) return NULL;
+
+        double* out = (double*)lookup(C, SM_CACHE_COLUMN_REDUCE, (uint32_t)kind);
+        if (out) return out;
+
+        size_t bytes = ((size_t)C->M->col ? C->M->col : 1) * sizeof(double);
+        out = (double*)malloc(bytes);
+        if (out) column_reduce_S_Matrix(C->M, kind, out);
+
+        return (const double*)store(C, SM_CACHE_COLUMN_REDUCE, (uint32_t)kind, out, bytes);
+}
+
+
+/*
+ * Function: cache_compressed
+ * ----------------------------
+ * Gets the compressed form of the matrix, built from the cached CSR copy when there is one.
+ *
+ * @param C - Pointer to the cache.
+ *
+ * @return The compressed form, or NULL if it can not be built.
+ */
+z_matrix* cache_compressed(sm_cache* C) {
+        if (!C) return NULL;
+
+        z_matrix* Z = (z_matrix*)lookup(C, SM_CACHE_COMPRESSED, 0);
+        if (Z) return Z;
+
+        // Peek without touching the recency order or the counters
+        csr_matrix* A = NULL;
+        for (sm_cache_entry* e = C->head; e; e = e->next) {
+                if (e->op == SM_CACHE_CSR) A = (csr_matrix*)e->data;
+        }
+
+        Z = A ? compressed_from_csr(A) : compressed_from_S_Matrix(C->M);
+        return (z_matrix*)store(C, SM_CACHE_COMPRESSED, 0, Z, Z ? (size_t)zm_bytes(Z) : 0);
+}
+
+
+/*
+ * Function: cache_plan
+ * ----------------------------
+ * Gets the product plan for a workload, so repeated products skip the tuning runs.
+ *
+ * @param C - Pointer to the cache.
+ * @param hint - The expected workload.
+ *
+ * @return The plan, or NULL if it can not be built.
+ */
+sm_plan* cache_plan(sm_cache* C, sm_workload hint) {
+        if (!C) return NULL;
+
+        sm_plan* P = (sm_plan*)lookup(C, SM_CACHE_PLAN, (uint32_t)hint);
+        if (P) return P;
+
+        P = matrix_optimize(C->M, hint);
+        return (sm_plan*)store(C, SM_CACHE_PLAN, (uint32_t)hint, P, P ? plan_bytes(P) : 0);
+}
+
+
+/*
+ * Function: cache_clear
+ * ----------------------------
+ * Drops every cached result; the counters are kept.
+ *
+ * @param C - Pointer to the cache.
+ */
+void cache_clear(sm_cache* C) {
+        if (!C) return;
+
+        while (C->head) drop_entry(C, C->head);
+}
+
+
+/*
+ * Function: free_cache
+ * ----------------------------
+ * Frees a cache and its results (not the matrix).
+ *
+ * @param C - Pointer to the cache.
+ */
+void free_cache(sm_cache* C) {
+        if (!C) return;
+
+        cache_clear(C);
+        free(C);
+}
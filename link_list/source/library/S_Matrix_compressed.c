@@ -0,0 +1,677 @@
+/*
+ * File Name: S_Matrix_compressed.c
+ * Authors: Arpit Patel, Dharm KaPatel
+ * Date: 2025-03-19
+ * Description: This file implements the compressed, read-only form of the S_Matrix data structure.
+ *              Rows are decoded with GCC vector types: byte and short gaps are widened eight at a
+ *              time, and the gaps are turned back into columns with an in-register prefix sum.
+ */
+
+
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <string.h>
+
+
+#include "../include/S_Matrix_compressed.h"
+#include "../include/S_Matrix_parallel.h"
+
+
+// Bytes of zero padding after the index stream, so the decoder can always load 8 bytes
+#define SM_INDEX_PADDING 8
+
+
+typedef uint32_t sm_u32x8 __attribute__((vector_size(8 * sizeof(uint32_t)), aligned(sizeof(uint32_t))));
+typedef uint16_t sm_u16x8 __attribute__((vector_size(8 * sizeof(uint16_t)), aligned(1)));
+typedef uint8_t sm_u8x8 __attribute__((vector_size(8 * sizeof(uint8_t)), aligned(1)));
+
+
+static inline uint8_t* put_varint(uint8_t* p, uint64_t v) {
+        while (v >= 0x80) {
+                *p++ = (uint8_t)(v | 0x80);
+                v >>= 7;
+        }
+        *p++ = (uint8_t)v;
+        return p;
+}
+
+
+static inline const uint8_t* get_varint(const uint8_t* p, uint64_t* v) {
+        uint64_t result = 0;
+        int shift = 0;
+        while (*p & 0x80) {
+                result |= (uint64_t)(*p++ & 0x7F) << shift;
+                shift += 7;
+        }
+        *v = result | ((uint64_t)*p++ << shift);
+        return p;
+}
+
+
+static inline uint32_t varint_size(uint64_t v) {
+        uint32_t size = 1;
+        while (v >= 0x80) {
+                v >>= 7;
+                size++;
+        }
+        return size;
+}
+
+
+static inline uint32_t bit_width(uint32_t v) {
+        return v ? 32 - (uint32_t)__builtin_clz(v) : 0;
+}
+
+
+static inline uint64_t packed_bytes(uint64_t count, uint32_t width) {
+        return (count * width + 7) / 8;
+}
+
+
+// Little-endian 8-byte load; the packed gaps are defined LSB first
+static inline uint64_t load64(const uint8_t* p) {
+        uint64_t v;
+        memcpy(&v, p, sizeof(v));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        v = __builtin_bswap64(v);
+#endif
+        return v;
+}
+
+
+static inline uint32_t unpack(const uint8_t* p, uint64_t k, uint32_t width) {
+        uint64_t bit = k * width;
+        uint64_t mask = (width == 32) ? UINT32_MAX : ((1ULL << width) - 1);
+        return (uint32_t)((load64(p + (bit >> 3)) >> (bit & 7)) & mask);
+}
+
+
+/*
+ * Function: decode_columns
+ * ----------------------------
+ * Decodes the columns of a row whose nnz varint has already been read.
+ *
+ * @param p - Pointer to the first column varint.
+ * @param n - Number of non-zeros of the row (at least 1).
+ * @param columns - Output array of n column indices.
+ *
+ * @return Pointer to the next row.
+ *
+ * Description:
+ *   The gaps are unpacked into columns[1..n-1] (eight lanes at a time for 8- and 16-bit widths),
+ *   then each group of eight is prefix-summed in a vector register and offset by the previous
+ *   column.
+ */
+static const uint8_t* decode_columns(const uint8_t* p, uint32_t n, uint32_t* columns) {
+        uint64_t first;
+        p = get_varint(p, &first);
+        uint32_t width = *p++;
+
+        columns[0] = (uint32_t)first;
+
+        uint32_t count = n - 1;
+        uint32_t* gaps = columns + 1;
+        uint32_t k = 0;
+
+        if (width == 0) {
+                memset(gaps, 0, (size_t)count * sizeof(uint32_t));
+                k = count;
+        }
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        else if (width == 8) {
+                for (; k + 8 <= count; k += 8) {
+                        *(sm_u32x8*)(gaps + k) = __builtin_convertvector(*(const sm_u8x8*)(p + k), sm_u32x8);
+                }
+        } else if (width == 16) {
+                for (; k + 8 <= count; k += 8) {
+                        *(sm_u32x8*)(gaps + k) = __builtin_convertvector(*(const sm_u16x8*)(p + 2 * k), sm_u32x8);
+                }
+        } else if (width == 32) {
+                memcpy(gaps, p, (size_t)count * sizeof(uint32_t));
+                k = count;
+        }
+#endif
+        for (; k < count; k++) {
+                gaps[k] = unpack(p, k, width);
+        }
+
+        // columns[i] = columns[i - 1] + gap + 1
+        const sm_u32x8 zero = { 0 };
+        uint32_t i = 1;
+        for (; i + 8 <= n; i += 8) {
+                sm_u32x8 x = *(sm_u32x8*)(columns + i) + 1;
+                x += __builtin_shuffle(x, zero, (sm_u32x8){ 8, 0, 1, 2, 3, 4, 5, 6 });
+                x += __builtin_shuffle(x, zero, (sm_u32x8){ 8, 8, 0, 1, 2, 3, 4, 5 });
+                x += __builtin_shuffle(x, zero, (sm_u32x8){ 8, 8, 8, 8, 0, 1, 2, 3 });
+                x += columns[i - 1];
+                *(sm_u32x8*)(columns + i) = x;
+        }
+        for (; i < n; i++) {
+                columns[i] += columns[i - 1] + 1;
+        }
+
+        return p + packed_bytes(count, width);
+}
+
+
+static inline const uint8_t* skip_row(const uint8_t* p, uint32_t* n) {
+        uint64_t count, first;
+        p = get_varint(p, &count);
+        *n = (uint32_t)count;
+        if (!count) return p;
+
+        p = get_varint(p, &first);
+        uint32_t width = *p++;
+        return p + packed_bytes(count - 1, width);
+}
+
+
+/*
+ * Function: seek_row
+ * ----------------------------
+ * Finds the encoded form of a row through its block.
+ *
+ * @param Z - Pointer to the compressed matrix.
+ * @param row - Row index (in bounds).
+ * @param entry - Output number of non-zeros before the row.
+ *
+ * @return Pointer to the row's nnz varint.
+ */
+static const uint8_t* seek_row(const z_matrix* Z, uint32_t row, uint64_t* entry) {
+        uint32_t block = (row - 1) / SM_COMPRESS_BLOCK;
+        const uint8_t* p = Z->index + Z->block_offset[block];
+        uint64_t e = Z->block_entry[block];
+
+        for (uint32_t r = block * SM_COMPRESS_BLOCK + 1; r < row; r++) {
+                uint32_t n;
+                p = skip_row(p, &n);
+                e += n;
+        }
+
+        *entry = e;
+        return p;
+}
+
+
+static inline double value_at(const z_matrix* Z, uint64_t entry) {
+        switch (Z->encoding) {
+        case SM_VALUES_DICT8: return Z->dictionary[((const uint8_t*)Z->codes)[entry]];
+        case SM_VALUES_DICT16: return Z->dictionary[((const uint16_t*)Z->codes)[entry]];
+        case SM_VALUES_RAW: break;
+        }
+        return ((const double*)Z->codes)[entry];
+}
+
+
+static void decode_values(const z_matrix* Z, uint64_t entry, uint32_t n, double* values) {
+        switch (Z->encoding) {
+        case SM_VALUES_DICT8: {
+                const uint8_t* codes = (const uint8_t*)Z->codes + entry;
+                for (uint32_t k = 0; k < n; k++) values[k] = Z->dictionary[codes[k]];
+                return;
+        }
+        case SM_VALUES_DICT16: {
+                const uint16_t* codes = (const uint16_t*)Z->codes + entry;
+                for (uint32_t k = 0; k < n; k++) values[k] = Z->dictionary[codes[k]];
+                return;
+        }
+        case SM_VALUES_RAW:
+                break;
+        }
+        memcpy(values, (const double*)Z->codes + entry, (size_t)n * sizeof(double));
+}
+
+
+static int compare_bits(const void* a, const void* b) {
+        uint64_t x = *(const uint64_t*)a;
+        uint64_t y = *(const uint64_t*)b;
+        return (x > y) - (x < y);
+}
+
+
+/*
+ * Function: encode_values
+ * ----------------------------
+ * Picks the value encoding and fills the dictionary and codes.
+ *
+ * @param Z - Pointer to the compressed matrix being built.
+ * @param A - Pointer to the source CSR matrix.
+ *
+ * @return true on success, false if allocation fails.
+ *
+ * Description:
+ *   Values are compared by bit pattern, so -0.0 and NaN payloads survive the round trip.
+ *   A dictionary is used only when it is smaller than the raw doubles.
+ */
+static bool encode_values(z_matrix* Z, csr_matrix* A) {
+        uint64_t nnz = A->nnz;
+        uint64_t* bits = (uint64_t*)malloc((nnz ? nnz : 1) * sizeof(uint64_t));
+        if (!bits) return false;
+
+        memcpy(bits, A->values, nnz * sizeof(uint64_t));
+        qsort(bits, nnz, sizeof(uint64_t), compare_bits);
+
+        uint64_t distinct = 0;
+        for (uint64_t i = 0; i < nnz; i++) {
+                if (i == 0 || bits[i] != bits[distinct - 1]) bits[distinct++] = bits[i];
+        }
+
+        size_t code_size = (distinct <= 256) ? 1 : 2;
+        bool dictionary = distinct <= 65536 && distinct * sizeof(double) + nnz * code_size < nnz * sizeof(double);
+
+        if (!dictionary) {
+                free(bits);
+                Z->encoding = SM_VALUES_RAW;
+                Z->codes = malloc((nnz ? nnz : 1) * sizeof(double));
+                if (!Z->codes) return false;
+                memcpy(Z->codes, A->values, nnz * sizeof(double));
+                return true;
+        }
+
+        Z->encoding = (code_size == 1) ? SM_VALUES_DICT8 : SM_VALUES_DICT16;
+        Z->dictionary_size = (uint32_t)distinct;
+        Z->dictionary = (double*)malloc(distinct * sizeof(double));
+        Z->codes = malloc(nnz * code_size);
+        if (!Z->dictionary || !Z->codes) {
+                free(bits);
+                return false;
+        }
+        memcpy(Z->dictionary, bits, distinct * sizeof(double));
+
+        for (uint64_t i = 0; i < nnz; i++) {
+                uint64_t key;
+                memcpy(&key, &A->values[i], sizeof(key));
+
+                uint64_t lo = 0, hi = distinct - 1;
+                while (lo < hi) {
+                        uint64_t mid = (lo + hi) / 2;
+                        if (bits[mid] < key) lo = mid + 1;
+                        else hi = mid;
+                }
+
+                if (code_size == 1) ((uint8_t*)Z->codes)[i] = (uint8_t)lo;
+                else ((uint16_t*)Z->codes)[i] = (uint16_t)lo;
+        }
+
+        free(bits);
+        return true;
+}
+
+
+static uint32_t row_width(csr_matrix* A, uint32_t i) {
+        uint32_t max_gap = 0;
+        for (uint64_t p = A->row_ptr[i] + 1; p < A->row_ptr[i + 1]; p++) {
+                uint32_t gap = A->col_idx[p] - A->col_idx[p - 1] - 1;
+                if (gap > max_gap) max_gap = gap;
+        }
+        return bit_width(max_gap);
+}
+
+
+/*
+ * Function: compressed_from_csr
+ * ----------------------------
+ * Compresses a CSR matrix.
+ *
+ * @param A - Pointer to the CSR matrix; columns must be strictly increasing within each row.
+ *
+ * @return Pointer to the compressed matrix, or NULL if A is NULL or allocation fails.
+ */
+z_matrix* compressed_from_csr(csr_matrix* A) {
+        if (!A) return NULL;
+
+        z_matrix* Z = (z_matrix*)calloc(1, sizeof(z_matrix));
+        if (!Z) return NULL;
+
+        Z->row = A->row;
+        Z->col = A->col;
+        Z->nnz = A->nnz;
+
+        // First pass sizes the index stream so it is allocated once
+        uint64_t size = 0;
+        for (uint32_t i = 0; i < A->row; i++) {
+                uint64_t n = A->row_ptr[i + 1] - A->row_ptr[i];
+                size += varint_size(n);
+                if (!n) continue;
+
+                size += varint_size(A->col_idx[A->row_ptr[i]]) + 1 + packed_bytes(n - 1, row_width(A, i));
+                if (n > Z->max_row_nnz) Z->max_row_nnz = (uint32_t)n;
+        }
+
+        uint32_t blocks = (A->row + SM_COMPRESS_BLOCK - 1) / SM_COMPRESS_BLOCK;
+        Z->index_size = size;
+        Z->index = (uint8_t*)calloc(size + SM_INDEX_PADDING, 1);
+        Z->block_offset = (uint64_t*)malloc((blocks ? blocks : 1) * sizeof(uint64_t));
+        Z->block_entry = (uint64_t*)malloc((blocks ? blocks : 1) * sizeof(uint64_t));
+        if (!Z->index || !Z->block_offset || !Z->block_entry || !encode_values(Z, A)) {
+                free_compressed_matrix(Z);
+                return NULL;
+        }
+
+        uint8_t* p = Z->index;
+        for (uint32_t i = 0; i < A->row; i++) {
+                if (i % SM_COMPRESS_BLOCK == 0) {
+                        Z->block_offset[i / SM_COMPRESS_BLOCK] = (uint64_t)(p - Z->index);
+                        Z->block_entry[i / SM_COMPRESS_BLOCK] = A->row_ptr[i];
+                }
+
+                uint64_t start = A->row_ptr[i];
+                uint64_t n = A->row_ptr[i + 1] - start;
+                p = put_varint(p, n);
+                if (!n) continue;
+
+                uint32_t width = row_width(A, i);
+                p = put_varint(p, A->col_idx[start]);
+                *p++ = (uint8_t)width;
+
+                // The buffer is zeroed, so each gap is ORed into place byte by byte
+                for (uint64_t k = 0; k + 1 < n; k++) {
+                        uint64_t bit = k * width;
+                        uint64_t gap = (uint64_t)(A->col_idx[start + k + 1] - A->col_idx[start + k] - 1) << (bit & 7);
+                        for (uint8_t* q = p + (bit >> 3); gap; q++, gap >>= 8) {
+                                *q |= (uint8_t)gap;
+                        }
+                }
+                p += packed_bytes(n - 1, width);
+        }
+
+        return Z;
+}
+
+
+/*
+ * Function: compressed_from_S_Matrix
+ * ----------------------------
+ * Compresses a linked matrix.
+ *
+ * @param M - Pointer to the matrix; a symmetric matrix is stored with both triangles.
+ *
+ * @return Pointer to the compressed matrix, or NULL if M is NULL or allocation fails.
+ */
+z_matrix* compressed_from_S_Matrix(matrix* M) {
+        csr_matrix* A = csr_from_S_Matrix(M);
+        if (!A) return NULL;
+
+        z_matrix* Z = compressed_from_csr(A);
+        free_csr_matrix(A);
+
+        return Z;
+}
+
+
+/*
+ * Function: zm_bytes
+ * ----------------------------
+ * Gets the memory held by a compressed matrix.
+ *
+ * @param Z - Pointer to the compressed matrix.
+ *
+ * @return Number of bytes, including the struct and the block tables.
+ */
+uint64_t zm_bytes(z_matrix* Z) {
+        if (!Z) return 0;
+
+        uint64_t blocks = (Z->row + SM_COMPRESS_BLOCK - 1) / SM_COMPRESS_BLOCK;
+        uint64_t code_size = (Z->encoding == SM_VALUES_DICT8) ? 1 : (Z->encoding == SM_VALUES_DICT16) ? 2 : sizeof(double);
+
+        return sizeof(z_matrix) + Z->index_size + SM_INDEX_PADDING + 2 * blocks * sizeof(uint64_t)
+                + (uint64_t)Z->dictionary_size * sizeof(double) + Z->nnz * code_size;
+}
+
+
+/*
+ * Function: zm_row_length
+ * ----------------------------
+ * Gets the number of non-zeros of one row.
+ *
+ * @param Z - Pointer to the compressed matrix.
+ * @param row - Row index.
+ *
+ * @return Number of non-zeros, or 0 if the row is out of bounds.
+ */
+uint32_t zm_row_length(z_matrix* Z, uint32_t row) {
+        if (!Z || row < 1 || row > Z->row) return 0;
+
+        uint64_t entry, n;
+        get_varint(seek_row(Z, row, &entry), &n);
+
+        return (uint32_t)n;
+}
+
+
+/*
+ * Function: zm_row
+ * ----------------------------
+ * Decodes one row into caller-provided arrays.
+ *
+ * @param Z - Pointer to the compressed matrix.
+ * @param row - Row index.
+ * @param columns - Output array of at least zm_row_length() column indices.
+ * @param values - Output array of as many values, or NULL.
+ *
+ * @return Number of non-zeros decoded, or 0 if the row is out of bounds.
+ */
+uint32_t zm_row(z_matrix* Z, uint32_t row, uint32_t* columns, double* values) {
+        if (!Z || !columns || row < 1 || row > Z->row) return 0;
+
+        uint64_t entry, n;
+        const uint8_t* p = get_varint(seek_row(Z, row, &entry), &n);
+        if (!n) return 0;
+
+        decode_columns(p, (uint32_t)n, columns);
+        if (values) decode_values(Z, entry, (uint32_t)n, values);
+
+        return (uint32_t)n;
+}
+
+
+/*
+ * Function: zm_get
+ * ----------------------------
+ * Reads one element without decoding the rest of its row.
+ *
+ * @param Z - Pointer to the compressed matrix.
+ * @param row - Row index.
+ * @param column - Column index.
+ *
+ * @return The value, or 0 if the position holds no value or is out of bounds.
+ */
+double zm_get(z_matrix* Z, uint32_t row, uint32_t column) {
+        if (!Z || row < 1 || row > Z->row || column < 1 || column > Z->col) return 0;
+
+        uint64_t entry, n, first;
+        const uint8_t* p = get_varint(seek_row(Z, row, &entry), &n);
+        if (!n) return 0;
+
+        p = get_varint(p, &first);
+        uint32_t width = *p++;
+
+        // Columns increase along the row, so the walk stops at the first one not below the target
+        uint64_t current = first;
+        uint64_t k = 0;
+        while (current < column && k + 1 < n) {
+                current += (uint64_t)unpack(p, k, width) + 1;
+                k++;
+        }
+
+        return (current == column) ? value_at(Z, entry + k) : 0;
+}
+
+
+/*
+ * Function: zm_scan
+ * ----------------------------
+ * Visits every non-zero in row-major order.
+ *
+ * @param Z - Pointer to the compressed matrix.
+ * @param visit - Callback receiving each non-zero.
+ * @param ctx - Caller context passed to visit.
+ *
+ * @return true on success, false if the row buffers can not be allocated.
+ */
+bool zm_scan(z_matrix* Z, sm_visit_fn visit, void* ctx) {
+        if (!Z || !visit) return false;
+
+        uint32_t capacity = Z->max_row_nnz ? Z->max_row_nnz : 1;
+        uint32_t* columns = (uint32_t*)malloc(capacity * sizeof(uint32_t));
+        double* values = (double*)malloc(capacity * sizeof(double));
+        if (!columns || !values) {
+                free(columns);
+                free(values);
+                return false;
+        }
+
+        const uint8_t* p = Z->index;
+        uint64_t entry = 0;
+        for (uint32_t i = 1; i <= Z->row; i++) {
+                uint64_t n;
+                p = get_varint(p, &n);
+                if (!n) continue;
+
+                p = decode_columns(p, (uint32_t)n, columns);
+                decode_values(Z, entry, (uint32_t)n, values);
+                entry += n;
+
+                for (uint32_t k = 0; k < n; k++) {
+                        visit(i, columns[k], values[k], ctx);
+                }
+        }
+
+        free(columns);
+        free(values);
+        return true;
+}
+
+
+/*
+ * Struct: zm_spmv_job
+ * ----------------------------
+ * Arguments shared by the threads of zm_spmv.
+ *
+ * Z: The compressed matrix.
+ * x: Input vector.
+ * y: Output vector.
+ * failed: Set when a thread can not allocate its row buffer.
+ */
+typedef struct zm_spmv_job {
+        z_matrix* Z;
+        const double* x;
+        double* y;
+        atomic_bool failed;
+} zm_spmv_job;
+
+
+static void spmv_blocks(uint64_t begin, uint64_t end, uint32_t thread, void* ctx) {
+        zm_spmv_job* job = (zm_spmv_job*)ctx;
+        z_matrix* Z = job->Z;
+        (void)thread;
+
+        if (end <= begin) return;
+
+        uint32_t* columns = (uint32_t*)malloc((Z->max_row_nnz ? Z->max_row_nnz : 1) * sizeof(uint32_t));
+        if (!columns) {
+                atomic_store(&job->failed, true);
+                return;
+        }
+
+        const uint8_t* p = Z->index + Z->block_offset[begin];
+        uint64_t entry = Z->block_entry[begin];
+        uint64_t last = end * SM_COMPRESS_BLOCK;
+        if (last > Z->row) last = Z->row;
+
+        for (uint64_t i = begin * SM_COMPRESS_BLOCK; i < last; i++) {
+                uint64_t n;
+                p = get_varint(p, &n);
+
+                double sum = 0;
+                if (n) {
+                        p = decode_columns(p, (uint32_t)n, columns);
+                        for (uint32_t k = 0; k < n; k++) {
+                                sum += value_at(Z, entry + k) * job->x[columns[k] - 1];
+                        }
+                        entry += n;
+                }
+                job->y[i] = sum;
+        }
+
+        free(columns);
+}
+
+
+/*
+ * Function: zm_spmv
+ * ----------------------------
+ * Computes y = Z * x, decoding the rows block by block.
+ *
+ * @param Z - Pointer to the compressed matrix.
+ * @param x - Input vector of Z->col entries.
+ * @param y - Output vector of Z->row entries.
+ * @param threads - Number of threads, or 0 for one per online CPU.
+ *
+ * @return true on success, false if the row buffers can not be allocated.
+ */
+bool zm_spmv(z_matrix* Z, const double* x, double* y, uint32_t threads) {
+        if (!Z || !x || !y) return false;
+
+        zm_spmv_job job = { .Z = Z, .x = x, .y = y };
+        atomic_init(&job.failed, false);
+
+        uint64_t blocks = (Z->row + SM_COMPRESS_BLOCK - 1) / SM_COMPRESS_BLOCK;
+        sm_parallel_for(blocks, sm_thread_count(threads), spmv_blocks, &job);
+
+        return !atomic_load(&job.failed);
+}
+
+
+/*
+ * Function: csr_from_compressed
+ * ----------------------------
+ * Decompresses a compressed matrix to CSR form.
+ *
+ * @param Z - Pointer to the compressed matrix.
+ *
+ * @return Pointer to the CSR matrix, or NULL if Z is NULL or allocation fails.
+ */
+csr_matrix* csr_from_compressed(z_matrix* Z) {
+        if (!Z) return NULL;
+
+        csr_matrix* A = create_csr_matrix(Z->row, Z->col, Z->nnz);
+        if (!A) return NULL;
+
+        const uint8_t* p = Z->index;
+        uint64_t entry = 0;
+        for (uint32_t i = 0; i < Z->row; i++) {
+                uint64_t n;
+                p = get_varint(p, &n);
+                if (n) {
+                        p = decode_columns(p, (uint32_t)n, A->col_idx + entry);
+                        decode_values(Z, entry, (uint32_t)n, A->values + entry);
+                        entry += n;
+                }
+                A->row_ptr[i + 1] = entry;
+        }
+
+        return A;
+}
+
+
+/*
+ * Function: free_compressed_matrix
+ * ----------------------------
+ * Frees all memory associated with a compressed matrix.
+ *
+ * @param Z - Pointer to the compressed matrix.
+ */
+void free_compressed_matrix(z_matrix* Z) {
+        if (!Z) return;
+
+        free(Z->index);
+        free(Z->block_offset);
+        free(Z->block_entry);
+        free(Z->dictionary);
+        free(Z->codes);
+        free(Z);
+}
@@ -0,0 +1,201 @@
+/*
+ * File Name: S_Matrix_concurrent.c
+ * Authors: Arpit Patel, Dharm KaPatel
+ * Date: 2025-03-19
+ * Description: This file implements the concurrent insertion mode for the S_Matrix data structure.
+ *              Row chains are only modified under their row stripe lock and column chains under
+ *              their column stripe lock, so an m_node's row_ptr and col_ptr are never written by
+ *              two threads at once.
+ */
+
+
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+
+#include "../include/S_Matrix_concurrent.h"
+
+
+/*
+ * Function: shared_header
+ * ----------------------------
+ * Gets a header node while other threads may be inserting, allocating its block if needed.
+ *
+ * @param CM - Pointer to the concurrent wrapper.
+ * @param ll - The row or column header list of the wrapped matrix.
+ * @param index - Position of the header (1-based, within the grown list).
+ *
+ * @return Pointer to the header node, or NULL if its block can not be allocated.
+ */
+static l_node* shared_header(c_matrix* CM, link_list* ll, uint32_t index) {
+        l_node* block = __atomic_load_n(&ll->blocks[(index - 1) / SM_HEADER_BLOCK], __ATOMIC_ACQUIRE);
+        if (block) return &block[(index - 1) % SM_HEADER_BLOCK];
+
+        pthread_mutex_lock(&CM->block_lock);
+        l_node* header = touch_header(ll, index);
+        pthread_mutex_unlock(&CM->block_lock);
+
+        return header;
+}
+
+
+/*
+ * Function: create_concurrent_S_Matrix
+ * ----------------------------
+ * Prepares a matrix for concurrent insertion.
+ *
+ * @param M - Pointer to the matrix.
+ *
+ * @return Pointer to the concurrent wrapper, or NULL if allocation fails.
+ */
+c_matrix* create_concurrent_S_Matrix(matrix* M) {
+        if (!M) return NULL;
+
+        c_matrix* CM = (c_matrix*)malloc(sizeof(c_matrix));
+        if (!CM) return NULL;
+
+        CM->M = M;
+        if (grow_list(M->rowList, M->row) != SM_OK || grow_list(M->columnList, M->col) != SM_OK) {
+                free(CM);
+                return NULL;
+        }
+
+        pthread_mutex_init(&CM->block_lock, NULL);
+        for (uint32_t i = 0; i < SM_LOCK_STRIPES; i++) {
+                pthread_mutex_init(&CM->row_locks[i], NULL);
+                pthread_mutex_init(&CM->col_locks[i], NULL);
+                CM->inserted[i] = 0;
+        }
+
+        return CM;
+}
+
+
+/*
+ * Function: insert_data_concurrent
+ * ----------------------------
+ * Inserts a value at the specified row and column; safe to call from many threads.
+ *
+ * @param CM - Pointer to the concurrent wrapper.
+ * @param row - Row index.
+ * @param column - Column index.
+ * @param value - Value to be inserted.
+ *
+ * @return SM_OK, SM_ERR_NOT_CREATED, SM_ERR_ZERO_VALUE, SM_ERR_OUT_OF_BOUNDS or SM_ERR_NO_MEMORY.
+ */
+sm_status insert_data_concurrent(c_matrix* CM, uint32_t row, uint32_t column, double value) {
+        if (!CM) return sm_fail(__func__, SM_ERR_NOT_CREATED);
+        if (value == 0) return sm_fail(__func__, SM_ERR_ZERO_VALUE);
+
+        matrix* M = CM->M;
+        if (row > M->row || row < 1 || column > M->col || column < 1) {
+                return sm_fail(__func__, SM_ERR_OUT_OF_BOUNDS);
+        }
+
+        // A symmetric matrix keeps only the upper triangle; swap before the stripes are chosen
+        if (M->symmetric && row > column) {
+                uint32_t temp = row;
+                row = column;
+                column = temp;
+        }
+
+        // Allocate outside the locks, the allocator has its own synchronisation
+        m_node* matrix_node = alloc_mat_node(row, column, value);
+        if (!matrix_node) return sm_fail(__func__, SM_ERR_NO_MEMORY);
+
+        l_node* row_pos = shared_header(CM, M->rowList, row);
+        l_node* col_pos = shared_header(CM, M->columnList, column);
+        if (!row_pos || !col_pos) {
+                free(matrix_node);
+                return sm_fail(__func__, SM_ERR_NO_MEMORY);
+        }
+
+        pthread_mutex_t* row_lock = &CM->row_locks[row % SM_LOCK_STRIPES];
+        pthread_mutex_t* col_lock = &CM->col_locks[column % SM_LOCK_STRIPES];
+
+        pthread_mutex_lock(row_lock);
+
+        // Find the position in the row chain, updating in place if the node exists
+        m_node* prev_row = NULL;
+        m_node* cur = row_pos->matrix_node;
+        while (cur && cur->column < column) {
+                prev_row = cur;
+                cur = cur->row_ptr;
+        }
+
+        if (cur && cur->column == column) {
+                cur->value = value;
+                pthread_mutex_unlock(row_lock);
+                free(matrix_node);
+                return SM_OK;
+        }
+        matrix_node->row_ptr = cur;
+
+        pthread_mutex_lock(col_lock);
+
+        // Find the position in the column chain
+        m_node* prev_col = NULL;
+        cur = col_pos->matrix_node;
+        while (cur && cur->row < row) {
+                prev_col = cur;
+                cur = cur->col_ptr;
+        }
+        matrix_node->col_ptr = cur;
+
+        if (prev_col) {
+                prev_col->col_ptr = matrix_node;
+        } else {
+                col_pos->matrix_node = matrix_node;
+        }
+
+        pthread_mutex_unlock(col_lock);
+
+        if (prev_row) {
+                prev_row->row_ptr = matrix_node;
+        } else {
+                row_pos->matrix_node = matrix_node;
+        }
+        CM->inserted[row % SM_LOCK_STRIPES]++;
+
+        pthread_mutex_unlock(row_lock);
+
+        return SM_OK;
+}
+
+
+/*
+ * Function: release_concurrent_S_Matrix
+ * ----------------------------
+ * Frees the concurrent wrapper and hands the matrix back to the plain API.
+ *
+ * @param CM - Pointer to the concurrent wrapper.
+ *
+ * @return Pointer to the wrapped matrix.
+ */
+matrix* release_concurrent_S_Matrix(c_matrix* CM) {
+        if (!CM) return NULL;
+
+        matrix* M = CM->M;
+        uint64_t inserted = 0;
+
+        for (uint32_t i = 0; i < SM_LOCK_STRIPES; i++) {
+                pthread_mutex_destroy(&CM->row_locks[i]);
+                pthread_mutex_destroy(&CM->col_locks[i]);
+                inserted += CM->inserted[i];
+        }
+
+        // The new nodes are counted here rather than with an atomic update per insert
+        count_mat_nodes(inserted, 0);
+        mem_stats_alloc(&M->mem, inserted * sizeof(m_node), inserted, inserted);
+
+        pthread_mutex_destroy(&CM->block_lock);
+        free(CM);
+
+        // Concurrent inserts do not touch the counter, so one step covers all of them
+        M->generation++;
+
+        return M;
+}
@@ -0,0 +1,442 @@
+/*
+ * File Name: S_Matrix_csr.c
+ * Authors: Arpit Patel, Dharm KaPatel
+ * Date: 2025-03-19
+ * Description: This file implements the compressed sparse row (CSR) form of the S_Matrix data
+ *              structure and the bulk conversions between the CSR and the linked form.
+ */
+
+
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdatomic.h>
+
+
+#include "../include/S_Matrix_csr.h"
+#include "../include/S_Matrix_parallel.h"
+
+
+/*
+ * Function: create_csr_matrix
+ * ----------------------------
+ * Allocates a CSR matrix with room for the given number of non-zeros.
+ *
+ * @param rows - Number of rows.
+ * @param columns - Number of columns.
+ * @param nnz - Number of non-zeros to reserve.
+ *
+ * @return Pointer to the CSR matrix with row_ptr zeroed, or NULL if allocation fails.
+ */
+csr_matrix* create_csr_matrix(uint32_t rows, uint32_t columns, uint64_t nnz) {
+        csr_matrix* A = (csr_matrix*)malloc(sizeof(csr_matrix));
+        if (!A) return NULL;
+
+        A->row = rows;
+        A->col = columns;
+        A->nnz = nnz;
+        A->row_ptr = (uint64_t*)calloc((size_t)rows + 1, sizeof(uint64_t));
+        A->col_idx = (uint32_t*)malloc((nnz ? nnz : 1) * sizeof(uint32_t));
+        A->values = (double*)malloc((nnz ? nnz : 1) * sizeof(double));
+
+        if (!A->row_ptr || !A->col_idx || !A->values) {
+                free_csr_matrix(A);
+                return NULL;
+        }
+
+        return A;
+}
+
+
+/*
+ * Function: csr_from_S_Matrix
+ * ----------------------------
+ * Exports a linked matrix to CSR form.
+ *
+ * @param M - Pointer to the matrix.
+ *
+ * @return Pointer to the CSR matrix, or NULL if M is NULL or allocation fails.
+ *
+ * Description:
+ *   A symmetric matrix is expanded: row i takes its lower triangle from the stored column i
+ *   and its upper triangle from the stored row i.
+ */
+csr_matrix* csr_from_S_Matrix(matrix* M) {
+        if (!M || !M->rowList) return NULL;
+
+        // First pass counts the non-zeros so the arrays are allocated once
+        uint64_t nnz = 0;
+        uint32_t index = 0;
+        for (l_node* temp; (temp = next_header(M->rowList, &index));) {
+                for (m_node* node = temp->matrix_node; node; node = node->row_ptr) {
+                        nnz += (M->symmetric && node->row != node->column) ? 2 : 1;
+                }
+        }
+
+        csr_matrix* A = create_csr_matrix(M->row, M->col, nnz);
+        if (!A) return NULL;
+
+        uint64_t k = 0;
+        link_list* cols = (M->symmetric && M->columnList) ? M->columnList : NULL;
+        for (uint32_t row_index = 1; row_index <= M->row; row_index++) {
+                // Rows past the end of the row list may still own mirrored entries
+                if (cols) {
+                        for (m_node* node = header_chain(cols, row_index); node && node->row < row_index; node = node->col_ptr) {
+                                A->col_idx[k] = node->row;
+                                A->values[k] = node->value;
+                                k++;
+                        }
+                }
+                for (m_node* node = header_chain(M->rowList, row_index); node; node = node->row_ptr) {
+                        A->col_idx[k] = node->column;
+                        A->values[k] = node->value;
+                        k++;
+                }
+                A->row_ptr[row_index] = k;
+        }
+
+        return A;
+}
+
+
+/*
+ * Function: sort_triplets
+ * ----------------------------
+ * Stable sort of triplets by row, then column.
+ *
+ * @param entries - Array of triplets.
+ * @param count - Number of triplets.
+ *
+ * @return true on success, false if the scratch buffer can not be allocated.
+ */
+bool sort_triplets(sm_triplet* entries, uint64_t count) {
+        if (count < 2) return true;
+
+        sm_triplet* scratch = (sm_triplet*)malloc(count * sizeof(sm_triplet));
+        if (!scratch) return false;
+
+        sm_triplet* src = entries;
+        sm_triplet* dst = scratch;
+
+        // Bottom-up merge sort; ties keep their input order so later duplicates stay later
+        for (uint64_t width = 1; width < count; width *= 2) {
+                for (uint64_t lo = 0; lo < count; lo += 2 * width) {
+                        uint64_t mid = (lo + width < count) ? lo + width : count;
+                        uint64_t hi = (lo + 2 * width < count) ? lo + 2 * width : count;
+                        uint64_t i = lo;
+                        uint64_t j = mid;
+                        uint64_t k = lo;
+
+                        while (i < mid && j < hi) {
+                                bool take_right = src[j].row < src[i].row ||
+                                        (src[j].row == src[i].row && src[j].column < src[i].column);
+                                dst[k++] = take_right ? src[j++] : src[i++];
+                        }
+                        while (i < mid) dst[k++] = src[i++];
+                        while (j < hi) dst[k++] = src[j++];
+                }
+
+                sm_triplet* temp = src;
+                src = dst;
+                dst = temp;
+        }
+
+        if (src != entries) {
+                memcpy(entries, src, count * sizeof(sm_triplet));
+        }
+
+        free(scratch);
+        return true;
+}
+
+
+/*
+ * Function: csr_from_triplets
+ * ----------------------------
+ * Builds a CSR matrix from unsorted triplets.
+ *
+ * @param rows - Number of rows.
+ * @param columns - Number of columns.
+ * @param entries - Array of triplets; it is sorted in place.
+ * @param count - Number of triplets.
+ *
+ * @return Pointer to the CSR matrix, or NULL if allocation fails.
+ */
+csr_matrix* csr_from_triplets(uint32_t rows, uint32_t columns, sm_triplet* entries, uint64_t count) {
+        if (!sort_triplets(entries, count)) return NULL;
+
+        // Keep the last entry of every run of equal positions
+        uint64_t nnz = 0;
+        for (uint64_t i = 0; i < count; i++) {
+                sm_triplet* t = &entries[i];
+                if (i + 1 < count && entries[i + 1].row == t->row && entries[i + 1].column == t->column) continue;
+                if (t->value == 0 || t->row < 1 || t->row > rows || t->column < 1 || t->column > columns) continue;
+                nnz++;
+        }
+
+        csr_matrix* A = create_csr_matrix(rows, columns, nnz);
+        if (!A) return NULL;
+
+        uint64_t k = 0;
+        for (uint64_t i = 0; i < count; i++) {
+                sm_triplet* t = &entries[i];
+                if (i + 1 < count && entries[i + 1].row == t->row && entries[i + 1].column == t->column) continue;
+                if (t->value == 0 || t->row < 1 || t->row > rows || t->column < 1 || t->column > columns) continue;
+
+                A->col_idx[k] = t->column;
+                A->values[k] = t->value;
+                A->row_ptr[t->row]++;
+                k++;
+        }
+
+        // Turn per-row counts into offsets
+        for (uint32_t r = 1; r <= rows; r++) {
+                A->row_ptr[r] += A->row_ptr[r - 1];
+        }
+
+        return A;
+}
+
+
+/*
+ * Function: csr_get
+ * ----------------------------
+ * Looks up a single element by binary search within its row.
+ *
+ * @param A - Pointer to the CSR matrix.
+ * @param row - Row index.
+ * @param column - Column index.
+ *
+ * @return The stored value, or 0 if the position is empty.
+ */
+double csr_get(csr_matrix* A, uint32_t row, uint32_t column) {
+        if (!A || row < 1 || row > A->row) return 0;
+
+        uint64_t lo = A->row_ptr[row - 1];
+        uint64_t hi = A->row_ptr[row];
+
+        while (lo < hi) {
+                uint64_t mid = lo + (hi - lo) / 2;
+                if (A->col_idx[mid] < column) {
+                        lo = mid + 1;
+                } else {
+                        hi = mid;
+                }
+        }
+
+        if (lo < A->row_ptr[row] && A->col_idx[lo] == column) {
+                return A->values[lo];
+        }
+
+        return 0;
+}
+
+
+/*
+ * Struct: link_job
+ * ----------------------------
+ * Shared state of S_Matrix_from_csr_parallel.
+ *
+ * M: The matrix being built; the header blocks it needs are allocated up front.
+ * A: The CSR form being linked.
+ * col_tail: Last node linked into each column so far (1-based).
+ * nodes: Node of each CSR entry.
+ * last_row: Number of rows with a header; the rows past it are empty.
+ * failed: Set when a node can not be allocated.
+ */
+typedef struct link_job {
+        matrix* M;
+        csr_matrix* A;
+        m_node** col_tail;
+        m_node** nodes;
+        uint32_t last_row;
+        atomic_bool failed;
+} link_job;
+
+
+/*
+ * Function: node_range
+ * ----------------------------
+ * Creates the nodes of the rows begin .. end - 1 and links their row chains.
+ *
+ * Description:
+ *   Each node joins its row chain at once, so free_S_Matrix can release a partial build.
+ *   Stops early once any thread has failed to allocate a node. The range's nodes are added
+ *   to the library totals in one step when it ends.
+ */
+static void node_range(uint64_t begin, uint64_t end, uint32_t thread, void* ctx) {
+        link_job* job = (link_job*)ctx;
+        csr_matrix* A = job->A;
+        uint64_t created = 0;
+        (void)thread;
+
+        for (uint64_t r = begin; r < end && !atomic_load_explicit(&job->failed, memory_order_relaxed); r++) {
+                m_node* prev = NULL;
+                for (uint64_t k = A->row_ptr[r]; k < A->row_ptr[r + 1]; k++) {
+                        m_node* node = alloc_mat_node((uint32_t)r + 1, A->col_idx[k], A->values[k]);
+                        if (!node) {
+                                atomic_store(&job->failed, true);
+                                break;
+                        }
+                        created++;
+
+                        if (prev) {
+                                prev->row_ptr = node;
+                        } else {
+                                seek_header(job->M->rowList, (uint32_t)r + 1)->matrix_node = node;
+                        }
+                        prev = node;
+                        job->nodes[k] = node;
+                }
+        }
+
+        count_mat_nodes(created, 0);
+}
+
+
+/*
+ * Function: column_range
+ * ----------------------------
+ * Links the column chains of the columns begin + 1 .. end.
+ *
+ * Description:
+ *   Each row is binary searched for its first column in the range, so threads touch
+ *   disjoint columns and need no locks.
+ */
+static void column_range(uint64_t begin, uint64_t end, uint32_t thread, void* ctx) {
+        link_job* job = (link_job*)ctx;
+        csr_matrix* A = job->A;
+        (void)thread;
+
+        for (uint32_t r = 0; r < job->last_row; r++) {
+                uint64_t lo = A->row_ptr[r];
+                uint64_t hi = A->row_ptr[r + 1];
+
+                while (lo < hi) {
+                        uint64_t mid = lo + (hi - lo) / 2;
+                        if (A->col_idx[mid] <= begin) {
+                                lo = mid + 1;
+                        } else {
+                                hi = mid;
+                        }
+                }
+
+                for (uint64_t k = lo; k < A->row_ptr[r + 1] && A->col_idx[k] <= end; k++) {
+                        uint32_t c = A->col_idx[k];
+
+                        if (job->col_tail[c]) {
+                                job->col_tail[c]->col_ptr = job->nodes[k];
+                        } else {
+                                seek_header(job->M->columnList, c)->matrix_node = job->nodes[k];
+                        }
+                        job->col_tail[c] = job->nodes[k];
+                }
+        }
+}
+
+
+/*
+ * Function: S_Matrix_from_csr
+ * ----------------------------
+ * Builds a linked matrix from CSR form on the calling thread.
+ *
+ * @param A - Pointer to the CSR matrix.
+ *
+ * @return Pointer to the matrix, or NULL if allocation fails.
+ */
+matrix* S_Matrix_from_csr(csr_matrix* A) {
+        return S_Matrix_from_csr_parallel(A, 1);
+}
+
+
+/*
+ * Function: S_Matrix_from_csr_parallel
+ * ----------------------------
+ * Builds a linked matrix from CSR form, creating rows and linking columns in parallel.
+ *
+ * @param A - Pointer to the CSR matrix.
+ * @param threads - Number of threads, or 0 for one per online CPU.
+ *
+ * @return Pointer to the matrix, or NULL if allocation fails.
+ */
+matrix* S_Matrix_from_csr_parallel(csr_matrix* A, uint32_t threads) {
+        if (!A) return NULL;
+
+        threads = sm_thread_count(threads);
+
+        matrix* M = create_S_Matrix(A->row, A->col);
+        if (!M) return NULL;
+
+        // Headers are only needed up to the last non-empty row and column
+        uint32_t last_row = 0;
+        uint32_t last_col = 0;
+        for (uint32_t r = 1; r <= A->row; r++) {
+                if (A->row_ptr[r] > A->row_ptr[r - 1]) {
+                        last_row = r;
+                        uint32_t c = A->col_idx[A->row_ptr[r] - 1];
+                        if (c > last_col) last_col = c;
+                }
+        }
+        uint64_t nnz = A->row_ptr[last_row];
+
+        link_job job;
+        job.M = M;
+        job.A = A;
+        job.col_tail = (m_node**)calloc((size_t)last_col + 1, sizeof(m_node*));
+        job.nodes = (m_node**)malloc((nnz ? nnz : 1) * sizeof(m_node*));
+        job.last_row = last_row;
+        atomic_init(&job.failed, false);
+
+        bool ok = job.col_tail && job.nodes &&
+                  grow_list(M->rowList, last_row) == SM_OK && grow_list(M->columnList, last_col) == SM_OK;
+
+        // Blocks are allocated here, on one thread, for the rows and columns that hold entries
+        for (uint32_t r = 1; ok && r <= last_row; r++) {
+                if (A->row_ptr[r] > A->row_ptr[r - 1] && !touch_header(M->rowList, r)) ok = false;
+        }
+        for (uint64_t k = 0; ok && k < nnz; k++) {
+                if (!touch_header(M->columnList, A->col_idx[k])) ok = false;
+        }
+
+        if (ok) {
+                sm_parallel_for(last_row, threads, node_range, &job);
+                ok = !atomic_load(&job.failed);
+        }
+
+        if (ok) {
+                sm_parallel_for(last_col, threads, column_range, &job);
+
+                mem_stats_alloc(&M->mem, nnz * sizeof(m_node), nnz, nnz);
+        }
+
+        free(job.col_tail);
+        free(job.nodes);
+
+        if (!ok) {
+                free_S_Matrix(M);
+                return NULL;
+        }
+
+        return M;
+}
+
+
+/*
+ * Function: free_csr_matrix
+ * ----------------------------
+ * Frees all memory associated with the CSR matrix.
+ *
+ * @param A - Pointer to the CSR matrix.
+ */
+void free_csr_matrix(csr_matrix* A) {
+        if (!A) {
+                return;
+        }
+
+        free(A->row_ptr);
+        free(A->col_idx);
+        free(A->values);
+        free(A);
+}
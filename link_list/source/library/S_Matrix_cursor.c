@@ -0,0 +1,312 @@
+/*
+ * File Name: S_Matrix_cursor.c
+ * Authors: Arpit Patel, Dharm KaPatel
+ * Date: 2025-03-19
+ * Description: This file implements the non-zero cursor of the S_Matrix data structure.
+ *              A second position runs SM_CURSOR_PREFETCH nodes ahead of the cursor along the
+ *              same traversal and issues a prefetch for every node it reaches, so the chain is
+ *              already in cache when the cursor gets there.
+ */
+
+
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+
+#include "../include/S_Matrix_cursor.h"
+
+
+/*
+ * Struct: sm_position
+ * ----------------------------
+ * A point in a traversal.
+ *
+ * index: Index of the current row or column (1-based).
+ * mirrored: Whether node is a stored entry of the other triangle of a symmetric matrix.
+ * node: Current node, or NULL at the end of the traversal.
+ */
+typedef struct sm_position {
+        uint32_t index;
+        bool mirrored;
+        m_node* node;
+} sm_position;
+
+
+/*
+ * Struct: sm_cursor
+ * ----------------------------
+ * State of a cursor.
+ *
+ * chains: Header list whose chains the traversal follows.
+ * mirror: For a symmetric matrix the column list, whose chains hold each row's part left of the diagonal; NULL otherwise.
+ * by_column: Whether chains are followed through col_ptr (columns) instead of row_ptr.
+ * swap: Whether entries are reported transposed (column order over a symmetric matrix).
+ * single: Whether the traversal stops at the end of the first chain.
+ * limit: Last chain index that can hold a node.
+ * start: Position of the first non-zero.
+ * pos: Position of the next non-zero to return.
+ * ahead: Prefetch position, SM_CURSOR_PREFETCH nodes past pos.
+ */
+struct sm_cursor {
+        link_list* chains;
+        link_list* mirror;
+        bool by_column;
+        bool swap;
+        bool single;
+        uint32_t limit;
+        sm_position start;
+        sm_position pos;
+        sm_position ahead;
+};
+
+
+/*
+ * Function: chain_head
+ * ----------------------------
+ * Gets the first node of a chain.
+ *
+ * @param ll - Pointer to the header list, or NULL.
+ * @param index - Index of the chain (1-based).
+ *
+ * @return The first node, or NULL if the chain is empty or past the list.
+ */
+static inline m_node* chain_head(link_list* ll, uint32_t index) {
+        return ll ? header_chain(ll, index) : NULL;
+}
+
+
+/*
+ * Function: enter_chain
+ * ----------------------------
+ * Moves a position to the first node of a row or column.
+ *
+ * @param C - Pointer to the cursor.
+ * @param p - Pointer to the position.
+ * @param index - The row or column (1-based).
+ *
+ * Description:
+ *   Row i of a symmetric matrix starts with the entries above the diagonal in stored column i,
+ *   which lie left of the diagonal once mirrored, and goes on with the stored row i.
+ */
+static void enter_chain(const sm_cursor* C, sm_position* p, uint32_t index) {
+        p->index = index;
+        p->mirrored = false;
+
+        m_node* node = chain_head(C->mirror, index);
+        if (node && node->row < index) {
+                p->mirrored = true;
+                p->node = node;
+                return;
+        }
+
+        p->node = chain_head(C->chains, index);
+}
+
+
+/*
+ * Function: settle
+ * ----------------------------
+ * Moves a position that ran off the end of a chain to the first node of the next non-empty chain.
+ *
+ * @param C - Pointer to the cursor.
+ * @param p - Pointer to the position.
+ */
+static void settle(const sm_cursor* C, sm_position* p) {
+        if (C->single) return;
+
+        while (!p->node && p->index < C->limit) {
+                enter_chain(C, p, p->index + 1);
+        }
+}
+
+
+/*
+ * Function: advance
+ * ----------------------------
+ * Moves a position to the next node of the traversal.
+ *
+ * @param C - Pointer to the cursor.
+ * @param p - Pointer to the position; a finished position stays finished.
+ */
+static inline void advance(const sm_cursor* C, sm_position* p) {
+        if (!p->node) return;
+
+        if (p->mirrored) {
+                p->node = p->node->col_ptr;
+                if (p->node && p->node->row < p->index) return;
+
+                // Reached the diagonal, which the stored row holds
+                p->mirrored = false;
+                p->node = chain_head(C->chains, p->index);
+        } else {
+                p->node = C->by_column ? p->node->col_ptr : p->node->row_ptr;
+        }
+
+        if (!p->node) settle(C, p);
+}
+
+
+/*
+ * Function: read_entry
+ * ----------------------------
+ * Reads the entry at a position in the coordinates of the traversal.
+ *
+ * @param C - Pointer to the cursor.
+ * @param p - Pointer to the position; it must be at a node.
+ * @param row - Output row index, or NULL.
+ * @param column - Output column index, or NULL.
+ * @param value - Output value, or NULL.
+ */
+static inline void read_entry(const sm_cursor* C, const sm_position* p, uint32_t* row, uint32_t* column, double* value) {
+        bool transposed = (p->mirrored != C->swap);
+        uint32_t r = transposed ? p->node->column : p->node->row;
+        uint32_t c = transposed ? p->node->row : p->node->column;
+
+        if (row) *row = r;
+        if (column) *column = c;
+        if (value) *value = p->node->value;
+}
+
+
+/*
+ * Function: create_cursor
+ * ----------------------------
+ * Creates a cursor positioned before the first non-zero of a traversal.
+ *
+ * @param M - Pointer to the matrix.
+ * @param order - Traversal order.
+ * @param index - Row (SM_CURSOR_ROW) or column (SM_CURSOR_COLUMN) to iterate; ignored otherwise.
+ *
+ * @return Pointer to the cursor, or NULL if M is NULL, the index is out of bounds or allocation fails.
+ */
+sm_cursor* create_cursor(matrix* M, sm_cursor_order order, uint32_t index) {
+        if (!M || !M->rowList || !M->columnList) return NULL;
+
+        bool by_column = (order == SM_CURSOR_COLUMN_MAJOR || order == SM_CURSOR_COLUMN);
+        bool single = (order == SM_CURSOR_ROW || order == SM_CURSOR_COLUMN);
+        uint32_t limit = by_column ? M->col : M->row;
+
+        if (single && (index < 1 || index > limit)) return NULL;
+
+        sm_cursor* C = (sm_cursor*)malloc(sizeof(sm_cursor));
+        if (!C) return NULL;
+
+        // Column j of a symmetric matrix is row j transposed, so every order walks rows
+        if (M->symmetric) {
+                C->chains = M->rowList;
+                C->mirror = M->columnList;
+                C->by_column = false;
+                C->swap = by_column;
+        } else {
+                C->chains = by_column ? M->columnList : M->rowList;
+                C->mirror = NULL;
+                C->by_column = by_column;
+                C->swap = false;
+        }
+        C->single = single;
+
+        // Chains past the header lists are empty
+        C->limit = C->chains->size;
+        if (C->mirror && C->mirror->size > C->limit) C->limit = C->mirror->size;
+        if (C->limit > limit) C->limit = limit;
+
+        if (single) {
+                enter_chain(C, &C->start, index);
+        } else {
+                C->start.index = 0;
+                C->start.mirrored = false;
+                C->start.node = NULL;
+                settle(C, &C->start);
+        }
+
+        cursor_reset(C);
+        return C;
+}
+
+
+/*
+ * Function: cursor_next
+ * ----------------------------
+ * Reads the next non-zero and advances the cursor.
+ *
+ * @param C - Pointer to the cursor.
+ * @param row - Output row index, or NULL.
+ * @param column - Output column index, or NULL.
+ * @param value - Output value, or NULL.
+ *
+ * @return true if an entry was read, false at the end of the traversal.
+ */
+bool cursor_next(sm_cursor* C, uint32_t* row, uint32_t* column, double* value) {
+        if (!C || !C->pos.node) return false;
+
+        read_entry(C, &C->pos, row, column, value);
+
+        advance(C, &C->pos);
+        advance(C, &C->ahead);
+        if (C->ahead.node) __builtin_prefetch(C->ahead.node);
+
+        return true;
+}
+
+
+/*
+ * Function: cursor_next_n
+ * ----------------------------
+ * Reads up to n non-zeros into caller-provided arrays and advances the cursor past them.
+ *
+ * @param C - Pointer to the cursor.
+ * @param rows - Output array of n row indices, or NULL.
+ * @param columns - Output array of n column indices, or NULL.
+ * @param values - Output array of n values, or NULL.
+ * @param n - Capacity of the arrays.
+ *
+ * @return Number of entries read.
+ */
+uint32_t cursor_next_n(sm_cursor* C, uint32_t* rows, uint32_t* columns, double* values, uint32_t n) {
+        if (!C) return 0;
+
+        uint32_t count = 0;
+        while (count < n && C->pos.node) {
+                read_entry(C, &C->pos, rows ? &rows[count] : NULL, columns ? &columns[count] : NULL, values ? &values[count] : NULL);
+                count++;
+
+                advance(C, &C->pos);
+                advance(C, &C->ahead);
+                if (C->ahead.node) __builtin_prefetch(C->ahead.node);
+        }
+
+        return count;
+}
+
+
+/*
+ * Function: cursor_reset
+ * ----------------------------
+ * Moves a cursor back before the first non-zero of its traversal.
+ *
+ * @param C - Pointer to the cursor.
+ */
+void cursor_reset(sm_cursor* C) {
+        if (!C) return;
+
+        C->pos = C->start;
+        C->ahead = C->start;
+        for (int step = 0; step < SM_CURSOR_PREFETCH && C->ahead.node; step++) {
+                advance(C, &C->ahead);
+                if (C->ahead.node) __builtin_prefetch(C->ahead.node);
+        }
+}
+
+
+/*
+ * Function: free_cursor
+ * ----------------------------
+ * Frees a cursor; the matrix is not touched.
+ *
+ * @param C - Pointer to the cursor.
+ */
+void free_cursor(sm_cursor* C) {
+        free(C);
+}
@@ -0,0 +1,240 @@
+/*
+ * File Name: S_Matrix_dense.c
+ * Authors: Arpit Patel, Dharm KaPatel
+ * Date: 2025-03-19
+ * Description: This file implements the dense conversions of the S_Matrix data structure. The import
+ *              compares eight cells per GCC vector against zero, turns the result into a bit mask
+ *              and copies one entry per set bit into a CSR form, so zero runs cost one compare per
+ *              eight cells. The CSR form is then linked by S_Matrix_from_csr_parallel().
+ */
+
+
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+
+#include "../include/S_Matrix_dense.h"
+#include "../include/S_Matrix_csr.h"
+#include "../include/S_Matrix_parallel.h"
+#include "S_Matrix_simd.h"
+
+
+// Bit i set when lane i of a compare result is true; a macro so no vector crosses a call
+#define MASK_BITS(m) ((uint32_t)(((m)[0] & 1) | ((m)[1] & 2) | ((m)[2] & 4) | ((m)[3] & 8) | \
+                                 ((m)[4] & 16) | ((m)[5] & 32) | ((m)[6] & 64) | ((m)[7] & 128)))
+
+
+/*
+ * Struct: dense_job
+ * ----------------------------
+ * Shared state of the import passes.
+ *
+ * A: The dense buffer.
+ * cols: Number of columns.
+ * ld: Leading dimension.
+ * C: CSR form being filled; row_ptr first holds the non-zeros per row, then the offsets.
+ */
+typedef struct dense_job {
+        const double* A;
+        uint32_t cols;
+        uint64_t ld;
+        csr_matrix* C;
+} dense_job;
+
+
+/*
+ * Function: count_range
+ * ----------------------------
+ * Counts the non-zeros of the dense rows begin .. end - 1 into row_ptr[r + 1].
+ */
+static void count_range(uint64_t begin, uint64_t end, uint32_t thread, void* ctx) {
+        dense_job* job = (dense_job*)ctx;
+        (void)thread;
+
+        for (uint64_t r = begin; r < end; r++) {
+                const double* row = job->A + r * job->ld;
+                uint64_t count = 0;
+                uint32_t c = 0;
+
+                for (; c + SM_LANES <= job->cols; c += SM_LANES) {
+                        sm_lanes v = *(const sm_lanes*)(row + c);
+                        sm_mask nonzero = (v != 0);
+                        count += (uint64_t)__builtin_popcount(MASK_BITS(nonzero));
+                }
+                for (; c < job->cols; c++) {
+                        if (row[c] != 0) count++;
+                }
+
+                job->C->row_ptr[r + 1] = count;
+        }
+}
+
+
+/*
+ * Function: fill_range
+ * ----------------------------
+ * Copies the non-zeros of the dense rows begin .. end - 1 into the CSR arrays.
+ */
+static void fill_range(uint64_t begin, uint64_t end, uint32_t thread, void* ctx) {
+        dense_job* job = (dense_job*)ctx;
+        csr_matrix* C = job->C;
+        (void)thread;
+
+        for (uint64_t r = begin; r < end; r++) {
+                const double* row = job->A + r * job->ld;
+                uint64_t slot = C->row_ptr[r];
+                uint32_t c = 0;
+
+                for (; c + SM_LANES <= job->cols; c += SM_LANES) {
+                        sm_lanes v = *(const sm_lanes*)(row + c);
+                        sm_mask nonzero = (v != 0);
+                        uint32_t bits = MASK_BITS(nonzero);
+
+                        while (bits) {
+                                uint32_t lane = (uint32_t)__builtin_ctz(bits);
+                                bits &= bits - 1;
+                                C->col_idx[slot] = c + lane + 1;
+                                C->values[slot++] = row[c + lane];
+                        }
+                }
+                for (; c < job->cols; c++) {
+                        if (row[c] != 0) {
+                                C->col_idx[slot] = c + 1;
+                                C->values[slot++] = row[c];
+                        }
+                }
+        }
+}
+
+
+/*
+ * Function: S_Matrix_from_dense
+ * ----------------------------
+ * Builds a linked matrix from a dense row-major buffer.
+ *
+ * @param A - The dense buffer.
+ * @param rows - Number of rows.
+ * @param cols - Number of columns.
+ * @param ld - Leading dimension (doubles between the starts of consecutive rows).
+ * @param threads - Number of threads, or 0 for one per online CPU.
+ *
+ * @return Pointer to the matrix, or NULL on invalid input or allocation failure.
+ */
+matrix* S_Matrix_from_dense(const double* A, uint32_t rows, uint32_t cols, uint64_t ld, uint32_t threads) {
+        if ((!A && rows && cols) || ld < cols) return NULL;
+        if (!rows || !cols) return create_S_Matrix(rows, cols);
+
+        threads = sm_thread_count(threads);
+
+        dense_job job;
+        job.A = A;
+        job.cols = cols;
+        job.ld = ld;
+        job.C = create_csr_matrix(rows, cols, 0);
+        if (!job.C) return NULL;
+
+        sm_parallel_for(rows, threads, count_range, &job);
+
+        uint64_t* row_ptr = job.C->row_ptr;
+        for (uint32_t r = 0; r < rows; r++) row_ptr[r + 1] += row_ptr[r];
+        uint64_t nnz = row_ptr[rows];
+
+        // The arrays were reserved empty; size them now that the count is known
+        uint32_t* col_idx = (uint32_t*)realloc(job.C->col_idx, (nnz ? nnz : 1) * sizeof(uint32_t));
+        if (col_idx) job.C->col_idx = col_idx;
+        double* values = (double*)realloc(job.C->values, (nnz ? nnz : 1) * sizeof(double));
+        if (values) job.C->values = values;
+
+        matrix* M = NULL;
+        if (col_idx && values) {
+                job.C->nnz = nnz;
+                sm_parallel_for(rows, threads, fill_range, &job);
+                M = S_Matrix_from_csr_parallel(job.C, threads);
+        }
+
+        free_csr_matrix(job.C);
+        return M;
+}
+
+
+/*
+ * Struct: export_job
+ * ----------------------------
+ * Shared state of dense_from_S_Matrix.
+ *
+ * M: The matrix.
+ * out: The dense buffer.
+ * ld: Leading dimension.
+ */
+typedef struct export_job {
+        matrix* M;
+        double* out;
+        uint64_t ld;
+} export_job;
+
+
+/*
+ * Function: zero_range
+ * ----------------------------
+ * Clears the dense rows begin .. end - 1.
+ */
+static void zero_range(uint64_t begin, uint64_t end, uint32_t thread, void* ctx) {
+        export_job* job = (export_job*)ctx;
+        (void)thread;
+
+        for (uint64_t r = begin; r < end; r++) {
+                memset(job->out + r * job->ld, 0, (size_t)job->M->col * sizeof(double));
+        }
+}
+
+
+/*
+ * Function: scatter_range
+ * ----------------------------
+ * Writes the stored entries of the rows begin .. end - 1 into the dense buffer.
+ */
+static void scatter_range(uint64_t begin, uint64_t end, uint32_t thread, void* ctx) {
+        export_job* job = (export_job*)ctx;
+        (void)thread;
+
+        // A mirrored cell (c, r) with c > r lies below the diagonal, which no other row stores
+        for (uint64_t r = begin; r < end; r++) {
+                for (m_node* node = header_chain(job->M->rowList, (uint32_t)r + 1); node; node = node->row_ptr) {
+                        job->out[(uint64_t)(node->row - 1) * job->ld + (node->column - 1)] = node->value;
+                        if (job->M->symmetric && node->column != node->row) {
+                                job->out[(uint64_t)(node->column - 1) * job->ld + (node->row - 1)] = node->value;
+                        }
+                }
+        }
+}
+
+
+/*
+ * Function: dense_from_S_Matrix
+ * ----------------------------
+ * Writes a linked matrix into a dense row-major buffer.
+ *
+ * @param M - Pointer to the matrix.
+ * @param out - Output buffer of at least (M->row - 1) * ld + M->col doubles.
+ * @param ld - Leading dimension, at least M->col.
+ * @param threads - Number of threads, or 0 for one per online CPU.
+ *
+ * @return true on success, false on invalid input or allocation failure.
+ */
+bool dense_from_S_Matrix(matrix* M, double* out, uint64_t ld, uint32_t threads) {
+        if (!M || !M->rowList || ld < M->col) return false;
+        if (!M->row || !M->col) return true;
+        if (!out) return false;
+
+        threads = sm_thread_count(threads);
+
+        export_job job = { M, out, ld };
+
+        sm_parallel_for(M->row, threads, zero_range, &job);
+        sm_parallel_for(M->rowList->size, threads, scatter_range, &job);
+
+        return true;
+}
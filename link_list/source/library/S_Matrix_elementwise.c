@@ -0,0 +1,734 @@
+/*
+ * File Name: S_Matrix_elementwise.c
+ * Authors: Arpit Patel, Dharm KaPatel
+ * Date: 2025-03-19
+ * Description: This file implements the element-wise operations and reductions of the S_Matrix data
+ *              structure. The CSR kernels use GCC vector types over the value array, so they stream
+ *              through memory at full SIMD width, and reductions combine per-thread partial results.
+ */
+
+
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+
+
+#include "../include/S_Matrix_elementwise.h"
+#include "../include/S_Matrix_parallel.h"
+#include "S_Matrix_simd.h"
+
+
+// Doubles per thread in the partial result arrays; one cache line so threads do not share lines
+#define SM_PARTIAL_STRIDE 8
+
+
+// Lane-wise |x| (clears the sign bits) and lane-wise select; macros so no vector crosses a call
+#define LANES_ABS(x) ((sm_lanes)((sm_mask)(x) & INT64_MAX))
+#define LANES_SELECT(take_a, a, b) ((sm_lanes)(((sm_mask)(a) & (take_a)) | ((sm_mask)(b) & ~(take_a))))
+
+
+/*
+ * Function: combine
+ * ----------------------------
+ * Folds one value into a running reduction. SM_REDUCE_NORM2 accumulates squares.
+ */
+static inline double combine(sm_reduce kind, double acc, double x) {
+        switch (kind) {
+        case SM_REDUCE_SUM: return acc + x;
+        case SM_REDUCE_NORM1: return acc + fabs(x);
+        case SM_REDUCE_NORM2: return acc + x * x;
+        case SM_REDUCE_NORM_INF: return (fabs(x) > acc) ? fabs(x) : acc;
+        case SM_REDUCE_MIN: return (x < acc) ? x : acc;
+        case SM_REDUCE_MAX: return (x > acc) ? x : acc;
+        case SM_REDUCE_NNZ: return acc + 1;
+        }
+        return acc;
+}
+
+
+/*
+ * Function: merge
+ * ----------------------------
+ * Joins two partial reductions; each is ignored when it saw no values.
+ */
+static inline double merge(sm_reduce kind, double a, uint64_t a_count, double b, uint64_t b_count) {
+        if (!a_count) return b;
+        if (!b_count) return a;
+
+        switch (kind) {
+        case SM_REDUCE_SUM:
+        case SM_REDUCE_NORM1:
+        case SM_REDUCE_NORM2:
+        case SM_REDUCE_NNZ:
+                return a + b;
+        case SM_REDUCE_NORM_INF:
+        case SM_REDUCE_MAX:
+                return (b > a) ? b : a;
+        case SM_REDUCE_MIN:
+                return (b < a) ? b : a;
+        }
+        return a;
+}
+
+
+/*
+ * Function: finish
+ * ----------------------------
+ * Turns an accumulated reduction into its result.
+ *
+ * @param kind - Reduction being computed.
+ * @param acc - Accumulated value.
+ * @param count - Number of values accumulated.
+ *
+ * @return 0 when nothing was accumulated, the square root of acc for SM_REDUCE_NORM2, acc otherwise.
+ */
+static inline double finish(sm_reduce kind, double acc, uint64_t count) {
+        if (!count) return 0;
+        return (kind == SM_REDUCE_NORM2) ? sqrt(acc) : acc;
+}
+
+
+/*
+ * Function: reduce_segment
+ * ----------------------------
+ * Reduces a contiguous run of values with SM_LANES independent accumulators.
+ *
+ * @param v - The values.
+ * @param n - Number of values (at least 1).
+ * @param kind - The reduction.
+ *
+ * @return The raw reduction (squares not yet rooted for SM_REDUCE_NORM2).
+ */
+static double reduce_segment(const double* v, uint64_t n, sm_reduce kind) {
+        if (kind == SM_REDUCE_NNZ) return (double)n;
+
+        uint64_t i = 0;
+        double acc = (kind == SM_REDUCE_MIN || kind == SM_REDUCE_MAX) ? v[0] : 0;
+
+        if (n >= SM_LANES) {
+                sm_lanes lanes = *(const sm_lanes*)v;
+                switch (kind) {
+                case SM_REDUCE_NORM1: lanes = LANES_ABS(lanes); break;
+                case SM_REDUCE_NORM2: lanes = lanes * lanes; break;
+                case SM_REDUCE_NORM_INF: lanes = LANES_ABS(lanes); break;
+                default: break;
+                }
+
+                for (i = SM_LANES; i + SM_LANES <= n; i += SM_LANES) {
+                        sm_lanes x = *(const sm_lanes*)(v + i);
+                        switch (kind) {
+                        case SM_REDUCE_SUM: lanes += x; break;
+                        case SM_REDUCE_NORM1: lanes += LANES_ABS(x); break;
+                        case SM_REDUCE_NORM2: lanes += x * x; break;
+                        case SM_REDUCE_NORM_INF: x = LANES_ABS(x); lanes = LANES_SELECT(x > lanes, x, lanes); break;
+                        case SM_REDUCE_MIN: lanes = LANES_SELECT(x < lanes, x, lanes); break;
+                        case SM_REDUCE_MAX: lanes = LANES_SELECT(x > lanes, x, lanes); break;
+                        case SM_REDUCE_NNZ: break;
+                        }
+                }
+
+                acc = lanes[0];
+                for (int lane = 1; lane < SM_LANES; lane++) {
+                        acc = merge(kind, acc, 1, lanes[lane], 1);
+                }
+        }
+
+        for (; i < n; i++) {
+                acc = combine(kind, acc, v[i]);
+        }
+
+        return acc;
+}
+
+
+/*
+ * Struct: ew_job
+ * ----------------------------
+ * Arguments shared by the threads of one element-wise call.
+ *
+ * A: The CSR matrix.
+ * kind: Reduction to compute.
+ * op: Predefined operator to apply.
+ * alpha: Scale factor.
+ * fn, ctx: User function and its context.
+ * out: Per-row or per-column output vector.
+ * partial: Per-thread partial results (value, count) or per-thread column arrays.
+ * seen: Per-thread column counts for csr_column_reduce.
+ */
+typedef struct ew_job {
+        csr_matrix* A;
+        sm_reduce kind;
+        sm_unary_op op;
+        double alpha;
+        sm_map_fn fn;
+        void* ctx;
+        double* out;
+        double* partial;
+        uint64_t* seen;
+} ew_job;
+
+
+/*
+ * Function: scale_range
+ * ----------------------------
+ * Multiplies the values begin .. end - 1 by alpha, one SIMD vector at a time.
+ */
+static void scale_range(uint64_t begin, uint64_t end, uint32_t thread, void* ctx) {
+        ew_job* job = (ew_job*)ctx;
+        double* v = job->A->values;
+        (void)thread;
+
+        uint64_t i = begin;
+        for (; i + SM_LANES <= end; i += SM_LANES) {
+                *(sm_lanes*)(v + i) *= job->alpha;
+        }
+        for (; i < end; i++) {
+                v[i] *= job->alpha;
+        }
+}
+
+
+/*
+ * Function: apply_range
+ * ----------------------------
+ * Applies the predefined operator to the values begin .. end - 1.
+ *
+ * Description:
+ *   Square roots are taken one value at a time; the other operators work on SIMD vectors.
+ */
+static void apply_range(uint64_t begin, uint64_t end, uint32_t thread, void* ctx) {
+        ew_job* job = (ew_job*)ctx;
+        double* v = job->A->values;
+        (void)thread;
+
+        uint64_t i = begin;
+        if (job->op == SM_OP_SQRT) {
+                for (; i < end; i++) v[i] = sqrt(v[i]);
+                return;
+        }
+
+        for (; i + SM_LANES <= end; i += SM_LANES) {
+                sm_lanes x = *(sm_lanes*)(v + i);
+                switch (job->op) {
+                case SM_OP_ABS: x = LANES_ABS(x); break;
+                case SM_OP_NEGATE: x = -x; break;
+                case SM_OP_SQUARE: x = x * x; break;
+                case SM_OP_RECIPROCAL: x = 1.0 / x; break;
+                case SM_OP_SQRT: break;
+                }
+                *(sm_lanes*)(v + i) = x;
+        }
+
+        for (; i < end; i++) {
+                switch (job->op) {
+                case SM_OP_ABS: v[i] = fabs(v[i]); break;
+                case SM_OP_NEGATE: v[i] = -v[i]; break;
+                case SM_OP_SQUARE: v[i] = v[i] * v[i]; break;
+                case SM_OP_RECIPROCAL: v[i] = 1.0 / v[i]; break;
+                case SM_OP_SQRT: break;
+                }
+        }
+}
+
+
+/*
+ * Function: map_range
+ * ----------------------------
+ * Replaces the values begin .. end - 1 with the result of the user function.
+ */
+static void map_range(uint64_t begin, uint64_t end, uint32_t thread, void* ctx) {
+        ew_job* job = (ew_job*)ctx;
+        double* v = job->A->values;
+        (void)thread;
+
+        for (uint64_t i = begin; i < end; i++) {
+                v[i] = job->fn(v[i], job->ctx);
+        }
+}
+
+
+/*
+ * Function: reduce_range
+ * ----------------------------
+ * Reduces the values begin .. end - 1 into the partial result slot of the thread.
+ */
+static void reduce_range(uint64_t begin, uint64_t end, uint32_t thread, void* ctx) {
+        ew_job* job = (ew_job*)ctx;
+
+        job->partial[thread * SM_PARTIAL_STRIDE] = (end > begin) ? reduce_segment(job->A->values + begin, end - begin, job->kind) : 0;
+        job->partial[thread * SM_PARTIAL_STRIDE + 1] = (double)(end - begin);
+}
+
+
+/*
+ * Function: row_range
+ * ----------------------------
+ * Reduces the rows begin .. end - 1 (0-based) into the output vector.
+ */
+static void row_range(uint64_t begin, uint64_t end, uint32_t thread, void* ctx) {
+        ew_job* job = (ew_job*)ctx;
+        csr_matrix* A = job->A;
+        (void)thread;
+
+        for (uint64_t i = begin; i < end; i++) {
+                uint64_t start = A->row_ptr[i];
+                uint64_t count = A->row_ptr[i + 1] - start;
+                job->out[i] = count ? finish(job->kind, reduce_segment(A->values + start, count, job->kind), count) : 0;
+        }
+}
+
+
+/*
+ * Function: column_range
+ * ----------------------------
+ * Reduces the entries of the rows begin .. end - 1 into the column arrays of the thread.
+ *
+ * Description:
+ *   Each thread owns a full column array; csr_column_reduce merges them afterwards.
+ */
+static void column_range(uint64_t begin, uint64_t end, uint32_t thread, void* ctx) {
+        ew_job* job = (ew_job*)ctx;
+        csr_matrix* A = job->A;
+        double* acc = job->partial + (size_t)thread * A->col;
+        uint64_t* seen = job->seen + (size_t)thread * A->col;
+
+        for (uint64_t p = A->row_ptr[begin]; p < A->row_ptr[end]; p++) {
+                uint32_t j = A->col_idx[p] - 1;
+                double x = A->values[p];
+                if (!seen[j] && (job->kind == SM_REDUCE_MIN || job->kind == SM_REDUCE_MAX)) acc[j] = x;
+                acc[j] = combine(job->kind, acc[j], x);
+                seen[j]++;
+        }
+}
+
+
+/*
+ * Function: csr_scale
+ * ----------------------------
+ * Multiplies every stored value by a constant.
+ *
+ * @param A - Pointer to the CSR matrix.
+ * @param alpha - Scale factor.
+ * @param threads - Number of threads, or 0 for one per online CPU.
+ */
+void csr_scale(csr_matrix* A, double alpha, uint32_t threads) {
+        if (!A) return;
+
+        ew_job job = { .A = A, .alpha = alpha };
+        sm_parallel_for(A->nnz, sm_thread_count(threads), scale_range, &job);
+}
+
+
+/*
+ * Function: csr_apply
+ * ----------------------------
+ * Applies a predefined operator to every stored value.
+ *
+ * @param A - Pointer to the CSR matrix.
+ * @param op - The operator.
+ * @param threads - Number of threads, or 0 for one per online CPU.
+ */
+void csr_apply(csr_matrix* A, sm_unary_op op, uint32_t threads) {
+        if (!A) return;
+
+        ew_job job = { .A = A, .op = op };
+        sm_parallel_for(A->nnz, sm_thread_count(threads), apply_range, &job);
+}
+
+
+/*
+ * Function: csr_map
+ * ----------------------------
+ * Applies a user function to every stored value.
+ *
+ * @param A - Pointer to the CSR matrix.
+ * @param fn - The function.
+ * @param ctx - Caller context passed to fn.
+ * @param threads - Number of threads, or 0 for one per online CPU.
+ */
+void csr_map(csr_matrix* A, sm_map_fn fn, void* ctx, uint32_t threads) {
+        if (!A || !fn) return;
+
+        ew_job job = { .A = A, .fn = fn, .ctx = ctx };
+        sm_parallel_for(A->nnz, sm_thread_count(threads), map_range, &job);
+}
+
+
+/*
+ * Function: csr_prune
+ * ----------------------------
+ * Drops the stored values with |v| < eps, and any stored zeros, compacting the arrays in place.
+ *
+ * @param A - Pointer to the CSR matrix.
+ * @param eps - Threshold.
+ *
+ * @return Number of entries dropped.
+ */
+uint64_t csr_prune(csr_matrix* A, double eps) {
+        if (!A) return 0;
+
+        uint64_t kept = 0;
+        uint64_t begin = 0;
+        for (uint32_t i = 0; i < A->row; i++) {
+                uint64_t end = A->row_ptr[i + 1];
+                for (uint64_t p = begin; p < end; p++) {
+                        double x = A->values[p];
+                        if (x == 0 || fabs(x) < eps) continue;
+
+                        A->col_idx[kept] = A->col_idx[p];
+                        A->values[kept] = x;
+                        kept++;
+                }
+                A->row_ptr[i + 1] = kept;
+                begin = end;
+        }
+
+        uint64_t dropped = A->nnz - kept;
+        A->nnz = kept;
+
+        return dropped;
+}
+
+
+/*
+ * Function: csr_reduce
+ * ----------------------------
+ * Reduces all stored values to one number.
+ *
+ * @param A - Pointer to the CSR matrix.
+ * @param kind - The reduction.
+ * @param threads - Number of threads, or 0 for one per online CPU.
+ *
+ * @return The reduced value (0 for an empty matrix).
+ */
+double csr_reduce(csr_matrix* A, sm_reduce kind, uint32_t threads) {
+        if (!A || !A->nnz) return 0;
+
+        threads = sm_thread_count(threads);
+        double* partial = (double*)calloc((size_t)threads * SM_PARTIAL_STRIDE, sizeof(double));
+        if (!partial) {
+                return finish(kind, reduce_segment(A->values, A->nnz, kind), A->nnz);
+        }
+
+        ew_job job = { .A = A, .kind = kind, .partial = partial };
+        uint32_t used = sm_parallel_for(A->nnz, threads, reduce_range, &job);
+
+        double acc = 0;
+        uint64_t count = 0;
+        for (uint32_t t = 0; t < used; t++) {
+                uint64_t part_count = (uint64_t)partial[t * SM_PARTIAL_STRIDE + 1];
+                acc = merge(kind, acc, count, partial[t * SM_PARTIAL_STRIDE], part_count);
+                count += part_count;
+        }
+
+        free(partial);
+        return finish(kind, acc, count);
+}
+
+
+/*
+ * Function: csr_row_reduce
+ * ----------------------------
+ * Reduces each row to one number.
+ *
+ * @param A - Pointer to the CSR matrix.
+ * @param kind - The reduction.
+ * @param out - Output vector of A->row entries.
+ * @param threads - Number of threads, or 0 for one per online CPU.
+ */
+void csr_row_reduce(csr_matrix* A, sm_reduce kind, double* out, uint32_t threads) {
+        if (!A || !out) return;
+
+        ew_job job = { .A = A, .kind = kind, .out = out };
+        sm_parallel_for(A->row, sm_thread_count(threads), row_range, &job);
+}
+
+
+/*
+ * Function: csr_column_reduce
+ * ----------------------------
+ * Reduces each column to one number.
+ *
+ * @param A - Pointer to the CSR matrix.
+ * @param kind - The reduction.
+ * @param out - Output vector of A->col entries.
+ * @param threads - Number of threads, or 0 for one per online CPU.
+ *
+ * @return true on success, false if the per-thread partial columns can not be allocated.
+ *
+ * Description:
+ *   Each thread reduces a band of rows into its own column array; the arrays are merged
+ *   column by column at the end.
+ */
+bool csr_column_reduce(csr_matrix* A, sm_reduce kind, double* out, uint32_t threads) {
+        if (!A || !out) return false;
+
+        threads = sm_thread_count(threads);
+        size_t slots = (size_t)threads * (A->col ? A->col : 1);
+        double* partial = (double*)calloc(slots, sizeof(double));
+        uint64_t* seen = (uint64_t*)calloc(slots, sizeof(uint64_t));
+        if (!partial || !seen) {
+                free(partial);
+                free(seen);
+                return false;
+        }
+
+        ew_job job = { .A = A, .kind = kind, .partial = partial, .seen = seen };
+        uint32_t used = sm_parallel_for(A->row, threads, column_range, &job);
+
+        for (uint32_t j = 0; j < A->col; j++) {
+                double acc = 0;
+                uint64_t count = 0;
+                for (uint32_t t = 0; t < used; t++) {
+                        size_t slot = (size_t)t * A->col + j;
+                        acc = merge(kind, acc, count, partial[slot], seen[slot]);
+                        count += seen[slot];
+                }
+                out[j] = finish(kind, acc, count);
+        }
+
+        free(partial);
+        free(seen);
+        return true;
+}
+
+
+/*
+ * Function: prune_S_Matrix
+ * ----------------------------
+ * Removes the entries with |v| < eps from a linked matrix.
+ *
+ * @param M - Pointer to the matrix.
+ * @param eps - Threshold.
+ *
+ * @return Number of entries removed.
+ *
+ * Description:
+ *   The first pass unlinks the dropped nodes from their column chains, the second unlinks
+ *   them from their row chains and frees them. Stored zeros are removed as well.
+ */
+uint64_t prune_S_Matrix(matrix* M, double eps) {
+        if (!M || !M->rowList || !M->columnList) return 0;
+
+        uint32_t index = 0;
+        for (l_node* temp; (temp = next_header(M->columnList, &index));) {
+                m_node** link = &temp->matrix_node;
+                while (*link) {
+                        double x = (*link)->value;
+                        if (x == 0 || fabs(x) < eps) {
+                                *link = (*link)->col_ptr;
+                        } else {
+                                link = &(*link)->col_ptr;
+                        }
+                }
+        }
+
+        uint64_t removed = 0;
+        index = 0;
+        for (l_node* temp; (temp = next_header(M->rowList, &index));) {
+                m_node** link = &temp->matrix_node;
+                while (*link) {
+                        m_node* node = *link;
+                        if (node->value == 0 || fabs(node->value) < eps) {
+                                *link = node->row_ptr;
+                                free(node);
+                                removed++;
+                        } else {
+                                link = &node->row_ptr;
+                        }
+                }
+        }
+
+        flush_mat_nodes(M);
+        count_mat_nodes(0, removed);
+        mem_stats_free(&M->mem, removed * sizeof(m_node), removed, removed);
+
+        if (removed) M->generation++;
+        return removed;
+}
+
+
+/*
+ * Function: scale_S_Matrix
+ * ----------------------------
+ * Multiplies every stored value of a linked matrix by a constant.
+ *
+ * @param M - Pointer to the matrix.
+ * @param alpha - Scale factor; 0 empties the matrix.
+ */
+void scale_S_Matrix(matrix* M, double alpha) {
+        if (!M || !M->rowList) return;
+
+        bool zeros = false;
+        uint32_t index = 0;
+        for (l_node* temp; (temp = next_header(M->rowList, &index));) {
+                for (m_node* node = temp->matrix_node; node; node = node->row_ptr) {
+                        node->value *= alpha;
+                        zeros |= (node->value == 0);
+                }
+        }
+
+        M->generation++;
+        if (zeros) prune_S_Matrix(M, 0);
+}
+
+
+/*
+ * Function: apply_op
+ * ----------------------------
+ * Applies a predefined operator to one value.
+ *
+ * @param op - The operator.
+ * @param x - The value.
+ *
+ * @return The result.
+ */
+static double apply_op(sm_unary_op op, double x) {
+        switch (op) {
+        case SM_OP_ABS: return fabs(x);
+        case SM_OP_NEGATE: return -x;
+        case SM_OP_SQUARE: return x * x;
+        case SM_OP_SQRT: return sqrt(x);
+        case SM_OP_RECIPROCAL: return 1.0 / x;
+        }
+        return x;
+}
+
+
+/*
+ * Function: apply_S_Matrix
+ * ----------------------------
+ * Applies a predefined operator to every stored value of a linked matrix.
+ *
+ * @param M - Pointer to the matrix.
+ * @param op - The operator; entries that become 0 are removed.
+ */
+void apply_S_Matrix(matrix* M, sm_unary_op op) {
+        if (!M || !M->rowList) return;
+
+        bool zeros = false;
+        uint32_t index = 0;
+        for (l_node* temp; (temp = next_header(M->rowList, &index));) {
+                for (m_node* node = temp->matrix_node; node; node = node->row_ptr) {
+                        node->value = apply_op(op, node->value);
+                        zeros |= (node->value == 0);
+                }
+        }
+
+        M->generation++;
+        if (zeros) prune_S_Matrix(M, 0);
+}
+
+
+/*
+ * Function: map_S_Matrix
+ * ----------------------------
+ * Applies a user function to every stored value of a linked matrix.
+ *
+ * @param M - Pointer to the matrix.
+ * @param fn - The function; entries it maps to 0 are removed.
+ * @param ctx - Caller context passed to fn.
+ */
+void map_S_Matrix(matrix* M, sm_map_fn fn, void* ctx) {
+        if (!M || !M->rowList || !fn) return;
+
+        bool zeros = false;
+        uint32_t index = 0;
+        for (l_node* temp; (temp = next_header(M->rowList, &index));) {
+                for (m_node* node = temp->matrix_node; node; node = node->row_ptr) {
+                        node->value = fn(node->value, ctx);
+                        zeros |= (node->value == 0);
+                }
+        }
+
+        M->generation++;
+        if (zeros) prune_S_Matrix(M, 0);
+}
+
+
+/*
+ * Function: accumulate
+ * ----------------------------
+ * Adds one value to a running reduction.
+ *
+ * @param kind - The reduction.
+ * @param acc - The running result.
+ * @param seen - Number of values added so far; incremented.
+ * @param x - The value.
+ */
+static inline void accumulate(sm_reduce kind, double* acc, uint64_t* seen, double x) {
+        if (!*seen && (kind == SM_REDUCE_MIN || kind == SM_REDUCE_MAX)) *acc = x;
+        *acc = combine(kind, *acc, x);
+        (*seen)++;
+}
+
+
+/*
+ * Function: reduce_chains
+ * ----------------------------
+ * Reduces each chain of a header list into an output vector.
+ *
+ * @param ll - Pointer to the header list.
+ * @param mirror - The other header list of a symmetric matrix, or NULL.
+ * @param count - Number of chains the matrix has (entries of out).
+ * @param by_column - Whether the chains are followed through col_ptr.
+ * @param kind - The reduction.
+ * @param out - Output vector.
+ *
+ * Description:
+ *   Row i of a symmetric matrix is also its column i, so chain i of the other list adds the
+ *   mirrored triangle; its diagonal entry is already in chain i of ll.
+ */
+static void reduce_chains(link_list* ll, link_list* mirror, uint32_t count, bool by_column, sm_reduce kind, double* out) {
+        for (uint32_t index = 1; index <= count; index++) {
+                double acc = 0;
+                uint64_t seen = 0;
+
+                if (ll) {
+                        for (m_node* node = header_chain(ll, index); node; node = by_column ? node->col_ptr : node->row_ptr) {
+                                accumulate(kind, &acc, &seen, node->value);
+                        }
+                }
+
+                if (mirror) {
+                        for (m_node* node = header_chain(mirror, index); node; node = by_column ? node->row_ptr : node->col_ptr) {
+                                if (node->row != node->column) accumulate(kind, &acc, &seen, node->value);
+                        }
+                }
+
+                out[index - 1] = finish(kind, acc, seen);
+        }
+}
+
+
+/*
+ * Function: row_reduce_S_Matrix
+ * ----------------------------
+ * Reduces each row of a linked matrix to one number.
+ *
+ * @param M - Pointer to the matrix.
+ * @param kind - The reduction.
+ * @param out - Output vector of M->row entries.
+ */
+void row_reduce_S_Matrix(matrix* M, sm_reduce kind, double* out) {
+        if (!M || !out) return;
+        reduce_chains(M->rowList, M->symmetric ? M->columnList : NULL, M->row, false, kind, out);
+}
+
+
+/*
+ * Function: column_reduce_S_Matrix
+ * ----------------------------
+ * Reduces each column of a linked matrix to one number, walking the column chains.
+ *
+ * @param M - Pointer to the matrix.
+ * @param kind - The reduction.
+ * @param out - Output vector of M->col entries.
+ */
+void column_reduce_S_Matrix(matrix* M, sm_reduce kind, double* out) {
+        if (!M || !out) return;
+        reduce_chains(M->columnList, M->symmetric ? M->rowList : NULL, M->col, true, kind, out);
+}
@@ -0,0 +1,312 @@
+/*
+ * File Name: S_Matrix_fingerprint.c
+ * Authors: Arpit Patel, Dharm KaPatel
+ * Date: 2025-03-19
+ * Description: This file implements content equality and content fingerprints of the S_Matrix
+ *              data structure. Threads take blocks of rows and reach each through seek_header.
+ *              The fingerprint gathers entries into eight-lane GCC vectors and hashes a full
+ *              vector at once, two independent 64-bit hashes per entry; the hashes are summed,
+ *              which is what makes the result independent of order and thread split.
+ */
+
+
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdatomic.h>
+
+
+#include "../include/S_Matrix_fingerprint.h"
+#include "../include/S_Matrix_csr.h"
+#include "../include/S_Matrix_parallel.h"
+#include "S_Matrix_simd.h"
+
+
+// MurmurHash3 finalizer; works on a scalar or a vector lvalue alike
+#define FMIX(x) do { \
+        (x) ^= (x) >> 33; \
+        (x) *= 0xFF51AFD7ED558CCDULL; \
+        (x) ^= (x) >> 33; \
+        (x) *= 0xC4CEB9FE1A85EC53ULL; \
+        (x) ^= (x) >> 33; \
+} while (0)
+
+
+// The two hashes of an entry with key (row << 32 | column) and value bits
+#define ENTRY_HASH(key, value, h1, h2) do { \
+        (h1) = (key) + 0x9E3779B97F4A7C15ULL; \
+        FMIX(h1); \
+        (h1) ^= (value); \
+        FMIX(h1); \
+        (h2) = (value) + 0xD1B54A32D192ED03ULL; \
+        FMIX(h2); \
+        (h2) ^= (key) * 0xAEF17502108EF2D9ULL; \
+        FMIX(h2); \
+} while (0)
+
+
+static inline uint64_t value_bits(double value) {
+        uint64_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        return bits;
+}
+
+
+/*
+ * Struct: hash_lanes
+ * ----------------------------
+ * Entries waiting to be hashed and the running sums of one thread.
+ *
+ * key: Keys of the waiting entries.
+ * value: Value bits of the waiting entries.
+ * fill: Number of waiting entries.
+ * sum1, sum2: Lane-wise sums of the hashed entries.
+ * count: Number of entries added.
+ */
+typedef struct hash_lanes {
+        uint64_t key[SM_LANES];
+        uint64_t value[SM_LANES];
+        uint32_t fill;
+        sm_words sum1;
+        sm_words sum2;
+        uint64_t count;
+} hash_lanes;
+
+
+static inline void flush_lanes(hash_lanes* h) {
+        sm_words key, value, h1, h2;
+        memcpy(&key, h->key, sizeof(key));
+        memcpy(&value, h->value, sizeof(value));
+
+        ENTRY_HASH(key, value, h1, h2);
+        h->sum1 += h1;
+        h->sum2 += h2;
+        h->fill = 0;
+}
+
+
+static inline void add_entry(hash_lanes* h, uint32_t row, uint32_t column, uint64_t bits) {
+        h->key[h->fill] = ((uint64_t)row << 32) | column;
+        h->value[h->fill] = bits;
+        h->count++;
+        if (++h->fill == SM_LANES) flush_lanes(h);
+}
+
+
+// Adds one row; a stored off-diagonal entry of a symmetric matrix stands for two entries
+static inline void add_row(hash_lanes* h, m_node* chain, bool symmetric) {
+        for (m_node* node = chain; node; node = node->row_ptr) {
+                uint64_t bits = value_bits(node->value);
+                add_entry(h, node->row, node->column, bits);
+                if (symmetric && node->row != node->column) add_entry(h, node->column, node->row, bits);
+        }
+}
+
+
+/*
+ * Struct: hash_job
+ * ----------------------------
+ * Shared state of fingerprint_S_Matrix.
+ *
+ * rows: Row header list of the matrix.
+ * symmetric: Whether the matrix stores one triangle.
+ * sums: Per thread, the two hash sums and the entry count.
+ */
+typedef struct hash_job {
+        link_list* rows;
+        bool symmetric;
+        uint64_t (*sums)[3];
+} hash_job;
+
+
+/*
+ * Function: finish_lanes
+ * ----------------------------
+ * Hashes the waiting entries and reduces the lanes.
+ *
+ * @param h - The lanes.
+ * @param out - Output: the two sums and the entry count.
+ */
+static void finish_lanes(hash_lanes* h, uint64_t out[3]) {
+        uint64_t s1 = 0, s2 = 0;
+
+        for (uint32_t i = 0; i < h->fill; i++) {
+                uint64_t h1, h2;
+                ENTRY_HASH(h->key[i], h->value[i], h1, h2);
+                s1 += h1;
+                s2 += h2;
+        }
+        for (uint32_t i = 0; i < SM_LANES; i++) {
+                s1 += h->sum1[i];
+                s2 += h->sum2[i];
+        }
+
+        out[0] = s1;
+        out[1] = s2;
+        out[2] = h->count;
+}
+
+
+static void hash_range(uint64_t begin, uint64_t end, uint32_t thread, void* ctx) {
+        hash_job* job = (hash_job*)ctx;
+        hash_lanes h;
+        memset(&h, 0, sizeof(h));
+
+        for (uint64_t r = begin; r < end; r++) add_row(&h, header_chain(job->rows, (uint32_t)r + 1), job->symmetric);
+
+        finish_lanes(&h, job->sums[thread]);
+}
+
+
+/*
+ * Function: fingerprint_S_Matrix
+ * ----------------------------
+ * Computes the content hash of a matrix.
+ *
+ * @param M - Pointer to the matrix.
+ * @param threads - Number of threads, or 0 for one per online CPU.
+ *
+ * @return The fingerprint; {0, 0} for NULL.
+ */
+sm_fingerprint fingerprint_S_Matrix(matrix* M, uint32_t threads) {
+        sm_fingerprint f = { 0, 0 };
+        if (!M || !M->rowList) return f;
+
+        threads = sm_thread_count(threads);
+
+        // Rows past the header list are empty
+        uint32_t count = (M->rowList->size < M->row) ? M->rowList->size : M->row;
+        hash_job job = { M->rowList, M->symmetric, (uint64_t (*)[3])calloc(threads, sizeof(uint64_t[3])) };
+
+        uint64_t s1 = 0, s2 = 0, nnz = 0;
+        if (job.sums) {
+                uint32_t used = sm_parallel_for(count, threads, hash_range, &job);
+                for (uint32_t t = 0; t < used; t++) {
+                        s1 += job.sums[t][0];
+                        s2 += job.sums[t][1];
+                        nnz += job.sums[t][2];
+                }
+        } else {
+                // Without the per-thread sums, hash every row on this thread
+                hash_lanes h;
+                memset(&h, 0, sizeof(h));
+                for (uint32_t r = 1; r <= count; r++) add_row(&h, header_chain(M->rowList, r), M->symmetric);
+
+                uint64_t out[3];
+                finish_lanes(&h, out);
+                s1 = out[0];
+                s2 = out[1];
+                nnz = out[2];
+        }
+
+        free(job.sums);
+
+        // Fold in the shape, so empty matrices of different sizes differ
+        uint64_t shape = ((uint64_t)M->row << 32) | M->col;
+        f.lo = s1 ^ shape;
+        FMIX(f.lo);
+        f.lo ^= nnz;
+        FMIX(f.lo);
+        f.hi = s2 + shape * 0xAEF17502108EF2D9ULL + nnz;
+        FMIX(f.hi);
+
+        return f;
+}
+
+
+// Whether two row chains differ in a column or a value
+static inline bool rows_differ(m_node* a, m_node* b) {
+        for (; a && b; a = a->row_ptr, b = b->row_ptr) {
+                if (a->column != b->column || value_bits(a->value) != value_bits(b->value)) return true;
+        }
+        return a || b;
+}
+
+
+/*
+ * Struct: equal_job
+ * ----------------------------
+ * Shared state of matrix_equal.
+ *
+ * a, b: Row header lists of the two matrices.
+ * differ: Set at the first difference, which stops every thread.
+ */
+typedef struct equal_job {
+        link_list* a;
+        link_list* b;
+        atomic_bool differ;
+} equal_job;
+
+
+static void equal_range(uint64_t begin, uint64_t end, uint32_t thread, void* ctx) {
+        equal_job* job = (equal_job*)ctx;
+        (void)thread;
+
+        for (uint64_t r = begin; r < end; r++) {
+                if ((r & 63) == 0 && atomic_load_explicit(&job->differ, memory_order_relaxed)) return;
+
+                if (rows_differ(header_chain(job->a, (uint32_t)r + 1), header_chain(job->b, (uint32_t)r + 1))) {
+                        atomic_store_explicit(&job->differ, true, memory_order_relaxed);
+                        return;
+                }
+        }
+}
+
+
+/*
+ * Function: csr_equal
+ * ----------------------------
+ * Compares the CSR forms of two matrices, which expand symmetric storage.
+ *
+ * @return true if the forms are equal, false if they differ or can not be built.
+ */
+static bool csr_equal(matrix* A, matrix* B) {
+        csr_matrix* a = csr_from_S_Matrix(A);
+        csr_matrix* b = csr_from_S_Matrix(B);
+
+        bool equal = a && b && a->nnz == b->nnz &&
+                     memcmp(a->row_ptr, b->row_ptr, ((size_t)a->row + 1) * sizeof(uint64_t)) == 0 &&
+                     memcmp(a->col_idx, b->col_idx, a->nnz * sizeof(uint32_t)) == 0 &&
+                     memcmp(a->values, b->values, a->nnz * sizeof(double)) == 0;
+
+        free_csr_matrix(a);
+        free_csr_matrix(b);
+
+        return equal;
+}
+
+
+/*
+ * Function: matrix_equal
+ * ----------------------------
+ * Checks whether two matrices have the same dimensions and the same values at the same positions.
+ *
+ * @param A - Pointer to the first matrix.
+ * @param B - Pointer to the second matrix.
+ * @param threads - Number of threads, or 0 for one per online CPU.
+ *
+ * @return true if the matrices are equal, false otherwise.
+ */
+bool matrix_equal(matrix* A, matrix* B, uint32_t threads) {
+        if (A == B) return true;
+        if (!A || !B || !A->rowList || !B->rowList) return false;
+        if (A->row != B->row || A->col != B->col) return false;
+
+        if (A->symmetric != B->symmetric) return csr_equal(A, B);
+
+        threads = sm_thread_count(threads);
+
+        equal_job job;
+        job.a = A->rowList;
+        job.b = B->rowList;
+        atomic_init(&job.differ, false);
+
+        // Rows past both header lists are empty in both matrices
+        uint32_t rows = (A->rowList->size > B->rowList->size) ? A->rowList->size : B->rowList->size;
+        if (rows > A->row) rows = A->row;
+        sm_parallel_for(rows, threads, equal_range, &job);
+
+        return !atomic_load(&job.differ);
+}
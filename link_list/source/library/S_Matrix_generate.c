@@ -0,0 +1,558 @@
+/*
+ * File Name: S_Matrix_generate.c
+ * Authors: Arpit Patel, Dharm KaPatel
+ * Date: 2025-03-19
+ * Description: This file implements the bulk generators of the S_Matrix data structure. Every
+ *              generator first fills a CSR form in parallel: rows are counted, the counts are
+ *              turned into offsets and the rows are filled, so the arrays are allocated once at
+ *              their exact size. The CSR form is then linked into a matrix by
+ *              S_Matrix_from_csr_parallel().
+ */
+
+
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+
+
+#include "../include/S_Matrix_generate.h"
+#include "../include/S_Matrix_csr.h"
+#include "../include/S_Matrix_parallel.h"
+
+
+/*
+ * Function: splitmix64
+ * ----------------------------
+ * Advances a SplitMix64 stream.
+ *
+ * @param state - State of the stream.
+ *
+ * @return The next 64 random bits.
+ */
+static inline uint64_t splitmix64(uint64_t* state) {
+        uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+}
+
+
+// Start of the stream of one row or edge, so the draws do not depend on the thread split
+static inline uint64_t stream_start(uint64_t seed, uint64_t index) {
+        uint64_t state = seed ^ (index * 0xD1B54A32D192ED03ULL);
+        return splitmix64(&state);
+}
+
+
+// Uniform double in [0, 1)
+static inline double uniform(uint64_t* state) {
+        return (double)(splitmix64(state) >> 11) * 0x1.0p-53;
+}
+
+
+/*
+ * Type: row_fn
+ * ----------------------------
+ * Produces one row of a generated matrix.
+ *
+ * row: The row (0-based).
+ * columns: Output columns (1-based, ascending), or NULL to only count.
+ * values: Output values, or NULL to only count.
+ * ctx: Generator state.
+ *
+ * Returns the number of entries of the row; both calls for a row must agree.
+ */
+typedef uint64_t (*row_fn)(uint32_t row, uint32_t* columns, double* values, const void* ctx);
+
+
+/*
+ * Struct: rows_job
+ * ----------------------------
+ * Shared state of build_rows.
+ */
+typedef struct rows_job {
+        row_fn fn;
+        const void* ctx;
+        uint64_t* counts;
+        csr_matrix* C;
+} rows_job;
+
+
+static void count_rows(uint64_t begin, uint64_t end, uint32_t thread, void* ctx) {
+        rows_job* job = (rows_job*)ctx;
+        (void)thread;
+
+        for (uint64_t r = begin; r < end; r++) {
+                job->counts[r + 1] = job->fn((uint32_t)r, NULL, NULL, job->ctx);
+        }
+}
+
+
+static void fill_rows(uint64_t begin, uint64_t end, uint32_t thread, void* ctx) {
+        rows_job* job = (rows_job*)ctx;
+        csr_matrix* C = job->C;
+        (void)thread;
+
+        for (uint64_t r = begin; r < end; r++) {
+                job->fn((uint32_t)r, C->col_idx + C->row_ptr[r], C->values + C->row_ptr[r], job->ctx);
+        }
+}
+
+
+/*
+ * Function: build_rows
+ * ----------------------------
+ * Generates a matrix row by row: counts every row, sizes the CSR form exactly, fills it and
+ * links it.
+ *
+ * @param rows - Number of rows.
+ * @param columns - Number of columns.
+ * @param fn - Row generator.
+ * @param ctx - Generator state.
+ * @param threads - Number of threads (already resolved).
+ *
+ * @return Pointer to the matrix, or NULL if allocation fails.
+ */
+static matrix* build_rows(uint32_t rows, uint32_t columns, row_fn fn, const void* ctx, uint32_t threads) {
+        rows_job job = { fn, ctx, (uint64_t*)calloc((size_t)rows + 1, sizeof(uint64_t)), NULL };
+        if (!job.counts) return NULL;
+
+        sm_parallel_for(rows, threads, count_rows, &job);
+        for (uint32_t r = 0; r < rows; r++) job.counts[r + 1] += job.counts[r];
+
+        job.C = create_csr_matrix(rows, columns, job.counts[rows]);
+        if (!job.C) {
+                free(job.counts);
+                return NULL;
+        }
+        memcpy(job.C->row_ptr, job.counts, ((size_t)rows + 1) * sizeof(uint64_t));
+        free(job.counts);
+
+        sm_parallel_for(rows, threads, fill_rows, &job);
+
+        matrix* M = S_Matrix_from_csr_parallel(job.C, threads);
+        free_csr_matrix(job.C);
+
+        return M;
+}
+
+
+/*
+ * Struct: kron_ctx
+ * ----------------------------
+ * The CSR forms of the factors of a Kronecker product.
+ */
+typedef struct kron_ctx {
+        csr_matrix* A;
+        csr_matrix* B;
+} kron_ctx;
+
+
+static uint64_t kron_row(uint32_t row, uint32_t* columns, double* values, const void* ctx) {
+        const kron_ctx* k = (const kron_ctx*)ctx;
+        csr_matrix* A = k->A;
+        csr_matrix* B = k->B;
+
+        uint32_t i = row / B->row;
+        uint32_t j = row % B->row;
+        uint64_t count = (A->row_ptr[i + 1] - A->row_ptr[i]) * (B->row_ptr[j + 1] - B->row_ptr[j]);
+        if (!columns) return count;
+
+        uint64_t n = 0;
+        for (uint64_t a = A->row_ptr[i]; a < A->row_ptr[i + 1]; a++) {
+                uint32_t base = (A->col_idx[a] - 1) * B->col;
+                double scale = A->values[a];
+
+                for (uint64_t b = B->row_ptr[j]; b < B->row_ptr[j + 1]; b++, n++) {
+                        columns[n] = base + B->col_idx[b];
+                        values[n] = scale * B->values[b];
+                }
+        }
+
+        return count;
+}
+
+
+/*
+ * Function: kron_S_Matrix
+ * ----------------------------
+ * Computes the Kronecker product A ⊗ B.
+ *
+ * @param A - Pointer to the left matrix.
+ * @param B - Pointer to the right matrix.
+ * @param threads - Number of threads, or 0 for one per online CPU.
+ *
+ * @return Pointer to the product, or NULL on invalid input or allocation failure.
+ */
+matrix* kron_S_Matrix(matrix* A, matrix* B, uint32_t threads) {
+        if (!A || !B) return NULL;
+
+        uint64_t rows = (uint64_t)A->row * B->row;
+        uint64_t columns = (uint64_t)A->col * B->col;
+        if (rows > UINT32_MAX || columns > UINT32_MAX) return NULL;
+
+        threads = sm_thread_count(threads);
+
+        kron_ctx ctx = { csr_from_S_Matrix(A), csr_from_S_Matrix(B) };
+        matrix* M = NULL;
+        if (ctx.A && ctx.B) M = build_rows((uint32_t)rows, (uint32_t)columns, kron_row, &ctx, threads);
+
+        free_csr_matrix(ctx.A);
+        free_csr_matrix(ctx.B);
+
+        return M;
+}
+
+
+/*
+ * Struct: rmat_job
+ * ----------------------------
+ * Shared state of generate_rmat.
+ *
+ * scale: log2 of the number of vertices.
+ * a, ab, abc: Cumulative quadrant probabilities.
+ * seed: Seed of the edge streams.
+ * cursor: Edges per row, then the next free slot of each row, then the distinct edges per row.
+ * row_ptr: Offsets of the rows in col_idx.
+ * col_idx: Columns of the drawn edges (1-based), grouped by row.
+ * C: The final CSR form.
+ */
+typedef struct rmat_job {
+        uint32_t scale;
+        double a;
+        double ab;
+        double abc;
+        uint64_t seed;
+        uint64_t* cursor;
+        uint64_t* row_ptr;
+        uint32_t* col_idx;
+        csr_matrix* C;
+} rmat_job;
+
+
+// Descends the quadrant tree for one edge; row and column are 0-based
+static inline void rmat_edge(const rmat_job* job, uint64_t e, uint32_t* row, uint32_t* column) {
+        uint64_t state = stream_start(job->seed, e);
+        uint32_t r = 0;
+        uint32_t c = 0;
+
+        // Quadrants in order: [0, a) top left, [a, ab) top right, [ab, abc) bottom left, rest bottom right
+        for (uint32_t level = 0; level < job->scale; level++) {
+                double u = uniform(&state);
+                uint32_t right = (u >= job->a) - (u >= job->ab) + (u >= job->abc);
+                r = (r << 1) | (u >= job->ab);
+                c = (c << 1) | right;
+        }
+
+        *row = r;
+        *column = c;
+}
+
+
+static void rmat_count(uint64_t begin, uint64_t end, uint32_t thread, void* ctx) {
+        rmat_job* job = (rmat_job*)ctx;
+        (void)thread;
+
+        for (uint64_t e = begin; e < end; e++) {
+                uint32_t r, c;
+                rmat_edge(job, e, &r, &c);
+                __atomic_fetch_add(&job->cursor[r], 1, __ATOMIC_RELAXED);
+        }
+}
+
+
+static void rmat_scatter(uint64_t begin, uint64_t end, uint32_t thread, void* ctx) {
+        rmat_job* job = (rmat_job*)ctx;
+        (void)thread;
+
+        // Edges land in their row in any order; sorting the rows makes the result deterministic
+        for (uint64_t e = begin; e < end; e++) {
+                uint32_t r, c;
+                rmat_edge(job, e, &r, &c);
+                job->col_idx[__atomic_fetch_add(&job->cursor[r], 1, __ATOMIC_RELAXED)] = c + 1;
+        }
+}
+
+
+static int compare_u32(const void* x, const void* y) {
+        uint32_t a = *(const uint32_t*)x;
+        uint32_t b = *(const uint32_t*)y;
+        return (a > b) - (a < b);
+}
+
+
+static void rmat_dedupe(uint64_t begin, uint64_t end, uint32_t thread, void* ctx) {
+        rmat_job* job = (rmat_job*)ctx;
+        (void)thread;
+
+        for (uint64_t r = begin; r < end; r++) {
+                uint32_t* cols = job->col_idx + job->row_ptr[r];
+                uint64_t n = job->row_ptr[r + 1] - job->row_ptr[r];
+                uint64_t unique = 0;
+
+                // Most rows of a power-law graph are short, where insertion sort beats qsort
+                if (n > 32) {
+                        qsort(cols, n, sizeof(uint32_t), compare_u32);
+                } else {
+                        for (uint64_t k = 1; k < n; k++) {
+                                uint32_t x = cols[k];
+                                uint64_t j = k;
+                                for (; j && cols[j - 1] > x; j--) cols[j] = cols[j - 1];
+                                cols[j] = x;
+                        }
+                }
+                for (uint64_t k = 0; k < n; k++) {
+                        if (!unique || cols[k] != cols[unique - 1]) cols[unique++] = cols[k];
+                }
+
+                job->cursor[r] = unique;
+        }
+}
+
+
+static void rmat_compact(uint64_t begin, uint64_t end, uint32_t thread, void* ctx) {
+        rmat_job* job = (rmat_job*)ctx;
+        csr_matrix* C = job->C;
+        (void)thread;
+
+        for (uint64_t r = begin; r < end; r++) {
+                uint64_t n = C->row_ptr[r + 1] - C->row_ptr[r];
+                memcpy(C->col_idx + C->row_ptr[r], job->col_idx + job->row_ptr[r], n * sizeof(uint32_t));
+                for (uint64_t k = C->row_ptr[r]; k < C->row_ptr[r + 1]; k++) C->values[k] = 1.0;
+        }
+}
+
+
+/*
+ * Function: generate_rmat
+ * ----------------------------
+ * Generates an R-MAT graph adjacency matrix.
+ *
+ * @param scale - log2 of the number of vertices, at most 31.
+ * @param edges - Number of edges to draw.
+ * @param a - Probability of the top left quadrant.
+ * @param b - Probability of the top right quadrant.
+ * @param c - Probability of the bottom left quadrant.
+ * @param seed - Seed of the random streams.
+ * @param threads - Number of threads, or 0 for one per online CPU.
+ *
+ * @return Pointer to the matrix, or NULL on invalid parameters or allocation failure.
+ */
+matrix* generate_rmat(uint32_t scale, uint64_t edges, double a, double b, double c, uint64_t seed, uint32_t threads) {
+        if (scale > 31 || !(a >= 0) || !(b >= 0) || !(c >= 0) || !(a + b + c <= 1)) return NULL;
+
+        threads = sm_thread_count(threads);
+        uint32_t n = 1U << scale;
+
+        rmat_job job;
+        job.scale = scale;
+        job.a = a;
+        job.ab = a + b;
+        job.abc = a + b + c;
+        job.seed = seed;
+        job.cursor = (uint64_t*)calloc(n, sizeof(uint64_t));
+        job.row_ptr = (uint64_t*)malloc(((size_t)n + 1) * sizeof(uint64_t));
+        job.col_idx = (uint32_t*)malloc((edges ? edges : 1) * sizeof(uint32_t));
+        job.C = NULL;
+
+        matrix* M = NULL;
+        if (!job.cursor || !job.row_ptr || !job.col_idx) goto done;
+
+        // Count, place and sort the drawn edges by row
+        sm_parallel_for(edges, threads, rmat_count, &job);
+        job.row_ptr[0] = 0;
+        for (uint32_t r = 0; r < n; r++) {
+                job.row_ptr[r + 1] = job.row_ptr[r] + job.cursor[r];
+                job.cursor[r] = job.row_ptr[r];
+        }
+        sm_parallel_for(edges, threads, rmat_scatter, &job);
+        sm_parallel_for(n, threads, rmat_dedupe, &job);
+
+        // Size the final form by the distinct edges
+        uint64_t nnz = 0;
+        for (uint32_t r = 0; r < n; r++) nnz += job.cursor[r];
+
+        job.C = create_csr_matrix(n, n, nnz);
+        if (!job.C) goto done;
+        for (uint32_t r = 0; r < n; r++) job.C->row_ptr[r + 1] = job.C->row_ptr[r] + job.cursor[r];
+
+        sm_parallel_for(n, threads, rmat_compact, &job);
+        M = S_Matrix_from_csr_parallel(job.C, threads);
+
+done:
+        free(job.cursor);
+        free(job.row_ptr);
+        free(job.col_idx);
+        free_csr_matrix(job.C);
+
+        return M;
+}
+
+
+/*
+ * Struct: er_ctx
+ * ----------------------------
+ * Parameters of generate_erdos_renyi.
+ */
+typedef struct er_ctx {
+        uint32_t columns;
+        double p;
+        double log_q;
+        uint64_t seed;
+} er_ctx;
+
+
+static uint64_t er_row(uint32_t row, uint32_t* columns, double* values, const void* ctx) {
+        const er_ctx* er = (const er_ctx*)ctx;
+        uint64_t count = 0;
+
+        if (er->p >= 1) {
+                for (uint32_t c = 1; columns && c <= er->columns; c++) {
+                        columns[c - 1] = c;
+                        values[c - 1] = 1.0;
+                }
+                return er->columns;
+        }
+        if (er->p <= 0) return 0;
+
+        // Gaps between entries are geometric with success probability p
+        uint64_t state = stream_start(er->seed, row);
+        uint64_t c = 0;
+        for (;;) {
+                double skip = floor(log(1.0 - uniform(&state)) / er->log_q);
+                if (skip >= (double)er->columns - (double)c) break;
+
+                c += (uint64_t)skip + 1;
+                if (columns) {
+                        columns[count] = (uint32_t)c;
+                        values[count] = 1.0;
+                }
+                count++;
+        }
+
+        return count;
+}
+
+
+/*
+ * Function: generate_erdos_renyi
+ * ----------------------------
+ * Generates a random matrix where every position is present independently.
+ *
+ * @param rows - Number of rows.
+ * @param columns - Number of columns.
+ * @param p - Probability of each position.
+ * @param seed - Seed of the random streams.
+ * @param threads - Number of threads, or 0 for one per online CPU.
+ *
+ * @return Pointer to the matrix, or NULL on invalid parameters or allocation failure.
+ */
+matrix* generate_erdos_renyi(uint32_t rows, uint32_t columns, double p, uint64_t seed, uint32_t threads) {
+        if (!(p >= 0 && p <= 1)) return NULL;
+
+        threads = sm_thread_count(threads);
+
+        er_ctx ctx = { columns, p, log1p(-p), seed };
+        return build_rows(rows, columns, er_row, &ctx, threads);
+}
+
+
+/*
+ * Struct: diagonal
+ * ----------------------------
+ * One diagonal of generate_diagonals.
+ */
+typedef struct diagonal {
+        int64_t offset;
+        double value;
+} diagonal;
+
+
+/*
+ * Struct: diagonals_ctx
+ * ----------------------------
+ * Parameters of generate_diagonals, with the diagonals sorted by offset.
+ */
+typedef struct diagonals_ctx {
+        uint32_t columns;
+        const diagonal* diagonals;
+        uint32_t count;
+} diagonals_ctx;
+
+
+static uint64_t diagonals_row(uint32_t row, uint32_t* columns, double* values, const void* ctx) {
+        const diagonals_ctx* d = (const diagonals_ctx*)ctx;
+        uint64_t count = 0;
+
+        for (uint32_t k = 0; k < d->count; k++) {
+                int64_t c = (int64_t)row + 1 + d->diagonals[k].offset;
+                if (c < 1 || c > (int64_t)d->columns) continue;
+
+                if (columns) {
+                        columns[count] = (uint32_t)c;
+                        values[count] = d->diagonals[k].value;
+                }
+                count++;
+        }
+
+        return count;
+}
+
+
+static int compare_diagonals(const void* x, const void* y) {
+        int64_t a = ((const diagonal*)x)->offset;
+        int64_t b = ((const diagonal*)y)->offset;
+        return (a > b) - (a < b);
+}
+
+
+/*
+ * Function: generate_diagonals
+ * ----------------------------
+ * Generates a banded matrix with constant values along chosen diagonals.
+ *
+ * @param rows - Number of rows.
+ * @param columns - Number of columns.
+ * @param offsets - Diagonal of each value as column - row.
+ * @param values - Value of each diagonal.
+ * @param count - Number of diagonals.
+ * @param threads - Number of threads, or 0 for one per online CPU.
+ *
+ * @return Pointer to the matrix, or NULL if an offset repeats or allocation fails.
+ */
+matrix* generate_diagonals(uint32_t rows, uint32_t columns, const int64_t* offsets, const double* values,
+                           uint32_t count, uint32_t threads) {
+        if (count && (!offsets || !values)) return NULL;
+
+        threads = sm_thread_count(threads);
+
+        diagonal* diagonals = (diagonal*)malloc((count ? count : 1) * sizeof(diagonal));
+        if (!diagonals) return NULL;
+
+        uint32_t kept = 0;
+        for (uint32_t k = 0; k < count; k++) {
+                diagonals[k].offset = offsets[k];
+                diagonals[k].value = values[k];
+        }
+        qsort(diagonals, count, sizeof(diagonal), compare_diagonals);
+
+        // Drop empty diagonals after the duplicate check, so a repeated offset is always an error
+        for (uint32_t k = 0; k < count; k++) {
+                if (k && diagonals[k].offset == diagonals[k - 1].offset) {
+                        free(diagonals);
+                        return NULL;
+                }
+        }
+        for (uint32_t k = 0; k < count; k++) {
+                if (diagonals[k].value != 0) diagonals[kept++] = diagonals[k];
+        }
+
+        diagonals_ctx ctx = { columns, diagonals, kept };
+        matrix* M = build_rows(rows, columns, diagonals_row, &ctx, threads);
+        free(diagonals);
+
+        return M;
+}
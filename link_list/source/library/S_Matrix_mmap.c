@@ -0,0 +1,610 @@
+/*
+ * File Name: S_Matrix_mmap.c
+ * Authors: Arpit Patel, Dharm KaPatel
+ * Date: 2025-03-19
+ * Description: This file implements the file-backed, memory-mapped sparse matrix. Both files are
+ *              grown in large steps and remapped, and trimmed back to their logical size when
+ *              the matrix is closed.
+ */
+
+
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+
+#include "../include/S_Matrix_mmap.h"
+#include "../include/S_Matrix_csr.h"
+
+
+#define MM_MAGIC "SMMAP01"
+#define MM_PAGE 4096
+#define MM_INITIAL_DATA (64 * 1024)
+
+
+/*
+ * Function: index_path
+ * ----------------------------
+ * Builds the path of the index file belonging to a data file.
+ *
+ * @param path - Path of the data file.
+ *
+ * @return Newly allocated "<path>.idx", or NULL if allocation fails.
+ */
+static char* index_path(const char* path) {
+        size_t len = strlen(path) + 5;
+        char* idx = (char*)malloc(len);
+        if (!idx) return NULL;
+
+        snprintf(idx, len, "%s.idx", path);
+        return idx;
+}
+
+
+static void* map_file(int fd, uint64_t size, bool writable) {
+        void* p = mmap(NULL, size, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+        return (p == MAP_FAILED) ? NULL : p;
+}
+
+
+/*
+ * Function: grow_data
+ * ----------------------------
+ * Grows and remaps the data file so it holds at least the given number of bytes.
+ *
+ * @param F - Pointer to the file-backed matrix.
+ * @param needed - Required size in bytes.
+ *
+ * @return true on success, false on I/O failure.
+ */
+static bool grow_data(mm_matrix* F, uint64_t needed) {
+        if (needed <= F->data_size) return true;
+
+        uint64_t new_size = F->data_size * 2;
+        if (new_size < needed) new_size = needed;
+        new_size = (new_size + MM_PAGE - 1) / MM_PAGE * MM_PAGE;
+
+        if (ftruncate(F->data_fd, (off_t)new_size) != 0) return false;
+
+        uint8_t* data = (uint8_t*)map_file(F->data_fd, new_size, true);
+        if (!data) return false;
+
+        munmap(F->data, F->data_size);
+        F->data = data;
+        F->data_size = new_size;
+
+        return true;
+}
+
+
+/*
+ * Function: grow_index
+ * ----------------------------
+ * Grows and remaps the index file so it covers the given row.
+ *
+ * @param F - Pointer to the file-backed matrix.
+ * @param row - Row index that must be addressable.
+ *
+ * @return true on success, false on I/O failure.
+ */
+static bool grow_index(mm_matrix* F, uint64_t row) {
+        if (row <= F->index_rows) return true;
+
+        uint64_t new_rows = F->index_rows * 2;
+        if (new_rows < row) new_rows = row;
+
+        if (ftruncate(F->index_fd, (off_t)((new_rows + 1) * sizeof(uint64_t))) != 0) return false;
+
+        uint64_t* index = (uint64_t*)map_file(F->index_fd, (new_rows + 1) * sizeof(uint64_t), true);
+        if (!index) return false;
+
+        munmap(F->index, (F->index_rows + 1) * sizeof(uint64_t));
+        F->index = index;
+        F->index_rows = new_rows;
+
+        return true;
+}
+
+
+/*
+ * Function: valid_records
+ * ----------------------------
+ * Checks that every indexed record of an opened file lies inside the written data.
+ *
+ * @param F - Pointer to the file-backed matrix, with the header already checked.
+ *
+ * @return true if every row's offset and record fit, false if the files are truncated or corrupt.
+ *
+ * Description:
+ *   mm_row trusts the index and the record's nnz afterwards, so this is what keeps reads
+ *   inside the mapping. Only the index and the record headers are touched, not the values.
+ */
+static bool valid_records(mm_matrix* F) {
+        mm_header* header = (mm_header*)F->data;
+
+        for (uint64_t r = 1; r <= header->row; r++) {
+                uint64_t offset = F->index[r];
+                if (!offset) continue;
+
+                if (offset < sizeof(mm_header) || offset % 8 || offset > header->end - 8) return false;
+
+                uint64_t nnz = ((uint32_t*)(F->data + offset))[1];
+                if (nnz * (sizeof(double) + sizeof(uint32_t)) > header->end - offset - 8) return false;
+        }
+
+        return true;
+}
+
+
+/*
+ * Function: mm_create
+ * ----------------------------
+ * Creates (or truncates) a file-backed matrix.
+ *
+ * @param path - Path of the data file; the index is written to <path>.idx.
+ * @param rows - Number of rows.
+ * @param columns - Number of columns.
+ *
+ * @return Pointer to the writable matrix, or NULL if the files can not be created.
+ */
+mm_matrix* mm_create(const char* path, uint32_t rows, uint32_t columns) {
+        char* idx = index_path(path);
+        mm_matrix* F = (mm_matrix*)calloc(1, sizeof(mm_matrix));
+        if (!idx || !F) {
+                free(idx);
+                free(F);
+                return NULL;
+        }
+
+        F->writable = true;
+        F->data_fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+        F->index_fd = open(idx, O_RDWR | O_CREAT | O_TRUNC, 0644);
+        free(idx);
+
+        if (F->data_fd < 0 || F->index_fd < 0) goto fail;
+
+        F->data_size = MM_INITIAL_DATA;
+        F->index_rows = rows ? rows : 1;
+
+        if (ftruncate(F->data_fd, (off_t)F->data_size) != 0) goto fail;
+        if (ftruncate(F->index_fd, (off_t)((F->index_rows + 1) * sizeof(uint64_t))) != 0) goto fail;
+
+        F->data = (uint8_t*)map_file(F->data_fd, F->data_size, true);
+        F->index = (uint64_t*)map_file(F->index_fd, (F->index_rows + 1) * sizeof(uint64_t), true);
+        if (!F->data || !F->index) goto fail;
+
+        mm_header* header = (mm_header*)F->data;
+        memcpy(header->magic, MM_MAGIC, sizeof(header->magic));
+        header->row = rows;
+        header->col = columns;
+        header->end = sizeof(mm_header);
+
+        return F;
+
+fail:
+        if (F->data) munmap(F->data, F->data_size);
+        if (F->index) munmap(F->index, (F->index_rows + 1) * sizeof(uint64_t));
+        if (F->data_fd >= 0) close(F->data_fd);
+        if (F->index_fd >= 0) close(F->index_fd);
+        free(F);
+        return NULL;
+}
+
+
+/*
+ * Function: mm_open
+ * ----------------------------
+ * Opens an existing file-backed matrix.
+ *
+ * @param path - Path of the data file.
+ * @param writable - Whether rows will be appended.
+ *
+ * @return Pointer to the matrix, or NULL if the files can not be opened or are not valid.
+ */
+mm_matrix* mm_open(const char* path, bool writable) {
+        char* idx = index_path(path);
+        mm_matrix* F = (mm_matrix*)calloc(1, sizeof(mm_matrix));
+        if (!idx || !F) {
+                free(idx);
+                free(F);
+                return NULL;
+        }
+
+        int flags = writable ? O_RDWR : O_RDONLY;
+        F->writable = writable;
+        F->data_fd = open(path, flags);
+        F->index_fd = open(idx, flags);
+        free(idx);
+
+        struct stat data_st;
+        struct stat index_st;
+        if (F->data_fd < 0 || F->index_fd < 0) goto fail;
+        if (fstat(F->data_fd, &data_st) != 0 || fstat(F->index_fd, &index_st) != 0) goto fail;
+        if ((uint64_t)data_st.st_size < sizeof(mm_header) || (uint64_t)index_st.st_size < 2 * sizeof(uint64_t)) goto fail;
+
+        F->data_size = (uint64_t)data_st.st_size;
+        F->index_rows = (uint64_t)index_st.st_size / sizeof(uint64_t) - 1;
+
+        F->data = (uint8_t*)map_file(F->data_fd, F->data_size, writable);
+        F->index = (uint64_t*)map_file(F->index_fd, (F->index_rows + 1) * sizeof(uint64_t), writable);
+        if (!F->data || !F->index) goto fail;
+
+        mm_header* header = (mm_header*)F->data;
+        if (memcmp(header->magic, MM_MAGIC, sizeof(header->magic)) != 0) goto fail;
+        if (header->end < sizeof(mm_header) || header->end > F->data_size || header->row > F->index_rows) goto fail;
+        if (!valid_records(F)) goto fail;
+
+        return F;
+
+fail:
+        if (F->data) munmap(F->data, F->data_size);
+        if (F->index) munmap(F->index, (F->index_rows + 1) * sizeof(uint64_t));
+        if (F->data_fd >= 0) close(F->data_fd);
+        if (F->index_fd >= 0) close(F->index_fd);
+        free(F);
+        return NULL;
+}
+
+
+/*
+ * Function: mm_rows
+ * ----------------------------
+ * Gets the number of rows of a file-backed matrix.
+ *
+ * @param F - Pointer to the file-backed matrix.
+ *
+ * @return Number of rows.
+ */
+uint32_t mm_rows(mm_matrix* F) {
+        return F ? ((mm_header*)F->data)->row : 0;
+}
+
+
+/*
+ * Function: mm_columns
+ * ----------------------------
+ * Gets the number of columns of a file-backed matrix.
+ *
+ * @param F - Pointer to the file-backed matrix.
+ *
+ * @return Number of columns.
+ */
+uint32_t mm_columns(mm_matrix* F) {
+        return F ? ((mm_header*)F->data)->col : 0;
+}
+
+
+/*
+ * Function: mm_append_row
+ * ----------------------------
+ * Appends the contents of one row to the end of the data file.
+ *
+ * @param F - Pointer to the writable file-backed matrix.
+ * @param row - Row index; rows past the current last row extend the matrix.
+ * @param cols - Column indices (1-based), strictly increasing.
+ * @param values - Non-zero values.
+ * @param nnz - Number of entries.
+ *
+ * @return SM_OK, SM_ERR_NOT_CREATED, SM_ERR_INVALID_ARG (read-only or unsorted columns),
+ *         SM_ERR_OUT_OF_BOUNDS, SM_ERR_ZERO_VALUE or SM_ERR_NO_MEMORY (the files can not grow).
+ */
+sm_status mm_append_row(mm_matrix* F, uint32_t row, const uint32_t* cols, const double* values, uint32_t nnz) {
+        if (!F) return sm_fail(__func__, SM_ERR_NOT_CREATED);
+        if (!F->writable) return sm_fail(__func__, SM_ERR_INVALID_ARG);
+        if (row < 1) return sm_fail(__func__, SM_ERR_OUT_OF_BOUNDS);
+
+        uint32_t columns = ((mm_header*)F->data)->col;
+        for (uint32_t k = 0; k < nnz; k++) {
+                if (cols[k] < 1 || cols[k] > columns) return sm_fail(__func__, SM_ERR_OUT_OF_BOUNDS);
+                if (values[k] == 0) return sm_fail(__func__, SM_ERR_ZERO_VALUE);
+                if (k && cols[k] <= cols[k - 1]) return sm_fail(__func__, SM_ERR_INVALID_ARG);
+        }
+
+        uint64_t offset = ((mm_header*)F->data)->end;
+        uint64_t record = (8 + (uint64_t)nnz * (sizeof(double) + sizeof(uint32_t)) + 7) / 8 * 8;
+
+        if (!grow_data(F, offset + record) || !grow_index(F, row)) return sm_fail(__func__, SM_ERR_NO_MEMORY);
+
+        uint8_t* p = F->data + offset;
+        ((uint32_t*)p)[0] = row;
+        ((uint32_t*)p)[1] = nnz;
+        if (nnz) {
+                memcpy(p + 8, values, (size_t)nnz * sizeof(double));
+                memcpy(p + 8 + (size_t)nnz * sizeof(double), cols, (size_t)nnz * sizeof(uint32_t));
+        }
+
+        // Publish the record only after its contents are in place
+        mm_header* header = (mm_header*)F->data;
+        F->index[row] = offset;
+        header->end = offset + record;
+        if (row > header->row) header->row = row;
+
+        return SM_OK;
+}
+
+
+/*
+ * Function: mm_row
+ * ----------------------------
+ * Gets a row without copying; the pages are read in when first touched.
+ *
+ * @param F - Pointer to the file-backed matrix.
+ * @param row - Row index.
+ * @param cols - Output pointer to the row's column indices.
+ * @param values - Output pointer to the row's values.
+ *
+ * @return Number of non-zeros in the row.
+ */
+uint32_t mm_row(mm_matrix* F, uint32_t row, const uint32_t** cols, const double** values) {
+        if (!F || row < 1 || row > mm_rows(F) || !F->index[row]) return 0;
+
+        uint8_t* p = F->data + F->index[row];
+        uint32_t nnz = ((uint32_t*)p)[1];
+
+        *values = (const double*)(p + 8);
+        *cols = (const uint32_t*)(p + 8 + (size_t)nnz * sizeof(double));
+
+        return nnz;
+}
+
+
+/*
+ * Function: mm_get
+ * ----------------------------
+ * Reads a single element by binary search within its row.
+ *
+ * @param F - Pointer to the file-backed matrix.
+ * @param row - Row index.
+ * @param column - Column index.
+ *
+ * @return The stored value, or 0 if the position is empty.
+ */
+double mm_get(mm_matrix* F, uint32_t row, uint32_t column) {
+        const uint32_t* cols;
+        const double* values;
+        uint32_t nnz = mm_row(F, row, &cols, &values);
+
+        uint32_t lo = 0;
+        uint32_t hi = nnz;
+        while (lo < hi) {
+                uint32_t mid = lo + (hi - lo) / 2;
+                if (cols[mid] < column) {
+                        lo = mid + 1;
+                } else {
+                        hi = mid;
+                }
+        }
+
+        return (lo < nnz && cols[lo] == column) ? values[lo] : 0;
+}
+
+
+/*
+ * Function: mm_prefetch_rows
+ * ----------------------------
+ * Hints the kernel to start reading the records of a range of rows.
+ *
+ * @param F - Pointer to the file-backed matrix.
+ * @param first - First row of the range.
+ * @param last - Last row of the range.
+ */
+void mm_prefetch_rows(mm_matrix* F, uint32_t first, uint32_t last) {
+        if (!F) return;
+        if (first < 1) first = 1;
+        if (last > mm_rows(F)) last = mm_rows(F);
+
+        // Records of consecutive rows are usually adjacent, so one span covers them
+        uint64_t lo = UINT64_MAX;
+        uint64_t hi = 0;
+        for (uint64_t r = first; r <= last; r++) {
+                uint64_t offset = F->index[r];
+                if (!offset) continue;
+
+                uint32_t nnz = ((uint32_t*)(F->data + offset))[1];
+                uint64_t end = offset + 8 + (uint64_t)nnz * (sizeof(double) + sizeof(uint32_t));
+                if (offset < lo) lo = offset;
+                if (end > hi) hi = end;
+        }
+
+        if (lo < hi) {
+                uint64_t start = lo / MM_PAGE * MM_PAGE;
+                madvise(F->data + start, hi - start, MADV_WILLNEED);
+        }
+}
+
+
+/*
+ * Function: mm_scan
+ * ----------------------------
+ * Visits every non-zero in row-major order with sequential readahead enabled.
+ *
+ * @param F - Pointer to the file-backed matrix.
+ * @param visit - Callback receiving each non-zero.
+ * @param ctx - Caller context passed to the callback.
+ */
+void mm_scan(mm_matrix* F, sm_visit_fn visit, void* ctx) {
+        if (!F || !visit) return;
+
+        madvise(F->data, F->data_size, MADV_SEQUENTIAL);
+
+        uint32_t rows = mm_rows(F);
+        for (uint32_t r = 1; r <= rows; r++) {
+                const uint32_t* cols;
+                const double* values;
+                uint32_t nnz = mm_row(F, r, &cols, &values);
+
+                for (uint32_t k = 0; k < nnz; k++) {
+                        visit(r, cols[k], values[k], ctx);
+                }
+        }
+
+        madvise(F->data, F->data_size, MADV_NORMAL);
+}
+
+
+/*
+ * Function: mm_save_S_Matrix
+ * ----------------------------
+ * Writes a linked matrix to a new file-backed matrix, one row at a time.
+ *
+ * @param path - Path of the data file.
+ * @param M - Pointer to the matrix.
+ *
+ * @return true on success, false on I/O or allocation failure.
+ *
+ * Description:
+ *   The file has no symmetric flag, so a symmetric matrix is written with both triangles;
+ *   every reader of the file then sees the full matrix.
+ */
+bool mm_save_S_Matrix(const char* path, matrix* M) {
+        if (!M) return false;
+
+        mm_matrix* F = mm_create(path, M->row, M->col);
+        if (!F) return false;
+
+        uint32_t cap = 64;
+        uint32_t* cols = (uint32_t*)malloc(cap * sizeof(uint32_t));
+        double* values = (double*)malloc(cap * sizeof(double));
+        bool ok = cols && values;
+
+        for (uint32_t r = 1; ok && r <= M->row; r++) {
+                // Row r of a symmetric matrix starts with the mirror of stored column r
+                m_node* mirror = M->symmetric ? header_chain(M->columnList, r) : NULL;
+                m_node* node = header_chain(M->rowList, r);
+                uint32_t nnz = 0;
+
+                while ((mirror && mirror->row < r) || node) {
+                        if (nnz == cap) {
+                                cap *= 2;
+                                uint32_t* new_cols = (uint32_t*)realloc(cols, cap * sizeof(uint32_t));
+                                if (new_cols) cols = new_cols;
+                                double* new_values = (double*)realloc(values, cap * sizeof(double));
+                                if (new_values) values = new_values;
+                                ok = new_cols && new_values;
+                                if (!ok) break;
+                        }
+
+                        if (mirror && mirror->row < r) {
+                                cols[nnz] = mirror->row;
+                                values[nnz] = mirror->value;
+                                mirror = mirror->col_ptr;
+                        } else {
+                                cols[nnz] = node->column;
+                                values[nnz] = node->value;
+                                node = node->row_ptr;
+                        }
+                        nnz++;
+                }
+
+                if (ok && nnz) ok = mm_append_row(F, r, cols, values, nnz) == SM_OK;
+        }
+
+        free(cols);
+        free(values);
+        mm_close(F);
+
+        return ok;
+}
+
+
+/*
+ * Function: S_Matrix_from_mm
+ * ----------------------------
+ * Loads a file-backed matrix into a linked matrix.
+ *
+ * @param F - Pointer to the file-backed matrix.
+ *
+ * @return Pointer to the matrix, or NULL if a record holds invalid columns or allocation fails.
+ */
+matrix* S_Matrix_from_mm(mm_matrix* F) {
+        if (!F) return NULL;
+
+        uint32_t rows = mm_rows(F);
+        uint64_t nnz = 0;
+        for (uint32_t r = 1; r <= rows; r++) {
+                if (F->index[r]) nnz += ((uint32_t*)(F->data + F->index[r]))[1];
+        }
+
+        csr_matrix* A = create_csr_matrix(rows, mm_columns(F), nnz);
+        if (!A) return NULL;
+
+        madvise(F->data, F->data_size, MADV_SEQUENTIAL);
+
+        bool ok = true;
+        uint64_t k = 0;
+        for (uint32_t r = 1; ok && r <= rows; r++) {
+                const uint32_t* cols;
+                const double* values;
+                uint32_t n = mm_row(F, r, &cols, &values);
+
+                // An empty row leaves cols and values unset
+                if (n) {
+                        memcpy(A->col_idx + k, cols, (size_t)n * sizeof(uint32_t));
+                        memcpy(A->values + k, values, (size_t)n * sizeof(double));
+                }
+
+                // The linked matrix trusts its columns, which mm_open does not read
+                for (uint64_t i = k; ok && i < k + n; i++) {
+                        ok = A->col_idx[i] >= 1 && A->col_idx[i] <= A->col && (i == k || A->col_idx[i] > A->col_idx[i - 1]);
+                }
+
+                k += n;
+                A->row_ptr[r] = k;
+        }
+
+        madvise(F->data, F->data_size, MADV_NORMAL);
+
+        if (!ok) {
+                free_csr_matrix(A);
+                return NULL;
+        }
+
+        matrix* M = S_Matrix_from_csr(A);
+        free_csr_matrix(A);
+
+        return M;
+}
+
+
+/*
+ * Function: mm_close
+ * ----------------------------
+ * Flushes and closes a file-backed matrix.
+ *
+ * @param F - Pointer to the file-backed matrix.
+ */
+void mm_close(mm_matrix* F) {
+        if (!F) {
+                return;
+        }
+
+        mm_header* header = (mm_header*)F->data;
+        uint64_t end = header->end;
+        uint64_t rows = header->row;
+
+        if (F->writable) {
+                msync(F->data, F->data_size, MS_SYNC);
+                msync(F->index, (F->index_rows + 1) * sizeof(uint64_t), MS_SYNC);
+        }
+
+        munmap(F->data, F->data_size);
+        munmap(F->index, (F->index_rows + 1) * sizeof(uint64_t));
+
+        // Drop the growth slack; if trimming fails the slack only costs disk space
+        if (F->writable) {
+                int rc = ftruncate(F->data_fd, (off_t)end);
+                rc |= ftruncate(F->index_fd, (off_t)(((rows ? rows : 1) + 1) * sizeof(uint64_t)));
+                (void)rc;
+        }
+
+        close(F->data_fd);
+        close(F->index_fd);
+        free(F);
+}
@@ -0,0 +1,632 @@
+/*
+ * File Name: S_Matrix_numa.c
+ * Authors: Arpit Patel, Dharm KaPatel
+ * Date: 2025-03-19
+ * Description: This file implements the NUMA-partitioned sparse matrix. The node topology is read
+ *              once from sysfs, block memory is mapped per partition and written by a thread
+ *              created on the block's node, and mbind() is called directly through syscall() so
+ *              no NUMA library is needed.
+ */
+
+
+#define _GNU_SOURCE
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdio.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+
+#include "../include/S_Matrix_numa.h"
+#include "../include/S_Matrix_parallel.h"
+
+
+// Memory policy of mbind(2) that restricts allocation to the given nodes
+#define SM_MPOL_BIND 2
+
+#define SM_MASK_WORDS ((SM_NUMA_MAX_NODES + 63) / 64)
+
+
+/*
+ * Struct: numa_topology
+ * ----------------------------
+ * Nodes this process can run on.
+ *
+ * nodes: Number of nodes.
+ * id: Kernel node number of each node.
+ * cpus: CPUs of each node, limited to the process affinity.
+ */
+typedef struct numa_topology {
+        uint32_t nodes;
+        uint32_t id[SM_NUMA_MAX_NODES];
+        cpu_set_t cpus[SM_NUMA_MAX_NODES];
+} numa_topology;
+
+
+static numa_topology topology;
+static pthread_once_t topology_once = PTHREAD_ONCE_INIT;
+
+
+/*
+ * Function: parse_list
+ * ----------------------------
+ * Parses a sysfs list such as "0-3,8,10-11" into a set.
+ *
+ * @param text - The list.
+ * @param set - Output set.
+ */
+static void parse_list(const char* text, cpu_set_t* set) {
+        CPU_ZERO(set);
+
+        while (*text) {
+                char* end;
+                unsigned long first = strtoul(text, &end, 10);
+                if (end == text) break;
+
+                unsigned long last = first;
+                if (*end == '-') {
+                        text = end + 1;
+                        last = strtoul(text, &end, 10);
+                }
+                for (unsigned long i = first; i <= last && i < CPU_SETSIZE; i++) CPU_SET(i, set);
+
+                text = end;
+                if (*text == ',') text++;
+                else break;
+        }
+}
+
+
+static bool read_text(const char* path, char* buffer, size_t size) {
+        FILE* in = fopen(path, "r");
+        if (!in) return false;
+
+        size_t got = fread(buffer, 1, size - 1, in);
+        buffer[got] = '\0';
+        fclose(in);
+
+        return got > 0;
+}
+
+
+static void load_topology(void) {
+        cpu_set_t allowed;
+        if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+                CPU_ZERO(&allowed);
+                for (uint32_t c = 0; c < sm_thread_count(0) && c < CPU_SETSIZE; c++) CPU_SET(c, &allowed);
+        }
+
+        char text[4096];
+        cpu_set_t online;
+        if (read_text("/sys/devices/system/node/online", text, sizeof(text))) {
+                parse_list(text, &online);
+        } else {
+                CPU_ZERO(&online);
+        }
+
+        // Nodes without usable CPUs (memory-only or outside the affinity) are left out
+        topology.nodes = 0;
+        for (uint32_t id = 0; id < SM_NUMA_MAX_NODES; id++) {
+                if (!CPU_ISSET(id, &online)) continue;
+
+                char path[64];
+                snprintf(path, sizeof(path), "/sys/devices/system/node/node%u/cpulist", id);
+                if (!read_text(path, text, sizeof(text))) continue;
+
+                cpu_set_t* cpus = &topology.cpus[topology.nodes];
+                parse_list(text, cpus);
+                CPU_AND(cpus, cpus, &allowed);
+                if (CPU_COUNT(cpus) == 0) continue;
+
+                topology.id[topology.nodes++] = id;
+        }
+
+        if (topology.nodes == 0) {
+                topology.nodes = 1;
+                topology.id[0] = 0;
+                topology.cpus[0] = allowed;
+        }
+}
+
+
+static const numa_topology* get_topology(void) {
+        pthread_once(&topology_once, load_topology);
+        return &topology;
+}
+
+
+/*
+ * Function: numa_node_count
+ * ----------------------------
+ * Gets the number of NUMA nodes this process can use.
+ *
+ * @return Number of nodes, 1 when the system exposes no topology.
+ */
+uint32_t numa_node_count(void) {
+        return get_topology()->nodes;
+}
+
+
+/*
+ * Function: numa_node_cpus
+ * ----------------------------
+ * Gets the number of CPUs of a node that this process may run on.
+ *
+ * @param node - The node.
+ *
+ * @return Number of CPUs, 0 if the node does not exist.
+ */
+uint32_t numa_node_cpus(uint32_t node) {
+        const numa_topology* T = get_topology();
+        return (node < T->nodes) ? (uint32_t)CPU_COUNT(&T->cpus[node]) : 0;
+}
+
+
+/*
+ * Function: numa_pin_thread
+ * ----------------------------
+ * Restricts the calling thread to the CPUs of a node.
+ *
+ * @param node - The node.
+ *
+ * @return true on success, false if the node does not exist or the affinity can not be set.
+ */
+bool numa_pin_thread(uint32_t node) {
+        const numa_topology* T = get_topology();
+        if (node >= T->nodes) return false;
+
+        return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &T->cpus[node]) == 0;
+}
+
+
+/*
+ * Function: start_on_node
+ * ----------------------------
+ * Starts a thread whose affinity is the CPUs of a node from its first instruction.
+ *
+ * @param tid - Output thread id.
+ * @param node - The node.
+ * @param fn - Thread function.
+ * @param arg - Argument of fn.
+ *
+ * @return true if the thread was started.
+ */
+static bool start_on_node(pthread_t* tid, uint32_t node, void* (*fn)(void*), void* arg) {
+        const numa_topology* T = get_topology();
+
+        pthread_attr_t attr;
+        if (pthread_attr_init(&attr) != 0) return false;
+        pthread_attr_setaffinity_np(&attr, sizeof(cpu_set_t), &T->cpus[node]);
+
+        bool started = pthread_create(tid, &attr, fn, arg) == 0;
+        pthread_attr_destroy(&attr);
+
+        return started;
+}
+
+
+static bool bind_region(void* addr, size_t bytes, uint32_t node) {
+#ifdef SYS_mbind
+        unsigned long mask[SM_MASK_WORDS + 1] = { 0 };
+        uint32_t id = get_topology()->id[node];
+        mask[id / (8 * sizeof(unsigned long))] |= 1UL << (id % (8 * sizeof(unsigned long)));
+
+        return syscall(SYS_mbind, addr, bytes, SM_MPOL_BIND, mask, (unsigned long)(8 * sizeof(mask)), 0UL) == 0;
+#else
+        (void)addr;
+        (void)bytes;
+        (void)node;
+        return false;
+#endif
+}
+
+
+/*
+ * Function: split_point
+ * ----------------------------
+ * Finds where the k-th of parts row ranges with about equal non-zeros begins.
+ *
+ * @param row_ptr - Row offsets (rows + 1 entries, starting at 0).
+ * @param rows - Number of rows.
+ * @param k - Range number, 0 .. parts.
+ * @param parts - Number of ranges.
+ *
+ * @return Row index (0-based) in [0, rows]; 0 for k = 0 and rows for k = parts.
+ */
+static uint32_t split_point(const uint64_t* row_ptr, uint32_t rows, uint32_t k, uint32_t parts) {
+        if (k == 0) return 0;
+        if (k >= parts) return rows;
+
+        uint64_t nnz = row_ptr[rows];
+        if (nnz == 0) return (uint32_t)((uint64_t)rows * k / parts);
+
+        uint64_t target = nnz * k / parts;
+        uint32_t lo = 0;
+        uint32_t hi = rows;
+        while (lo < hi) {
+                uint32_t mid = lo + (hi - lo) / 2;
+                if (row_ptr[mid] < target) {
+                        lo = mid + 1;
+                } else {
+                        hi = mid;
+                }
+        }
+
+        return lo;
+}
+
+
+/*
+ * Struct: build_task
+ * ----------------------------
+ * Copy of one row block, run on the block's node.
+ */
+typedef struct build_task {
+        n_partition* P;
+        const csr_matrix* A;
+        sm_numa_placement placement;
+        bool ok;
+} build_task;
+
+
+static void* build_partition(void* arg) {
+        build_task* task = (build_task*)arg;
+        n_partition* P = task->P;
+        const csr_matrix* A = task->A;
+
+        size_t row_bytes = ((size_t)P->rows + 1) * sizeof(uint64_t);
+        size_t col_bytes = (P->nnz * sizeof(uint32_t) + 7) & ~(size_t)7;
+        size_t value_bytes = P->nnz * sizeof(double);
+
+        P->region_bytes = row_bytes + col_bytes + value_bytes;
+        P->region = mmap(NULL, P->region_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (P->region == MAP_FAILED) {
+                P->region = NULL;
+                task->ok = false;
+                return NULL;
+        }
+
+        if (task->placement == SM_NUMA_BIND) P->bound = bind_region(P->region, P->region_bytes, P->home);
+
+        // These writes are the first touch of every page of the block
+        P->row_ptr = (uint64_t*)P->region;
+        P->col_idx = (uint32_t*)((char*)P->region + row_bytes);
+        P->values = (double*)((char*)P->region + row_bytes + col_bytes);
+
+        uint64_t base = A->row_ptr[P->first_row - 1];
+        for (uint32_t i = 0; i <= P->rows; i++) {
+                P->row_ptr[i] = A->row_ptr[P->first_row - 1 + i] - base;
+        }
+        if (P->nnz) {
+                memcpy(P->col_idx, A->col_idx + base, P->nnz * sizeof(uint32_t));
+                memcpy(P->values, A->values + base, P->nnz * sizeof(double));
+        }
+
+        task->ok = true;
+        return NULL;
+}
+
+
+/*
+ * Function: numa_from_csr
+ * ----------------------------
+ * Builds a partitioned matrix from a CSR matrix.
+ *
+ * @param A - Pointer to the CSR matrix.
+ * @param partitions - Number of row blocks, or 0 for one per node.
+ * @param threads - Total threads for the kernels, or 0 for every CPU of each node.
+ * @param placement - How block memory is placed.
+ *
+ * @return Pointer to the partitioned matrix, or NULL on invalid input or allocation failure.
+ */
+n_matrix* numa_from_csr(csr_matrix* A, uint32_t partitions, uint32_t threads, sm_numa_placement placement) {
+        if (!A || !A->row_ptr) return NULL;
+
+        uint32_t nodes = numa_node_count();
+        if (partitions == 0) partitions = nodes;
+
+        n_matrix* N = (n_matrix*)malloc(sizeof(n_matrix));
+        if (!N) return NULL;
+
+        N->row = A->row;
+        N->col = A->col;
+        N->nnz = A->nnz;
+        N->partition_count = partitions;
+        N->partitions = (n_partition*)calloc(partitions, sizeof(n_partition));
+
+        build_task* tasks = (build_task*)malloc(partitions * sizeof(build_task));
+        pthread_t* tids = (pthread_t*)malloc(partitions * sizeof(pthread_t));
+        bool* started = (bool*)calloc(partitions, sizeof(bool));
+        if (!N->partitions || !tasks || !tids || !started) {
+                free(tasks);
+                free(tids);
+                free(started);
+                free_numa_matrix(N);
+                return NULL;
+        }
+
+        for (uint32_t p = 0; p < partitions; p++) {
+                n_partition* P = &N->partitions[p];
+                uint32_t begin = split_point(A->row_ptr, A->row, p, partitions);
+                uint32_t end = split_point(A->row_ptr, A->row, p + 1, partitions);
+
+                P->home = p % nodes;
+                P->node = P->home;
+                P->first_row = begin + 1;
+                P->rows = end - begin;
+                P->nnz = A->row_ptr[end] - A->row_ptr[begin];
+
+                if (threads) {
+                        P->threads = threads / partitions + (p < threads % partitions ? 1 : 0);
+                } else {
+                        uint32_t sharing = partitions / nodes + (P->home < partitions % nodes ? 1 : 0);
+                        P->threads = numa_node_cpus(P->home) / sharing;
+                }
+                if (P->threads < 1) P->threads = 1;
+
+                tasks[p].P = P;
+                tasks[p].A = A;
+                tasks[p].placement = placement;
+                tasks[p].ok = false;
+        }
+
+        for (uint32_t p = 0; p < partitions; p++) {
+                started[p] = start_on_node(&tids[p], N->partitions[p].home, build_partition, &tasks[p]);
+        }
+
+        bool ok = true;
+        for (uint32_t p = 0; p < partitions; p++) {
+                if (started[p]) {
+                        pthread_join(tids[p], NULL);
+                } else {
+                        // Placed wherever the calling thread runs, but still correct
+                        build_partition(&tasks[p]);
+                }
+                if (!tasks[p].ok) ok = false;
+        }
+
+        free(tasks);
+        free(tids);
+        free(started);
+
+        if (!ok) {
+                free_numa_matrix(N);
+                return NULL;
+        }
+
+        return N;
+}
+
+
+/*
+ * Function: numa_from_S_Matrix
+ * ----------------------------
+ * Builds a partitioned matrix from a linked matrix (symmetric storage is expanded).
+ *
+ * @param M - Pointer to the matrix.
+ * @param partitions - Number of row blocks, or 0 for one per node.
+ * @param threads - Total threads for the kernels, or 0 for every CPU of each node.
+ * @param placement - How block memory is placed.
+ *
+ * @return Pointer to the partitioned matrix, or NULL on invalid input or allocation failure.
+ */
+n_matrix* numa_from_S_Matrix(matrix* M, uint32_t partitions, uint32_t threads, sm_numa_placement placement) {
+        csr_matrix* A = csr_from_S_Matrix(M);
+        if (!A) return NULL;
+
+        n_matrix* N = numa_from_csr(A, partitions, threads, placement);
+        free_csr_matrix(A);
+
+        return N;
+}
+
+
+/*
+ * Struct: spmv_task
+ * ----------------------------
+ * One share of one row block in nm_spmv.
+ */
+typedef struct spmv_task {
+        const n_partition* P;
+        uint32_t part;
+        uint32_t parts;
+        const double* x;
+        double* y;
+} spmv_task;
+
+
+static void* spmv_share(void* arg) {
+        spmv_task* task = (spmv_task*)arg;
+        const n_partition* P = task->P;
+
+        uint32_t begin = split_point(P->row_ptr, P->rows, task->part, task->parts);
+        uint32_t end = split_point(P->row_ptr, P->rows, task->part + 1, task->parts);
+        double* y = task->y + (P->first_row - 1);
+
+        for (uint32_t i = begin; i < end; i++) {
+                double sum = 0;
+                for (uint64_t k = P->row_ptr[i]; k < P->row_ptr[i + 1]; k++) {
+                        sum += P->values[k] * task->x[P->col_idx[k] - 1];
+                }
+                y[i] = sum;
+        }
+
+        return NULL;
+}
+
+
+/*
+ * Function: nm_spmv
+ * ----------------------------
+ * Computes y = N x, running each block on threads pinned to its node.
+ *
+ * @param N - Pointer to the partitioned matrix.
+ * @param x - Input vector of N->col entries.
+ * @param y - Output vector of N->row entries.
+ *
+ * @return true on success, false on invalid input.
+ *
+ * Description:
+ *   A block's threads each take a range of its rows with about equal non-zeros. Blocks with
+ *   fewer than SM_PARALLEL_GRAIN non-zeros per thread use fewer threads, and a matrix below
+ *   the grain runs on the calling thread.
+ */
+bool nm_spmv(n_matrix* N, const double* x, double* y) {
+        if (!N || !x || !y) return false;
+
+        uint32_t total = 0;
+        for (uint32_t p = 0; p < N->partition_count; p++) {
+                const n_partition* P = &N->partitions[p];
+                uint64_t useful = P->nnz / SM_PARALLEL_GRAIN;
+                total += (useful < P->threads) ? (useful ? (uint32_t)useful : 1) : P->threads;
+        }
+
+        spmv_task* tasks = NULL;
+        pthread_t* tids = NULL;
+        bool* started = NULL;
+        if (N->nnz >= SM_PARALLEL_GRAIN) {
+                tasks = (spmv_task*)malloc(total * sizeof(spmv_task));
+                tids = (pthread_t*)malloc(total * sizeof(pthread_t));
+                started = (bool*)calloc(total, sizeof(bool));
+        }
+
+        if (!tasks || !tids || !started) {
+                for (uint32_t p = 0; p < N->partition_count; p++) {
+                        spmv_task task = { &N->partitions[p], 0, 1, x, y };
+                        spmv_share(&task);
+                }
+                free(tasks);
+                free(tids);
+                free(started);
+                return true;
+        }
+
+        uint32_t t = 0;
+        for (uint32_t p = 0; p < N->partition_count; p++) {
+                const n_partition* P = &N->partitions[p];
+                uint64_t useful = P->nnz / SM_PARALLEL_GRAIN;
+                uint32_t parts = (useful < P->threads) ? (useful ? (uint32_t)useful : 1) : P->threads;
+
+                for (uint32_t s = 0; s < parts; s++, t++) {
+                        tasks[t] = (spmv_task){ P, s, parts, x, y };
+                        started[t] = start_on_node(&tids[t], P->node, spmv_share, &tasks[t]);
+                }
+        }
+
+        for (t = 0; t < total; t++) {
+                if (started[t]) {
+                        pthread_join(tids[t], NULL);
+                } else {
+                        spmv_share(&tasks[t]);
+                }
+        }
+
+        free(tasks);
+        free(tids);
+        free(started);
+
+        return true;
+}
+
+
+/*
+ * Function: nm_get
+ * ----------------------------
+ * Looks up a single element.
+ *
+ * @param N - Pointer to the partitioned matrix.
+ * @param row - Row index.
+ * @param column - Column index.
+ *
+ * @return The stored value, or 0 if the position is empty or out of bounds.
+ */
+double nm_get(n_matrix* N, uint32_t row, uint32_t column) {
+        if (!N || row < 1 || row > N->row) return 0;
+
+        // Last block starting at or before the row
+        uint32_t lo = 0;
+        uint32_t hi = N->partition_count;
+        while (hi - lo > 1) {
+                uint32_t mid = lo + (hi - lo) / 2;
+                if (N->partitions[mid].first_row <= row) {
+                        lo = mid;
+                } else {
+                        hi = mid;
+                }
+        }
+
+        const n_partition* P = &N->partitions[lo];
+        uint32_t i = row - P->first_row;
+        if (i >= P->rows) return 0;
+
+        uint64_t a = P->row_ptr[i];
+        uint64_t b = P->row_ptr[i + 1];
+        while (a < b) {
+                uint64_t mid = a + (b - a) / 2;
+                if (P->col_idx[mid] < column) {
+                        a = mid + 1;
+                } else {
+                        b = mid;
+                }
+        }
+
+        return (a < P->row_ptr[i + 1] && P->col_idx[a] == column) ? P->values[a] : 0;
+}
+
+
+/*
+ * Function: csr_from_numa
+ * ----------------------------
+ * Gathers a partitioned matrix back into one CSR matrix.
+ *
+ * @param N - Pointer to the partitioned matrix.
+ *
+ * @return Pointer to the CSR matrix, or NULL on invalid input or allocation failure.
+ */
+csr_matrix* csr_from_numa(n_matrix* N) {
+        if (!N) return NULL;
+
+        csr_matrix* A = create_csr_matrix(N->row, N->col, N->nnz);
+        if (!A) return NULL;
+
+        uint64_t base = 0;
+        for (uint32_t p = 0; p < N->partition_count; p++) {
+                const n_partition* P = &N->partitions[p];
+                for (uint32_t i = 0; i < P->rows; i++) {
+                        A->row_ptr[P->first_row + i] = base + P->row_ptr[i + 1];
+                }
+                if (P->nnz) {
+                        memcpy(A->col_idx + base, P->col_idx, P->nnz * sizeof(uint32_t));
+                        memcpy(A->values + base, P->values, P->nnz * sizeof(double));
+                }
+                base += P->nnz;
+        }
+
+        return A;
+}
+
+
+/*
+ * Function: free_numa_matrix
+ * ----------------------------
+ * Frees a partitioned matrix.
+ *
+ * @param N - Pointer to the partitioned matrix.
+ */
+void free_numa_matrix(n_matrix* N) {
+        if (!N) return;
+
+        if (N->partitions) {
+                for (uint32_t p = 0; p < N->partition_count; p++) {
+                        if (N->partitions[p].region) munmap(N->partitions[p].region, N->partitions[p].region_bytes);
+                }
+                free(N->partitions);
+        }
+        free(N);
+}
@@ -0,0 +1,410 @@
+/*
+ * File Name: S_Matrix_optimize.c
+ * Authors: Arpit Patel, Dharm KaPatel
+ * Date: 2025-03-19
+ * Description: This file implements the format auto-tuner of the S_Matrix data structure.
+ *              The candidates are built side by side from one CSR export, timed through the same
+ *              plan entry points the caller will use, and the losers are freed.
+ */
+
+
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+
+#include "../include/S_Matrix_optimize.h"
+#include "../include/S_Matrix_reorder.h"
+#include "../include/S_Matrix_solver.h"
+#include "../include/S_Matrix_spmm.h"
+#include "../include/S_Matrix_parallel.h"
+
+
+// Largest dictionary for which the compressed form is timed as an SpMV candidate
+#define SM_COMPRESS_CANDIDATE_VALUES 256
+
+// Block density from which the compressed form is timed whatever the values: most column gaps are then zero and pack to width 0
+#define SM_COMPRESS_CANDIDATE_DENSITY 0.5
+
+// A row counts as long once its histogram bin is this many bins (a factor of 2 each) above the mean row's bin
+#define SM_SKEW_BINS 4
+
+// Rows are skewed when more than one in SM_SKEW_SHARE of the non-empty rows is long
+#define SM_SKEW_SHARE 1000
+
+
+static double now_seconds(void) {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+
+static uint32_t* inverse_of(const uint32_t* perm, uint32_t n) {
+        uint32_t* inverse = (uint32_t*)malloc((n ? n : 1) * sizeof(uint32_t));
+        if (!inverse) return NULL;
+
+        for (uint32_t i = 0; i < n; i++) {
+                inverse[perm[i] - 1] = i + 1;
+        }
+        return inverse;
+}
+
+
+static uint32_t csr_bandwidth(csr_matrix* A) {
+        uint32_t bandwidth = 0;
+        for (uint32_t i = 0; i < A->row; i++) {
+                for (uint64_t p = A->row_ptr[i]; p < A->row_ptr[i + 1]; p++) {
+                        uint32_t c = A->col_idx[p] - 1;
+                        uint32_t d = (c > i) ? c - i : i - c;
+                        if (d > bandwidth) bandwidth = d;
+                }
+        }
+        return bandwidth;
+}
+
+
+/*
+ * Function: skewed_rows
+ * ----------------------------
+ * Checks the row histogram for a heavy tail of long rows, as in power-law graphs.
+ *
+ * @param S - Pointer to the structure statistics.
+ *
+ * @return true if more than one in SM_SKEW_SHARE of the non-empty rows is at least 2^SM_SKEW_BINS
+ *         times as long as the mean row.
+ */
+static bool skewed_rows(const sm_structure* S) {
+        uint64_t rows = 0;
+        for (uint32_t b = 1; b < SM_ROW_HISTOGRAM_BINS; b++) {
+                rows += S->row_histogram[b];
+        }
+        if (!rows) return false;
+
+        uint64_t long_rows = 0;
+        for (uint32_t b = row_histogram_bin((uint32_t)(S->nnz / rows)) + SM_SKEW_BINS; b < SM_ROW_HISTOGRAM_BINS; b++) {
+                long_rows += S->row_histogram[b];
+        }
+        return long_rows * SM_SKEW_SHARE > rows;
+}
+
+
+/*
+ * Function: build_reordered
+ * ----------------------------
+ * Builds the RCM-permuted CSR form into a candidate plan.
+ *
+ * @param R - Candidate plan receiving csr and the permutations.
+ * @param M - Pointer to the source matrix.
+ * @param A - CSR form of M.
+ *
+ * @return true if the permuted form was built and at least halves the bandwidth.
+ */
+static bool build_reordered(sm_plan* R, matrix* M, csr_matrix* A) {
+        if (!compute_ordering(M, SM_ORDER_RCM, &R->row_perm, &R->col_perm)) return false;
+
+        R->row_inverse = inverse_of(R->row_perm, A->row);
+        R->col_inverse = inverse_of(R->col_perm, A->col);
+        sm_triplet* entries = (sm_triplet*)malloc((A->nnz ? A->nnz : 1) * sizeof(sm_triplet));
+
+        if (R->row_inverse && R->col_inverse && entries) {
+                uint64_t k = 0;
+                for (uint32_t r = 0; r < A->row; r++) {
+                        uint32_t old = R->row_perm[r] - 1;
+                        for (uint64_t p = A->row_ptr[old]; p < A->row_ptr[old + 1]; p++) {
+                                entries[k].row = r + 1;
+                                entries[k].column = R->col_inverse[A->col_idx[p] - 1];
+                                entries[k].value = A->values[p];
+                                k++;
+                        }
+                }
+                R->csr = csr_from_triplets(A->row, A->col, entries, k);
+        }
+        free(entries);
+
+        if (R->csr && 2 * csr_bandwidth(R->csr) <= R->stats.bandwidth) return true;
+
+        free_csr_matrix(R->csr);
+        free(R->row_perm);
+        free(R->col_perm);
+        free(R->row_inverse);
+        free(R->col_inverse);
+        R->csr = NULL;
+        R->row_perm = R->col_perm = R->row_inverse = R->col_inverse = NULL;
+        return false;
+}
+
+
+/*
+ * Function: time_candidate
+ * ----------------------------
+ * Times the workload's product on a candidate plan.
+ *
+ * @param C - The candidate plan.
+ * @param X - Input block of C->stats.col rows of k entries.
+ * @param k - Number of vectors (1 times plan_spmv, more times plan_spmm).
+ * @param Y - Output block of C->stats.row rows of k entries.
+ *
+ * @return Seconds taken by the fastest of SM_CALIBRATE_RUNS runs after one warm-up run,
+ *         or a negative value if a run fails.
+ */
+static double time_candidate(sm_plan* C, const double* X, uint32_t k, double* Y) {
+        double best = -1;
+
+        for (int run = 0; run <= SM_CALIBRATE_RUNS; run++) {
+                double start = now_seconds();
+                bool ok = (k == 1) ? plan_spmv(C, X, Y) : plan_spmm(C, X, k, Y);
+                double elapsed = now_seconds() - start;
+
+                if (!ok) return -1;
+                if (run > 0 && (best < 0 || elapsed < best)) best = elapsed;
+        }
+
+        return best;
+}
+
+
+static void release_layouts(sm_plan* P) {
+        free_csr_matrix(P->csr);
+        free_compressed_matrix(P->compressed);
+        free(P->row_perm);
+        free(P->col_perm);
+        free(P->row_inverse);
+        free(P->col_inverse);
+}
+
+
+/*
+ * Function: matrix_optimize
+ * ----------------------------
+ * Chooses and builds the layout and kernel for a matrix and workload.
+ *
+ * @param M - Pointer to the matrix.
+ * @param hint - The expected workload.
+ *
+ * @return Pointer to the plan, or NULL if M is NULL or allocation fails.
+ */
+sm_plan* matrix_optimize(matrix* M, sm_workload hint) {
+        if (!M) return NULL;
+
+        sm_plan* P = (sm_plan*)calloc(1, sizeof(sm_plan));
+        if (!P) return NULL;
+
+        P->threads = 1;
+        csr_matrix* A = csr_from_S_Matrix(M);
+        if (!A || !analyze_S_Matrix(M, SM_OPTIMIZE_SAMPLE, &P->stats)) {
+                free_csr_matrix(A);
+                free(P);
+                return NULL;
+        }
+
+        if (hint == SM_WORKLOAD_ARCHIVE) {
+                P->format = SM_FORMAT_COMPRESSED;
+                P->compressed = compressed_from_csr(A);
+                free_csr_matrix(A);
+                if (!P->compressed) {
+                        free(P);
+                        return NULL;
+                }
+                return P;
+        }
+
+        P->format = SM_FORMAT_CSR;
+        P->csr = A;
+        if (hint == SM_WORKLOAD_RANDOM_ACCESS || A->nnz < SM_CALIBRATE_MIN_NNZ) return P;
+
+        // Candidates: [0] CSR, [1] reordered CSR, [2] compressed
+        sm_plan candidates[3];
+        bool present[3] = { true, false, false };
+        for (int c = 0; c < 3; c++) {
+                candidates[c] = *P;
+                candidates[c].csr = NULL;
+        }
+        candidates[0].csr = A;
+        candidates[1].format = SM_FORMAT_CSR_REORDERED;
+        candidates[2].format = SM_FORMAT_COMPRESSED;
+
+        // RCM orders the symmetrized pattern, so an unsymmetric matrix needs a wider band to gain
+        // from it; hub rows keep the band wide under any order
+        uint32_t band_limit = P->stats.symmetric ? M->row / 4 : M->row / 2;
+        if (M->row == M->col && P->stats.bandwidth > band_limit && !skewed_rows(&P->stats)) {
+                present[1] = build_reordered(&candidates[1], M, A);
+        }
+        if (hint == SM_WORKLOAD_SPMV && (P->stats.distinct_values <= SM_COMPRESS_CANDIDATE_VALUES ||
+                                         P->stats.block_density >= SM_COMPRESS_CANDIDATE_DENSITY)) {
+                candidates[2].compressed = compressed_from_csr(A);
+                present[2] = candidates[2].compressed != NULL;
+        }
+
+        uint32_t k = (hint == SM_WORKLOAD_SPMM) ? SM_SPMM_LANES : 1;
+        double* X = (double*)malloc((size_t)M->col * k * sizeof(double) + sizeof(double));
+        double* Y = (double*)malloc((size_t)M->row * k * sizeof(double) + sizeof(double));
+
+        uint32_t thread_options[2] = { 1, sm_thread_count(0) };
+        int best = 0;
+        uint32_t best_threads = 1;
+        double best_time = -1;
+
+        if (X && Y) {
+                for (uint64_t i = 0; i < (uint64_t)M->col * k; i++) X[i] = 1.0;
+
+                for (int c = 0; c < 3; c++) {
+                        if (!present[c]) continue;
+                        for (int t = 0; t < 2; t++) {
+                                if (t == 1 && thread_options[1] == 1) break;
+
+                                candidates[c].threads = thread_options[t];
+                                double elapsed = time_candidate(&candidates[c], X, k, Y);
+                                if (elapsed >= 0 && (best_time < 0 || elapsed < best_time)) {
+                                        best_time = elapsed;
+                                        best = c;
+                                        best_threads = thread_options[t];
+                                }
+                        }
+                }
+        }
+        free(X);
+        free(Y);
+
+        // Keep the winner and free every other layout
+        for (int c = 0; c < 3; c++) {
+                if (present[c] && c != best) release_layouts(&candidates[c]);
+        }
+
+        sm_structure stats = P->stats;
+        *P = candidates[best];
+        P->stats = stats;
+        P->threads = best_threads;
+
+        return P;
+}
+
+
+/*
+ * Function: plan_spmv
+ * ----------------------------
+ * Computes y = M x with the plan's kernel.
+ *
+ * @param P - Pointer to the plan.
+ * @param x - Input vector of M->col entries.
+ * @param y - Output vector of M->row entries.
+ *
+ * @return true on success, false on invalid input or allocation failure.
+ */
+bool plan_spmv(sm_plan* P, const double* x, double* y) {
+        if (!P || !x || !y) return false;
+
+        switch (P->format) {
+        case SM_FORMAT_CSR:
+                csr_spmv(P->csr, x, y, P->threads);
+                return true;
+        case SM_FORMAT_COMPRESSED:
+                return zm_spmv(P->compressed, x, y, P->threads);
+        case SM_FORMAT_CSR_REORDERED:
+                break;
+        }
+
+        csr_matrix* A = P->csr;
+        double* xp = (double*)malloc(((size_t)A->col + A->row + 1) * sizeof(double));
+        if (!xp) return false;
+        double* yp = xp + A->col;
+
+        for (uint32_t c = 0; c < A->col; c++) xp[c] = x[P->col_perm[c] - 1];
+        csr_spmv(A, xp, yp, P->threads);
+        for (uint32_t r = 0; r < A->row; r++) y[P->row_perm[r] - 1] = yp[r];
+
+        free(xp);
+        return true;
+}
+
+
+/*
+ * Function: plan_spmm
+ * ----------------------------
+ * Computes Y = M X for a row-major block of k vectors with the plan's kernel.
+ *
+ * @param P - Pointer to the plan.
+ * @param X - Input block, M->col rows of k entries.
+ * @param k - Number of vectors.
+ * @param Y - Output block, M->row rows of k entries; overwritten.
+ *
+ * @return true on success, false on invalid input or allocation failure.
+ */
+bool plan_spmm(sm_plan* P, const double* X, uint32_t k, double* Y) {
+        if (!P || !X || !Y || k == 0) return false;
+
+        if (P->format == SM_FORMAT_CSR) return csr_spmm(P->csr, X, k, Y, P->threads);
+
+        uint32_t rows = P->stats.row;
+        uint32_t cols = P->stats.col;
+        double* xp = (double*)malloc(((size_t)cols + rows + 1) * ((P->format == SM_FORMAT_COMPRESSED) ? 1 : k) * sizeof(double));
+        if (!xp) return false;
+
+        bool ok = true;
+        if (P->format == SM_FORMAT_COMPRESSED) {
+                // No blocked kernel for the compressed form: one SpMV per vector
+                double* yp = xp + cols;
+                for (uint32_t v = 0; v < k && ok; v++) {
+                        for (uint32_t c = 0; c < cols; c++) xp[c] = X[(size_t)c * k + v];
+                        ok = zm_spmv(P->compressed, xp, yp, P->threads);
+                        for (uint32_t r = 0; r < rows; r++) Y[(size_t)r * k + v] = yp[r];
+                }
+        } else {
+                double* yp = xp + (size_t)cols * k;
+                for (uint32_t c = 0; c < cols; c++) {
+                        memcpy(xp + (size_t)c * k, X + (size_t)(P->col_perm[c] - 1) * k, k * sizeof(double));
+                }
+                ok = csr_spmm(P->csr, xp, k, yp, P->threads);
+                for (uint32_t r = 0; ok && r < rows; r++) {
+                        memcpy(Y + (size_t)(P->row_perm[r] - 1) * k, yp + (size_t)r * k, k * sizeof(double));
+                }
+        }
+
+        free(xp);
+        return ok;
+}
+
+
+/*
+ * Function: plan_get
+ * ----------------------------
+ * Reads one element through the plan's layout.
+ *
+ * @param P - Pointer to the plan.
+ * @param row - Row index.
+ * @param column - Column index.
+ *
+ * @return The value, or 0 if the position holds no value or is out of bounds.
+ */
+double plan_get(sm_plan* P, uint32_t row, uint32_t column) {
+        if (!P || row < 1 || row > P->stats.row || column < 1 || column > P->stats.col) return 0;
+
+        switch (P->format) {
+        case SM_FORMAT_CSR:
+                return csr_get(P->csr, row, column);
+        case SM_FORMAT_COMPRESSED:
+                return zm_get(P->compressed, row, column);
+        case SM_FORMAT_CSR_REORDERED:
+                break;
+        }
+
+        return csr_get(P->csr, P->row_inverse[row - 1], P->col_inverse[column - 1]);
+}
+
+
+/*
+ * Function: free_plan
+ * ----------------------------
+ * Frees a plan and the layouts it built.
+ *
+ * @param P - Pointer to the plan.
+ */
+void free_plan(sm_plan* P) {
+        if (!P) return;
+
+        release_layouts(P);
+        free(P);
+}
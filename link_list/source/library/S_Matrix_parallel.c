@@ -0,0 +1,271 @@
+/*
+ * File Name: S_Matrix_parallel.c
+ * Authors: Arpit Patel, Dharm KaPatel
+ * Date: 2025-03-19
+ * Description: This file implements the fork-join helper used by the parallel S_Matrix kernels.
+ *              Worker threads are started on first use and wait for the next range between calls.
+ */
+
+
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <unistd.h>
+
+
+#include "../include/S_Matrix_parallel.h"
+
+
+/*
+ * Struct: sm_chunk
+ * ----------------------------
+ * One chunk of a parallel range, handed to a worker thread.
+ */
+typedef struct sm_chunk {
+        uint64_t begin;
+        uint64_t end;
+        uint32_t thread;
+        sm_range_fn fn;
+        void* ctx;
+} sm_chunk;
+
+
+static void* run_chunk(void* arg) {
+        sm_chunk* chunk = (sm_chunk*)arg;
+        chunk->fn(chunk->begin, chunk->end, chunk->thread, chunk->ctx);
+        return NULL;
+}
+
+
+/*
+ * Struct: sm_pool
+ * ----------------------------
+ * Worker threads kept alive between calls of sm_parallel_for.
+ *
+ * lock: Guards every other field.
+ * start: Signalled when a new range is published.
+ * done: Signalled when the last worker of a range finishes its chunk.
+ * size: Number of workers started; worker w (1-based) runs chunk w.
+ * generation: Incremented for every published range.
+ * pending: Number of workers still running a chunk of the current range.
+ * n, threads, fn, ctx: The current range.
+ */
+typedef struct sm_pool {
+        pthread_mutex_t lock;
+        pthread_cond_t start;
+        pthread_cond_t done;
+        uint32_t size;
+        uint64_t generation;
+        uint32_t pending;
+        uint64_t n;
+        uint32_t threads;
+        sm_range_fn fn;
+        void* ctx;
+} sm_pool;
+
+
+static sm_pool pool = { PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, PTHREAD_COND_INITIALIZER,
+                        0, 0, 0, 0, 0, NULL, NULL };
+
+// Held by the one caller currently using the pool
+static pthread_mutex_t dispatch = PTHREAD_MUTEX_INITIALIZER;
+
+
+/*
+ * Struct: sm_worker_start
+ * ----------------------------
+ * Start arguments of a worker; the worker frees it.
+ *
+ * id: Chunk index of the worker.
+ * generation: Last range published before the worker was started.
+ */
+typedef struct sm_worker_start {
+        uint32_t id;
+        uint64_t generation;
+} sm_worker_start;
+
+
+/*
+ * Function: pool_worker
+ * ----------------------------
+ * Waits for published ranges and runs its own chunk of each range that needs it.
+ *
+ * @param arg - The sm_worker_start of this worker.
+ */
+static void* pool_worker(void* arg) {
+        sm_worker_start* init = (sm_worker_start*)arg;
+        uint32_t id = init->id;
+        uint64_t seen = init->generation;
+        free(init);
+
+        pthread_mutex_lock(&pool.lock);
+        for (;;) {
+                while (pool.generation == seen) pthread_cond_wait(&pool.start, &pool.lock);
+                seen = pool.generation;
+                if (id >= pool.threads) continue;
+
+                sm_chunk chunk = { pool.n * id / pool.threads, pool.n * (id + 1) / pool.threads, id, pool.fn, pool.ctx };
+                pthread_mutex_unlock(&pool.lock);
+
+                run_chunk(&chunk);
+
+                pthread_mutex_lock(&pool.lock);
+                if (--pool.pending == 0) pthread_cond_signal(&pool.done);
+        }
+
+        return NULL;
+}
+
+
+/*
+ * Function: grow_pool
+ * ----------------------------
+ * Starts workers until the pool has the requested number; the caller holds dispatch.
+ *
+ * @param wanted - Number of workers needed.
+ *
+ * @return Number of workers available, which is below wanted if a thread can not be started.
+ */
+static uint32_t grow_pool(uint32_t wanted) {
+        // Workers only read the generation under the lock, and none is published while dispatch is held
+        while (pool.size < wanted) {
+                sm_worker_start* init = (sm_worker_start*)malloc(sizeof(sm_worker_start));
+                if (!init) break;
+                init->id = pool.size + 1;
+                init->generation = pool.generation;
+
+                pthread_t tid;
+                if (pthread_create(&tid, NULL, pool_worker, init) != 0) {
+                        free(init);
+                        break;
+                }
+                pthread_detach(tid);
+                pool.size++;
+        }
+
+        return pool.size;
+}
+
+
+/*
+ * Function: spawn_for
+ * ----------------------------
+ * Runs the chunks of a range on freshly created threads.
+ *
+ * Description:
+ *   Used when the pool is busy with another range, for example for a call made from inside a
+ *   work function or from a second thread at the same time.
+ */
+static void spawn_for(uint64_t n, uint32_t threads, sm_range_fn fn, void* ctx) {
+        sm_chunk* chunks = (sm_chunk*)malloc(threads * sizeof(sm_chunk));
+        pthread_t* tids = (pthread_t*)malloc(threads * sizeof(pthread_t));
+        bool* started = (bool*)calloc(threads, sizeof(bool));
+        if (!chunks || !tids || !started) {
+                free(chunks);
+                free(tids);
+                free(started);
+                for (uint32_t t = 0; t < threads; t++) fn(n * t / threads, n * (t + 1) / threads, t, ctx);
+                return;
+        }
+
+        for (uint32_t t = 0; t < threads; t++) {
+                chunks[t].begin = n * t / threads;
+                chunks[t].end = n * (t + 1) / threads;
+                chunks[t].thread = t;
+                chunks[t].fn = fn;
+                chunks[t].ctx = ctx;
+        }
+
+        for (uint32_t t = 1; t < threads; t++) {
+                started[t] = pthread_create(&tids[t], NULL, run_chunk, &chunks[t]) == 0;
+        }
+
+        run_chunk(&chunks[0]);
+
+        for (uint32_t t = 1; t < threads; t++) {
+                if (started[t]) {
+                        pthread_join(tids[t], NULL);
+                } else {
+                        run_chunk(&chunks[t]);
+                }
+        }
+
+        free(chunks);
+        free(tids);
+        free(started);
+}
+
+
+/*
+ * Function: sm_thread_count
+ * ----------------------------
+ * Resolves a requested thread count.
+ *
+ * @param requested - Requested number of threads, or 0 for one per online CPU.
+ *
+ * @return Number of threads to use, at least 1.
+ */
+uint32_t sm_thread_count(uint32_t requested) {
+        if (requested) return requested;
+
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        return (cpus > 0) ? (uint32_t)cpus : 1;
+}
+
+
+/*
+ * Function: sm_parallel_for
+ * ----------------------------
+ * Runs a work function over [0, n) split into contiguous chunks, one per thread.
+ *
+ * @param n - Number of work items.
+ * @param threads - Number of threads (already resolved with sm_thread_count).
+ * @param fn - Work function.
+ * @param ctx - Caller context passed to fn.
+ *
+ * @return Number of chunks actually used; chunk indices passed to fn are below this value.
+ */
+uint32_t sm_parallel_for(uint64_t n, uint32_t threads, sm_range_fn fn, void* ctx) {
+        if (threads < 1) threads = 1;
+        if (n < (uint64_t)threads * SM_PARALLEL_GRAIN) {
+                threads = (uint32_t)(n / SM_PARALLEL_GRAIN);
+                if (threads < 1) threads = 1;
+        }
+
+        if (threads == 1) {
+                fn(0, n, 0, ctx);
+                return 1;
+        }
+
+        if (pthread_mutex_trylock(&dispatch) != 0) {
+                spawn_for(n, threads, fn, ctx);
+                return threads;
+        }
+
+        uint32_t ready = grow_pool(threads - 1);
+        if (ready > threads - 1) ready = threads - 1;
+
+        pthread_mutex_lock(&pool.lock);
+        pool.n = n;
+        pool.threads = threads;
+        pool.fn = fn;
+        pool.ctx = ctx;
+        pool.pending = ready;
+        pool.generation++;
+        pthread_cond_broadcast(&pool.start);
+        pthread_mutex_unlock(&pool.lock);
+
+        // Chunk 0 and the chunks of workers that could not be started run here
+        fn(0, n / threads, 0, ctx);
+        for (uint32_t t = ready + 1; t < threads; t++) fn(n * t / threads, n * (t + 1) / threads, t, ctx);
+
+        pthread_mutex_lock(&pool.lock);
+        while (pool.pending) pthread_cond_wait(&pool.done, &pool.lock);
+        pthread_mutex_unlock(&pool.lock);
+
+        pthread_mutex_unlock(&dispatch);
+
+        return threads;
+}
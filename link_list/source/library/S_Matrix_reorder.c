@@ -0,0 +1,705 @@
+/*
+ * File Name: S_Matrix_reorder.c
+ * Authors: Arpit Patel, Dharm KaPatel
+ * Date: 2025-03-19
+ * Description: This file implements the bandwidth-reducing reorderings for the S_Matrix data structure.
+ *              The graph algorithms run on a symmetrized adjacency structure built once from the
+ *              row chains, with vertices numbered from 0.
+ */
+
+
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+
+#include "../include/S_Matrix_reorder.h"
+#include "../include/S_Matrix_csr.h"
+
+
+/*
+ * Struct: sm_graph
+ * ----------------------------
+ * Adjacency structure of the symmetrized matrix pattern.
+ *
+ * n: Number of vertices.
+ * ptr: Offsets into adj; the neighbours of v are adj[ptr[v]] .. adj[ptr[v + 1] - 1].
+ * adj: Neighbour lists.
+ */
+typedef struct sm_graph {
+        uint32_t n;
+        uint64_t* ptr;
+        uint32_t* adj;
+} sm_graph;
+
+
+/*
+ * Struct: bfs_state
+ * ----------------------------
+ * Scratch space shared by the breadth-first searches.
+ *
+ * mark: Stamp of the search that last visited each vertex.
+ * stamp: Stamp of the current search.
+ * queue: Visit order of the current search.
+ */
+typedef struct bfs_state {
+        uint32_t* mark;
+        uint32_t stamp;
+        uint32_t* queue;
+} bfs_state;
+
+
+/*
+ * Struct: degree_pair
+ * ----------------------------
+ * Vertex with its degree, used to sort neighbours by degree.
+ */
+typedef struct degree_pair {
+        uint64_t degree;
+        uint32_t vertex;
+} degree_pair;
+
+
+static int compare_degree_pair(const void* a, const void* b) {
+        const degree_pair* x = (const degree_pair*)a;
+        const degree_pair* y = (const degree_pair*)b;
+        if (x->degree != y->degree) return (x->degree < y->degree) ? -1 : 1;
+        return (x->vertex < y->vertex) ? -1 : (x->vertex > y->vertex);
+}
+
+
+static uint64_t degree(sm_graph* g, uint32_t v) {
+        return g->ptr[v + 1] - g->ptr[v];
+}
+
+
+/*
+ * Function: build_graph
+ * ----------------------------
+ * Builds the symmetrized adjacency structure of a matrix, ignoring the diagonal.
+ *
+ * @param M - Pointer to the matrix.
+ * @param g - Output graph.
+ *
+ * @return true on success, false if allocation fails.
+ */
+static bool build_graph(matrix* M, sm_graph* g) {
+        g->n = (M->row > M->col) ? M->row : M->col;
+        g->ptr = (uint64_t*)calloc((size_t)g->n + 1, sizeof(uint64_t));
+        g->adj = NULL;
+        if (!g->ptr) return false;
+
+        uint32_t index = 0;
+        for (l_node* temp; (temp = next_header(M->rowList, &index));) {
+                for (m_node* node = temp->matrix_node; node; node = node->row_ptr) {
+                        if (node->row == node->column) continue;
+                        g->ptr[node->row]++;
+                        g->ptr[node->column]++;
+                }
+        }
+
+        for (uint32_t v = 1; v <= g->n; v++) {
+                g->ptr[v] += g->ptr[v - 1];
+        }
+
+        g->adj = (uint32_t*)malloc((g->ptr[g->n] ? g->ptr[g->n] : 1) * sizeof(uint32_t));
+        uint64_t* fill = (uint64_t*)malloc(((size_t)g->n + 1) * sizeof(uint64_t));
+        if (!g->adj || !fill) {
+                free(fill);
+                free(g->ptr);
+                free(g->adj);
+                return false;
+        }
+        memcpy(fill, g->ptr, ((size_t)g->n + 1) * sizeof(uint64_t));
+
+        index = 0;
+        for (l_node* temp; (temp = next_header(M->rowList, &index));) {
+                for (m_node* node = temp->matrix_node; node; node = node->row_ptr) {
+                        if (node->row == node->column) continue;
+                        uint32_t r = node->row - 1;
+                        uint32_t c = node->column - 1;
+                        g->adj[fill[r]++] = c;
+                        g->adj[fill[c]++] = r;
+                }
+        }
+
+        free(fill);
+        return true;
+}
+
+
+static void free_graph(sm_graph* g) {
+        free(g->ptr);
+        free(g->adj);
+}
+
+
+/*
+ * Function: bfs
+ * ----------------------------
+ * Breadth-first search restricted to the vertices carrying a given label.
+ *
+ * @param g - Pointer to the graph.
+ * @param start - Start vertex.
+ * @param part - Label of each vertex, or NULL for no restriction.
+ * @param label - Label the visited vertices must carry.
+ * @param s - Scratch space; the visit order is left in s->queue.
+ * @param far - Output: vertex of least degree in the last BFS level.
+ * @param depth - Output: number of BFS levels.
+ *
+ * @return Number of visited vertices.
+ */
+static uint32_t bfs(sm_graph* g, uint32_t start, const uint32_t* part, uint32_t label, bfs_state* s, uint32_t* far, uint32_t* depth) {
+        s->stamp++;
+        s->mark[start] = s->stamp;
+        s->queue[0] = start;
+
+        uint32_t head = 0;
+        uint32_t tail = 1;
+        uint32_t level_start = 0;
+        *depth = 0;
+
+        while (head < tail) {
+                uint32_t level_end = tail;
+                level_start = head;
+                (*depth)++;
+
+                for (; head < level_end; head++) {
+                        uint32_t u = s->queue[head];
+                        for (uint64_t k = g->ptr[u]; k < g->ptr[u + 1]; k++) {
+                                uint32_t w = g->adj[k];
+                                if (s->mark[w] == s->stamp || (part && part[w] != label)) continue;
+                                s->mark[w] = s->stamp;
+                                s->queue[tail++] = w;
+                        }
+                }
+        }
+
+        *far = s->queue[level_start];
+        for (uint32_t i = level_start; i < tail; i++) {
+                if (degree(g, s->queue[i]) < degree(g, *far)) *far = s->queue[i];
+        }
+
+        return tail;
+}
+
+
+/*
+ * Function: peripheral_vertex
+ * ----------------------------
+ * Finds a pseudo-peripheral vertex of the component holding a vertex (George-Liu heuristic).
+ *
+ * @param g - Pointer to the graph.
+ * @param start - Any vertex of the component.
+ * @param part - Label of each vertex, or NULL for no restriction.
+ * @param label - Label of the component's vertices.
+ * @param s - Scratch space.
+ *
+ * @return A vertex at (nearly) maximal distance from the rest of the component.
+ */
+static uint32_t peripheral_vertex(sm_graph* g, uint32_t start, const uint32_t* part, uint32_t label, bfs_state* s) {
+        uint32_t far;
+        uint32_t depth;
+        bfs(g, start, part, label, s, &far, &depth);
+
+        // A few rounds are enough in practice; each one can only move further out
+        for (int round = 0; round < 4 && far != start; round++) {
+                uint32_t next_far;
+                uint32_t next_depth;
+                bfs(g, far, part, label, s, &next_far, &next_depth);
+                if (next_depth <= depth) break;
+
+                start = far;
+                far = next_far;
+                depth = next_depth;
+        }
+
+        return far;
+}
+
+
+/*
+ * Function: rcm_order
+ * ----------------------------
+ * Computes the Reverse Cuthill-McKee vertex order.
+ *
+ * @param g - Pointer to the graph.
+ * @param order - Output array of g->n vertices.
+ *
+ * @return true on success, false if allocation fails.
+ */
+static bool rcm_order(sm_graph* g, uint32_t* order) {
+        bfs_state s = { (uint32_t*)calloc(g->n ? g->n : 1, sizeof(uint32_t)), 0, (uint32_t*)malloc((g->n ? g->n : 1) * sizeof(uint32_t)) };
+        bool* placed = (bool*)calloc(g->n ? g->n : 1, sizeof(bool));
+
+        uint64_t max_degree = 0;
+        for (uint32_t v = 0; v < g->n; v++) {
+                if (degree(g, v) > max_degree) max_degree = degree(g, v);
+        }
+        degree_pair* pairs = (degree_pair*)malloc((max_degree ? max_degree : 1) * sizeof(degree_pair));
+
+        if (!s.mark || !s.queue || !placed || !pairs) {
+                free(s.mark);
+                free(s.queue);
+                free(placed);
+                free(pairs);
+                return false;
+        }
+
+        uint32_t count = 0;
+        for (uint32_t v0 = 0; v0 < g->n; v0++) {
+                if (placed[v0]) continue;
+
+                uint32_t start = peripheral_vertex(g, v0, NULL, 0, &s);
+                uint32_t head = count;
+                order[count++] = start;
+                placed[start] = true;
+
+                // Cuthill-McKee: visit neighbours in increasing degree
+                while (head < count) {
+                        uint32_t u = order[head++];
+                        uint32_t n_pairs = 0;
+
+                        for (uint64_t k = g->ptr[u]; k < g->ptr[u + 1]; k++) {
+                                uint32_t w = g->adj[k];
+                                if (placed[w]) continue;
+                                placed[w] = true;
+                                pairs[n_pairs].degree = degree(g, w);
+                                pairs[n_pairs].vertex = w;
+                                n_pairs++;
+                        }
+
+                        qsort(pairs, n_pairs, sizeof(degree_pair), compare_degree_pair);
+                        for (uint32_t i = 0; i < n_pairs; i++) {
+                                order[count++] = pairs[i].vertex;
+                        }
+                }
+        }
+
+        // Reverse
+        for (uint32_t i = 0; i < g->n / 2; i++) {
+                uint32_t temp = order[i];
+                order[i] = order[g->n - 1 - i];
+                order[g->n - 1 - i] = temp;
+        }
+
+        free(s.mark);
+        free(s.queue);
+        free(placed);
+        free(pairs);
+        return true;
+}
+
+
+/*
+ * Function: partition_order
+ * ----------------------------
+ * Computes a vertex order by recursive BFS bisection.
+ *
+ * @param g - Pointer to the graph.
+ * @param order - Output array of g->n vertices.
+ *
+ * @return true on success, false if allocation fails.
+ *
+ * Description:
+ *   Each part is laid out in BFS order from a pseudo-peripheral vertex and split in two
+ *   halves, until parts have at most SM_PARTITION_LEAF vertices. Every part therefore
+ *   occupies a contiguous index range made of vertices that are close in the graph.
+ */
+static bool partition_order(sm_graph* g, uint32_t* order) {
+        size_t n = g->n ? g->n : 1;
+        bfs_state s = { (uint32_t*)calloc(n, sizeof(uint32_t)), 0, (uint32_t*)malloc(n * sizeof(uint32_t)) };
+        uint32_t* part = (uint32_t*)calloc(n, sizeof(uint32_t));
+        uint32_t* layout = (uint32_t*)malloc(n * sizeof(uint32_t));
+        bool* laid = (bool*)calloc(n, sizeof(bool));
+
+        // Parts are ranges [lo, hi) of order; at most one pending range per level of every split
+        uint32_t stack_cap = 128;
+        uint32_t* stack = (uint32_t*)malloc(stack_cap * 3 * sizeof(uint32_t));
+
+        if (!s.mark || !s.queue || !part || !layout || !laid || !stack) {
+                free(s.mark);
+                free(s.queue);
+                free(part);
+                free(layout);
+                free(laid);
+                free(stack);
+                return false;
+        }
+
+        for (uint32_t v = 0; v < g->n; v++) {
+                order[v] = v;
+        }
+
+        uint32_t next_label = 1;
+        uint32_t top = 0;
+        stack[0] = 0;
+        stack[1] = g->n;
+        stack[2] = 0;
+        top = 1;
+
+        bool ok = true;
+        while (top && ok) {
+                top--;
+                uint32_t lo = stack[3 * top];
+                uint32_t hi = stack[3 * top + 1];
+                uint32_t label = stack[3 * top + 2];
+
+                if (hi - lo <= SM_PARTITION_LEAF) continue;
+
+                // BFS order of the part; disconnected pieces follow one another
+                uint32_t count = 0;
+                for (uint32_t i = lo; i < hi; i++) {
+                        uint32_t v = order[i];
+                        if (laid[v]) continue;
+
+                        uint32_t start = peripheral_vertex(g, v, part, label, &s);
+                        uint32_t far;
+                        uint32_t depth;
+                        uint32_t visited = bfs(g, start, part, label, &s, &far, &depth);
+
+                        for (uint32_t k = 0; k < visited; k++) {
+                                if (laid[s.queue[k]]) continue;
+                                laid[s.queue[k]] = true;
+                                layout[count++] = s.queue[k];
+                        }
+                }
+
+                memcpy(order + lo, layout, (size_t)count * sizeof(uint32_t));
+
+                uint32_t mid = lo + (hi - lo) / 2;
+                uint32_t label_a = next_label++;
+                uint32_t label_b = next_label++;
+                for (uint32_t i = lo; i < hi; i++) {
+                        part[order[i]] = (i < mid) ? label_a : label_b;
+                        laid[order[i]] = false;
+                }
+
+                if (top + 2 > stack_cap) {
+                        stack_cap *= 2;
+                        uint32_t* new_stack = (uint32_t*)realloc(stack, stack_cap * 3 * sizeof(uint32_t));
+                        if (!new_stack) {
+                                ok = false;
+                                break;
+                        }
+                        stack = new_stack;
+                }
+
+                stack[3 * top] = mid;
+                stack[3 * top + 1] = hi;
+                stack[3 * top + 2] = label_b;
+                top++;
+                stack[3 * top] = lo;
+                stack[3 * top + 1] = mid;
+                stack[3 * top + 2] = label_a;
+                top++;
+        }
+
+        free(s.mark);
+        free(s.queue);
+        free(part);
+        free(layout);
+        free(laid);
+        free(stack);
+        return ok;
+}
+
+
+/*
+ * Function: degree_perm
+ * ----------------------------
+ * Stable counting sort of indices by their number of non-zeros, fewest first.
+ *
+ * @param counts - Number of non-zeros of each index (0-based).
+ * @param n - Number of indices.
+ * @param perm - Output permutation (new to old, 1-based).
+ *
+ * @return true on success, false if allocation fails.
+ */
+static bool degree_perm(const uint32_t* counts, uint32_t n, uint32_t* perm) {
+        uint32_t max_count = 0;
+        for (uint32_t i = 0; i < n; i++) {
+                if (counts[i] > max_count) max_count = counts[i];
+        }
+
+        uint64_t* bucket = (uint64_t*)calloc((size_t)max_count + 2, sizeof(uint64_t));
+        if (!bucket) return false;
+
+        for (uint32_t i = 0; i < n; i++) {
+                bucket[counts[i] + 1]++;
+        }
+        for (uint32_t c = 1; c <= max_count + 1; c++) {
+                bucket[c] += bucket[c - 1];
+        }
+        for (uint32_t i = 0; i < n; i++) {
+                perm[bucket[counts[i]]++] = i + 1;
+        }
+
+        free(bucket);
+        return true;
+}
+
+
+/*
+ * Function: compute_ordering
+ * ----------------------------
+ * Computes row and column permutations for a matrix.
+ *
+ * @param M - Pointer to the matrix.
+ * @param kind - Reordering to compute.
+ * @param row_perm - Output array of M->row entries (caller frees).
+ * @param col_perm - Output array of M->col entries (caller frees).
+ *
+ * @return true on success, false if M is NULL or allocation fails.
+ */
+bool compute_ordering(matrix* M, sm_ordering kind, uint32_t** row_perm, uint32_t** col_perm) {
+        if (!M || !row_perm || !col_perm) return false;
+
+        uint32_t* rp = (uint32_t*)malloc((M->row ? M->row : 1) * sizeof(uint32_t));
+        uint32_t* cp = (uint32_t*)malloc((M->col ? M->col : 1) * sizeof(uint32_t));
+        if (!rp || !cp) {
+                free(rp);
+                free(cp);
+                return false;
+        }
+
+        bool ok = false;
+        if (kind == SM_ORDER_DEGREE) {
+                uint32_t* row_counts = (uint32_t*)calloc(M->row ? M->row : 1, sizeof(uint32_t));
+                uint32_t* col_counts = (uint32_t*)calloc(M->col ? M->col : 1, sizeof(uint32_t));
+
+                if (row_counts && col_counts) {
+                        uint32_t index = 0;
+                        for (l_node* temp; (temp = next_header(M->rowList, &index));) {
+                                for (m_node* node = temp->matrix_node; node; node = node->row_ptr) {
+                                        row_counts[node->row - 1]++;
+                                        col_counts[node->column - 1]++;
+
+                                        // The mirrored entry (column, row) of a symmetric matrix
+                                        if (M->symmetric && node->row != node->column) {
+                                                row_counts[node->column - 1]++;
+                                                col_counts[node->row - 1]++;
+                                        }
+                                }
+                        }
+                        ok = degree_perm(row_counts, M->row, rp) && degree_perm(col_counts, M->col, cp);
+                }
+
+                free(row_counts);
+                free(col_counts);
+        } else {
+                sm_graph g;
+                if (build_graph(M, &g)) {
+                        uint32_t* order = (uint32_t*)malloc((g.n ? g.n : 1) * sizeof(uint32_t));
+
+                        if (order) {
+                                ok = (kind == SM_ORDER_RCM) ? rcm_order(&g, order) : partition_order(&g, order);
+                        }
+
+                        // Rows and columns follow the same vertex order
+                        if (ok) {
+                                uint32_t r = 0;
+                                uint32_t c = 0;
+                                for (uint32_t i = 0; i < g.n; i++) {
+                                        if (order[i] < M->row) rp[r++] = order[i] + 1;
+                                        if (order[i] < M->col) cp[c++] = order[i] + 1;
+                                }
+                        }
+
+                        free(order);
+                        free_graph(&g);
+                }
+        }
+
+        if (!ok) {
+                free(rp);
+                free(cp);
+                return false;
+        }
+
+        *row_perm = rp;
+        *col_perm = cp;
+        return true;
+}
+
+
+/*
+ * Function: invert_perm
+ * ----------------------------
+ * Inverts a permutation, checking that it is one.
+ *
+ * @param perm - Permutation (new to old, 1-based).
+ * @param n - Number of entries.
+ *
+ * @return Inverse permutation (old to new, 1-based, indexed by old - 1), or NULL if perm is invalid or allocation fails.
+ */
+static uint32_t* invert_perm(const uint32_t* perm, uint32_t n) {
+        uint32_t* inverse = (uint32_t*)calloc(n ? n : 1, sizeof(uint32_t));
+        if (!inverse) return NULL;
+
+        for (uint32_t i = 0; i < n; i++) {
+                if (perm[i] < 1 || perm[i] > n || inverse[perm[i] - 1]) {
+                        free(inverse);
+                        return NULL;
+                }
+                inverse[perm[i] - 1] = i + 1;
+        }
+
+        return inverse;
+}
+
+
+/*
+ * Struct: column_entry
+ * ----------------------------
+ * Non-zero of one row, used to sort a permuted row by its new column index.
+ */
+typedef struct column_entry {
+        uint32_t column;
+        double value;
+} column_entry;
+
+
+static int compare_column_entry(const void* a, const void* b) {
+        uint32_t x = ((const column_entry*)a)->column;
+        uint32_t y = ((const column_entry*)b)->column;
+        return (x > y) - (x < y);
+}
+
+
+/*
+ * Function: permute_S_Matrix
+ * ----------------------------
+ * Builds a permuted copy of a matrix.
+ *
+ * @param M - Pointer to the matrix.
+ * @param row_perm - Row permutation (new to old), M->row entries.
+ * @param col_perm - Column permutation (new to old), M->col entries.
+ *
+ * @return Pointer to the permuted matrix, or NULL if a permutation is invalid or allocation fails.
+ *
+ * Description:
+ *   The copy of a symmetric matrix is a general matrix holding both triangles, since distinct
+ *   row and column permutations do not keep it symmetric.
+ */
+matrix* permute_S_Matrix(matrix* M, const uint32_t* row_perm, const uint32_t* col_perm) {
+        if (!M || !row_perm || !col_perm) return NULL;
+
+        uint32_t* row_check = invert_perm(row_perm, M->row);
+        uint32_t* col_inverse = invert_perm(col_perm, M->col);
+        bool rows_valid = row_check != NULL;
+        free(row_check);
+        if (!rows_valid || !col_inverse) {
+                free(col_inverse);
+                return NULL;
+        }
+
+        // Rows are visited in the new order through the CSR form, which also expands a symmetric matrix
+        csr_matrix* C = csr_from_S_Matrix(M);
+        if (!C) {
+                free(col_inverse);
+                return NULL;
+        }
+
+        uint64_t max_row_nnz = 0;
+        for (uint32_t r = 0; r < C->row; r++) {
+                if (C->row_ptr[r + 1] - C->row_ptr[r] > max_row_nnz) max_row_nnz = C->row_ptr[r + 1] - C->row_ptr[r];
+        }
+
+        csr_matrix* A = create_csr_matrix(M->row, M->col, C->nnz);
+        column_entry* entries = (column_entry*)malloc((max_row_nnz ? max_row_nnz : 1) * sizeof(column_entry));
+        matrix* P = NULL;
+
+        if (A && entries) {
+                uint64_t k = 0;
+                for (uint32_t r = 1; r <= M->row; r++) {
+                        uint32_t old = row_perm[r - 1];
+                        uint32_t n = 0;
+
+                        for (uint64_t p = C->row_ptr[old - 1]; p < C->row_ptr[old]; p++) {
+                                entries[n].column = col_inverse[C->col_idx[p] - 1];
+                                entries[n].value = C->values[p];
+                                n++;
+                        }
+
+                        qsort(entries, n, sizeof(column_entry), compare_column_entry);
+                        for (uint32_t i = 0; i < n; i++) {
+                                A->col_idx[k] = entries[i].column;
+                                A->values[k] = entries[i].value;
+                                k++;
+                        }
+                        A->row_ptr[r] = k;
+                }
+
+                P = S_Matrix_from_csr(A);
+        }
+
+        free_csr_matrix(A);
+        free_csr_matrix(C);
+        free(entries);
+        free(col_inverse);
+
+        return P;
+}
+
+
+/*
+ * Function: reorder_S_Matrix
+ * ----------------------------
+ * Computes an ordering and applies it in one call.
+ *
+ * @param M - Pointer to the matrix.
+ * @param kind - Reordering to compute.
+ * @param row_perm - Output row permutation (caller frees), or NULL if not needed.
+ * @param col_perm - Output column permutation (caller frees), or NULL if not needed.
+ *
+ * @return Pointer to the permuted matrix, or NULL on failure.
+ */
+matrix* reorder_S_Matrix(matrix* M, sm_ordering kind, uint32_t** row_perm, uint32_t** col_perm) {
+        uint32_t* rp;
+        uint32_t* cp;
+        if (!compute_ordering(M, kind, &rp, &cp)) return NULL;
+
+        matrix* P = permute_S_Matrix(M, rp, cp);
+
+        if (P && row_perm) {
+                *row_perm = rp;
+        } else {
+                free(rp);
+        }
+
+        if (P && col_perm) {
+                *col_perm = cp;
+        } else {
+                free(cp);
+        }
+
+        return P;
+}
+
+
+/*
+ * Function: bandwidth_S_Matrix
+ * ----------------------------
+ * Computes the bandwidth of a matrix, the largest |row - column| over all non-zeros.
+ *
+ * @param M - Pointer to the matrix.
+ *
+ * @return The bandwidth, or 0 for an empty matrix.
+ */
+uint32_t bandwidth_S_Matrix(matrix* M) {
+        if (!M || !M->rowList) return 0;
+
+        uint32_t bandwidth = 0;
+        uint32_t index = 0;
+        for (l_node* temp; (temp = next_header(M->rowList, &index));) {
+                for (m_node* node = temp->matrix_node; node; node = node->row_ptr) {
+                        uint32_t d = (node->row > node->column) ? node->row - node->column : node->column - node->row;
+                        if (d > bandwidth) bandwidth = d;
+                }
+        }
+
+        return bandwidth;
+}
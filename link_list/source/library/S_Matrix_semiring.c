@@ -0,0 +1,696 @@
+/*
+ * File Name: S_Matrix_semiring.c
+ * Authors: Arpit Patel, Dharm KaPatel
+ * Date: 2025-03-19
+ * Description: This file implements the semiring kernels and graph algorithms for the S_Matrix data
+ *              structure. The kernels are compiled once per semiring from S_Matrix_semiring_impl.h,
+ *              so the add and multiply operations are inlined into the inner loops.
+ */
+
+
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+
+
+#include "../include/S_Matrix_semiring.h"
+#include "../include/S_Matrix_csr.h"
+
+
+/*
+ * Struct: sm_adjacency
+ * ----------------------------
+ * Direct access to the chains of a matrix, indexed from 0.
+ *
+ * rows: The number of rows in the matrix.
+ * cols: The number of columns in the matrix.
+ * n: Number of vertices, max(rows, cols); both arrays have n entries.
+ * out: First node of each row chain (edges leaving a vertex), from rowList.
+ * in: First node of each column chain (edges entering a vertex), from columnList.
+ *
+ * A symmetric matrix stores each edge once, so its kernels run undirected and follow both
+ * chains. The diagonal is then seen twice, which is harmless as every semiring here has an
+ * idempotent addition.
+ */
+typedef struct sm_adjacency {
+        uint32_t rows;
+        uint32_t cols;
+        uint32_t n;
+        m_node** out;
+        m_node** in;
+} sm_adjacency;
+
+
+#define SR_CONCAT_(a, b) a##_##b
+#define SR_CONCAT(a, b) SR_CONCAT_(a, b)
+#define SR_NAME(name) SR_CONCAT(name, SR_SUFFIX)
+
+#define SR_SUFFIX min_plus
+#define SR_ZERO INFINITY
+#define SR_ADD(a, b) ((b) < (a) ? (b) : (a))
+#define SR_MUL(a, b) ((a) + (b))
+#include "S_Matrix_semiring_impl.h"
+#undef SR_SUFFIX
+#undef SR_ZERO
+#undef SR_ADD
+#undef SR_MUL
+
+#define SR_SUFFIX or_and
+#define SR_ZERO 0.0
+#define SR_ADD(a, b) (((a) != 0 || (b) != 0) ? 1.0 : 0.0)
+#define SR_MUL(a, b) (((a) != 0 && (b) != 0) ? 1.0 : 0.0)
+#define SR_TERMINAL 1.0
+#include "S_Matrix_semiring_impl.h"
+#undef SR_SUFFIX
+#undef SR_ZERO
+#undef SR_ADD
+#undef SR_MUL
+#undef SR_TERMINAL
+
+#define SR_SUFFIX max_times
+#define SR_ZERO 0.0
+#define SR_ADD(a, b) ((b) > (a) ? (b) : (a))
+#define SR_MUL(a, b) ((a) * (b))
+#include "S_Matrix_semiring_impl.h"
+#undef SR_SUFFIX
+#undef SR_ZERO
+#undef SR_ADD
+#undef SR_MUL
+
+
+/*
+ * Function: collect_heads
+ * ----------------------------
+ * Copies the first node of each chain of a header list into an array.
+ *
+ * @param ll - Pointer to the header list.
+ * @param count - Number of chains the matrix has.
+ * @param size - Number of array entries (at least count); the rest are NULL.
+ *
+ * @return Array of chain heads, or NULL if allocation fails.
+ */
+static m_node** collect_heads(link_list* ll, uint32_t count, uint32_t size) {
+        m_node** heads = (m_node**)calloc(size ? size : 1, sizeof(m_node*));
+        if (!heads) return NULL;
+
+        for (uint32_t index = 0; ll && index < count; index++) {
+                heads[index] = header_chain(ll, index + 1);
+        }
+
+        return heads;
+}
+
+
+/*
+ * Function: general_copy
+ * ----------------------------
+ * Copies a symmetric matrix into a general one that stores both triangles.
+ *
+ * @param M - Pointer to the matrix.
+ *
+ * @return Pointer to the copy, or NULL if allocation fails.
+ */
+static matrix* general_copy(matrix* M) {
+        csr_matrix* A = csr_from_S_Matrix(M);
+        if (!A) return NULL;
+
+        matrix* copy = S_Matrix_from_csr(A);
+        free_csr_matrix(A);
+
+        return copy;
+}
+
+
+/*
+ * Function: compare_index
+ * ----------------------------
+ * qsort comparator that orders uint32_t indices ascending.
+ *
+ * @param a - Pointer to the first index.
+ * @param b - Pointer to the second index.
+ *
+ * @return Negative, zero or positive as the first index is below, equal to or above the second.
+ */
+static int compare_index(const void* a, const void* b) {
+        uint32_t x = *(const uint32_t*)a;
+        uint32_t y = *(const uint32_t*)b;
+        return (x > y) - (x < y);
+}
+
+
+/*
+ * Function: build_adjacency
+ * ----------------------------
+ * Collects the row and column chain heads of a matrix into an adjacency. Both arrays get
+ * max(rows, cols) entries so that every vertex can be looked up in either direction.
+ *
+ * @param M - Pointer to the matrix.
+ * @param g - Adjacency to fill in; release it with free_adjacency even on failure.
+ *
+ * @return true on success, false if allocation fails.
+ */
+static bool build_adjacency(matrix* M, sm_adjacency* g) {
+        g->rows = M->row;
+        g->cols = M->col;
+        g->n = (M->row > M->col) ? M->row : M->col;
+        g->out = collect_heads(M->rowList, M->row, g->n);
+        g->in = collect_heads(M->columnList, M->col, g->n);
+
+        return g->out && g->in;
+}
+
+
+/*
+ * Function: free_adjacency
+ * ----------------------------
+ * Frees the head arrays of an adjacency. The nodes belong to the matrix and are not touched.
+ *
+ * @param g - Pointer to the adjacency.
+ */
+static void free_adjacency(sm_adjacency* g) {
+        free(g->out);
+        free(g->in);
+}
+
+
+/*
+ * Function: run_push
+ * ----------------------------
+ * Dispatches one push step to the kernel of the given semiring.
+ *
+ * @param s - The semiring.
+ * @param g - Adjacency of the matrix.
+ * @param undirected - Whether column chains are followed as well as row chains.
+ * @param x - Input vector.
+ * @param frontier - Vertices whose entries of x are pushed.
+ * @param count - Number of entries in frontier.
+ * @param y - Output vector, accumulated into.
+ * @param mask - Outputs that may be written, or NULL for all of them.
+ * @param next - Receives the indices of the outputs that changed.
+ * @param queued - Per-vertex flags that keep an index from being appended to next twice.
+ *
+ * @return Number of indices appended to next.
+ */
+static uint32_t run_push(sm_semiring s, const sm_adjacency* g, bool undirected, const double* x, const uint32_t* frontier, uint32_t count,
+                         double* y, const bool* mask, uint32_t* next, uint8_t* queued) {
+        switch (s) {
+        case SM_SEMIRING_MIN_PLUS: return push_min_plus(g, undirected, x, frontier, count, y, mask, next, queued);
+        case SM_SEMIRING_OR_AND: return push_or_and(g, undirected, x, frontier, count, y, mask, next, queued);
+        case SM_SEMIRING_MAX_TIMES: return push_max_times(g, undirected, x, frontier, count, y, mask, next, queued);
+        }
+        return 0;
+}
+
+
+/*
+ * Function: run_pull
+ * ----------------------------
+ * Dispatches one pull step to the kernel of the given semiring.
+ *
+ * @param s - The semiring.
+ * @param g - Adjacency of the matrix.
+ * @param undirected - Whether row chains are followed as well as column chains.
+ * @param x - Input vector.
+ * @param limit - Number of outputs to gather, starting from vertex 0.
+ * @param y - Output vector, accumulated into.
+ * @param mask - Outputs that may be written, or NULL for all of them.
+ * @param next - Receives the indices of the outputs that changed.
+ * @param queued - Per-vertex flags that keep an index from being appended to next twice.
+ *
+ * @return Number of indices appended to next.
+ */
+static uint32_t run_pull(sm_semiring s, const sm_adjacency* g, bool undirected, const double* x, uint32_t limit,
+                         double* y, const bool* mask, uint32_t* next, uint8_t* queued) {
+        switch (s) {
+        case SM_SEMIRING_MIN_PLUS: return pull_min_plus(g, undirected, x, limit, y, mask, next, queued);
+        case SM_SEMIRING_OR_AND: return pull_or_and(g, undirected, x, limit, y, mask, next, queued);
+        case SM_SEMIRING_MAX_TIMES: return pull_max_times(g, undirected, x, limit, y, mask, next, queued);
+        }
+        return 0;
+}
+
+
+/*
+ * Struct: sm_traversal
+ * ----------------------------
+ * State of a frontier-based traversal.
+ *
+ * g: Adjacency of the matrix.
+ * undirected: Whether edges are followed in both directions.
+ * degree: Number of edges followed out of each vertex.
+ * total: Sum of degree over all vertices.
+ * unexplored: Sum of degree over the vertices not reached yet.
+ * x: Input vector of the current step.
+ * y: Output vector of the current step.
+ * mask: Vertices still to be reached (BFS), or NULL.
+ * frontier: Vertices active in the current step.
+ * next: Vertices changed by the current step.
+ * queued: Whether a vertex is already in next.
+ */
+typedef struct sm_traversal {
+        sm_adjacency g;
+        bool undirected;
+        uint32_t* degree;
+        uint64_t total;
+        uint64_t unexplored;
+        double* x;
+        double* y;
+        bool* mask;
+        uint32_t* frontier;
+        uint32_t* next;
+        uint8_t* queued;
+} sm_traversal;
+
+
+/*
+ * Function: free_traversal
+ * ----------------------------
+ * Frees the adjacency and the scratch arrays of a traversal. Safe after a failed
+ * setup_traversal, since that zeroes the traversal before allocating anything.
+ *
+ * @param t - Pointer to the traversal.
+ */
+static void free_traversal(sm_traversal* t) {
+        free_adjacency(&t->g);
+        free(t->degree);
+        free(t->x);
+        free(t->y);
+        free(t->mask);
+        free(t->frontier);
+        free(t->next);
+        free(t->queued);
+}
+
+
+/*
+ * Function: setup_traversal
+ * ----------------------------
+ * Builds the adjacency, the degrees and the scratch arrays of a traversal.
+ *
+ * @param t - Pointer to the traversal to fill in.
+ * @param M - Pointer to the matrix.
+ * @param undirected - Whether edges are followed in both directions; always so for a symmetric matrix.
+ * @param vectors - Whether the x/y vectors and the mask are needed.
+ *
+ * @return true on success, false if allocation fails.
+ */
+static bool setup_traversal(sm_traversal* t, matrix* M, bool undirected, bool vectors) {
+        memset(t, 0, sizeof(sm_traversal));
+        t->undirected = undirected || M->symmetric;
+        if (!build_adjacency(M, &t->g)) return false;
+
+        uint32_t n = t->g.n;
+        size_t slots = n ? n : 1;
+        t->degree = (uint32_t*)calloc(slots, sizeof(uint32_t));
+        t->frontier = (uint32_t*)malloc(slots * sizeof(uint32_t));
+        t->next = (uint32_t*)malloc(slots * sizeof(uint32_t));
+        t->queued = (uint8_t*)calloc(slots, sizeof(uint8_t));
+        if (!t->degree || !t->frontier || !t->next || !t->queued) return false;
+
+        if (vectors) {
+                t->x = (double*)calloc(slots, sizeof(double));
+                t->y = (double*)calloc(slots, sizeof(double));
+                t->mask = (bool*)malloc(slots * sizeof(bool));
+                if (!t->x || !t->y || !t->mask) return false;
+                for (uint32_t v = 0; v < n; v++) t->mask[v] = true;
+        }
+
+        for (uint32_t v = 0; v < n; v++) {
+                for (m_node* node = t->g.out[v]; node; node = node->row_ptr) t->degree[v]++;
+                if (t->undirected) {
+                        for (m_node* node = t->g.in[v]; node; node = node->col_ptr) t->degree[v]++;
+                }
+                t->total += t->degree[v];
+        }
+        t->unexplored = t->total;
+
+        return true;
+}
+
+
+/*
+ * Function: bfs_from
+ * ----------------------------
+ * Runs one breadth-first search as a sequence of masked (or, and) products.
+ *
+ * @param t - Pointer to the traversal; its mask marks the vertices not reached by any search yet.
+ * @param source - Start vertex (0-based), not reached yet.
+ * @param out - Output array written for every reached vertex.
+ * @param label - Value written to out, or UINT32_MAX to write the hop count instead.
+ *
+ * Description:
+ *   x holds the frontier and y collects the next frontier; both are all zero between
+ *   steps. A step pushes from the frontier while it is small and pulls into the unreached
+ *   vertices once the frontier's edges outweigh the unexplored ones.
+ */
+static void bfs_from(sm_traversal* t, uint32_t source, uint32_t* out, uint32_t label) {
+        uint32_t n = t->g.n;
+        uint32_t depth = 0;
+
+        t->mask[source] = false;
+        t->x[source] = 1;
+        t->frontier[0] = source;
+        t->unexplored -= t->degree[source];
+        out[source] = (label == UINT32_MAX) ? 0 : label;
+
+        uint32_t count = 1;
+        uint64_t frontier_edges = t->degree[source];
+        bool pull = false;
+
+        while (count) {
+                if (!pull && frontier_edges * SM_PULL_ALPHA > t->unexplored) {
+                        pull = true;
+                } else if (pull && (uint64_t)count * SM_PUSH_BETA < n) {
+                        pull = false;
+                }
+
+                uint32_t next_count = pull
+                        ? run_pull(SM_SEMIRING_OR_AND, &t->g, t->undirected, t->x, n, t->y, t->mask, t->next, t->queued)
+                        : run_push(SM_SEMIRING_OR_AND, &t->g, t->undirected, t->x, t->frontier, count, t->y, t->mask, t->next, t->queued);
+                depth++;
+
+                for (uint32_t f = 0; f < count; f++) {
+                        t->x[t->frontier[f]] = 0;
+                }
+
+                frontier_edges = 0;
+                for (uint32_t f = 0; f < next_count; f++) {
+                        uint32_t v = t->next[f];
+                        out[v] = (label == UINT32_MAX) ? depth : label;
+                        t->mask[v] = false;
+                        t->x[v] = 1;
+                        t->y[v] = 0;
+                        t->queued[v] = 0;
+                        frontier_edges += t->degree[v];
+                        t->unexplored -= t->degree[v];
+                }
+
+                uint32_t* swap = t->frontier;
+                t->frontier = t->next;
+                t->next = swap;
+                count = next_count;
+        }
+}
+
+
+/*
+ * Function: semiring_zero
+ * ----------------------------
+ * Gets the additive identity of a semiring.
+ *
+ * @param s - The semiring.
+ *
+ * @return The semiring's zero.
+ */
+double semiring_zero(sm_semiring s) {
+        return (s == SM_SEMIRING_MIN_PLUS) ? INFINITY : 0.0;
+}
+
+
+/*
+ * Function: semiring_mxv
+ * ----------------------------
+ * Matrix-vector product y = y (+) M (x) x over a semiring, walking the row chains.
+ *
+ * @param M - Pointer to the matrix.
+ * @param s - The semiring.
+ * @param x - Input vector of M->col entries.
+ * @param y - Accumulator of M->row entries.
+ * @param mask - Rows to compute (true), or NULL for all.
+ *
+ * @return true on success, false on invalid input or allocation failure.
+ */
+bool semiring_mxv(matrix* M, sm_semiring s, const double* x, double* y, const bool* mask) {
+        if (!M || !x || !y) return false;
+
+        sm_adjacency g;
+        if (!build_adjacency(M, &g)) {
+                free_adjacency(&g);
+                return false;
+        }
+
+        switch (s) {
+        case SM_SEMIRING_MIN_PLUS: mxv_min_plus(&g, M->symmetric, x, y, mask); break;
+        case SM_SEMIRING_OR_AND: mxv_or_and(&g, M->symmetric, x, y, mask); break;
+        case SM_SEMIRING_MAX_TIMES: mxv_max_times(&g, M->symmetric, x, y, mask); break;
+        }
+
+        free_adjacency(&g);
+        return true;
+}
+
+
+/*
+ * Function: semiring_vxm
+ * ----------------------------
+ * Vector-matrix product y = y (+) x (x) M over a semiring.
+ *
+ * @param M - Pointer to the matrix.
+ * @param s - The semiring.
+ * @param x - Input vector of M->row entries.
+ * @param y - Accumulator of M->col entries.
+ * @param mask - Columns to compute (true), or NULL for all.
+ * @param dir - Traversal direction.
+ *
+ * @return true on success, false on invalid input or allocation failure.
+ */
+bool semiring_vxm(matrix* M, sm_semiring s, const double* x, double* y, const bool* mask, sm_direction dir) {
+        if (!M || !x || !y) return false;
+
+        sm_traversal t;
+        if (!setup_traversal(&t, M, false, false)) {
+                free_traversal(&t);
+                return false;
+        }
+
+        double zero = semiring_zero(s);
+        uint32_t count = 0;
+        uint64_t frontier_edges = 0;
+        for (uint32_t i = 0; i < M->row; i++) {
+                if (x[i] != zero) {
+                        t.frontier[count++] = i;
+                        frontier_edges += t.degree[i];
+                }
+        }
+
+        if (dir == SM_AUTO) {
+                dir = (frontier_edges * SM_PULL_ALPHA > t.total) ? SM_PULL : SM_PUSH;
+        }
+
+        if (dir == SM_PULL) {
+                run_pull(s, &t.g, t.undirected, x, M->col, y, mask, t.next, t.queued);
+        } else {
+                run_push(s, &t.g, t.undirected, x, t.frontier, count, y, mask, t.next, t.queued);
+        }
+
+        free_traversal(&t);
+        return true;
+}
+
+
+/*
+ * Function: semiring_spgemm
+ * ----------------------------
+ * Matrix-matrix product A (+).(x) B over a semiring.
+ *
+ * @param A - Pointer to the left matrix.
+ * @param B - Pointer to the right matrix; B->row must equal A->col.
+ * @param s - The semiring.
+ *
+ * @return Pointer to the product, or NULL on a dimension mismatch or allocation failure.
+ */
+matrix* semiring_spgemm(matrix* A, matrix* B, sm_semiring s) {
+        if (!A || !B || A->col != B->row) return NULL;
+
+        // The row chains of a symmetric operand miss its lower triangle, so use a general copy
+        matrix* full_a = A->symmetric ? general_copy(A) : A;
+        matrix* full_b = B->symmetric ? general_copy(B) : B;
+
+        m_node** a_rows = full_a ? collect_heads(full_a->rowList, A->row, A->row) : NULL;
+        m_node** b_rows = full_b ? collect_heads(full_b->rowList, B->row, B->row) : NULL;
+        double* acc = (double*)malloc((B->col ? B->col : 1) * sizeof(double));
+        uint8_t* seen = (uint8_t*)calloc(B->col ? B->col : 1, sizeof(uint8_t));
+        uint32_t* touched = (uint32_t*)malloc((B->col ? B->col : 1) * sizeof(uint32_t));
+
+        csr_matrix* C = create_csr_matrix(A->row, B->col, 0);
+        uint64_t capacity = 1;
+        matrix* result = NULL;
+
+        if (!a_rows || !b_rows || !acc || !seen || !touched || !C) goto done;
+
+        C->nnz = 0;
+        for (uint32_t i = 0; i < A->row; i++) {
+                uint32_t count = 0;
+                switch (s) {
+                case SM_SEMIRING_MIN_PLUS: count = spgemm_row_min_plus(a_rows[i], b_rows, B->row, acc, seen, touched); break;
+                case SM_SEMIRING_OR_AND: count = spgemm_row_or_and(a_rows[i], b_rows, B->row, acc, seen, touched); break;
+                case SM_SEMIRING_MAX_TIMES: count = spgemm_row_max_times(a_rows[i], b_rows, B->row, acc, seen, touched); break;
+                }
+
+                if (C->nnz + count > capacity) {
+                        while (C->nnz + count > capacity) capacity *= 2;
+
+                        uint32_t* col_idx = (uint32_t*)realloc(C->col_idx, capacity * sizeof(uint32_t));
+                        if (col_idx) C->col_idx = col_idx;
+                        double* values = (double*)realloc(C->values, capacity * sizeof(double));
+                        if (values) C->values = values;
+                        if (!col_idx || !values) goto done;
+                }
+
+                // Emit the row in column order
+                qsort(touched, count, sizeof(uint32_t), compare_index);
+                for (uint32_t k = 0; k < count; k++) {
+                        uint32_t j = touched[k];
+                        seen[j] = 0;
+                        if (acc[j] == 0) continue;
+
+                        C->col_idx[C->nnz] = j + 1;
+                        C->values[C->nnz] = acc[j];
+                        C->nnz++;
+                }
+                C->row_ptr[i + 1] = C->nnz;
+        }
+
+        result = S_Matrix_from_csr(C);
+
+done:
+        if (full_a != A) free_S_Matrix(full_a);
+        if (full_b != B) free_S_Matrix(full_b);
+        free(a_rows);
+        free(b_rows);
+        free(acc);
+        free(seen);
+        free(touched);
+        if (C) free_csr_matrix(C);
+
+        return result;
+}
+
+
+/*
+ * Function: bfs_S_Matrix
+ * ----------------------------
+ * Breadth-first search from a vertex with direction-optimizing (or, and) steps.
+ *
+ * @param M - Pointer to the matrix.
+ * @param source - Start vertex (1-based).
+ * @param level - Output array of max(rows, columns) entries.
+ *
+ * @return true on success, false on invalid input or allocation failure.
+ */
+bool bfs_S_Matrix(matrix* M, uint32_t source, uint32_t* level) {
+        if (!M || !level || source == 0) return false;
+
+        sm_traversal t;
+        if (!setup_traversal(&t, M, false, true) || source > t.g.n) {
+                free_traversal(&t);
+                return false;
+        }
+
+        for (uint32_t v = 0; v < t.g.n; v++) {
+                level[v] = UINT32_MAX;
+        }
+        bfs_from(&t, source - 1, level, UINT32_MAX);
+
+        free_traversal(&t);
+        return true;
+}
+
+
+/*
+ * Function: sssp_S_Matrix
+ * ----------------------------
+ * Single-source shortest paths by (min, +) relaxation (Bellman-Ford).
+ *
+ * @param M - Pointer to the matrix.
+ * @param source - Start vertex (1-based).
+ * @param dist - Output array of max(rows, columns) entries.
+ *
+ * @return true on success, false on invalid input, allocation failure or a negative cycle.
+ *
+ * Description:
+ *   dist is both the input and the output of every product, so an improvement found early
+ *   in a round is already used later in the same round.
+ */
+bool sssp_S_Matrix(matrix* M, uint32_t source, double* dist) {
+        if (!M || !dist || source == 0) return false;
+
+        sm_traversal t;
+        if (!setup_traversal(&t, M, false, false) || source > t.g.n) {
+                free_traversal(&t);
+                return false;
+        }
+
+        uint32_t n = t.g.n;
+        for (uint32_t v = 0; v < n; v++) {
+                dist[v] = INFINITY;
+        }
+        dist[source - 1] = 0;
+        t.frontier[0] = source - 1;
+
+        uint32_t count = 1;
+        uint32_t rounds = 0;
+        while (count && rounds < n) {
+                uint64_t frontier_edges = 0;
+                for (uint32_t f = 0; f < count; f++) {
+                        frontier_edges += t.degree[t.frontier[f]];
+                }
+
+                uint32_t next_count = (frontier_edges * SM_PULL_ALPHA > t.total)
+                        ? run_pull(SM_SEMIRING_MIN_PLUS, &t.g, t.undirected, dist, n, dist, NULL, t.next, t.queued)
+                        : run_push(SM_SEMIRING_MIN_PLUS, &t.g, t.undirected, dist, t.frontier, count, dist, NULL, t.next, t.queued);
+
+                for (uint32_t f = 0; f < next_count; f++) {
+                        t.queued[t.next[f]] = 0;
+                }
+
+                uint32_t* swap = t.frontier;
+                t.frontier = t.next;
+                t.next = swap;
+                count = next_count;
+                rounds++;
+        }
+
+        // Still improving after n rounds means a negative cycle
+        free_traversal(&t);
+        return count == 0;
+}
+
+
+/*
+ * Function: components_S_Matrix
+ * ----------------------------
+ * Labels the weakly connected components, following edges in both directions.
+ *
+ * @param M - Pointer to the matrix.
+ * @param component - Output array of max(rows, columns) entries.
+ *
+ * @return Number of components, or 0 on invalid input or allocation failure.
+ *
+ * Description:
+ *   Vertices are scanned in increasing order and each one not yet reached seeds a
+ *   breadth-first search over the edges in both directions. The mask and the unexplored
+ *   edge count carry over between searches, so the total cost stays O(n + nnz).
+ */
+uint32_t components_S_Matrix(matrix* M, uint32_t* component) {
+        if (!M || !component) return 0;
+
+        sm_traversal t;
+        if (!setup_traversal(&t, M, true, true)) {
+                free_traversal(&t);
+                return 0;
+        }
+
+        uint32_t count = 0;
+        for (uint32_t v = 0; v < t.g.n; v++) {
+                if (!t.mask[v]) continue;
+                bfs_from(&t, v, component, v + 1);
+                count++;
+        }
+
+        free_traversal(&t);
+        return count;
+}
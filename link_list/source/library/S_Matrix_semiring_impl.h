@@ -0,0 +1,180 @@
+/*
+ * File Name: S_Matrix_semiring_impl.h
+ * Authors: Arpit Patel, Dharm KaPatel
+ * Date: 2025-03-19
+ * Description: Kernel template for one semiring.
+ *              Do not include directly; S_Matrix_semiring.c includes it once per semiring with
+ *              SR_SUFFIX, SR_ZERO, SR_ADD(a, b) and SR_MUL(a, b) defined. SR_TERMINAL may be
+ *              defined to a value that SR_ADD can never move away from, letting gathers stop early.
+ */
+
+
+#if !defined(SR_SUFFIX) || !defined(SR_ZERO) || !defined(SR_ADD) || !defined(SR_MUL)
+#error "S_Matrix_semiring_impl.h needs SR_SUFFIX, SR_ZERO, SR_ADD and SR_MUL"
+#endif
+
+
+/*
+ * Function: mxv_<suffix>
+ * ----------------------------
+ * y = y (+) A (x) x for the unmasked rows, reading the row chains (and the column chains
+ * when undirected).
+ */
+static void SR_NAME(mxv)(const sm_adjacency* g, bool undirected, const double* x, double* y, const bool* mask) {
+        for (uint32_t i = 0; i < g->rows; i++) {
+                if (mask && !mask[i]) continue;
+
+                double acc = y[i];
+                for (m_node* node = g->out[i]; node; node = node->row_ptr) {
+                        acc = SR_ADD(acc, SR_MUL(node->value, x[node->column - 1]));
+#ifdef SR_TERMINAL
+                        if (acc == SR_TERMINAL) goto gathered;
+#endif
+                }
+
+                if (undirected) {
+                        for (m_node* node = g->in[i]; node; node = node->col_ptr) {
+                                acc = SR_ADD(acc, SR_MUL(node->value, x[node->row - 1]));
+#ifdef SR_TERMINAL
+                                if (acc == SR_TERMINAL) goto gathered;
+#endif
+                        }
+                }
+
+#ifdef SR_TERMINAL
+gathered:
+#endif
+                y[i] = acc;
+        }
+}
+
+
+/*
+ * Function: push_<suffix>
+ * ----------------------------
+ * y = y (+) x (x) A restricted to the frontier rows, scattering along their row chains
+ * (and their column chains when undirected).
+ *
+ * @return Number of outputs that changed; their indices are appended to next.
+ */
+static uint32_t SR_NAME(push)(const sm_adjacency* g, bool undirected, const double* x, const uint32_t* frontier, uint32_t count,
+                              double* y, const bool* mask, uint32_t* next, uint8_t* queued) {
+        uint32_t next_count = 0;
+
+        for (uint32_t f = 0; f < count; f++) {
+                uint32_t u = frontier[f];
+                double xu = x[u];
+
+                for (m_node* node = g->out[u]; node; node = node->row_ptr) {
+                        uint32_t v = node->column - 1;
+                        if (mask && !mask[v]) continue;
+
+                        double updated = SR_ADD(y[v], SR_MUL(xu, node->value));
+                        if (updated != y[v]) {
+                                y[v] = updated;
+                                if (!queued[v]) {
+                                        queued[v] = 1;
+                                        next[next_count++] = v;
+                                }
+                        }
+                }
+
+                if (!undirected) continue;
+
+                for (m_node* node = g->in[u]; node; node = node->col_ptr) {
+                        uint32_t v = node->row - 1;
+                        if (mask && !mask[v]) continue;
+
+                        double updated = SR_ADD(y[v], SR_MUL(xu, node->value));
+                        if (updated != y[v]) {
+                                y[v] = updated;
+                                if (!queued[v]) {
+                                        queued[v] = 1;
+                                        next[next_count++] = v;
+                                }
+                        }
+                }
+        }
+
+        return next_count;
+}
+
+
+/*
+ * Function: pull_<suffix>
+ * ----------------------------
+ * y = y (+) x (x) A for the unmasked outputs below limit, gathering along their column
+ * chains (and their row chains when undirected).
+ *
+ * @return Number of outputs that changed; their indices are appended to next.
+ */
+static uint32_t SR_NAME(pull)(const sm_adjacency* g, bool undirected, const double* x, uint32_t limit,
+                              double* y, const bool* mask, uint32_t* next, uint8_t* queued) {
+        uint32_t next_count = 0;
+
+        for (uint32_t v = 0; v < limit; v++) {
+                if (mask && !mask[v]) continue;
+
+                double acc = y[v];
+                for (m_node* node = g->in[v]; node; node = node->col_ptr) {
+                        acc = SR_ADD(acc, SR_MUL(x[node->row - 1], node->value));
+#ifdef SR_TERMINAL
+                        if (acc == SR_TERMINAL) goto gathered;
+#endif
+                }
+
+                if (undirected) {
+                        for (m_node* node = g->out[v]; node; node = node->row_ptr) {
+                                acc = SR_ADD(acc, SR_MUL(x[node->column - 1], node->value));
+#ifdef SR_TERMINAL
+                                if (acc == SR_TERMINAL) goto gathered;
+#endif
+                        }
+                }
+
+#ifdef SR_TERMINAL
+gathered:
+#endif
+                if (acc != y[v]) {
+                        y[v] = acc;
+                        if (!queued[v]) {
+                                queued[v] = 1;
+                                next[next_count++] = v;
+                        }
+                }
+        }
+
+        return next_count;
+}
+
+
+/*
+ * Function: spgemm_row_<suffix>
+ * ----------------------------
+ * One row of A (+).(x) B with a dense accumulator (Gustavson's method).
+ *
+ * @return Number of output columns touched; their indices are in touched, values in acc.
+ */
+static uint32_t SR_NAME(spgemm_row)(m_node* a_row, m_node* const* b_rows, uint32_t b_rows_count,
+                                    double* acc, uint8_t* seen, uint32_t* touched) {
+        uint32_t count = 0;
+
+        for (m_node* a = a_row; a; a = a->row_ptr) {
+                if (a->column > b_rows_count) continue;
+
+                for (m_node* b = b_rows[a->column - 1]; b; b = b->row_ptr) {
+                        uint32_t j = b->column - 1;
+                        double product = SR_MUL(a->value, b->value);
+
+                        if (!seen[j]) {
+                                seen[j] = 1;
+                                acc[j] = SR_ADD(SR_ZERO, product);
+                                touched[count++] = j;
+                        } else {
+                                acc[j] = SR_ADD(acc[j], product);
+                        }
+                }
+        }
+
+        return count;
+}
@@ -0,0 +1,28 @@
+/*
+ * File Name: S_Matrix_simd.h
+ * Authors: Arpit Patel, Dharm KaPatel
+ * Date: 2025-03-19
+ * Description: GCC vector types shared by the SIMD kernels of the S_Matrix library.
+ *              Vectors are only passed through macros, never through function calls,
+ *              so the code does not depend on the vector calling convention.
+ */
+
+
+#ifndef S_MATRIX_SIMD_H
+#define S_MATRIX_SIMD_H
+
+
+#include <stdint.h>
+
+
+// Elements per SIMD vector
+#define SM_LANES 8
+
+
+// Values, compare masks and 64-bit words; aligned to one element, so loads need no aligned address
+typedef double sm_lanes __attribute__((vector_size(SM_LANES * sizeof(double)), aligned(sizeof(double))));
+typedef int64_t sm_mask __attribute__((vector_size(SM_LANES * sizeof(int64_t)), aligned(sizeof(int64_t))));
+typedef uint64_t sm_words __attribute__((vector_size(SM_LANES * sizeof(uint64_t)), aligned(sizeof(uint64_t))));
+
+
+#endif // S_MATRIX_SIMD_H
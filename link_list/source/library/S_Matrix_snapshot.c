@@ -0,0 +1,832 @@
+/*
+ * File Name: S_Matrix_snapshot.c
+ * Authors: Arpit Patel, Dharm KaPatel
+ * Date: 2025-03-19
+ * Description: This file implements the versioned sparse matrix with copy-on-write snapshots.
+ *              A version is a radix tree of directory nodes over row blocks. A write copies the
+ *              blocks it touches and the nodes on their paths, and shares everything else with
+ *              the previous version through reference counts.
+ */
+
+
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+
+#include "../include/S_Matrix_snapshot.h"
+
+
+
+
+/*
+ * Function: create_row_block
+ * ----------------------------
+ * Allocates a row block and its arrays in a single allocation.
+ *
+ * @param nnz - Number of non-zeros the block holds.
+ *
+ * @return Pointer to the block with one reference, or NULL if allocation fails.
+ */
+static sm_row_block* create_row_block(uint32_t nnz) {
+        sm_row_block* block = (sm_row_block*)malloc(sizeof(sm_row_block) + (size_t)nnz * (sizeof(double) + sizeof(uint32_t)));
+        if (!block) return NULL;
+
+        atomic_init(&block->refs, 1);
+        block->nnz = nnz;
+        memset(block->row_ptr, 0, sizeof(block->row_ptr));
+        block->values = (double*)(block + 1);
+        block->col_idx = (uint32_t*)(block->values + nnz);
+
+        return block;
+}
+
+
+static void release_row_block(sm_row_block* block) {
+        if (block && atomic_fetch_sub(&block->refs, 1) == 1) {
+                free(block);
+        }
+}
+
+
+/*
+ * Function: copy_block_dir
+ * ----------------------------
+ * Creates a directory node sharing the children of another.
+ *
+ * @param src - Node to copy, or NULL for an empty node.
+ * @param level - Level of the node; level 1 holds row blocks.
+ *
+ * @return Pointer to the node with one reference, or NULL if allocation fails.
+ */
+static sm_block_dir* copy_block_dir(sm_block_dir* src, uint32_t level) {
+        sm_block_dir* dir = (sm_block_dir*)calloc(1, sizeof(sm_block_dir));
+        if (!dir) return NULL;
+
+        atomic_init(&dir->refs, 1);
+        for (uint32_t slot = 0; src && slot < SM_DIR_FANOUT; slot++) {
+                if (level > 1) {
+                        dir->dirs[slot] = src->dirs[slot];
+                        if (dir->dirs[slot]) atomic_fetch_add(&dir->dirs[slot]->refs, 1);
+                } else {
+                        dir->blocks[slot] = src->blocks[slot];
+                        if (dir->blocks[slot]) atomic_fetch_add(&dir->blocks[slot]->refs, 1);
+                }
+        }
+
+        return dir;
+}
+
+
+/*
+ * Function: release_block_dir
+ * ----------------------------
+ * Drops a reference to a directory node; the last release drops its children in turn.
+ *
+ * @param dir - The node, or NULL.
+ * @param level - Level of the node; level 1 holds row blocks.
+ */
+static void release_block_dir(sm_block_dir* dir, uint32_t level) {
+        if (!dir || atomic_fetch_sub(&dir->refs, 1) != 1) return;
+
+        for (uint32_t slot = 0; slot < SM_DIR_FANOUT; slot++) {
+                if (level > 1) {
+                        release_block_dir(dir->dirs[slot], level - 1);
+                } else {
+                        release_row_block(dir->blocks[slot]);
+                }
+        }
+        free(dir);
+}
+
+
+/*
+ * Function: tree_depth
+ * ----------------------------
+ * Gets the levels of directory nodes needed to cover a number of rows.
+ *
+ * @param rows - Number of rows.
+ *
+ * @return The depth, at least 1.
+ */
+static uint32_t tree_depth(uint32_t rows) {
+        uint32_t depth = 1;
+        for (uint64_t span = (uint64_t)SM_BLOCK_ROWS * SM_DIR_FANOUT; span < rows; span *= SM_DIR_FANOUT) {
+                depth++;
+        }
+        return depth;
+}
+
+
+/*
+ * Function: child_index
+ * ----------------------------
+ * Gets the child of a directory node on the path to a row block.
+ *
+ * @param b - Index of the row block (0-based).
+ * @param level - Level of the node.
+ *
+ * @return Index into the node's children.
+ */
+static inline uint32_t child_index(uint64_t b, uint32_t level) {
+        return (uint32_t)(b >> (SM_DIR_BITS * (level - 1))) % SM_DIR_FANOUT;
+}
+
+
+/*
+ * Function: find_block
+ * ----------------------------
+ * Walks a version's tree down to a row block.
+ *
+ * @param S - Pointer to the version.
+ * @param b - Index of the row block (0-based).
+ *
+ * @return Pointer to the block, or NULL if its rows are empty.
+ */
+static sm_row_block* find_block(sm_snapshot* S, uint64_t b) {
+        sm_block_dir* dir = S->root;
+        for (uint32_t level = S->depth; dir && level > 1; level--) {
+                dir = dir->dirs[child_index(b, level)];
+        }
+
+        return dir ? dir->blocks[child_index(b, 1)] : NULL;
+}
+
+
+/*
+ * Function: own_path
+ * ----------------------------
+ * Makes the directory nodes on the path to a row block private to a version being built.
+ *
+ * @param S - Pointer to the new version.
+ * @param old - Version S was cloned from, or NULL if S shares nothing.
+ * @param b - Index of the row block (0-based).
+ *
+ * @return Pointer to the level 1 node holding the block, or NULL if allocation fails.
+ *
+ * Description:
+ *   A node S still shares with old is copied and S's reference to the original dropped;
+ *   a node already copied for an earlier block of the same write is used as it is.
+ */
+static sm_block_dir* own_path(sm_snapshot* S, sm_snapshot* old, uint64_t b) {
+        sm_block_dir** link = &S->root;
+        sm_block_dir* shared = (old && old->depth == S->depth) ? old->root : NULL;
+
+        for (uint32_t level = S->depth; ; level--) {
+                if (!*link || *link == shared) {
+                        sm_block_dir* dir = copy_block_dir(*link, level);
+                        if (!dir) return NULL;
+
+                        release_block_dir(*link, level);
+                        *link = dir;
+                }
+                if (level == 1) return *link;
+
+                uint32_t index = child_index(b, level);
+                shared = shared ? shared->dirs[index] : NULL;
+                link = &(*link)->dirs[index];
+        }
+}
+
+
+/*
+ * Function: create_version
+ * ----------------------------
+ * Allocates an empty version of the given dimensions.
+ *
+ * @param rows - Number of rows.
+ * @param columns - Number of columns.
+ *
+ * @return Pointer to the version with one reference, or NULL if allocation fails.
+ */
+static sm_snapshot* create_version(uint32_t rows, uint32_t columns) {
+        sm_snapshot* S = (sm_snapshot*)malloc(sizeof(sm_snapshot));
+        if (!S) return NULL;
+
+        atomic_init(&S->refs, 1);
+        S->row = rows;
+        S->col = columns;
+        S->nnz = 0;
+        S->depth = tree_depth(rows);
+        S->root = NULL;
+
+        return S;
+}
+
+
+/*
+ * Function: clone_version
+ * ----------------------------
+ * Creates a new version sharing the whole tree of an existing one.
+ *
+ * @param old - Version to share from.
+ * @param rows - Number of rows of the new version (at least old->row).
+ * @param columns - Number of columns of the new version.
+ *
+ * @return Pointer to the new version, or NULL if allocation fails.
+ *
+ * Description:
+ *   Shares the old root; if the new version needs more levels, the old tree becomes the
+ *   first child of each new one. The cost is O(depth), whatever the size of the matrix.
+ */
+static sm_snapshot* clone_version(sm_snapshot* old, uint32_t rows, uint32_t columns) {
+        sm_snapshot* S = create_version(rows, columns);
+        if (!S) return NULL;
+
+        S->nnz = old->nnz;
+        S->root = old->root;
+        if (!S->root) return S;
+
+        atomic_fetch_add(&S->root->refs, 1);
+        for (uint32_t level = old->depth + 1; level <= S->depth; level++) {
+                sm_block_dir* up = copy_block_dir(NULL, level);
+                if (!up) {
+                        S->depth = level - 1;
+                        release_snapshot(S);
+                        return NULL;
+                }
+
+                up->dirs[0] = S->root;
+                S->root = up;
+        }
+
+        return S;
+}
+
+
+/*
+ * Function: version_from_csr
+ * ----------------------------
+ * Builds a version from a CSR matrix.
+ *
+ * @param A - Pointer to the CSR matrix.
+ *
+ * @return Pointer to the version, or NULL if allocation fails.
+ */
+static sm_snapshot* version_from_csr(csr_matrix* A) {
+        sm_snapshot* S = create_version(A->row, A->col);
+        if (!S) return NULL;
+
+        for (uint64_t first = 1; first <= A->row; first += SM_BLOCK_ROWS) {
+                uint64_t last = first + SM_BLOCK_ROWS - 1;
+                if (last > A->row) last = A->row;
+
+                uint64_t start = A->row_ptr[first - 1];
+                uint64_t nnz = A->row_ptr[last] - start;
+                if (!nnz) continue;
+
+                uint64_t b = (first - 1) / SM_BLOCK_ROWS;
+                sm_block_dir* dir = own_path(S, NULL, b);
+                if (!dir) goto fail;
+
+                sm_row_block* block = create_row_block((uint32_t)nnz);
+                if (!block) goto fail;
+
+                for (uint64_t r = first; r <= last; r++) {
+                        block->row_ptr[r - first + 1] = (uint32_t)(A->row_ptr[r] - start);
+                }
+                for (uint64_t r = last + 1; r < first + SM_BLOCK_ROWS; r++) {
+                        block->row_ptr[r - first + 1] = (uint32_t)nnz;
+                }
+                memcpy(block->col_idx, A->col_idx + start, nnz * sizeof(uint32_t));
+                memcpy(block->values, A->values + start, nnz * sizeof(double));
+
+                dir->blocks[child_index(b, 1)] = block;
+                S->nnz += nnz;
+        }
+
+        return S;
+
+fail:
+        release_snapshot(S);
+        return NULL;
+}
+
+
+/*
+ * Function: merge_block
+ * ----------------------------
+ * Builds a new block from an old one and sorted entries falling into it.
+ *
+ * @param old - Previous block, or NULL if it was empty.
+ * @param first_row - Row index of the block's first row.
+ * @param entries - Entries sorted by row and column; for equal positions the last wins.
+ * @param count - Number of entries.
+ *
+ * @return Pointer to the new block, or NULL if allocation fails.
+ */
+static sm_row_block* merge_block(sm_row_block* old, uint32_t first_row, sm_triplet* entries, uint64_t count) {
+        // Two passes over the same merge: the first sizes the block, the second fills it
+        sm_row_block* block = NULL;
+        for (int pass = 0; pass < 2; pass++) {
+                uint32_t k = 0;
+                uint64_t j = 0;
+
+                for (uint32_t lr = 0; lr < SM_BLOCK_ROWS; lr++) {
+                        uint32_t row = first_row + lr;
+                        uint32_t i = old ? old->row_ptr[lr] : 0;
+                        uint32_t end = old ? old->row_ptr[lr + 1] : 0;
+
+                        while (i < end || (j < count && entries[j].row == row)) {
+                                bool have_entry = j < count && entries[j].row == row;
+                                if (have_entry && j + 1 < count && entries[j + 1].row == row && entries[j + 1].column == entries[j].column) {
+                                        j++;
+                                        continue;
+                                }
+
+                                uint32_t column;
+                                double value;
+                                if (!have_entry || (i < end && old->col_idx[i] < entries[j].column)) {
+                                        column = old->col_idx[i];
+                                        value = old->values[i];
+                                        i++;
+                                } else {
+                                        if (i < end && old->col_idx[i] == entries[j].column) i++;
+                                        column = entries[j].column;
+                                        value = entries[j].value;
+                                        j++;
+                                }
+
+                                if (block) {
+                                        block->col_idx[k] = column;
+                                        block->values[k] = value;
+                                }
+                                k++;
+                        }
+
+                        if (block) block->row_ptr[lr + 1] = k;
+                }
+
+                if (!block) {
+                        block = create_row_block(k);
+                        if (!block) return NULL;
+                }
+        }
+
+        return block;
+}
+
+
+/*
+ * Function: publish_version
+ * ----------------------------
+ * Makes a new version current and drops the matrix's reference to the old one.
+ *
+ * @param V - Pointer to the versioned matrix.
+ * @param S - Version to publish.
+ */
+static void publish_version(v_matrix* V, sm_snapshot* S) {
+        pthread_mutex_lock(&V->publish_lock);
+        sm_snapshot* old = V->current;
+        V->current = S;
+        pthread_mutex_unlock(&V->publish_lock);
+
+        release_snapshot(old);
+}
+
+
+/*
+ * Function: create_versioned_matrix
+ * ----------------------------
+ * Creates an empty versioned matrix.
+ *
+ * @param rows - Number of rows.
+ * @param columns - Number of columns.
+ *
+ * @return Pointer to the matrix, or NULL if allocation fails.
+ */
+v_matrix* create_versioned_matrix(uint32_t rows, uint32_t columns) {
+        v_matrix* V = (v_matrix*)malloc(sizeof(v_matrix));
+        if (!V) return NULL;
+
+        V->current = create_version(rows, columns);
+        if (!V->current) {
+                free(V);
+                return NULL;
+        }
+
+        pthread_mutex_init(&V->publish_lock, NULL);
+        pthread_mutex_init(&V->writer_lock, NULL);
+
+        return V;
+}
+
+
+/*
+ * Function: versioned_from_S_Matrix
+ * ----------------------------
+ * Creates a versioned matrix holding the contents of a linked matrix.
+ *
+ * @param M - Pointer to the matrix.
+ *
+ * @return Pointer to the versioned matrix, or NULL if allocation fails.
+ */
+v_matrix* versioned_from_S_Matrix(matrix* M) {
+        csr_matrix* A = csr_from_S_Matrix(M);
+        if (!A) return NULL;
+
+        sm_snapshot* S = version_from_csr(A);
+        free_csr_matrix(A);
+        if (!S) return NULL;
+
+        v_matrix* V = (v_matrix*)malloc(sizeof(v_matrix));
+        if (!V) {
+                release_snapshot(S);
+                return NULL;
+        }
+
+        V->current = S;
+        pthread_mutex_init(&V->publish_lock, NULL);
+        pthread_mutex_init(&V->writer_lock, NULL);
+
+        return V;
+}
+
+
+/*
+ * Function: insert_batch_locked
+ * ----------------------------
+ * Applies a batch and publishes it as one new version; the caller holds the writer lock.
+ *
+ * @param V - Pointer to the versioned matrix.
+ * @param entries - Array of triplets; it is filtered and sorted in place.
+ * @param count - Number of triplets.
+ *
+ * @return true on success, false if allocation fails (nothing is published).
+ */
+static bool insert_batch_locked(v_matrix* V, sm_triplet* entries, uint64_t count) {
+        sm_snapshot* old = V->current;
+
+        // Drop unusable entries up front so they can not shadow valid ones
+        uint64_t kept = 0;
+        for (uint64_t i = 0; i < count; i++) {
+                sm_triplet* t = &entries[i];
+                if (t->value == 0 || t->row < 1 || t->row > old->row || t->column < 1 || t->column > old->col) continue;
+                entries[kept++] = *t;
+        }
+
+        if (!sort_triplets(entries, kept)) return false;
+
+        sm_snapshot* S = clone_version(old, old->row, old->col);
+        if (!S) return false;
+
+        uint64_t i = 0;
+        while (i < kept) {
+                uint32_t b = (entries[i].row - 1) / SM_BLOCK_ROWS;
+                uint64_t j = i;
+                while (j < kept && (entries[j].row - 1) / SM_BLOCK_ROWS == b) j++;
+
+                // The nodes on the block's path are copied if they are still shared with old
+                sm_block_dir* dir = own_path(S, old, b);
+                if (!dir) goto fail;
+
+                uint32_t slot = child_index(b, 1);
+                sm_row_block* prev = dir->blocks[slot];
+                sm_row_block* block = merge_block(prev, b * SM_BLOCK_ROWS + 1, entries + i, j - i);
+                if (!block) goto fail;
+
+                S->nnz += block->nnz - (prev ? prev->nnz : 0);
+                dir->blocks[slot] = block;
+                release_row_block(prev);
+
+                i = j;
+        }
+
+        publish_version(V, S);
+        return true;
+
+fail:
+        release_snapshot(S);
+        return false;
+}
+
+
+/*
+ * Function: vm_insert_data
+ * ----------------------------
+ * Inserts or updates a value and publishes a new version.
+ *
+ * @param V - Pointer to the versioned matrix.
+ * @param row - Row index.
+ * @param column - Column index.
+ * @param value - Value to be inserted.
+ *
+ * @return SM_OK, SM_ERR_NOT_CREATED, SM_ERR_ZERO_VALUE, SM_ERR_OUT_OF_BOUNDS or SM_ERR_NO_MEMORY.
+ */
+sm_status vm_insert_data(v_matrix* V, uint32_t row, uint32_t column, double value) {
+        if (!V) return sm_fail(__func__, SM_ERR_NOT_CREATED);
+        if (value == 0) return sm_fail(__func__, SM_ERR_ZERO_VALUE);
+
+        // Checked and applied under one hold, so a resize or transpose can not come in between
+        sm_triplet entry = { row, column, value };
+        pthread_mutex_lock(&V->writer_lock);
+        sm_status status = SM_OK;
+        if (row < 1 || column < 1 || row > V->current->row || column > V->current->col) {
+                status = SM_ERR_OUT_OF_BOUNDS;
+        } else if (!insert_batch_locked(V, &entry, 1)) {
+                status = SM_ERR_NO_MEMORY;
+        }
+        pthread_mutex_unlock(&V->writer_lock);
+
+        return status == SM_OK ? SM_OK : sm_fail(__func__, status);
+}
+
+
+/*
+ * Function: vm_insert_batch
+ * ----------------------------
+ * Inserts or updates many values and publishes them as one new version.
+ *
+ * @param V - Pointer to the versioned matrix.
+ * @param entries - Array of triplets; it is filtered and sorted in place.
+ * @param count - Number of triplets.
+ *
+ * @return SM_OK, SM_ERR_NOT_CREATED or SM_ERR_NO_MEMORY (nothing is published).
+ */
+sm_status vm_insert_batch(v_matrix* V, sm_triplet* entries, uint64_t count) {
+        if (!V) return sm_fail(__func__, SM_ERR_NOT_CREATED);
+
+        pthread_mutex_lock(&V->writer_lock);
+        bool inserted = insert_batch_locked(V, entries, count);
+        pthread_mutex_unlock(&V->writer_lock);
+
+        return inserted ? SM_OK : sm_fail(__func__, SM_ERR_NO_MEMORY);
+}
+
+
+/*
+ * Function: vm_resize
+ * ----------------------------
+ * Doubles the dimensions and publishes a new version sharing every row block.
+ *
+ * @param V - Pointer to the versioned matrix.
+ *
+ * @return SM_OK, SM_ERR_NOT_CREATED, SM_ERR_OVERFLOW or SM_ERR_NO_MEMORY.
+ */
+sm_status vm_resize(v_matrix* V) {
+        if (!V) return sm_fail(__func__, SM_ERR_NOT_CREATED);
+
+        pthread_mutex_lock(&V->writer_lock);
+
+        sm_snapshot* old = V->current;
+        if (old->row > UINT32_MAX / 2 || old->col > UINT32_MAX / 2) {
+                pthread_mutex_unlock(&V->writer_lock);
+                return sm_fail(__func__, SM_ERR_OVERFLOW);
+        }
+
+        sm_snapshot* S = clone_version(old, old->row * 2, old->col * 2);
+        if (!S) {
+                pthread_mutex_unlock(&V->writer_lock);
+                return sm_fail(__func__, SM_ERR_NO_MEMORY);
+        }
+
+        publish_version(V, S);
+        pthread_mutex_unlock(&V->writer_lock);
+        return SM_OK;
+}
+
+
+/*
+ * Struct: transpose_ctx
+ * ----------------------------
+ * State of the visitor collecting transposed entries.
+ *
+ * entries: Output array.
+ * count: Number of entries written.
+ */
+typedef struct transpose_ctx {
+        sm_triplet* entries;
+        uint64_t count;
+} transpose_ctx;
+
+
+static void transpose_visit(uint32_t row, uint32_t column, double value, void* ctx) {
+        transpose_ctx* t = (transpose_ctx*)ctx;
+        sm_triplet* e = &t->entries[t->count++];
+        e->row = column;
+        e->column = row;
+        e->value = value;
+}
+
+
+/*
+ * Function: vm_transpose
+ * ----------------------------
+ * Transposes the matrix and publishes the result as a new version.
+ *
+ * @param V - Pointer to the versioned matrix.
+ *
+ * @return SM_OK, SM_ERR_NOT_CREATED or SM_ERR_NO_MEMORY.
+ */
+sm_status vm_transpose(v_matrix* V) {
+        if (!V) return sm_fail(__func__, SM_ERR_NOT_CREATED);
+
+        pthread_mutex_lock(&V->writer_lock);
+
+        sm_snapshot* old = V->current;
+        transpose_ctx t = { (sm_triplet*)malloc((old->nnz ? old->nnz : 1) * sizeof(sm_triplet)), 0 };
+        if (!t.entries) {
+                pthread_mutex_unlock(&V->writer_lock);
+                return sm_fail(__func__, SM_ERR_NO_MEMORY);
+        }
+
+        snapshot_scan(old, transpose_visit, &t);
+
+        csr_matrix* A = csr_from_triplets(old->col, old->row, t.entries, t.count);
+        free(t.entries);
+
+        sm_snapshot* S = A ? version_from_csr(A) : NULL;
+        free_csr_matrix(A);
+
+        if (!S) {
+                pthread_mutex_unlock(&V->writer_lock);
+                return sm_fail(__func__, SM_ERR_NO_MEMORY);
+        }
+
+        publish_version(V, S);
+        pthread_mutex_unlock(&V->writer_lock);
+        return SM_OK;
+}
+
+
+/*
+ * Function: snapshot
+ * ----------------------------
+ * Takes a consistent read-only view of the current version in O(1).
+ *
+ * @param V - Pointer to the versioned matrix.
+ *
+ * @return Pointer to the snapshot; release it with release_snapshot.
+ */
+sm_snapshot* snapshot(v_matrix* V) {
+        if (!V) return NULL;
+
+        pthread_mutex_lock(&V->publish_lock);
+        sm_snapshot* S = V->current;
+        atomic_fetch_add(&S->refs, 1);
+        pthread_mutex_unlock(&V->publish_lock);
+
+        return S;
+}
+
+
+/*
+ * Function: snapshot_get
+ * ----------------------------
+ * Reads a single element of a snapshot.
+ *
+ * @param S - Pointer to the snapshot.
+ * @param row - Row index.
+ * @param column - Column index.
+ *
+ * @return The stored value, or 0 if the position is empty.
+ */
+double snapshot_get(sm_snapshot* S, uint32_t row, uint32_t column) {
+        if (!S || row < 1 || row > S->row) return 0;
+
+        sm_row_block* block = find_block(S, (row - 1) / SM_BLOCK_ROWS);
+        if (!block) return 0;
+
+        uint32_t lr = (row - 1) % SM_BLOCK_ROWS;
+        uint32_t lo = block->row_ptr[lr];
+        uint32_t hi = block->row_ptr[lr + 1];
+        uint32_t end = hi;
+
+        while (lo < hi) {
+                uint32_t mid = lo + (hi - lo) / 2;
+                if (block->col_idx[mid] < column) {
+                        lo = mid + 1;
+                } else {
+                        hi = mid;
+                }
+        }
+
+        return (lo < end && block->col_idx[lo] == column) ? block->values[lo] : 0;
+}
+
+
+/*
+ * Function: scan_dir
+ * ----------------------------
+ * Visits the non-zeros under a directory node in row-major order.
+ *
+ * @param dir - The node, or NULL.
+ * @param level - Level of the node.
+ * @param first_block - Index of the first row block under the node (0-based).
+ * @param visit - Callback receiving each non-zero.
+ * @param ctx - Caller context passed to the callback.
+ */
+static void scan_dir(sm_block_dir* dir, uint32_t level, uint64_t first_block, sm_visit_fn visit, void* ctx) {
+        if (!dir) return;
+
+        uint64_t span = (uint64_t)1 << (SM_DIR_BITS * (level - 1));
+        for (uint32_t slot = 0; slot < SM_DIR_FANOUT; slot++) {
+                if (level > 1) {
+                        scan_dir(dir->dirs[slot], level - 1, first_block + slot * span, visit, ctx);
+                        continue;
+                }
+
+                sm_row_block* block = dir->blocks[slot];
+                if (!block) continue;
+
+                uint64_t first_row = (first_block + slot) * SM_BLOCK_ROWS + 1;
+                for (uint32_t lr = 0; lr < SM_BLOCK_ROWS; lr++) {
+                        for (uint32_t k = block->row_ptr[lr]; k < block->row_ptr[lr + 1]; k++) {
+                                visit((uint32_t)(first_row + lr), block->col_idx[k], block->values[k], ctx);
+                        }
+                }
+        }
+}
+
+
+/*
+ * Function: snapshot_scan
+ * ----------------------------
+ * Visits every non-zero of a snapshot in row-major order.
+ *
+ * @param S - Pointer to the snapshot.
+ * @param visit - Callback receiving each non-zero.
+ * @param ctx - Caller context passed to the callback.
+ */
+void snapshot_scan(sm_snapshot* S, sm_visit_fn visit, void* ctx) {
+        if (!S || !visit) return;
+
+        scan_dir(S->root, S->depth, 0, visit, ctx);
+}
+
+
+/*
+ * Function: csr_from_snapshot
+ * ----------------------------
+ * Exports a snapshot to CSR form.
+ *
+ * @param S - Pointer to the snapshot.
+ *
+ * @return Pointer to the CSR matrix, or NULL if allocation fails.
+ */
+csr_matrix* csr_from_snapshot(sm_snapshot* S) {
+        if (!S) return NULL;
+
+        csr_matrix* A = create_csr_matrix(S->row, S->col, S->nnz);
+        if (!A) return NULL;
+
+        uint64_t k = 0;
+        sm_row_block* block = NULL;
+        for (uint32_t row = 1; row <= S->row; row++) {
+                // The tree is walked once per block, not once per row
+                if ((row - 1) % SM_BLOCK_ROWS == 0) block = find_block(S, (row - 1) / SM_BLOCK_ROWS);
+
+                if (block) {
+                        uint32_t lr = (row - 1) % SM_BLOCK_ROWS;
+                        uint32_t start = block->row_ptr[lr];
+                        uint32_t n = block->row_ptr[lr + 1] - start;
+                        memcpy(A->col_idx + k, block->col_idx + start, n * sizeof(uint32_t));
+                        memcpy(A->values + k, block->values + start, n * sizeof(double));
+                        k += n;
+                }
+
+                A->row_ptr[row] = k;
+        }
+
+        return A;
+}
+
+
+/*
+ * Function: release_snapshot
+ * ----------------------------
+ * Drops a reference to a snapshot; the last release frees the blocks no other version shares.
+ *
+ * @param S - Pointer to the snapshot.
+ */
+void release_snapshot(sm_snapshot* S) {
+        if (!S || atomic_fetch_sub(&S->refs, 1) != 1) {
+                return;
+        }
+
+        release_block_dir(S->root, S->depth);
+        free(S);
+}
+
+
+/*
+ * Function: free_versioned_matrix
+ * ----------------------------
+ * Frees the versioned matrix; snapshots still held by readers stay valid until released.
+ *
+ * @param V - Pointer to the versioned matrix.
+ */
+void free_versioned_matrix(v_matrix* V) {
+        if (!V) {
+                return;
+        }
+
+        release_snapshot(V->current);
+        pthread_mutex_destroy(&V->publish_lock);
+        pthread_mutex_destroy(&V->writer_lock);
+        free(V);
+}
@@ -0,0 +1,667 @@
+/*
+ * File Name: S_Matrix_solver.c
+ * Authors: Arpit Patel, Dharm KaPatel
+ * Date: 2025-03-19
+ * Description: This file implements the iterative linear solvers for the S_Matrix data structure.
+ *              Every pass over the vectors is a fused kernel: the updates of one iteration and the
+ *              inner products that follow them are done while the data is in cache, and the
+ *              passes are split across threads with per-thread partial sums.
+ */
+
+
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+
+
+#include "../include/S_Matrix_solver.h"
+#include "../include/S_Matrix_parallel.h"
+
+
+// Doubles per thread in the partial sum array; one cache line so threads do not share lines
+#define SM_PARTIAL_STRIDE 8
+
+
+/*
+ * Enum: sm_vec_op
+ * ----------------------------
+ * Fused kernels run by vector_range. p0 and p1 are the two partial sums of each thread.
+ *
+ * OP_RESIDUAL: r = b - Ax; p0 = r.r, p1 = b.b.
+ * OP_SPMV_DOT: out = A in; p0 = w.out, p1 = out.out.
+ * OP_CG_UPDATE: x += alpha p, r -= alpha q, z = D^-1 r (Jacobi); p0 = r.z, p1 = r.r.
+ * OP_CG_DIRECTION: p = z + beta p.
+ * OP_BICG_DIRECTION: p = r + beta (p - omega v), phat = D^-1 p (Jacobi).
+ * OP_BICG_S: s = r - alpha v, shat = D^-1 s (Jacobi); p0 = s.s.
+ * OP_BICG_UPDATE: x += alpha phat + omega shat, r = s - omega t; p0 = r.r, p1 = rhat.r.
+ * OP_AXPY: x += alpha phat.
+ * OP_DOT: p0 = r.z.
+ */
+typedef enum sm_vec_op {
+        OP_RESIDUAL,
+        OP_SPMV_DOT,
+        OP_CG_UPDATE,
+        OP_CG_DIRECTION,
+        OP_BICG_DIRECTION,
+        OP_BICG_S,
+        OP_BICG_UPDATE,
+        OP_AXPY,
+        OP_DOT
+} sm_vec_op;
+
+
+/*
+ * Struct: sm_workspace
+ * ----------------------------
+ * Vectors, preconditioner data and kernel arguments of one solve.
+ *
+ * A: The CSR matrix.
+ * n: Number of unknowns.
+ * threads: Number of threads for the vector kernels.
+ * op: Kernel to run in the next pass.
+ * in, out, w: Operands of OP_SPMV_DOT.
+ * b .. shat: Solver vectors; z, phat and shat alias r, p and s when there is no preconditioner.
+ * alpha, beta, omega: Scalars of the current kernel.
+ * dinv: Inverse diagonal for Jacobi, NULL otherwise.
+ * lu: ILU(0) factors in the pattern of A, NULL otherwise.
+ * diag: Position of the diagonal entry of each row (ILU(0) only).
+ * partial: Per-thread partial sums, SM_PARTIAL_STRIDE doubles per thread.
+ * owned: Vectors allocated for this solve, freed by free_workspace.
+ * owned_count: Number of entries in owned.
+ */
+typedef struct sm_workspace {
+        csr_matrix* A;
+        uint64_t n;
+        uint32_t threads;
+        sm_vec_op op;
+        const double* in;
+        double* out;
+        const double* w;
+        const double* b;
+        double* x;
+        double* r;
+        double* z;
+        double* p;
+        double* q;
+        double* rhat;
+        double* s;
+        double* t;
+        double* phat;
+        double* shat;
+        double alpha;
+        double beta;
+        double omega;
+        double* dinv;
+        double* lu;
+        uint64_t* diag;
+        double* partial;
+        double* owned[9];
+        int owned_count;
+} sm_workspace;
+
+
+static inline double row_dot(csr_matrix* A, uint64_t i, const double* v) {
+        double sum = 0;
+        for (uint64_t k = A->row_ptr[i]; k < A->row_ptr[i + 1]; k++) {
+                sum += A->values[k] * v[A->col_idx[k] - 1];
+        }
+        return sum;
+}
+
+
+static void vector_range(uint64_t begin, uint64_t end, uint32_t thread, void* ctx) {
+        sm_workspace* ws = (sm_workspace*)ctx;
+        const double* dinv = ws->dinv;
+        double p0 = 0;
+        double p1 = 0;
+
+        switch (ws->op) {
+        case OP_RESIDUAL:
+                for (uint64_t i = begin; i < end; i++) {
+                        double ri = ws->b[i] - row_dot(ws->A, i, ws->x);
+                        ws->r[i] = ri;
+                        p0 += ri * ri;
+                        p1 += ws->b[i] * ws->b[i];
+                }
+                break;
+        case OP_SPMV_DOT:
+                for (uint64_t i = begin; i < end; i++) {
+                        double yi = row_dot(ws->A, i, ws->in);
+                        ws->out[i] = yi;
+                        p0 += ws->w[i] * yi;
+                        p1 += yi * yi;
+                }
+                break;
+        case OP_CG_UPDATE:
+                for (uint64_t i = begin; i < end; i++) {
+                        ws->x[i] += ws->alpha * ws->p[i];
+                        double ri = ws->r[i] - ws->alpha * ws->q[i];
+                        ws->r[i] = ri;
+                        if (dinv) {
+                                double zi = ri * dinv[i];
+                                ws->z[i] = zi;
+                                p0 += ri * zi;
+                        }
+                        p1 += ri * ri;
+                }
+                if (!dinv) p0 = p1;
+                break;
+        case OP_CG_DIRECTION:
+                for (uint64_t i = begin; i < end; i++) {
+                        ws->p[i] = ws->z[i] + ws->beta * ws->p[i];
+                }
+                break;
+        case OP_BICG_DIRECTION:
+                for (uint64_t i = begin; i < end; i++) {
+                        double pi = ws->r[i] + ws->beta * (ws->p[i] - ws->omega * ws->q[i]);
+                        ws->p[i] = pi;
+                        if (dinv) ws->phat[i] = pi * dinv[i];
+                }
+                break;
+        case OP_BICG_S:
+                for (uint64_t i = begin; i < end; i++) {
+                        double si = ws->r[i] - ws->alpha * ws->q[i];
+                        ws->s[i] = si;
+                        if (dinv) ws->shat[i] = si * dinv[i];
+                        p0 += si * si;
+                }
+                break;
+        case OP_BICG_UPDATE:
+                for (uint64_t i = begin; i < end; i++) {
+                        ws->x[i] += ws->alpha * ws->phat[i] + ws->omega * ws->shat[i];
+                        double ri = ws->s[i] - ws->omega * ws->t[i];
+                        ws->r[i] = ri;
+                        p0 += ri * ri;
+                        p1 += ws->rhat[i] * ri;
+                }
+                break;
+        case OP_AXPY:
+                for (uint64_t i = begin; i < end; i++) {
+                        ws->x[i] += ws->alpha * ws->phat[i];
+                }
+                break;
+        case OP_DOT:
+                for (uint64_t i = begin; i < end; i++) {
+                        p0 += ws->r[i] * ws->z[i];
+                }
+                break;
+        }
+
+        ws->partial[thread * SM_PARTIAL_STRIDE] = p0;
+        ws->partial[thread * SM_PARTIAL_STRIDE + 1] = p1;
+}
+
+
+/*
+ * Function: run_kernel
+ * ----------------------------
+ * Runs one fused kernel over all unknowns and reduces the partial sums.
+ *
+ * @param ws - Pointer to the workspace.
+ * @param op - Kernel to run.
+ * @param s0 - Output first sum, or NULL.
+ * @param s1 - Output second sum, or NULL.
+ */
+static void run_kernel(sm_workspace* ws, sm_vec_op op, double* s0, double* s1) {
+        ws->op = op;
+        uint32_t used = sm_parallel_for(ws->n, ws->threads, vector_range, ws);
+
+        double sum0 = 0;
+        double sum1 = 0;
+        for (uint32_t t = 0; t < used; t++) {
+                sum0 += ws->partial[t * SM_PARTIAL_STRIDE];
+                sum1 += ws->partial[t * SM_PARTIAL_STRIDE + 1];
+        }
+
+        if (s0) *s0 = sum0;
+        if (s1) *s1 = sum1;
+}
+
+
+/*
+ * Function: build_jacobi
+ * ----------------------------
+ * Computes the inverse diagonal of the matrix.
+ *
+ * @param ws - Pointer to the workspace.
+ *
+ * @return true on success, false if a diagonal entry is zero or allocation fails.
+ */
+static bool build_jacobi(sm_workspace* ws) {
+        csr_matrix* A = ws->A;
+        ws->dinv = (double*)malloc(ws->n * sizeof(double));
+        if (!ws->dinv) return false;
+
+        for (uint64_t i = 0; i < ws->n; i++) {
+                double d = csr_get(A, (uint32_t)(i + 1), (uint32_t)(i + 1));
+                if (d == 0) return false;
+                ws->dinv[i] = 1.0 / d;
+        }
+
+        return true;
+}
+
+
+/*
+ * Function: build_ilu0
+ * ----------------------------
+ * Computes the ILU(0) factorization: unit lower L and upper U sharing the pattern of A.
+ *
+ * @param ws - Pointer to the workspace.
+ *
+ * @return true on success, false if a diagonal entry is missing, a pivot is zero or allocation fails.
+ */
+static bool build_ilu0(sm_workspace* ws) {
+        csr_matrix* A = ws->A;
+        uint64_t n = ws->n;
+
+        ws->lu = (double*)malloc((A->nnz ? A->nnz : 1) * sizeof(double));
+        ws->diag = (uint64_t*)malloc(n * sizeof(uint64_t));
+        uint64_t* where = (uint64_t*)malloc(n * sizeof(uint64_t));
+        if (!ws->lu || !ws->diag || !where) {
+                free(where);
+                return false;
+        }
+
+        memcpy(ws->lu, A->values, A->nnz * sizeof(double));
+
+        for (uint64_t i = 0; i < n; i++) {
+                where[i] = UINT64_MAX;
+        }
+
+        bool ok = true;
+        for (uint64_t i = 0; i < n && ok; i++) {
+                uint64_t start = A->row_ptr[i];
+                uint64_t stop = A->row_ptr[i + 1];
+
+                ws->diag[i] = UINT64_MAX;
+                for (uint64_t k = start; k < stop; k++) {
+                        uint64_t c = A->col_idx[k] - 1;
+                        where[c] = k;
+                        if (c == i) ws->diag[i] = k;
+                }
+
+                // Eliminate with every earlier row k that row i references, in column order
+                for (uint64_t k = start; k < stop && A->col_idx[k] - 1 < i; k++) {
+                        uint64_t pivot_row = A->col_idx[k] - 1;
+                        ws->lu[k] /= ws->lu[ws->diag[pivot_row]];
+
+                        for (uint64_t j = ws->diag[pivot_row] + 1; j < A->row_ptr[pivot_row + 1]; j++) {
+                                uint64_t slot = where[A->col_idx[j] - 1];
+                                if (slot != UINT64_MAX) ws->lu[slot] -= ws->lu[k] * ws->lu[j];
+                        }
+                }
+
+                if (ws->diag[i] == UINT64_MAX || ws->lu[ws->diag[i]] == 0) ok = false;
+
+                for (uint64_t k = start; k < stop; k++) {
+                        where[A->col_idx[k] - 1] = UINT64_MAX;
+                }
+        }
+
+        free(where);
+        return ok;
+}
+
+
+/*
+ * Function: apply_ilu0
+ * ----------------------------
+ * Solves LU out = in by forward and backward substitution.
+ *
+ * @param ws - Pointer to the workspace.
+ * @param in - Right-hand side.
+ * @param out - Output vector (may not alias in).
+ */
+static void apply_ilu0(sm_workspace* ws, const double* in, double* out) {
+        csr_matrix* A = ws->A;
+
+        for (uint64_t i = 0; i < ws->n; i++) {
+                double sum = in[i];
+                for (uint64_t k = A->row_ptr[i]; k < ws->diag[i]; k++) {
+                        sum -= ws->lu[k] * out[A->col_idx[k] - 1];
+                }
+                out[i] = sum;
+        }
+
+        for (uint64_t i = ws->n; i-- > 0;) {
+                double sum = out[i];
+                for (uint64_t k = ws->diag[i] + 1; k < A->row_ptr[i + 1]; k++) {
+                        sum -= ws->lu[k] * out[A->col_idx[k] - 1];
+                }
+                out[i] = sum / ws->lu[ws->diag[i]];
+        }
+}
+
+
+/*
+ * Function: setup_workspace
+ * ----------------------------
+ * Validates the inputs, allocates the solver vectors and builds the preconditioner.
+ *
+ * @param ws - Pointer to the workspace to fill in.
+ * @param A - Pointer to the CSR matrix.
+ * @param b - Right-hand side.
+ * @param x - Initial guess.
+ * @param opts - Solver parameters.
+ * @param vectors - Workspace fields to allocate a vector of n entries for.
+ * @param count - Number of entries in vectors.
+ *
+ * @return true on success, false on invalid input or allocation failure.
+ */
+static bool setup_workspace(sm_workspace* ws, csr_matrix* A, const double* b, double* x, const sm_solver_options* opts, double** vectors[], int count) {
+        memset(ws, 0, sizeof(sm_workspace));
+        if (!A || !b || !x || A->row != A->col) return false;
+
+        ws->A = A;
+        ws->n = A->row;
+        ws->b = b;
+        ws->x = x;
+        ws->threads = sm_thread_count(opts->threads);
+
+        ws->partial = (double*)calloc((size_t)ws->threads * SM_PARTIAL_STRIDE, sizeof(double));
+        if (!ws->partial) return false;
+
+        for (int v = 0; v < count; v++) {
+                *vectors[v] = (double*)calloc(ws->n ? ws->n : 1, sizeof(double));
+                if (!*vectors[v]) return false;
+                ws->owned[ws->owned_count++] = *vectors[v];
+        }
+
+        if (opts->precond == SM_PRECOND_JACOBI) return build_jacobi(ws);
+        if (opts->precond == SM_PRECOND_ILU0) return build_ilu0(ws);
+        return true;
+}
+
+
+static void free_workspace(sm_workspace* ws) {
+        for (int v = 0; v < ws->owned_count; v++) {
+                free(ws->owned[v]);
+        }
+        free(ws->partial);
+        free(ws->dinv);
+        free(ws->lu);
+        free(ws->diag);
+}
+
+
+static void set_result(sm_solver_result* result, uint32_t iterations, double rr, double bnorm, double tolerance) {
+        if (!result) return;
+        result->iterations = iterations;
+        result->residual = (bnorm > 0) ? sqrt(rr) / bnorm : sqrt(rr);
+        result->converged = result->residual <= tolerance;
+}
+
+
+/*
+ * Function: default_solver_options
+ * ----------------------------
+ * Fills in the default solver parameters.
+ *
+ * @param opts - Pointer to the options to fill in.
+ */
+void default_solver_options(sm_solver_options* opts) {
+        opts->tolerance = 1e-8;
+        opts->max_iterations = 1000;
+        opts->precond = SM_PRECOND_NONE;
+        opts->threads = 0;
+}
+
+
+/*
+ * Function: csr_spmv
+ * ----------------------------
+ * Multiplies a CSR matrix by a dense vector, y = Ax.
+ *
+ * @param A - Pointer to the CSR matrix.
+ * @param x - Input vector of A->col entries.
+ * @param y - Output vector of A->row entries.
+ * @param threads - Number of threads, or 0 for one per online CPU.
+ */
+void csr_spmv(csr_matrix* A, const double* x, double* y, uint32_t threads) {
+        if (!A || !x || !y) return;
+
+        sm_workspace ws;
+        memset(&ws, 0, sizeof(sm_workspace));
+        ws.A = A;
+        ws.n = A->row;
+        ws.threads = sm_thread_count(threads);
+        ws.in = x;
+        ws.out = y;
+        ws.w = y;
+
+        ws.partial = (double*)calloc((size_t)ws.threads * SM_PARTIAL_STRIDE, sizeof(double));
+        if (!ws.partial) ws.threads = 1;
+
+        double spare[SM_PARTIAL_STRIDE];
+        if (!ws.partial) ws.partial = spare;
+
+        run_kernel(&ws, OP_SPMV_DOT, NULL, NULL);
+
+        if (ws.partial != spare) free(ws.partial);
+}
+
+
+/*
+ * Function: csr_solve_cg
+ * ----------------------------
+ * Solves Ax = b with the preconditioned Conjugate Gradient method.
+ *
+ * @param A - Pointer to the square, symmetric positive definite CSR matrix.
+ * @param b - Right-hand side.
+ * @param x - Initial guess on entry, solution on return.
+ * @param opts - Solver parameters, or NULL for the defaults.
+ * @param result - Output outcome of the solve, or NULL if not needed.
+ *
+ * @return true if the solve ran, false on invalid input or allocation failure.
+ */
+bool csr_solve_cg(csr_matrix* A, const double* b, double* x, const sm_solver_options* opts, sm_solver_result* result) {
+        sm_solver_options defaults;
+        if (!opts) {
+                default_solver_options(&defaults);
+                opts = &defaults;
+        }
+
+        // Without a preconditioner z is r itself
+        bool precond = opts->precond != SM_PRECOND_NONE;
+        sm_workspace ws;
+        double** vectors[] = { &ws.r, &ws.p, &ws.q, &ws.z };
+        if (!setup_workspace(&ws, A, b, x, opts, vectors, precond ? 4 : 3)) {
+                free_workspace(&ws);
+                return false;
+        }
+        if (!precond) ws.z = ws.r;
+
+        double rr, bb;
+        run_kernel(&ws, OP_RESIDUAL, &rr, &bb);
+        double bnorm = sqrt(bb);
+        double limit = opts->tolerance * (bnorm > 0 ? bnorm : 1);
+        uint32_t iterations = 0;
+
+        double rz = rr;
+        if (opts->precond == SM_PRECOND_JACOBI) {
+                for (uint64_t i = 0; i < ws.n; i++) ws.z[i] = ws.r[i] * ws.dinv[i];
+                run_kernel(&ws, OP_DOT, &rz, NULL);
+        } else if (opts->precond == SM_PRECOND_ILU0) {
+                apply_ilu0(&ws, ws.r, ws.z);
+                run_kernel(&ws, OP_DOT, &rz, NULL);
+        }
+        memcpy(ws.p, ws.z, ws.n * sizeof(double));
+
+        while (sqrt(rr) > limit && iterations < opts->max_iterations && rz != 0) {
+                double pq;
+                ws.in = ws.p;
+                ws.out = ws.q;
+                ws.w = ws.p;
+                run_kernel(&ws, OP_SPMV_DOT, &pq, NULL);
+                if (pq == 0) break;
+
+                ws.alpha = rz / pq;
+                double rz_next;
+                run_kernel(&ws, OP_CG_UPDATE, &rz_next, &rr);
+                iterations++;
+
+                if (sqrt(rr) <= limit) break;
+
+                if (opts->precond == SM_PRECOND_ILU0) {
+                        apply_ilu0(&ws, ws.r, ws.z);
+                        run_kernel(&ws, OP_DOT, &rz_next, NULL);
+                }
+
+                ws.beta = rz_next / rz;
+                rz = rz_next;
+                run_kernel(&ws, OP_CG_DIRECTION, NULL, NULL);
+        }
+
+        set_result(result, iterations, rr, bnorm, opts->tolerance);
+        free_workspace(&ws);
+
+        return true;
+}
+
+
+/*
+ * Function: csr_solve_bicgstab
+ * ----------------------------
+ * Solves Ax = b with the right-preconditioned BiCGSTAB method.
+ *
+ * @param A - Pointer to the square CSR matrix.
+ * @param b - Right-hand side.
+ * @param x - Initial guess on entry, solution on return.
+ * @param opts - Solver parameters, or NULL for the defaults.
+ * @param result - Output outcome of the solve, or NULL if not needed.
+ *
+ * @return true if the solve ran, false on invalid input or allocation failure.
+ */
+bool csr_solve_bicgstab(csr_matrix* A, const double* b, double* x, const sm_solver_options* opts, sm_solver_result* result) {
+        sm_solver_options defaults;
+        if (!opts) {
+                default_solver_options(&defaults);
+                opts = &defaults;
+        }
+
+        // Without a preconditioner phat and shat are p and s themselves
+        bool precond = opts->precond != SM_PRECOND_NONE;
+        sm_workspace ws;
+        double** vectors[] = { &ws.r, &ws.p, &ws.q, &ws.rhat, &ws.s, &ws.t, &ws.phat, &ws.shat };
+        if (!setup_workspace(&ws, A, b, x, opts, vectors, precond ? 8 : 6)) {
+                free_workspace(&ws);
+                return false;
+        }
+        if (!precond) {
+                ws.phat = ws.p;
+                ws.shat = ws.s;
+        }
+
+        double rr, bb;
+        run_kernel(&ws, OP_RESIDUAL, &rr, &bb);
+        double bnorm = sqrt(bb);
+        double limit = opts->tolerance * (bnorm > 0 ? bnorm : 1);
+        uint32_t iterations = 0;
+
+        memcpy(ws.rhat, ws.r, ws.n * sizeof(double));
+        double rho = 1, alpha = 1, omega = 1;
+        double rho_next = rr;
+
+        while (sqrt(rr) > limit && iterations < opts->max_iterations && rho_next != 0) {
+                ws.beta = (rho_next / rho) * (alpha / omega);
+                ws.omega = omega;
+                run_kernel(&ws, OP_BICG_DIRECTION, NULL, NULL);
+                if (opts->precond == SM_PRECOND_ILU0) apply_ilu0(&ws, ws.p, ws.phat);
+
+                double rv;
+                ws.in = ws.phat;
+                ws.out = ws.q;
+                ws.w = ws.rhat;
+                run_kernel(&ws, OP_SPMV_DOT, &rv, NULL);
+                if (rv == 0) break;
+
+                alpha = rho_next / rv;
+                ws.alpha = alpha;
+
+                double ss;
+                run_kernel(&ws, OP_BICG_S, &ss, NULL);
+                iterations++;
+
+                if (sqrt(ss) <= limit) {
+                        run_kernel(&ws, OP_AXPY, NULL, NULL);
+                        rr = ss;
+                        break;
+                }
+
+                if (opts->precond == SM_PRECOND_ILU0) apply_ilu0(&ws, ws.s, ws.shat);
+
+                double ts, tt;
+                ws.in = ws.shat;
+                ws.out = ws.t;
+                ws.w = ws.s;
+                run_kernel(&ws, OP_SPMV_DOT, &ts, &tt);
+                if (tt == 0) {
+                        run_kernel(&ws, OP_AXPY, NULL, NULL);
+                        rr = ss;
+                        break;
+                }
+
+                omega = ts / tt;
+                ws.omega = omega;
+                rho = rho_next;
+                run_kernel(&ws, OP_BICG_UPDATE, &rr, &rho_next);
+                if (omega == 0) break;
+        }
+
+        set_result(result, iterations, rr, bnorm, opts->tolerance);
+        free_workspace(&ws);
+
+        return true;
+}
+
+
+/*
+ * Function: solve_cg
+ * ----------------------------
+ * Solves Mx = b with Conjugate Gradient, converting the linked matrix to CSR first.
+ *
+ * @param M - Pointer to the matrix.
+ * @param b - Right-hand side.
+ * @param x - Initial guess on entry, solution on return.
+ * @param opts - Solver parameters, or NULL for the defaults.
+ * @param result - Output outcome of the solve, or NULL if not needed.
+ *
+ * @return true if the solve ran, false otherwise.
+ */
+bool solve_cg(matrix* M, const double* b, double* x, const sm_solver_options* opts, sm_solver_result* result) {
+        csr_matrix* A = csr_from_S_Matrix(M);
+        if (!A) return false;
+
+        bool ok = csr_solve_cg(A, b, x, opts, result);
+        free_csr_matrix(A);
+
+        return ok;
+}
+
+
+/*
+ * Function: solve_bicgstab
+ * ----------------------------
+ * Solves Mx = b with BiCGSTAB, converting the linked matrix to CSR first.
+ *
+ * @param M - Pointer to the matrix.
+ * @param b - Right-hand side.
+ * @param x - Initial guess on entry, solution on return.
+ * @param opts - Solver parameters, or NULL for the defaults.
+ * @param result - Output outcome of the solve, or NULL if not needed.
+ *
+ * @return true if the solve ran, false otherwise.
+ */
+bool solve_bicgstab(matrix* M, const double* b, double* x, const sm_solver_options* opts, sm_solver_result* result) {
+        csr_matrix* A = csr_from_S_Matrix(M);
+        if (!A) return false;
+
+        bool ok = csr_solve_bicgstab(A, b, x, opts, result);
+        free_csr_matrix(A);
+
+        return ok;
+}
@@ -0,0 +1,292 @@
+/*
+ * File Name: S_Matrix_spmm.c
+ * Authors: Arpit Patel, Dharm KaPatel
+ * Date: 2025-03-19
+ * Description: This file implements the sparse times dense multi-vector products (SpMM).
+ *              The kernel uses GCC vector types, so the slices map to whatever SIMD width the
+ *              target supports without intrinsics.
+ */
+
+
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdatomic.h>
+
+
+#include "../include/S_Matrix_spmm.h"
+#include "../include/S_Matrix_parallel.h"
+
+
+// One SIMD slice of the vectors; only element alignment is assumed so any k is allowed
+typedef double sm_slice __attribute__((vector_size(SM_SPMM_LANES * sizeof(double)), aligned(sizeof(double))));
+
+
+/*
+ * Function: spmm_row
+ * ----------------------------
+ * Computes one row of Y = A X from the row's non-zeros.
+ *
+ * @param cols - Column indices (1-based) of the row.
+ * @param values - Values of the row.
+ * @param nnz - Number of non-zeros in the row.
+ * @param X - Input block, row-major with k entries per row; row c - 1 belongs to column c.
+ * @param k - Number of vectors.
+ * @param y - Output row of k entries; overwritten, so an empty row yields zeros.
+ *
+ * Description:
+ *   Columns of the block are processed SM_SPMM_BLOCK slices at a time with the partial
+ *   sums in registers; a narrower pass and a scalar tail handle the remainder. Slices are
+ *   loaded with element alignment only, so X and y need no SIMD alignment.
+ */
+static void spmm_row(const uint32_t* cols, const double* values, uint64_t nnz, const double* X, uint32_t k, double* y) {
+        uint32_t j = 0;
+
+        for (; j + SM_SPMM_BLOCK * SM_SPMM_LANES <= k; j += SM_SPMM_BLOCK * SM_SPMM_LANES) {
+                sm_slice acc[SM_SPMM_BLOCK];
+                memset(acc, 0, sizeof(acc));
+
+                for (uint64_t p = 0; p < nnz; p++) {
+                        const double* x = X + (size_t)(cols[p] - 1) * k + j;
+                        double v = values[p];
+                        for (int b = 0; b < SM_SPMM_BLOCK; b++) {
+                                acc[b] += v * *(const sm_slice*)(x + b * SM_SPMM_LANES);
+                        }
+                }
+
+                for (int b = 0; b < SM_SPMM_BLOCK; b++) {
+                        *(sm_slice*)(y + j + b * SM_SPMM_LANES) = acc[b];
+                }
+        }
+
+        for (; j + SM_SPMM_LANES <= k; j += SM_SPMM_LANES) {
+                sm_slice acc = { 0 };
+                for (uint64_t p = 0; p < nnz; p++) {
+                        acc += values[p] * *(const sm_slice*)(X + (size_t)(cols[p] - 1) * k + j);
+                }
+                *(sm_slice*)(y + j) = acc;
+        }
+
+        if (j < k) {
+                double acc[SM_SPMM_LANES] = { 0 };
+                uint32_t tail = k - j;
+                for (uint64_t p = 0; p < nnz; p++) {
+                        const double* x = X + (size_t)(cols[p] - 1) * k + j;
+                        for (uint32_t b = 0; b < tail; b++) {
+                                acc[b] += values[p] * x[b];
+                        }
+                }
+                memcpy(y + j, acc, tail * sizeof(double));
+        }
+}
+
+
+/*
+ * Struct: spmm_job
+ * ----------------------------
+ * Arguments shared by the threads of one product.
+ *
+ * A: CSR source, or NULL.
+ * rows: Row chain heads of a linked source, or NULL.
+ * F: File-backed source, or NULL.
+ * X: Input block.
+ * k: Number of vectors.
+ * Y: Output block.
+ * failed: Set by a thread that could not allocate its gather buffer.
+ */
+typedef struct spmm_job {
+        csr_matrix* A;
+        m_node** rows;
+        mm_matrix* F;
+        const double* X;
+        uint32_t k;
+        double* Y;
+        atomic_bool failed;
+} spmm_job;
+
+
+/*
+ * Function: csr_range
+ * ----------------------------
+ * Work function of csr_spmm; computes rows begin .. end - 1 straight from the CSR arrays.
+ *
+ * @param begin - First row (0-based).
+ * @param end - One past the last row.
+ * @param thread - Unused.
+ * @param ctx - Pointer to the spmm_job; A is set.
+ */
+static void csr_range(uint64_t begin, uint64_t end, uint32_t thread, void* ctx) {
+        spmm_job* job = (spmm_job*)ctx;
+        csr_matrix* A = job->A;
+        (void)thread;
+
+        for (uint64_t i = begin; i < end; i++) {
+                uint64_t start = A->row_ptr[i];
+                spmm_row(A->col_idx + start, A->values + start, A->row_ptr[i + 1] - start, job->X, job->k, job->Y + i * job->k);
+        }
+}
+
+
+/*
+ * Function: chain_range
+ * ----------------------------
+ * Work function of spmm_S_Matrix. Each row chain is first gathered into a per-thread pair of
+ * arrays, so the kernel reads contiguous memory instead of chasing pointers once per slice.
+ *
+ * @param begin - First row (0-based).
+ * @param end - One past the last row.
+ * @param thread - Unused.
+ * @param ctx - Pointer to the spmm_job; rows is set.
+ *
+ * Description:
+ *   The gather arrays start at 64 entries and double as needed. If an allocation fails the
+ *   thread stops, leaves its remaining rows of Y unwritten and sets job->failed.
+ */
+static void chain_range(uint64_t begin, uint64_t end, uint32_t thread, void* ctx) {
+        spmm_job* job = (spmm_job*)ctx;
+        (void)thread;
+
+        uint64_t capacity = 64;
+        uint32_t* cols = (uint32_t*)malloc(capacity * sizeof(uint32_t));
+        double* values = (double*)malloc(capacity * sizeof(double));
+        bool ok = cols && values;
+
+        for (uint64_t i = begin; i < end && ok; i++) {
+                uint64_t nnz = 0;
+                for (m_node* node = job->rows[i]; node && ok; node = node->row_ptr) {
+                        if (nnz == capacity) {
+                                capacity *= 2;
+                                uint32_t* grown_cols = (uint32_t*)realloc(cols, capacity * sizeof(uint32_t));
+                                if (grown_cols) cols = grown_cols;
+                                double* grown_values = (double*)realloc(values, capacity * sizeof(double));
+                                if (grown_values) values = grown_values;
+                                ok = grown_cols && grown_values;
+                                if (!ok) break;
+                        }
+                        cols[nnz] = node->column;
+                        values[nnz] = node->value;
+                        nnz++;
+                }
+
+                if (ok) spmm_row(cols, values, nnz, job->X, job->k, job->Y + i * job->k);
+        }
+
+        if (!ok) atomic_store(&job->failed, true);
+        free(cols);
+        free(values);
+}
+
+
+/*
+ * Function: mm_range
+ * ----------------------------
+ * Work function of mm_spmm. The rows of the chunk are prefetched first, then each one is
+ * read in place from the mapping.
+ *
+ * @param begin - First row (0-based).
+ * @param end - One past the last row.
+ * @param thread - Unused.
+ * @param ctx - Pointer to the spmm_job; F is set.
+ */
+static void mm_range(uint64_t begin, uint64_t end, uint32_t thread, void* ctx) {
+        spmm_job* job = (spmm_job*)ctx;
+        (void)thread;
+
+        if (end > begin) mm_prefetch_rows(job->F, (uint32_t)begin + 1, (uint32_t)end);
+
+        for (uint64_t i = begin; i < end; i++) {
+                const uint32_t* cols = NULL;
+                const double* values = NULL;
+                uint32_t nnz = mm_row(job->F, (uint32_t)(i + 1), &cols, &values);
+                spmm_row(cols, values, nnz, job->X, job->k, job->Y + i * job->k);
+        }
+}
+
+
+/*
+ * Function: csr_spmm
+ * ----------------------------
+ * Multiplies a CSR matrix by a dense block of vectors, Y = A X.
+ *
+ * @param A - Pointer to the CSR matrix.
+ * @param X - Input block, A->col rows of k entries.
+ * @param k - Number of vectors.
+ * @param Y - Output block, A->row rows of k entries; overwritten.
+ * @param threads - Number of threads, or 0 for one per online CPU.
+ *
+ * @return true on success, false on invalid input.
+ */
+bool csr_spmm(csr_matrix* A, const double* X, uint32_t k, double* Y, uint32_t threads) {
+        if (!A || !X || !Y) return false;
+
+        spmm_job job = { .A = A, .X = X, .k = k, .Y = Y };
+        sm_parallel_for(A->row, sm_thread_count(threads), csr_range, &job);
+
+        return true;
+}
+
+
+/*
+ * Function: spmm_S_Matrix
+ * ----------------------------
+ * Multiplies a linked matrix by a dense block of vectors, Y = M X.
+ *
+ * @param M - Pointer to the matrix.
+ * @param X - Input block, M->col rows of k entries.
+ * @param k - Number of vectors.
+ * @param Y - Output block, M->row rows of k entries; overwritten.
+ * @param threads - Number of threads, or 0 for one per online CPU.
+ *
+ * @return true on success, false on invalid input or allocation failure.
+ *
+ * Description:
+ *   A symmetric matrix is multiplied through its CSR form, which holds both triangles.
+ */
+bool spmm_S_Matrix(matrix* M, const double* X, uint32_t k, double* Y, uint32_t threads) {
+        if (!M || !X || !Y) return false;
+
+        if (M->symmetric) {
+                csr_matrix* A = csr_from_S_Matrix(M);
+                bool ok = csr_spmm(A, X, k, Y, threads);
+                free_csr_matrix(A);
+                return ok;
+        }
+
+        m_node** rows = (m_node**)calloc(M->row ? M->row : 1, sizeof(m_node*));
+        if (!rows) return false;
+
+        for (uint32_t index = 0; index < M->row; index++) {
+                rows[index] = header_chain(M->rowList, index + 1);
+        }
+
+        spmm_job job = { .rows = rows, .X = X, .k = k, .Y = Y };
+        sm_parallel_for(M->row, sm_thread_count(threads), chain_range, &job);
+
+        free(rows);
+        return !atomic_load(&job.failed);
+}
+
+
+/*
+ * Function: mm_spmm
+ * ----------------------------
+ * Multiplies a file-backed matrix by a dense block of vectors, Y = F X.
+ *
+ * @param F - Pointer to the file-backed matrix.
+ * @param X - Input block, mm_columns(F) rows of k entries.
+ * @param k - Number of vectors.
+ * @param Y - Output block, mm_rows(F) rows of k entries; overwritten.
+ * @param threads - Number of threads, or 0 for one per online CPU.
+ *
+ * @return true on success, false on invalid input.
+ */
+bool mm_spmm(mm_matrix* F, const double* X, uint32_t k, double* Y, uint32_t threads) {
+        if (!F || !X || !Y) return false;
+
+        spmm_job job = { .F = F, .X = X, .k = k, .Y = Y };
+        sm_parallel_for(mm_rows(F), sm_thread_count(threads), mm_range, &job);
+
+        return true;
+}
@@ -0,0 +1,74 @@
+/*
+ * File Name: S_Matrix_typed.c
+ * Authors: Arpit Patel, Dharm KaPatel
+ * Date: 2025-03-19
+ * Description: This file instantiates the type-specialized S_Matrix variants declared in
+ *              S_Matrix_typed.h. Each variant is compiled from the same template with its
+ *              value and index types fixed, so the inner loops have no runtime dispatch.
+ */
+
+
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+
+#include "../include/S_Matrix_typed.h"
+
+
+/*
+ * Function: fail
+ * ----------------------------
+ * Reports an error to the trace hook of the matrix library and returns it.
+ *
+ * @param function - Name of the failing function.
+ * @param status - The error.
+ *
+ * @return status.
+ */
+static sm_status fail(const char* function, sm_status status) {
+        return sm_fail(function, status);
+}
+
+
+#define SM_SUFFIX f32_u32
+#define SM_VALUE_T float
+#define SM_INDEX_T uint32_t
+#define SM_INDEX_MAX UINT32_MAX
+#include "S_Matrix_typed_impl.h"
+#undef SM_SUFFIX
+#undef SM_VALUE_T
+#undef SM_INDEX_T
+#undef SM_INDEX_MAX
+
+#define SM_SUFFIX f64_u32
+#define SM_VALUE_T double
+#define SM_INDEX_T uint32_t
+#define SM_INDEX_MAX UINT32_MAX
+#include "S_Matrix_typed_impl.h"
+#undef SM_SUFFIX
+#undef SM_VALUE_T
+#undef SM_INDEX_T
+#undef SM_INDEX_MAX
+
+#define SM_SUFFIX f32_u64
+#define SM_VALUE_T float
+#define SM_INDEX_T uint64_t
+#define SM_INDEX_MAX UINT64_MAX
+#include "S_Matrix_typed_impl.h"
+#undef SM_SUFFIX
+#undef SM_VALUE_T
+#undef SM_INDEX_T
+#undef SM_INDEX_MAX
+
+#define SM_SUFFIX f64_u64
+#define SM_VALUE_T double
+#define SM_INDEX_T uint64_t
+#define SM_INDEX_MAX UINT64_MAX
+#include "S_Matrix_typed_impl.h"
+#undef SM_SUFFIX
+#undef SM_VALUE_T
+#undef SM_INDEX_T
+#undef SM_INDEX_MAX
@@ -0,0 +1,387 @@
+/*
+ * File Name: S_Matrix_typed_impl.h
+ * Authors: Arpit Patel, Dharm KaPatel
+ * Date: 2025-03-19
+ * Description: Implementation template for one type-specialized S_Matrix variant.
+ *              Do not include directly; S_Matrix_typed.c includes it once per variant
+ *              with SM_SUFFIX, SM_VALUE_T, SM_INDEX_T and SM_INDEX_MAX defined.
+ *              SM_INDEX_MAX must be a preprocessor constant so that it can be used in #if.
+ */
+
+
+#if !defined(SM_SUFFIX) || !defined(SM_VALUE_T) || !defined(SM_INDEX_T) || !defined(SM_INDEX_MAX)
+#error "S_Matrix_typed_impl.h needs SM_SUFFIX, SM_VALUE_T, SM_INDEX_T and SM_INDEX_MAX"
+#endif
+
+
+#define SM_NODE SM_NAME(m_node)
+#define SM_MATRIX SM_NAME(S_Matrix)
+
+// Largest index a head array can cover; it holds index + 1 entries, which must fit in size_t bytes
+#define SM_HEADS_MAX ((uint64_t)SIZE_MAX / sizeof(SM_INDEX_T) - 1)
+
+// An index type this far below SIZE_MAX can not overflow a head array or the pool, so the
+// size checks against SIZE_MAX are left out (they would always be false)
+#if SM_INDEX_MAX > SIZE_MAX / 1024
+#define SM_CHECK_BYTES 1
+#else
+#define SM_CHECK_BYTES 0
+#endif
+
+
+/*
+ * Function: sm_grow_heads_<suffix>
+ * ----------------------------
+ * Makes sure the row and column head arrays cover the given row and column.
+ *
+ * @param M - Pointer to the matrix.
+ * @param row - Row index that must be addressable.
+ * @param column - Column index that must be addressable.
+ *
+ * @return true on success, false if the arrays can not be that large or allocation fails.
+ */
+static bool SM_NAME(sm_grow_heads)(SM_MATRIX* M, SM_INDEX_T row, SM_INDEX_T column) {
+        if (row > M->row_cap) {
+                SM_INDEX_T new_cap = (M->row_cap > M->row / 2) ? M->row : M->row_cap * 2;
+                if (new_cap < row) new_cap = row;
+#if SM_CHECK_BYTES
+                if (new_cap > SM_HEADS_MAX) return false;
+#endif
+
+                SM_INDEX_T* heads = (SM_INDEX_T*)realloc(M->row_heads, ((size_t)new_cap + 1) * sizeof(SM_INDEX_T));
+                if (!heads) return false;
+
+                for (SM_INDEX_T i = M->row_cap + 1; i <= new_cap; i++) heads[i] = 0;
+                M->row_heads = heads;
+                M->row_cap = new_cap;
+        }
+
+        if (column > M->col_cap) {
+                SM_INDEX_T new_cap = (M->col_cap > M->col / 2) ? M->col : M->col_cap * 2;
+                if (new_cap < column) new_cap = column;
+#if SM_CHECK_BYTES
+                if (new_cap > SM_HEADS_MAX) return false;
+#endif
+
+                SM_INDEX_T* heads = (SM_INDEX_T*)realloc(M->col_heads, ((size_t)new_cap + 1) * sizeof(SM_INDEX_T));
+                if (!heads) return false;
+
+                for (SM_INDEX_T i = M->col_cap + 1; i <= new_cap; i++) heads[i] = 0;
+                M->col_heads = heads;
+                M->col_cap = new_cap;
+        }
+
+        return true;
+}
+
+
+/*
+ * Function: sm_alloc_node_<suffix>
+ * ----------------------------
+ * Takes the next free slot from the node pool, doubling the pool when it is full.
+ *
+ * @param M - Pointer to the matrix.
+ *
+ * @return Slot of the new node, or 0 if allocation fails.
+ */
+static SM_INDEX_T SM_NAME(sm_alloc_node)(SM_MATRIX* M) {
+        if (M->pool_size == M->pool_cap) {
+                if (M->pool_cap > SM_INDEX_MAX / 2) return 0;
+#if SM_CHECK_BYTES
+                if (M->pool_cap > SIZE_MAX / sizeof(SM_NODE) / 2) return 0;
+#endif
+
+                SM_INDEX_T new_cap = M->pool_cap * 2;
+                SM_NODE* pool = (SM_NODE*)realloc(M->pool, (size_t)new_cap * sizeof(SM_NODE));
+                if (!pool) return 0;
+
+                M->pool = pool;
+                M->pool_cap = new_cap;
+        }
+
+        return M->pool_size++;
+}
+
+
+/*
+ * Function: create_S_Matrix_<suffix>
+ * ----------------------------
+ * Creates an empty matrix with a small node pool. The head arrays start with only the unused
+ * slot 0 and grow on the first insert into a row or column.
+ *
+ * @param rows - Number of rows.
+ * @param columns - Number of columns.
+ *
+ * @return Pointer to the new matrix, or NULL if allocation fails.
+ */
+SM_MATRIX* SM_NAME(create_S_Matrix)(SM_INDEX_T rows, SM_INDEX_T columns) {
+        SM_MATRIX* M = (SM_MATRIX*)malloc(sizeof(SM_MATRIX));
+        if (M == NULL) return NULL;
+
+        M->row = rows;
+        M->col = columns;
+        M->row_cap = 0;
+        M->col_cap = 0;
+        M->pool_size = 1;
+        M->pool_cap = 16;
+
+        M->pool = (SM_NODE*)malloc((size_t)M->pool_cap * sizeof(SM_NODE));
+        M->row_heads = (SM_INDEX_T*)calloc(1, sizeof(SM_INDEX_T));
+        M->col_heads = (SM_INDEX_T*)calloc(1, sizeof(SM_INDEX_T));
+
+        if (!M->pool || !M->row_heads || !M->col_heads) {
+                free(M->pool);
+                free(M->row_heads);
+                free(M->col_heads);
+                free(M);
+                return NULL;
+        }
+
+        return M;
+}
+
+
+/*
+ * Function: insert_data_<suffix>
+ * ----------------------------
+ * Inserts a value, or overwrites the value already stored at that position.
+ *
+ * @param M - Pointer to the matrix.
+ * @param row - Row index, from 1 to M->row.
+ * @param column - Column index, from 1 to M->col.
+ * @param value - Value to store; must not be zero.
+ *
+ * @return SM_OK on success, SM_ERR_NOT_CREATED, SM_ERR_ZERO_VALUE, SM_ERR_OUT_OF_BOUNDS or
+ *         SM_ERR_NO_MEMORY otherwise.
+ */
+sm_status SM_NAME(insert_data)(SM_MATRIX* M, SM_INDEX_T row, SM_INDEX_T column, SM_VALUE_T value) {
+        if (!M) {
+                return fail(__func__, SM_ERR_NOT_CREATED);
+        }
+
+        if (value == 0) {
+                return fail(__func__, SM_ERR_ZERO_VALUE);
+        }
+
+        if (row > M->row || row < 1 || column > M->col || column < 1) {
+                return fail(__func__, SM_ERR_OUT_OF_BOUNDS);
+        }
+
+        if (!SM_NAME(sm_grow_heads)(M, row, column)) {
+                return fail(__func__, SM_ERR_NO_MEMORY);
+        }
+
+        // Find the position in the row chain, updating in place if the node exists
+        SM_INDEX_T prev_row = 0;
+        SM_INDEX_T cur = M->row_heads[row];
+        while (cur && M->pool[cur].column < column) {
+                prev_row = cur;
+                cur = M->pool[cur].row_ptr;
+        }
+
+        if (cur && M->pool[cur].column == column) {
+                M->pool[cur].value = value;
+                return SM_OK;
+        }
+        SM_INDEX_T next_row = cur;
+
+        // Find the position in the column chain
+        SM_INDEX_T prev_col = 0;
+        cur = M->col_heads[column];
+        while (cur && M->pool[cur].row < row) {
+                prev_col = cur;
+                cur = M->pool[cur].col_ptr;
+        }
+        SM_INDEX_T next_col = cur;
+
+        SM_INDEX_T slot = SM_NAME(sm_alloc_node)(M);
+        if (!slot) {
+                return fail(__func__, SM_ERR_NO_MEMORY);
+        }
+
+        SM_NODE* node = &M->pool[slot];
+        node->row = row;
+        node->column = column;
+        node->value = value;
+        node->row_ptr = next_row;
+        node->col_ptr = next_col;
+
+        if (prev_row) {
+                M->pool[prev_row].row_ptr = slot;
+        } else {
+                M->row_heads[row] = slot;
+        }
+
+        if (prev_col) {
+                M->pool[prev_col].col_ptr = slot;
+        } else {
+                M->col_heads[column] = slot;
+        }
+
+        return SM_OK;
+}
+
+
+/*
+ * Function: duplicatevalue_<suffix>
+ * ----------------------------
+ * Checks whether the matrix stores the given value anywhere.
+ *
+ * @param M - Pointer to the matrix.
+ * @param value - Value to look for; must not be zero.
+ * @param found - Set to true if the value is stored, false otherwise.
+ *
+ * @return SM_OK on success, SM_ERR_INVALID_ARG, SM_ERR_NOT_CREATED or SM_ERR_ZERO_VALUE otherwise.
+ */
+sm_status SM_NAME(duplicatevalue)(SM_MATRIX* M, SM_VALUE_T value, bool* found) {
+        if (!found) {
+                return fail(__func__, SM_ERR_INVALID_ARG);
+        }
+        *found = false;
+
+        if (!M) {
+                return fail(__func__, SM_ERR_NOT_CREATED);
+        }
+
+        if (value == 0) {
+                return fail(__func__, SM_ERR_ZERO_VALUE);
+        }
+
+        // Every used slot is a live element, so the pool can be scanned front to back
+        for (SM_INDEX_T slot = 1; slot < M->pool_size; slot++) {
+                if (M->pool[slot].value == value) {
+                        *found = true;
+                        return SM_OK;
+                }
+        }
+
+        return SM_OK;
+}
+
+
+/*
+ * Function: resize_<suffix>
+ * ----------------------------
+ * Doubles the number of rows and columns. Only the dimensions change; the head arrays grow
+ * when an insert first reaches the new rows and columns.
+ *
+ * @param M - Pointer to the matrix.
+ *
+ * @return SM_OK on success, SM_ERR_NOT_CREATED or SM_ERR_OVERFLOW if a doubled dimension does
+ *         not fit the index type.
+ */
+sm_status SM_NAME(resize)(SM_MATRIX* M) {
+        if (!M) {
+                return fail(__func__, SM_ERR_NOT_CREATED);
+        }
+
+        if (M->row > SM_INDEX_MAX / 2 || M->col > SM_INDEX_MAX / 2) {
+                return fail(__func__, SM_ERR_OVERFLOW);
+        }
+
+        M->row *= 2;
+        M->col *= 2;
+
+        return SM_OK;
+}
+
+
+/*
+ * Function: transpose_<suffix>
+ * ----------------------------
+ * Transposes the matrix in place by swapping the head arrays and, in every node, the row and
+ * column and the two chain links.
+ *
+ * @param M - Pointer to the matrix.
+ *
+ * @return SM_OK on success, SM_ERR_NOT_CREATED if M is NULL.
+ */
+sm_status SM_NAME(transpose)(SM_MATRIX* M) {
+        if (!M) {
+                return fail(__func__, SM_ERR_NOT_CREATED);
+        }
+
+        SM_INDEX_T temp_size = M->row;
+        M->row = M->col;
+        M->col = temp_size;
+
+        temp_size = M->row_cap;
+        M->row_cap = M->col_cap;
+        M->col_cap = temp_size;
+
+        SM_INDEX_T* temp_heads = M->row_heads;
+        M->row_heads = M->col_heads;
+        M->col_heads = temp_heads;
+
+        for (SM_INDEX_T slot = 1; slot < M->pool_size; slot++) {
+                SM_NODE* node = &M->pool[slot];
+
+                // Swap row and column of each node
+                SM_INDEX_T temp_val = node->row;
+                node->row = node->column;
+                node->column = temp_val;
+
+                // Swap row_ptr and col_ptr of each node
+                SM_INDEX_T temp_ptr = node->row_ptr;
+                node->row_ptr = node->col_ptr;
+                node->col_ptr = temp_ptr;
+        }
+
+        return SM_OK;
+}
+
+
+/*
+ * Function: displayMatrix_<suffix>
+ * ----------------------------
+ * Prints the matrix in dense form, zeros included.
+ *
+ * @param M - Pointer to the matrix, or NULL.
+ */
+void SM_NAME(displayMatrix)(SM_MATRIX* M) {
+        printf("\n--------Current Matrix--------\n");
+        if (!M) {
+                printf("Not Created\n");
+                return;
+        }
+
+        for (SM_INDEX_T row_index = 1; row_index <= M->row; row_index++) {
+                SM_INDEX_T cur = (row_index <= M->row_cap) ? M->row_heads[row_index] : 0;
+
+                for (SM_INDEX_T col_index = 1; col_index <= M->col; col_index++) {
+                        if (cur && M->pool[cur].column == col_index) {
+                                printf("%6.1f", (double)M->pool[cur].value);
+                                cur = M->pool[cur].row_ptr;
+                        } else {
+                                printf("%6.1f", 0.0);
+                        }
+                }
+
+                printf("\n");
+        }
+}
+
+
+/*
+ * Function: free_S_Matrix_<suffix>
+ * ----------------------------
+ * Frees the node pool, the head arrays and the matrix.
+ *
+ * @param M - Pointer to the matrix, or NULL.
+ */
+void SM_NAME(free_S_Matrix)(SM_MATRIX* M) {
+        if (!M) {
+                return;
+        }
+
+        free(M->pool);
+        free(M->row_heads);
+        free(M->col_heads);
+        free(M);
+}
+
+
+#undef SM_NODE
+#undef SM_MATRIX
+#undef SM_HEADS_MAX
+#undef SM_CHECK_BYTES
@@ -0,0 +1,508 @@
+/*
+ * File Name: S_Matrix_view.c
+ * Authors: Arpit Patel, Dharm KaPatel
+ * Date: 2025-03-19
+ * Description: This file implements the zero-copy submatrix views of the S_Matrix data structure.
+ *              Selected rows are reached directly through the header blocks, and the column
+ *              selection is applied while walking each row chain.
+ */
+
+
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+
+#include "../include/S_Matrix_view.h"
+
+
+/*
+ * Function: create_view
+ * ----------------------------
+ * Allocates a view of a matrix with both selections empty; the caller fills them in.
+ *
+ * @param M - Pointer to the matrix.
+ *
+ * @return Pointer to the view, or NULL if allocation fails.
+ */
+static sm_view* create_view(matrix* M) {
+        sm_view* V = (sm_view*)calloc(1, sizeof(sm_view));
+        if (V) V->M = M;
+        return V;
+}
+
+
+/*
+ * Function: copy_index_set
+ * ----------------------------
+ * Fills an index map from a caller's set, or with the full range when the set is NULL.
+ *
+ * @param map - Pointer to the index map to fill in.
+ * @param set - Selected indices, or NULL.
+ * @param count - Number of selected indices.
+ * @param limit - Largest valid index.
+ *
+ * @return true on success, false if the set is empty, unsorted, out of bounds or allocation fails.
+ */
+static bool copy_index_set(sm_index_map* map, const uint32_t* set, uint32_t count, uint32_t limit) {
+        if (!set) {
+                map->first = 1;
+                map->count = limit;
+                return limit > 0;
+        }
+
+        if (count == 0) return false;
+        for (uint32_t k = 0; k < count; k++) {
+                if (set[k] < 1 || set[k] > limit) return false;
+                if (k > 0 && set[k] <= set[k - 1]) return false;
+        }
+
+        map->set = (uint32_t*)malloc(count * sizeof(uint32_t));
+        if (!map->set) return false;
+
+        memcpy(map->set, set, count * sizeof(uint32_t));
+        map->first = set[0];
+        map->count = count;
+
+        return true;
+}
+
+
+/*
+ * Function: base_index
+ * ----------------------------
+ * Translates a view index back into a matrix index: the index-th entry of the set, or the
+ * index-th index of the range.
+ *
+ * @param map - Row or column selection of the view.
+ * @param index - View index, from 1 to map->count; not checked.
+ *
+ * @return The matrix index.
+ */
+static uint32_t base_index(const sm_index_map* map, uint32_t index) {
+        return map->set ? map->set[index - 1] : map->first + index - 1;
+}
+
+
+/*
+ * Function: map_column
+ * ----------------------------
+ * Translates a matrix column into view coordinates while walking a row in column order.
+ *
+ * @param cols - Column selection of the view.
+ * @param column - Column of the current node.
+ * @param cursor - Position in the set where the search resumes; start it at 0 for each row.
+ *                 Unused for a range selection.
+ *
+ * @return The view column, 0 if the column is not selected, or UINT32_MAX if no later
+ *         column of the row can be selected.
+ *
+ * Description:
+ *   The calls for one row must pass increasing columns. The cursor then only moves forward:
+ *   each call binary-searches the rest of the set, and a match moves the cursor past it, so
+ *   walking a row costs O(nnz log count) at worst and the search space shrinks as it goes.
+ *   UINT32_MAX lets the caller stop walking the chain early.
+ */
+static uint32_t map_column(const sm_index_map* cols, uint32_t column, uint32_t* cursor) {
+        if (!cols->set) {
+                if (column < cols->first) return 0;
+                if (column - cols->first >= cols->count) return UINT32_MAX;
+                return column - cols->first + 1;
+        }
+
+        // Lower bound of column in set[*cursor .. count)
+        uint32_t lo = *cursor;
+        uint32_t hi = cols->count;
+        while (lo < hi) {
+                uint32_t mid = lo + (hi - lo) / 2;
+                if (cols->set[mid] < column) {
+                        lo = mid + 1;
+                } else {
+                        hi = mid;
+                }
+        }
+
+        *cursor = lo;
+        if (lo == cols->count) return UINT32_MAX;
+        if (cols->set[lo] != column) return 0;
+
+        *cursor = lo + 1;
+        return lo + 1;
+}
+
+
+/*
+ * Function: walk_row
+ * ----------------------------
+ * Visits the selected non-zeros of one matrix row in column order.
+ *
+ * @param V - Pointer to the view.
+ * @param row - Row of the matrix.
+ * @param view_row - The same row in view coordinates.
+ * @param visit - Callback receiving each non-zero.
+ * @param ctx - Caller context passed to the callback.
+ *
+ * Description:
+ *   For a symmetric matrix the part left of the diagonal is read first, from the stored column.
+ */
+static void walk_row(sm_view* V, uint32_t row, uint32_t view_row, sm_visit_fn visit, void* ctx) {
+        link_list* rows = V->M->rowList;
+        link_list* cols = V->M->columnList;
+        uint32_t cursor = 0;
+
+        if (V->M->symmetric) {
+                for (m_node* node = header_chain(cols, row); node && node->row < row; node = node->col_ptr) {
+                        uint32_t view_col = map_column(&V->cols, node->row, &cursor);
+                        if (view_col == UINT32_MAX) return;
+                        if (view_col) visit(view_row, view_col, node->value, ctx);
+                }
+        }
+
+        for (m_node* node = header_chain(rows, row); node; node = node->row_ptr) {
+                uint32_t view_col = map_column(&V->cols, node->column, &cursor);
+                if (view_col == UINT32_MAX) break;
+                if (view_col) visit(view_row, view_col, node->value, ctx);
+        }
+}
+
+
+/*
+ * Function: walk_view
+ * ----------------------------
+ * Visits the non-zeros of a range of view rows.
+ *
+ * @param V - Pointer to the view.
+ * @param first - First view row, at least 1.
+ * @param last - Last view row, at most V->rows.count.
+ * @param visit - Callback receiving each non-zero, in view coordinates.
+ * @param ctx - Caller context passed to the callback.
+ */
+static void walk_view(sm_view* V, uint32_t first, uint32_t last, sm_visit_fn visit, void* ctx) {
+        for (uint32_t view_row = first; view_row <= last; view_row++) {
+                walk_row(V, base_index(&V->rows, view_row), view_row, visit, ctx);
+        }
+}
+
+
+/*
+ * Function: view_block
+ * ----------------------------
+ * Creates a view of a contiguous block of a matrix in O(1).
+ *
+ * @param M - Pointer to the matrix.
+ * @param first_row - First row of the block.
+ * @param last_row - Last row of the block.
+ * @param first_col - First column of the block.
+ * @param last_col - Last column of the block.
+ *
+ * @return Pointer to the view, or NULL if the block is empty, out of bounds or allocation fails.
+ */
+sm_view* view_block(matrix* M, uint32_t first_row, uint32_t last_row, uint32_t first_col, uint32_t last_col) {
+        if (!M || first_row < 1 || first_row > last_row || last_row > M->row) return NULL;
+        if (first_col < 1 || first_col > last_col || last_col > M->col) return NULL;
+
+        sm_view* V = create_view(M);
+        if (!V) return NULL;
+
+        V->rows.first = first_row;
+        V->rows.count = last_row - first_row + 1;
+        V->cols.first = first_col;
+        V->cols.count = last_col - first_col + 1;
+
+        return V;
+}
+
+
+/*
+ * Function: view_rows
+ * ----------------------------
+ * Creates a view of a band of rows (all columns) in O(1).
+ *
+ * @param M - Pointer to the matrix.
+ * @param first - First row of the band.
+ * @param last - Last row of the band.
+ *
+ * @return Pointer to the view, or NULL on invalid input or allocation failure.
+ */
+sm_view* view_rows(matrix* M, uint32_t first, uint32_t last) {
+        return M ? view_block(M, first, last, 1, M->col) : NULL;
+}
+
+
+/*
+ * Function: view_columns
+ * ----------------------------
+ * Creates a view of a band of columns (all rows) in O(1).
+ *
+ * @param M - Pointer to the matrix.
+ * @param first - First column of the band.
+ * @param last - Last column of the band.
+ *
+ * @return Pointer to the view, or NULL on invalid input or allocation failure.
+ */
+sm_view* view_columns(matrix* M, uint32_t first, uint32_t last) {
+        return M ? view_block(M, 1, M->row, first, last) : NULL;
+}
+
+
+/*
+ * Function: view_index_sets
+ * ----------------------------
+ * Creates a view of arbitrary sets of rows and columns.
+ *
+ * @param M - Pointer to the matrix.
+ * @param rows - Selected rows in strictly increasing order, or NULL for all rows.
+ * @param row_count - Number of selected rows.
+ * @param cols - Selected columns in strictly increasing order, or NULL for all columns.
+ * @param col_count - Number of selected columns.
+ *
+ * @return Pointer to the view, or NULL on invalid input or allocation failure.
+ */
+sm_view* view_index_sets(matrix* M, const uint32_t* rows, uint32_t row_count, const uint32_t* cols, uint32_t col_count) {
+        if (!M) return NULL;
+
+        sm_view* V = create_view(M);
+        if (!V) return NULL;
+
+        if (!copy_index_set(&V->rows, rows, row_count, M->row) || !copy_index_set(&V->cols, cols, col_count, M->col)) {
+                free_view(V);
+                return NULL;
+        }
+
+        return V;
+}
+
+
+/*
+ * Function: view_get
+ * ----------------------------
+ * Reads a single element of a view.
+ *
+ * @param V - Pointer to the view.
+ * @param row - Row index in view coordinates.
+ * @param column - Column index in view coordinates.
+ *
+ * @return The stored value, or 0 if the position is empty or outside the view.
+ */
+double view_get(sm_view* V, uint32_t row, uint32_t column) {
+        if (!V || row < 1 || row > V->rows.count || column < 1 || column > V->cols.count) return 0;
+
+        uint32_t target_row = base_index(&V->rows, row);
+        uint32_t target_col = base_index(&V->cols, column);
+
+        // The lower triangle of a symmetric matrix is read from its mirror
+        if (V->M->symmetric && target_row > target_col) {
+                uint32_t temp = target_row;
+                target_row = target_col;
+                target_col = temp;
+        }
+
+        for (m_node* node = header_chain(V->M->rowList, target_row); node && node->column <= target_col; node = node->row_ptr) {
+                if (node->column == target_col) return node->value;
+        }
+
+        return 0;
+}
+
+
+/*
+ * Function: view_scan
+ * ----------------------------
+ * Visits every non-zero of a view in row-major order, in view coordinates.
+ *
+ * @param V - Pointer to the view.
+ * @param visit - Callback receiving each non-zero.
+ * @param ctx - Caller context passed to the callback.
+ */
+void view_scan(sm_view* V, sm_visit_fn visit, void* ctx) {
+        if (!V || !visit) return;
+        walk_view(V, 1, V->rows.count, visit, ctx);
+}
+
+
+/*
+ * Function: view_scan_row
+ * ----------------------------
+ * Visits the non-zeros of one view row in column order, in view coordinates.
+ *
+ * @param V - Pointer to the view.
+ * @param row - Row index in view coordinates.
+ * @param visit - Callback receiving each non-zero.
+ * @param ctx - Caller context passed to the callback.
+ */
+void view_scan_row(sm_view* V, uint32_t row, sm_visit_fn visit, void* ctx) {
+        if (!V || !visit || row < 1 || row > V->rows.count) return;
+        walk_view(V, row, row, visit, ctx);
+}
+
+
+/*
+ * Struct: spmv_ctx
+ * ----------------------------
+ * Operands of view_spmv.
+ */
+typedef struct spmv_ctx {
+        const double* x;
+        double* y;
+} spmv_ctx;
+
+
+/*
+ * Function: spmv_visit
+ * ----------------------------
+ * Visit callback of view_spmv; adds one product term to y.
+ *
+ * @param row - View row of the non-zero.
+ * @param column - View column of the non-zero.
+ * @param value - The non-zero.
+ * @param ctx - Pointer to the spmv_ctx.
+ */
+static void spmv_visit(uint32_t row, uint32_t column, double value, void* ctx) {
+        spmv_ctx* s = (spmv_ctx*)ctx;
+        s->y[row - 1] += value * s->x[column - 1];
+}
+
+
+/*
+ * Function: view_spmv
+ * ----------------------------
+ * Multiplies a view by a dense vector, y = Vx.
+ *
+ * @param V - Pointer to the view.
+ * @param x - Input vector of V->cols.count entries, indexed from 0.
+ * @param y - Output vector of V->rows.count entries, indexed from 0; overwritten.
+ */
+void view_spmv(sm_view* V, const double* x, double* y) {
+        if (!V || !x || !y) return;
+
+        memset(y, 0, V->rows.count * sizeof(double));
+
+        spmv_ctx s = { x, y };
+        walk_view(V, 1, V->rows.count, spmv_visit, &s);
+}
+
+
+/*
+ * Struct: export_ctx
+ * ----------------------------
+ * State of the pass of csr_from_view that fills the column and value arrays.
+ */
+typedef struct export_ctx {
+        csr_matrix* A;
+        uint64_t next;
+} export_ctx;
+
+
+/*
+ * Function: count_visit
+ * ----------------------------
+ * Visit callback of the first pass of csr_from_view; counts the non-zeros of each row.
+ *
+ * @param row - View row of the non-zero.
+ * @param column - Unused.
+ * @param value - Unused.
+ * @param ctx - Row counts, indexed by view row, so entry 0 stays free for the prefix sum.
+ */
+static void count_visit(uint32_t row, uint32_t column, double value, void* ctx) {
+        uint64_t* counts = (uint64_t*)ctx;
+        (void)column;
+        (void)value;
+        counts[row]++;
+}
+
+
+/*
+ * Function: fill_visit
+ * ----------------------------
+ * Visit callback of the second pass of csr_from_view; appends one non-zero. The walk goes row
+ * by row in column order, so appending keeps the CSR arrays sorted.
+ *
+ * @param row - Unused.
+ * @param column - View column of the non-zero.
+ * @param value - The non-zero.
+ * @param ctx - Pointer to the export_ctx.
+ */
+static void fill_visit(uint32_t row, uint32_t column, double value, void* ctx) {
+        export_ctx* e = (export_ctx*)ctx;
+        (void)row;
+        e->A->col_idx[e->next] = column;
+        e->A->values[e->next] = value;
+        e->next++;
+}
+
+
+/*
+ * Function: csr_from_view
+ * ----------------------------
+ * Exports a view to CSR form in view coordinates.
+ *
+ * @param V - Pointer to the view.
+ *
+ * @return Pointer to the CSR matrix, or NULL if allocation fails.
+ */
+csr_matrix* csr_from_view(sm_view* V) {
+        if (!V) return NULL;
+
+        uint64_t* counts = (uint64_t*)calloc((size_t)V->rows.count + 1, sizeof(uint64_t));
+        if (!counts) return NULL;
+
+        walk_view(V, 1, V->rows.count, count_visit, counts);
+
+        uint64_t nnz = 0;
+        for (uint32_t r = 1; r <= V->rows.count; r++) {
+                nnz += counts[r];
+                counts[r] = nnz;
+        }
+
+        csr_matrix* A = create_csr_matrix(V->rows.count, V->cols.count, nnz);
+        if (!A) {
+                free(counts);
+                return NULL;
+        }
+
+        memcpy(A->row_ptr, counts, ((size_t)V->rows.count + 1) * sizeof(uint64_t));
+        free(counts);
+
+        export_ctx e = { A, 0 };
+        walk_view(V, 1, V->rows.count, fill_visit, &e);
+
+        return A;
+}
+
+
+/*
+ * Function: materialize_view
+ * ----------------------------
+ * Copies a view into a new, independent linked matrix.
+ *
+ * @param V - Pointer to the view.
+ *
+ * @return Pointer to the matrix, or NULL if allocation fails.
+ */
+matrix* materialize_view(sm_view* V) {
+        csr_matrix* A = csr_from_view(V);
+        if (!A) return NULL;
+
+        matrix* M = S_Matrix_from_csr(A);
+        free_csr_matrix(A);
+
+        return M;
+}
+
+
+/*
+ * Function: free_view
+ * ----------------------------
+ * Frees a view; the viewed matrix is not touched.
+ *
+ * @param V - Pointer to the view.
+ */
+void free_view(sm_view* V) {
+        if (!V) return;
+
+        free(V->rows.set);
+        free(V->cols.set);
+        free(V);
+}
@@ -16,12 +16,12 @@
 /*
  * Function: _manage_patient
  * ----------------------------
- * Manages the patient queue by providing options to add, view, upgrade, process, bulk process, clear, and quit.
+ * Manages the patient queue by providing options to add, view, upgrade, reprioritize, process, bulk process, clear, and quit.
  *
  * Description:
  *   This function provides a menu-driven interface for managing patients in a priority queue.
  *   It allows the user to perform various operations such as adding a new patient, viewing the front patient,
- *   upgrading a patient's priority, processing the front patient, bulk processing, clearing the queue, and quitting the system.
+ *   upgrading or reprioritizing a patient, processing the front patient, bulk processing, clearing the queue, and quitting the system.
  */
 void _manage_patient() {
         system("clear");
@@ -31,7 +31,7 @@ void _manage_patient() {
         while(1) {
                 toString(p_queue);
                 char choice;
-                printf("N)ew, F)ront, U)pgrade, P)rocess, B)ulk, C)lear, Q)uit? ");
+                printf("N)ew, F)ront, U)pgrade, R)eprioritize, P)rocess, B)ulk, C)lear, Q)uit? ");
 
                 // Clearing buffer
                 do {
@@ -130,6 +130,40 @@ void _manage_patient() {
                                 printf("\n\n");
                                 break;
                         }
+                        case 'r': {
+                                char patient_name[20];
+                                uint16_t priority;
+                                printf("Name? ");
+
+                                do {
+                                        clearerr(stdin);
+                                } while (getchar() == EOF);
+
+                                fgets(patient_name, 20, stdin);
+                                patient_name[strcspn(patient_name,"\n")] = '\0';
+                                bool input_valid = false;
+                                while (!input_valid) {
+                                        printf("New priority? ");
+                                        if (scanf("%hu", &priority) == 1 && priority < 4) {
+                                                input_valid = true;
+                                        }
+                                        else {
+                                                printf("Enter valid priority!!\n");
+                                                do {
+                                                        clearerr(stdin);
+                                                } while (getchar() != '\n');
+                                        }
+                                }
+
+                                q_node* handle = pq_findPT(p_queue, patient_name);
+                                if (handle) {
+                                        pq_reprioritize(p_queue, handle, priority);
+                                } else {
+                                        printf("Patient not found\n");
+                                }
+                                printf("\n\n");
+                                break;
+                        }
                         case 'p': {
                                 if (!pq_isEmpty(p_queue)) {
                                         printf("Processing patient: %s\n\n", pq_processPT(p_queue));
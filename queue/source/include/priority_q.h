@@ -10,6 +10,9 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stdio.h>
+
+#include "../../../common/include/instrument.h"
 
 /*
  * Struct: q_node
@@ -18,10 +21,17 @@
  *
  * patient_name: Name of the patient.
  * next: Pointer to the next node in the queue.
+ * prev: Pointer to the previous node in the queue, so a node can be unlinked in O(1).
+ * priority: Priority level the node is waiting in.
+ *
+ * A node returned by pq_newPT is the patient's handle: it keeps its address while the patient
+ * moves between levels and is valid until the patient is processed or the queue is cleared.
  */
 typedef struct q_node {
         char* patient_name;
         struct q_node* next;
+        struct q_node* prev;
+        uint8_t priority;
 } q_node;
 
 /*
@@ -33,12 +43,14 @@ typedef struct q_node {
  * rear: Pointer to the rear node of the queue.
  * max_patient: Maximum number of patients allowed in this priority level.
  * current_patient: Current number of patients in this priority level.
+ * mem: Memory of the patients waiting in this priority level and its high-water marks.
  */
 typedef struct P_Queue {
         q_node* front;
         q_node* rear;
         uint8_t max_patient;
         uint8_t current_patient;
+        mem_stats mem;
 } P_Queue;
 
 /*
@@ -78,8 +90,10 @@ void FreePQ(P_Queue* p_arr);
  * @param p_arr - Array of priority queues.
  * @param pt_name - Name of the patient.
  * @param priority - Priority of the patient.
+ *
+ * @return Handle of the patient, or NULL if the patient was not added.
  */
-void pq_newPT(P_Queue* p_arr, char* pt_name, uint16_t priority);
+q_node* pq_newPT(P_Queue* p_arr, char* pt_name, uint16_t priority);
 
 /*
  * Function: pq_processPT
@@ -125,6 +139,38 @@ uint16_t pq_frontPriority(P_Queue* p_arr);
  */
 void pq_upgradePT(P_Queue* p_arr, char* patient_name, uint16_t new_priority);
 
+/*
+ * Function: pq_findPT
+ * ----------------------------
+ * Finds the handle of a waiting patient by name.
+ *
+ * @param p_arr - Pointer to the priority queue array.
+ * @param patient_name - Name of the patient.
+ *
+ * @return Handle of the first patient with that name in processing order, or NULL.
+ */
+q_node* pq_findPT(P_Queue* p_arr, char* patient_name);
+
+/*
+ * Function: pq_reprioritize
+ * ----------------------------
+ * Moves a waiting patient to another priority level, higher or lower.
+ *
+ * @param p_arr - Pointer to the priority queue array the patient waits in.
+ * @param handle - Handle of the patient from pq_newPT or pq_findPT.
+ * @param new_priority - New priority of the patient (0-3).
+ *
+ * @return true if the patient is at new_priority, false if the handle or priority is invalid
+ *         or that level is full.
+ *
+ * Description:
+ *   The patient is unlinked through its prev pointer and appended to the rear of the new
+ *   level, so the move takes O(1) time whatever the queue length. Like a new arrival, the
+ *   patient is processed after everyone already waiting at that level. Asking for the
+ *   current priority changes nothing and keeps the patient's place.
+ */
+bool pq_reprioritize(P_Queue* p_arr, q_node* handle, uint16_t new_priority);
+
 /*
  * Function: pq_isEmpty
  * ----------------------------
@@ -154,4 +200,53 @@ void pq_clear(P_Queue* p_arr);
  */
 void toString(P_Queue* p_arr);
 
+/*
+ * Function: pq_memory
+ * ----------------------------
+ * Reads the memory statistics of one priority level.
+ *
+ * @param p_arr - Pointer to the priority queue array.
+ * @param priority - The priority level (0-3).
+ * @param out - Output statistics; zeroed if the level does not exist.
+ *
+ * Description:
+ *   A patient moved by pq_upgradePT or pq_reprioritize leaves one level and joins another without an
+ *   allocation, so only the byte and node counts of the two levels change.
+ */
+void pq_memory(P_Queue* p_arr, uint16_t priority, mem_stats* out);
+
+/*
+ * Function: pq_memory_totals
+ * ----------------------------
+ * Reads the memory statistics of all priority queues of the process together.
+ *
+ * @param out - Output statistics.
+ */
+void pq_memory_totals(mem_stats* out);
+
+/*
+ * Function: pq_timers
+ * ----------------------------
+ * Gets the timers of the main queue operations.
+ *
+ * @param count - Output, number of timers.
+ *
+ * @return The timers: pq_newPT, pq_processPT, pq_upgradePT, pq_reprioritize and pq_clear.
+ *         They stay at zero unless the library is built with INSTRUMENT_TIMERS; pq_newPT
+ *         includes the wait for an answer when a level is full.
+ */
+const op_timer* pq_timers(uint32_t* count);
+
+/*
+ * Function: pq_memory_json
+ * ----------------------------
+ * Writes the library totals, the statistics of each priority level and the timers as JSON.
+ *
+ * @param out - Destination stream.
+ * @param p_arr - Pointer to the priority queue array, or NULL for the totals and timers only.
+ *
+ * @return true if the JSON was written, false on a stream error.
+ */
+bool pq_memory_json(FILE* out, P_Queue* p_arr);
+
 #endif // PRIORITY_Q_H
@@ -14,6 +14,27 @@
 
 #include "../include/priority_q.h"
 
+// Memory of every priority queue of the process
+static mem_stats totals;
+
+// Timers of the main operations, in the order pq_timers documents
+enum {
+        TIMER_NEW,
+        TIMER_PROCESS,
+        TIMER_UPGRADE,
+        TIMER_REPRIORITIZE,
+        TIMER_CLEAR,
+        TIMER_COUNT
+};
+
+static op_timer timers[TIMER_COUNT] = {
+        { "pq_newPT", 0, 0 },
+        { "pq_processPT", 0, 0 },
+        { "pq_upgradePT", 0, 0 },
+        { "pq_reprioritize", 0, 0 },
+        { "pq_clear", 0, 0 }
+};
+
 /*
  * Function: create_q_node
  * ----------------------------
@@ -33,10 +54,94 @@ q_node* create_q_node(char* pt_name) {
 
         new_q_node->patient_name = pt_name;
         new_q_node->next = NULL;
+        new_q_node->prev = NULL;
+        new_q_node->priority = 0;
 
+        mem_stats_alloc(&totals, sizeof(q_node), 1, 1);
         return new_q_node;
 }
 
+/*
+ * Function: free_q_node
+ * ----------------------------
+ * Frees a node made by create_q_node (not the patient name).
+ *
+ * @param node - Pointer to the node.
+ */
+static void free_q_node(q_node* node) {
+        free(node);
+        mem_stats_free(&totals, sizeof(q_node), 1, 1);
+}
+
+/*
+ * Function: append_q_node
+ * ----------------------------
+ * Links a node at the rear of a priority level.
+ *
+ * @param level - The priority level.
+ * @param node - The node, not linked anywhere.
+ */
+static void append_q_node(P_Queue* level, q_node* node) {
+        node->next = NULL;
+        node->prev = level->rear;
+
+        if (level->rear) {
+                level->rear->next = node;
+        } else {
+                level->front = node;
+        }
+
+        level->rear = node;
+        level->current_patient++;
+}
+
+/*
+ * Function: unlink_q_node
+ * ----------------------------
+ * Takes a node out of its priority level in O(1) time.
+ *
+ * @param level - The priority level the node is linked in.
+ * @param node - The node.
+ */
+static void unlink_q_node(P_Queue* level, q_node* node) {
+        if (node->prev) {
+                node->prev->next = node->next;
+        } else {
+                level->front = node->next;
+        }
+
+        if (node->next) {
+                node->next->prev = node->prev;
+        } else {
+                level->rear = node->prev;
+        }
+
+        node->next = NULL;
+        node->prev = NULL;
+        level->current_patient--;
+}
+
+/*
+ * Function: move_q_node
+ * ----------------------------
+ * Moves a node to the rear of another priority level.
+ *
+ * @param p_arr - Pointer to the priority queue array.
+ * @param node - The node.
+ * @param new_priority - The new priority level, which must have room.
+ */
+static void move_q_node(P_Queue* p_arr, q_node* node, uint8_t new_priority) {
+        uint8_t priority = node->priority;
+
+        unlink_q_node(&p_arr[priority], node);
+        node->priority = new_priority;
+        append_q_node(&p_arr[new_priority], node);
+
+        // The node changes level without being reallocated
+        mem_stats_free(&p_arr[priority].mem, sizeof(q_node), 1, 0);
+        mem_stats_alloc(&p_arr[new_priority].mem, sizeof(q_node), 1, 0);
+}
+
 /*
  * Function: PQ
  * ----------------------------
@@ -55,7 +160,9 @@ P_Queue* PQ() {
                 priority_arr[priority].front = NULL;
                 priority_arr[priority].rear = NULL;
                 priority_arr[priority].current_patient = 0;
+                priority_arr[priority].mem = (mem_stats){ 0 };
         }
+        mem_stats_alloc(&totals, 4 * sizeof(P_Queue), 0, 1);
 
         priority_arr[0].max_patient = 3;
         priority_arr[1].max_patient = 10;
@@ -79,11 +186,12 @@ void FreePQ(P_Queue* p_arr) {
                         while (temp) {
                                 q_node* cur = temp;
                                 temp = temp->next;
-                                free(cur);
+                                free_q_node(cur);
                         }
                 }
         }
         free(p_arr);
+        mem_stats_free(&totals, 4 * sizeof(P_Queue), 0, 1);
 }
 
 /*
@@ -94,19 +202,22 @@ void FreePQ(P_Queue* p_arr) {
  * @param p_arr - Array of priority queues.
  * @param pt_name - Name of the patient.
  * @param priority - Priority of the patient.
+ *
+ * @return Handle of the patient, or NULL if the patient was not added.
  */
-void pq_newPT(P_Queue* p_arr, char* pt_name, uint16_t priority) {
+q_node* pq_newPT(P_Queue* p_arr, char* pt_name, uint16_t priority) {
+        OP_TIMED(timers[TIMER_NEW]);
+
         q_node* new_node = create_q_node(pt_name);
+        if (!new_node) return NULL;
 
-        if (!p_arr[priority].front) {
-                p_arr[priority].front = new_node;
-                p_arr[priority].rear = new_node;
-                p_arr[priority].current_patient++;
-        } else {
+        if (p_arr[priority].front) {
                 if (p_arr[priority].current_patient == p_arr[priority].max_patient) {
+                        free_q_node(new_node);
+
                         if (priority == 3) {
                                 printf("You can't adjust more patients\n");
-                                return;
+                                return NULL;
                         }
 
                         printf("You can't add more patients in this priority\n");
@@ -119,16 +230,18 @@ void pq_newPT(P_Queue* p_arr, char* pt_name, uint16_t priority) {
                         } while (choice == '\n');
 
                         if (tolower(choice) == 'y') {
-                                pq_newPT(p_arr, pt_name, priority + 1);
+                                return pq_newPT(p_arr, pt_name, priority + 1);
                         }
 
-                        return;
+                        return NULL;
                 }
-
-                p_arr[priority].rear->next = new_node;
-                p_arr[priority].rear = new_node;
-                p_arr[priority].current_patient++;
         }
+
+        new_node->priority = priority;
+        append_q_node(&p_arr[priority], new_node);
+        mem_stats_alloc(&p_arr[priority].mem, sizeof(q_node), 1, 1);
+
+        return new_node;
 }
 
 /*
@@ -141,6 +254,8 @@ void pq_newPT(P_Queue* p_arr, char* pt_name, uint16_t priority) {
  * @return Name of the processed patient.
  */
 char* pq_processPT(P_Queue* p_arr) {
+        OP_TIMED(timers[TIMER_PROCESS]);
+
         if (pq_isEmpty(p_arr)) {
                 return "Sorry, There is no Patient";
         } else {
@@ -148,17 +263,11 @@ char* pq_processPT(P_Queue* p_arr) {
                 for (priority = 0; priority < 4 && !p_arr[priority].front; priority++);
 
                 q_node* temp = p_arr[priority].front;
+                unlink_q_node(&p_arr[priority], temp);
 
-                if (!temp->next) {
-                        p_arr[priority].front = NULL;
-                        p_arr[priority].rear = NULL;
-                } else {
-                        p_arr[priority].front = temp->next;
-                }
-
-                p_arr[priority].current_patient--;
                 char* patient_name = temp->patient_name;
-                free(temp);
+                free_q_node(temp);
+                mem_stats_free(&p_arr[priority].mem, sizeof(q_node), 1, 1);
 
                 return patient_name;
         }
@@ -214,64 +323,89 @@ uint16_t pq_frontPriority(P_Queue* p_arr) {
  * @param new_priority - New priority of the patient.
  */
 void pq_upgradePT(P_Queue* p_arr, char* patient_name, uint16_t new_priority) {
+        OP_TIMED(timers[TIMER_UPGRADE]);
+
         if (pq_isEmpty(p_arr)) {
                 printf("Sorry! There is no patient\n");
                 return;
         }
 
-        bool found_patient = false;
-        
-        for (uint8_t priority = 0; priority < 4 && !found_patient; priority++) {
-                q_node* temp = p_arr[priority].front;
-                q_node* prev = NULL;
+        q_node* temp = pq_findPT(p_arr, patient_name);
+        if (!temp) {
+                printf("Patient not found\n");
+                return;
+        }
 
-                while (temp) {
+        if (temp->priority <= new_priority) {
+                printf("You can't downgrade the priority\n");
+                return;
+        }
+
+        if (p_arr[new_priority].current_patient == p_arr[new_priority].max_patient) {
+                printf("Upper priority is already full\n");
+                return;
+        }
+
+        move_q_node(p_arr, temp, new_priority);
+}
+
+/*
+ * Function: pq_findPT
+ * ----------------------------
+ * Finds the handle of a waiting patient by name.
+ *
+ * @param p_arr - Pointer to the priority queue array.
+ * @param patient_name - Name of the patient.
+ *
+ * @return Handle of the first patient with that name in processing order, or NULL.
+ */
+q_node* pq_findPT(P_Queue* p_arr, char* patient_name) {
+        if (!p_arr || !patient_name) return NULL;
+
+        for (uint8_t priority = 0; priority < 4; priority++) {
+                for (q_node* temp = p_arr[priority].front; temp; temp = temp->next) {
                         if (strcmp(temp->patient_name, patient_name) == 0) {
-                                if (priority <= new_priority) {
-                                        printf("You can't downgrade the priority\n");
-                                        return;
-                                }
-
-                                if (p_arr[new_priority].current_patient == p_arr[new_priority].max_patient) {
-                                        printf("Upper priority is already full\n");
-                                        return;
-                                }
-
-                                if (prev) {
-                                        prev->next = temp->next;
-                                } else {
-                                        p_arr[priority].front = temp->next;
-                                }
-
-                                if (temp == p_arr[priority].rear) {
-                                        p_arr[priority].rear = prev;
-                                }
-
-                                p_arr[priority].current_patient--;
-
-                                if (!p_arr[new_priority].front) {
-                                        p_arr[new_priority].front = temp;
-                                        p_arr[new_priority].rear = temp;
-                                } else {
-                                        p_arr[new_priority].rear->next = temp;
-                                        p_arr[new_priority].rear = temp;
-                                }
-
-                                temp->next = NULL;
-                                p_arr[new_priority].current_patient++;
-
-                                found_patient = true;
-                                break;
+                                return temp;
                         }
-
-                        prev = temp;
-                        temp = temp->next;
                 }
         }
 
-        if (!found_patient) {
+        return NULL;
+}
+
+/*
+ * Function: pq_reprioritize
+ * ----------------------------
+ * Moves a waiting patient to another priority level, higher or lower.
+ *
+ * @param p_arr - Pointer to the priority queue array the patient waits in.
+ * @param handle - Handle of the patient from pq_newPT or pq_findPT.
+ * @param new_priority - New priority of the patient (0-3).
+ *
+ * @return true if the patient is at new_priority, false otherwise.
+ */
+bool pq_reprioritize(P_Queue* p_arr, q_node* handle, uint16_t new_priority) {
+        OP_TIMED(timers[TIMER_REPRIORITIZE]);
+
+        if (!p_arr || !handle || handle->priority > 3) {
                 printf("Patient not found\n");
+                return false;
+        }
+
+        if (new_priority > 3) {
+                printf("Enter valid priority!!\n");
+                return false;
+        }
+
+        if (handle->priority == new_priority) return true;
+
+        if (p_arr[new_priority].current_patient == p_arr[new_priority].max_patient) {
+                printf("That priority is already full\n");
+                return false;
         }
+
+        move_q_node(p_arr, handle, new_priority);
+        return true;
 }
 
 /*
@@ -300,6 +434,8 @@ bool pq_isEmpty(P_Queue* p_arr) {
  * @param p_arr - Pointer to the priority queue array.
  */
 void pq_clear(P_Queue* p_arr) {
+        OP_TIMED(timers[TIMER_CLEAR]);
+
         if (pq_isEmpty(p_arr)) {
                 printf("Queue is already clean\n");
                 return;
@@ -310,8 +446,11 @@ void pq_clear(P_Queue* p_arr) {
                 while (temp) {
                         q_node* cur = temp;
                         temp = temp->next;
-                        free(cur);
+                        free_q_node(cur);
                 }
+
+                uint64_t removed = p_arr[priority].current_patient;
+                mem_stats_free(&p_arr[priority].mem, removed * sizeof(q_node), removed, removed);
                 p_arr[priority].front = NULL;
                 p_arr[priority].rear = NULL;
                 p_arr[priority].current_patient = 0;
@@ -354,3 +493,69 @@ void toString(P_Queue* p_arr) {
         }
         printf("} (not empty)\n");
 }
+
+/*
+ * Function: pq_memory
+ * ----------------------------
+ * Reads the memory statistics of one priority level.
+ *
+ * @param p_arr - Pointer to the priority queue array.
+ * @param priority - The priority level (0-3).
+ * @param out - Output statistics; zeroed if the level does not exist.
+ */
+void pq_memory(P_Queue* p_arr, uint16_t priority, mem_stats* out) {
+        if (!out) return;
+
+        if (!p_arr || priority > 3) {
+                *out = (mem_stats){ 0 };
+                return;
+        }
+
+        mem_stats_read(&p_arr[priority].mem, out);
+}
+
+/*
+ * Function: pq_memory_totals
+ * ----------------------------
+ * Reads the memory statistics of all priority queues of the process together.
+ *
+ * @param out - Output statistics.
+ */
+void pq_memory_totals(mem_stats* out) {
+        if (out) mem_stats_read(&totals, out);
+}
+
+/*
+ * Function: pq_timers
+ * ----------------------------
+ * Gets the timers of the main queue operations.
+ *
+ * @param count - Output, number of timers.
+ *
+ * @return The timers.
+ */
+const op_timer* pq_timers(uint32_t* count) {
+        if (count) *count = TIMER_COUNT;
+        return timers;
+}
+
+/*
+ * Function: pq_memory_json
+ * ----------------------------
+ * Writes the library totals, the statistics of each priority level and the timers as JSON.
+ *
+ * @param out - Destination stream.
+ * @param p_arr - Pointer to the priority queue array, or NULL for the totals and timers only.
+ *
+ * @return true if the JSON was written, false on a stream error.
+ */
+bool pq_memory_json(FILE* out, P_Queue* p_arr) {
+        if (!p_arr) return instrument_json(out, "priority_q", &totals, NULL, 0, timers, TIMER_COUNT);
+
+        mem_stats levels[4];
+        for (uint16_t priority = 0; priority < 4; priority++) {
+                mem_stats_read(&p_arr[priority].mem, &levels[priority]);
+        }
+
+        return instrument_json(out, "priority_q", &totals, levels, 4, timers, TIMER_COUNT);
+}